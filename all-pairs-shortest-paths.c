@@ -10,6 +10,12 @@
 #include "util.h" //assert_memory()
 #include "vadd.h" //VADD_Compute_Edge_Delay()
 #include "shortest-path.h" //Update_LinkDelay_Information()
+#include "heap.h" //indexed_heap_t
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h> //SSE2 intrinsics for the Floyd-Warshall kernels
+#define FLOYD_WARSHALL_SSE2_KERNEL
+#endif
 
 ///////////////////////////////////////////////////////////////////
 void Floyd_Warshall_Allocate_All_Matrices(int G_size, double ***Dr_move, int ***Mr_move, int *matrix_size_for_movement_in_Gr, double ***Dv_move, int ***Mv_move, int *matrix_size_for_movement_in_Gv, int ***Dv_scan, int ***Mv_scan, int *matrix_size_for_scanning_in_Gv, int ***Dv_breach, int ***Mv_breach, int *matrix_size_for_breach_in_Gv)
@@ -64,51 +70,50 @@ void Floyd_Warshall_Free_All_Matrices(double ***Dr_move, int ***Mr_move, int *ma
 
 double** Floyd_Warshall_Allocate_Matrix_Of_Type_Double(int size)
 { //allocate the memory of the matrix of type double whose rows and columns correspond to size
-	double **A = NULL; //matrix
-	int i;
-
-	A = (double**)calloc(size, sizeof(double*)); //all of entries are set to zero
-	assert_memory(A);
-
-	for(i = 0; i < size; i++)
-	{
-		A[i] = (double*)calloc(size, sizeof(double));
-		assert_memory(A[i]);
-	}
-
-	return A;
+	return Floyd_Warshall_Allocate_2D_Matrix_Of_Type_Double(size, size);
 }
 
 int** Floyd_Warshall_Allocate_Matrix_Of_Type_Int(int size)
-{ //allocate the memory of the matrix of type int whose rows and columns correspond to size
+{ //allocate the memory of the matrix of type int whose rows and columns correspond to size;
+  //the rows are laid out contiguously in row-major order in one memory block
 	int **A = NULL; //matrix
+	int *block = NULL; //memory block for all the rows
 	int i;
 
 	A = (int**)calloc(size, sizeof(int*)); //all of entries are set to zero
 	assert_memory(A);
 
+	if(size == 0)
+		return A;
+
+	block = (int*)calloc((size_t)size*size, sizeof(int));
+	assert_memory(block);
+
 	for(i = 0; i < size; i++)
-	{
-		A[i] = (int*)calloc(size, sizeof(int));
-		assert_memory(A[i]);
-	}
+		A[i] = block + (size_t)i*size;
 
 	return A;
 }
 
 double** Floyd_Warshall_Allocate_2D_Matrix_Of_Type_Double(int row_size, int column_size)
-{ //allocate the memory of the 2-dimensional matrix of type double whose row_size is row size and column_size is column size
+{ //allocate the memory of the 2-dimensional matrix of type double whose row_size is row size and column_size is column size;
+  //the rows are laid out contiguously in row-major order in one memory block and A[i] points to the i-th row,
+  //so the matrix is still accessed as A[i][j] but a row scan does not jump across the heap
 	double **A = NULL; //matrix
+	double *block = NULL; //memory block for all the rows
 	int i;
 
 	A = (double**)calloc(row_size, sizeof(double*)); //all of entries are set to zero
 	assert_memory(A);
 
+	if(row_size == 0)
+		return A;
+
+	block = (double*)calloc((size_t)row_size*column_size, sizeof(double));
+	assert_memory(block);
+
 	for(i = 0; i < row_size; i++)
-	{
-		A[i] = (double*)calloc(column_size, sizeof(double));
-		assert_memory(A[i]);
-	}
+		A[i] = block + (size_t)i*column_size;
 
 	return A;
 }
@@ -160,30 +165,24 @@ int** Floyd_Warshall_Reallocate_Matrix_Of_Type_Int(int **A, int old_size, int ne
 
 void Floyd_Warshall_Free_Matrix_Of_Type_Double(double **A, int size)
 { //free the memory for 2-dimensional martix A of type double
-	int i;
-	
-	for(i = 0; i < size; i++)
-		free(A[i]);
+	if(size > 0)
+		free(A[0]); //the memory block for all the rows
 
 	free(A);
 }
 
 void Floyd_Warshall_Free_Matrix_Of_Type_Int(int **A, int size)
 { //free the memory for 2-dimensional martix A of type int
-	int i;
-	
-	for(i = 0; i < size; i++)
-		free(A[i]);
+	if(size > 0)
+		free(A[0]); //the memory block for all the rows
 
 	free(A);
 }
 
 void Floyd_Warshall_Free_2D_Matrix_Of_Type_Double(double **A, int row_size, int column_size)
 { //free the memory for 2-dimensional martix A of type double whose row_size is row size and column_size is column size
-	int i;
-	
-	for(i = 0; i < row_size; i++)
-		free(A[i]);
+	if(row_size > 0)
+		free(A[0]); //the memory block for all the rows
 
 	free(A);
 }
@@ -779,7 +778,7 @@ double** Floyd_Warshall_Make_Weight_Matrix_For_Movement(double **W, int W_size,
 
 		while(ptr != NULL)
 		{
-			j = atoi(ptr->vertex) - 1; 
+			j = ptr->vertex_id - 1; 
 			//node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 			W[i][j] = ptr->weight;
 			ptr = ptr->next;
@@ -898,7 +897,7 @@ void Floyd_Warshall_Make_Weight_Matrix_For_EDD(double **D, double **S, int D_siz
 
 		while(ptr != NULL)
 		{
-			j = atoi(ptr->vertex) - 1; 
+			j = ptr->vertex_id - 1; 
 			//node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 			
 			/* update the link delay, link delay variance, link delay standard deviation for each edge in the graph G with the traffic statistics of vehicular traffic density and vehicle speed */
@@ -959,7 +958,7 @@ void Floyd_Warshall_Make_Weight_Matrix_For_EDD_VAR(double **D, double **S, int D
 
 		while(ptr != NULL)
 		{
-			j = atoi(ptr->vertex) - 1; 
+			j = ptr->vertex_id - 1; 
 			//node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 
 			/* update the link delay, link delay variance, link delay standard deviation for each edge in the graph G with the traffic statistics of vehicular traffic density and vehicle speed */
@@ -1023,7 +1022,7 @@ void Floyd_Warshall_Make_Weight_Matrix_For_EDC(double **W, double **D, double **
 
 		while(ptr != NULL)
 		{
-			j = atoi(ptr->vertex) - 1; 
+			j = ptr->vertex_id - 1; 
 			//node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 			
 			/* update the link cost (e.g., delay or link utilization), link cost variance, link cost standard deviation for each edge in the graph G with the traffic statistics of vehicular traffic density and vehicle speed */
@@ -1079,7 +1078,7 @@ int** Floyd_Warshall_Make_Weight_Matrix_For_Hop(int **W, int W_size, struct_grap
 
 		while(ptr != NULL)
 		{
-			j = atoi(ptr->vertex) - 1; 
+			j = ptr->vertex_id - 1; 
 			//node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 			W[i][j] = 1; //Note that 1 indicates the existence of an edge between nodes i and j
 			ptr = ptr->next;
@@ -1365,6 +1364,526 @@ int Floyd_Warshall_Construct_Matrices_For_EDC(struct_graph_node *G, int G_size,
 	return 0;
 }
 
+/** incremental maintenance of the all-pairs shortest path matrices for EDD and EDC */
+#if defined(_LINUX_) && FORWARDING_TABLE_THREAD_POOL_FLAG /* [ */
+/* the forwarding table workers of UpdateForwardingTableQueue() run the incremental update concurrently, so each thread has its own scratch matrices */
+#define APSP_THREAD_LOCAL __thread
+#define APSP_COUNT(counter, n) __sync_fetch_and_add(&(counter), (n))
+#else
+#define APSP_THREAD_LOCAL
+#define APSP_COUNT(counter, n) ((counter) += (n))
+#endif /* ] */
+
+static APSP_THREAD_LOCAL double **apsp_incremental_W = NULL; //scratch matrix for the new edge weights
+static APSP_THREAD_LOCAL double **apsp_incremental_V = NULL; //scratch matrix for the new supplementary edge weights
+static APSP_THREAD_LOCAL int apsp_incremental_scratch_size = 0; //row and column size of the scratch matrices
+
+static unsigned long apsp_incremental_unchanged_count = 0; //number of updates where no edge weight changed
+static unsigned long apsp_incremental_repair_count = 0; //number of updates repaired incrementally
+static unsigned long apsp_incremental_rebuild_count = 0; //number of updates rebuilt with the Floyd-Warshall algorithm
+static unsigned long apsp_incremental_changed_edge_count = 0; //number of changed edges handled by the incremental repairs
+
+static void Floyd_Warshall_Prepare_Scratch_Matrices_For_Incremental_Update(int G_size)
+{ //make sure that the scratch matrices for the new edge weights can hold G_size nodes
+	if(G_size <= apsp_incremental_scratch_size)
+		return;
+
+	if(apsp_incremental_W != NULL)
+	{
+		Floyd_Warshall_Free_Matrix_Of_Type_Double(apsp_incremental_W, apsp_incremental_scratch_size);
+		Floyd_Warshall_Free_Matrix_Of_Type_Double(apsp_incremental_V, apsp_incremental_scratch_size);
+	}
+
+	apsp_incremental_W = Floyd_Warshall_Allocate_Matrix_Of_Type_Double(G_size);
+	apsp_incremental_V = Floyd_Warshall_Allocate_Matrix_Of_Type_Double(G_size);
+	apsp_incremental_scratch_size = G_size;
+}
+
+static void Floyd_Warshall_Recompute_Shortest_PathInfo_Row(double **W, double **V, int n, double **D, int **M, double **S, int src, boolean *visit)
+{ //recompute the row src of D, M and S with Dijkstra's algorithm over the edge weight matrix W and the supplementary edge weight matrix V
+	int i, u, v;
+	double min;
+
+	for(v = 0; v < n; v++)
+	{
+		D[src][v] = INF;
+		S[src][v] = INF;
+		M[src][v] = NIL;
+		visit[v] = FALSE;
+	}
+	D[src][src] = 0;
+	S[src][src] = 0;
+
+	for(i = 0; i < n; i++)
+	{
+		/* pick the unvisited node with the minimum distance */
+		u = NIL;
+		min = INF;
+		for(v = 0; v < n; v++)
+		{
+			if(visit[v] == FALSE && D[src][v] < min)
+			{
+				min = D[src][v];
+				u = v;
+			}
+		}
+
+		if(u == NIL)
+			break; //the remaining nodes are unreachable from src
+
+		visit[u] = TRUE;
+
+		/* relax the edges going out of u */
+		for(v = 0; v < n; v++)
+		{
+			if(visit[v] == TRUE || W[u][v] >= INF)
+				continue;
+
+			if(D[src][v] > D[src][u] + W[u][v])
+			{
+				D[src][v] = D[src][u] + W[u][v];
+				S[src][v] = S[src][u] + V[u][v];
+				M[src][v] = u;
+			}
+		}
+	}
+}
+
+#if APSP_INCREMENTAL_UPDATE_SELF_CHECK_FLAG
+static void Floyd_Warshall_Check_Incremental_Update(double **W, double **V, int n, double **D, int **M, double **S, int (*construct)(double**, int**, double**, int))
+{ //compare the incrementally repaired matrices D, M and S with the ones rebuilt by the Floyd-Warshall algorithm
+	double **D_batch = NULL, **S_batch = NULL;
+	int **M_batch = NULL;
+	int i, j;
+	int predecessor_mismatch_count = 0, supplementary_mismatch_count = 0;
+
+	Floyd_Warshall_Allocate_Matrices_For_EDD(&D_batch, &M_batch, &S_batch, n);
+	for(i = 0; i < n; i++)
+	{
+		memcpy(D_batch[i], W[i], n*sizeof(double));
+		memcpy(S_batch[i], V[i], n*sizeof(double));
+	}
+	construct(D_batch, M_batch, S_batch, n);
+
+	for(i = 0; i < n; i++)
+	{
+		for(j = 0; j < n; j++)
+		{
+			if(fabs(D[i][j] - D_batch[i][j]) > ERROR_TOLERANCE_FOR_REAL_ARITHMETIC*MAX(1, fabs(D_batch[i][j])))
+			{
+				printf("Floyd_Warshall_Check_Incremental_Update(): D[%d][%d](=%f) is different from the Floyd-Warshall result(=%f)\n", i, j, (float)D[i][j], (float)D_batch[i][j]);
+				exit(1);
+			}
+
+			if(M[i][j] != M_batch[i][j])
+				predecessor_mismatch_count++; //a different shortest path with the same length is chosen
+
+			if(fabs(S[i][j] - S_batch[i][j]) > ERROR_TOLERANCE_FOR_REAL_ARITHMETIC*MAX(1, fabs(S_batch[i][j])))
+				supplementary_mismatch_count++;
+		}
+	}
+
+	if(predecessor_mismatch_count > 0 || supplementary_mismatch_count > 0)
+		printf("Floyd_Warshall_Check_Incremental_Update(): D matches; tie-breaking differs in %d predecessors and %d supplementary metrics\n", predecessor_mismatch_count, supplementary_mismatch_count);
+
+	Floyd_Warshall_Free_Matrices_For_EDD(&D_batch, &M_batch, &S_batch, &n);
+}
+#endif
+
+static void Floyd_Warshall_Update_Shortest_PathInfo_Incrementally(double **W, double **V, int n, double **D, int **M, double **S, double ***W_prev, double ***V_prev, int *n_prev, boolean rebuild_flag, int (*construct)(double**, int**, double**, int))
+{ //repair D, M and S for the new edge weights W and V from the previous edge weights W_prev and V_prev; if there are too many changed edges, rebuild them with the Floyd-Warshall algorithm
+	int i, j, k, u, v;
+	int edge_number = 0; //number of edges in the new weight matrix
+	int changed_edge_number = 0; //number of changed edges
+	int decreased_edge_number = 0; //number of edges whose weight decreased
+	boolean *row_flag = NULL; //flags for the rows to be recomputed
+	boolean *visit = NULL; //visit flags for Dijkstra's algorithm
+	int *decreased_edge_tail = NULL, *decreased_edge_head = NULL; //decreased edges (u,v)
+	double w, t; //weight and supplementary weight of a decreased edge
+
+	if(*W_prev == NULL || *n_prev != n)
+		rebuild_flag = TRUE;
+
+	/** count the edges and the changed edges */
+	if(rebuild_flag == FALSE)
+	{
+		for(u = 0; u < n; u++)
+		{
+			for(v = 0; v < n; v++)
+			{
+				if(u == v)
+					continue;
+
+				if(W[u][v] < INF)
+					edge_number++;
+
+				if(W[u][v] != (*W_prev)[u][v] || V[u][v] != (*V_prev)[u][v])
+					changed_edge_number++;
+			}
+		}
+
+		if(changed_edge_number > APSP_INCREMENTAL_UPDATE_CHANGE_RATIO_THRESHOLD*edge_number)
+			rebuild_flag = TRUE;
+	}
+
+	if(rebuild_flag)
+	{
+		/** rebuild D, M and S with the Floyd-Warshall algorithm */
+		for(i = 0; i < n; i++)
+		{
+			memcpy(D[i], W[i], n*sizeof(double));
+			memcpy(S[i], V[i], n*sizeof(double));
+		}
+		construct(D, M, S, n);
+
+		APSP_COUNT(apsp_incremental_rebuild_count, 1);
+	}
+	else if(changed_edge_number == 0)
+	{
+		/** D, M and S are still valid */
+		APSP_COUNT(apsp_incremental_unchanged_count, 1);
+	}
+	else
+	{
+		row_flag = (boolean*)calloc(n, sizeof(boolean));
+		assert_memory(row_flag);
+		visit = (boolean*)calloc(n, sizeof(boolean));
+		assert_memory(visit);
+		decreased_edge_tail = (int*)calloc(changed_edge_number, sizeof(int));
+		assert_memory(decreased_edge_tail);
+		decreased_edge_head = (int*)calloc(changed_edge_number, sizeof(int));
+		assert_memory(decreased_edge_head);
+
+		/** classify the changed edges: an edge whose weight increased or whose supplementary weight changed
+		    invalidates the rows whose shortest path tree contains it, and an edge whose weight decreased can
+		    only shorten the existing paths */
+		for(u = 0; u < n; u++)
+		{
+			for(v = 0; v < n; v++)
+			{
+				if(u == v || (W[u][v] == (*W_prev)[u][v] && V[u][v] == (*V_prev)[u][v]))
+					continue;
+
+				if(W[u][v] < (*W_prev)[u][v])
+				{
+					decreased_edge_tail[decreased_edge_number] = u;
+					decreased_edge_head[decreased_edge_number] = v;
+					decreased_edge_number++;
+				}
+
+				if(W[u][v] > (*W_prev)[u][v] || V[u][v] != (*V_prev)[u][v])
+				{
+					for(i = 0; i < n; i++)
+					{
+						if(M[i][v] == u)
+							row_flag[i] = TRUE;
+					}
+				}
+			}
+		}
+
+		/** recompute the invalidated rows from scratch with the new weights */
+		for(i = 0; i < n; i++)
+		{
+			if(row_flag[i])
+				Floyd_Warshall_Recompute_Shortest_PathInfo_Row(W, V, n, D, M, S, i, visit);
+		}
+
+		/** relax all the pairs through each decreased edge (u,v) */
+		for(k = 0; k < decreased_edge_number; k++)
+		{
+			u = decreased_edge_tail[k];
+			v = decreased_edge_head[k];
+			w = W[u][v];
+			t = V[u][v];
+
+			for(i = 0; i < n; i++)
+			{
+				if(D[i][u] >= INF)
+					continue;
+
+				for(j = 0; j < n; j++)
+				{
+					if(D[v][j] >= INF)
+						continue;
+
+					if(D[i][j] > D[i][u] + w + D[v][j])
+					{
+						D[i][j] = D[i][u] + w + D[v][j];
+						S[i][j] = S[i][u] + t + S[v][j];
+						M[i][j] = (j == v) ? u : M[v][j];
+					}
+				}
+			}
+		}
+
+		free(row_flag);
+		free(visit);
+		free(decreased_edge_tail);
+		free(decreased_edge_head);
+
+		APSP_COUNT(apsp_incremental_repair_count, 1);
+		APSP_COUNT(apsp_incremental_changed_edge_count, changed_edge_number);
+
+#if APSP_INCREMENTAL_UPDATE_SELF_CHECK_FLAG
+		Floyd_Warshall_Check_Incremental_Update(W, V, n, D, M, S, construct);
+#endif
+	}
+
+	/** remember the edge weights for the next update */
+	if(*W_prev == NULL || *n_prev != n)
+	{
+		if(*W_prev != NULL)
+			Floyd_Warshall_Free_Weight_Matrices_For_Incremental_Update(W_prev, V_prev, n_prev);
+
+		*W_prev = Floyd_Warshall_Allocate_Matrix_Of_Type_Double(n);
+		*V_prev = Floyd_Warshall_Allocate_Matrix_Of_Type_Double(n);
+		*n_prev = n;
+	}
+
+	for(i = 0; i < n; i++)
+	{
+		memcpy((*W_prev)[i], W[i], n*sizeof(double));
+		memcpy((*V_prev)[i], V[i], n*sizeof(double));
+	}
+}
+
+int Floyd_Warshall_Construct_Matrices_For_EDD_Incrementally(struct_graph_node *G, int G_size, double ***D, int ***M, double ***S, int *matrix_size, double ***W_prev, double ***V_prev, int *n_prev, parameter_t *param)
+{ //construct the matrices D, M and S for EDD by repairing the ones of the previous update with the changed edge weights
+	boolean rebuild_flag = FALSE; //flag to rebuild the matrices with the Floyd-Warshall algorithm
+
+	/** check whether graph information is valid or not */
+	if(G_size < 0 || G == NULL)
+	{
+	  printf("Floyd_Warshall_Construct_Matrices_For_EDD_Incrementally(): G_size(%d) < 0 or G is NULL\n", G_size);
+	  exit(1);
+	}
+
+	/** check whether G_size is greater than matrix_size. If so, expand the size of the matrices D, M and S */
+	if(G_size > *matrix_size)
+	{
+          Floyd_Warshall_Reallocate_Matrices_For_EDD(G_size, D, M, S, matrix_size);
+          rebuild_flag = TRUE; //the previous shortest paths are lost
+	}
+
+	Floyd_Warshall_Prepare_Scratch_Matrices_For_Incremental_Update(G_size);
+
+	Floyd_Warshall_Make_Weight_Matrix_For_EDD(apsp_incremental_W, apsp_incremental_V, apsp_incremental_scratch_size, G, G_size, param);
+	//construct the new weight matrices from the adjacent list G representing the graph
+
+	Floyd_Warshall_Update_Shortest_PathInfo_Incrementally(apsp_incremental_W, apsp_incremental_V, G_size, *D, *M, *S, W_prev, V_prev, n_prev, rebuild_flag, Floyd_Warshall_Construct_Shortest_PathInfo_For_EDD);
+
+	return 0;
+}
+
+int Floyd_Warshall_Construct_Matrices_For_EDC_Incrementally(struct_graph_node *G, int G_size, double ***W, double ***D, int ***M, double ***S, int *matrix_size, double ***W_prev, double ***V_prev, int *n_prev, parameter_t *param)
+{ //construct the matrices W, D, M and S for EDC by repairing the ones of the previous update with the changed edge weights
+	boolean rebuild_flag = FALSE; //flag to rebuild the matrices with the Floyd-Warshall algorithm
+
+	/** check whether graph information is valid or not */
+	if(G_size < 0 || G == NULL)
+	{
+	  printf("Floyd_Warshall_Construct_Matrices_For_EDC_Incrementally(): G_size(%d) < 0 or G is NULL\n", G_size);
+	  exit(1);
+	}
+
+	/** check whether G_size is greater than matrix_size. If so, expand the size of the matrices W, D, M and S */
+	if(G_size > *matrix_size)
+	{
+	  Floyd_Warshall_Reallocate_Matrices_For_EDC(G_size, W, D, M, S, matrix_size);
+          rebuild_flag = TRUE; //the previous shortest paths are lost
+	}
+
+	Floyd_Warshall_Prepare_Scratch_Matrices_For_Incremental_Update(G_size);
+
+	Floyd_Warshall_Make_Weight_Matrix_For_EDC(*W, apsp_incremental_W, apsp_incremental_V, *matrix_size, G, G_size, param);
+	//construct the adjacency matrix W and the new weight matrices from the adjacent list G representing the graph
+
+	Floyd_Warshall_Update_Shortest_PathInfo_Incrementally(apsp_incremental_W, apsp_incremental_V, G_size, *D, *M, *S, W_prev, V_prev, n_prev, rebuild_flag, Floyd_Warshall_Construct_Shortest_PathInfo_For_EDC);
+
+	return 0;
+}
+
+int Floyd_Warshall_Free_Weight_Matrices_For_Incremental_Update(double ***W_prev, double ***V_prev, int *n_prev)
+{ //free the edge weight matrices remembered for the incremental update
+  if(*W_prev != NULL)
+    Floyd_Warshall_Free_Matrix_Of_Type_Double(*W_prev, *n_prev);
+
+  if(*V_prev != NULL)
+    Floyd_Warshall_Free_Matrix_Of_Type_Double(*V_prev, *n_prev);
+
+  *W_prev = NULL;
+  *V_prev = NULL;
+  *n_prev = 0;
+
+  return 0;
+}
+
+void Floyd_Warshall_Free_Scratch_Matrices_For_Incremental_Update()
+{ //free the calling thread's scratch matrices for the new edge weights
+  if(apsp_incremental_W != NULL)
+  {
+    Floyd_Warshall_Free_Matrix_Of_Type_Double(apsp_incremental_W, apsp_incremental_scratch_size);
+    Floyd_Warshall_Free_Matrix_Of_Type_Double(apsp_incremental_V, apsp_incremental_scratch_size);
+  }
+
+  apsp_incremental_W = NULL;
+  apsp_incremental_V = NULL;
+  apsp_incremental_scratch_size = 0;
+}
+
+void Floyd_Warshall_Report_Incremental_Update_Statistics(FILE *fp)
+{ //report the counters of the incremental update of the all-pairs shortest path matrices
+  fprintf(fp, "apsp_incremental_update: unchanged=%lu, repaired=%lu, rebuilt=%lu, repaired_changed_edges=%lu\n", apsp_incremental_unchanged_count, apsp_incremental_repair_count, apsp_incremental_rebuild_count, apsp_incremental_changed_edge_count);
+}
+
+/** single-target shortest path vectors towards a target point for the forwarding table */
+/* edge weights taken by Reverse_Dijkstra_Construct_Vectors() */
+#define REVERSE_DIJKSTRA_WEIGHT_EDD 0 //edge delay as weight and edge delay variance as supplementary weight
+#define REVERSE_DIJKSTRA_WEIGHT_EDD_VAR 1 //edge delay variance as weight and edge delay as supplementary weight
+#define REVERSE_DIJKSTRA_WEIGHT_EDC 2 //edge cost as weight and edge cost variance as supplementary weight
+
+static void Reverse_Dijkstra_Construct_Vectors(struct_graph_node *G, int G_size, int target, double *D, int *N, double *S, int weight_type, parameter_t *param)
+{ //compute the shortest path weight D[i], the next node N[i] and the supplementary metric S[i] from each node i to node target with Dijkstra's algorithm over the reversed edges of G, using the same edge weights as the Floyd-Warshall weight matrices
+	int *in_start = NULL; //in_start[v] is the index of the first incoming edge of node v in in_tail, in_W and in_V
+	int *in_tail = NULL; //tail nodes of the incoming edges
+	double *in_W = NULL; //weights of the incoming edges
+	double *in_V = NULL; //supplementary weights of the incoming edges
+	indexed_heap_t H; //minimum priority queue of the node ids (i.e., node index + 1) not yet in the shortest path tree
+	struct_graph_node *ptr = NULL; //pointer to graph node
+	int edge_number = 0; //number of the directed edges in G
+	int i, j, e, u;
+	double w;
+
+	/** update the link delay or link cost of each edge in G with the traffic statistics of vehicular traffic density and vehicle speed */
+	if(weight_type == REVERSE_DIJKSTRA_WEIGHT_EDC)
+		Update_LinkCost_Information(param, G, G_size);
+	else
+		Update_LinkDelay_Information(param, G, G_size);
+
+	/** group the edges of G by their head nodes */
+	in_start = (int*)calloc(G_size+1, sizeof(int));
+	assert_memory(in_start);
+
+	for(i = 0; i < G_size; i++)
+	{
+		for(ptr = G[i].next; ptr != NULL; ptr = ptr->next)
+		{
+			in_start[ptr->vertex_id]++;
+			edge_number++;
+		}
+	}
+
+	for(j = 0; j < G_size; j++)
+		in_start[j+1] += in_start[j];
+
+	in_tail = (int*)calloc(MAX(edge_number, 1), sizeof(int));
+	assert_memory(in_tail);
+	in_W = (double*)calloc(MAX(edge_number, 1), sizeof(double));
+	assert_memory(in_W);
+	in_V = (double*)calloc(MAX(edge_number, 1), sizeof(double));
+	assert_memory(in_V);
+
+	for(i = 0; i < G_size; i++)
+	{
+		for(ptr = G[i].next; ptr != NULL; ptr = ptr->next)
+		{
+			j = ptr->vertex_id - 1;
+			e = in_start[j]++; //in_start[j] is restored to the first edge of node j below
+
+			in_tail[e] = i;
+
+			/* the link (i,j) without any stationary node on it is not valid for EDD */
+			if(param->vanet_table.Ar_edd[i][j] != 1)
+			{
+				in_W[e] = INF;
+				in_V[e] = INF;
+			}
+			else if(weight_type == REVERSE_DIJKSTRA_WEIGHT_EDD)
+			{
+				in_W[e] = ptr->edge_delay;
+				in_V[e] = ptr->edge_delay_variance;
+			}
+			else if(weight_type == REVERSE_DIJKSTRA_WEIGHT_EDD_VAR)
+			{
+				in_W[e] = ptr->edge_delay_variance;
+				in_V[e] = ptr->edge_delay;
+			}
+			else
+			{
+				in_W[e] = ptr->edge_cost;
+				in_V[e] = ptr->edge_cost_variance;
+			}
+		}
+	}
+
+	for(j = G_size; j > 0; j--)
+		in_start[j] = in_start[j-1];
+	in_start[0] = 0;
+
+	/** grow the shortest path tree towards target from the nodes closest to target */
+	Indexed_Heap_Init(&H, G_size);
+	for(i = 0; i < G_size; i++)
+	{
+		D[i] = INF;
+		S[i] = INF;
+		N[i] = NIL;
+	}
+	D[target] = 0;
+	S[target] = 0;
+
+	for(i = 0; i < G_size; i++)
+		Indexed_Heap_Append(&H, i+1, D[i]);
+	Indexed_Heap_Build(&H);
+
+	while(H.size > 0)
+	{
+		/* take the node with the minimum distance to target */
+		u = Indexed_Heap_Extract_Min(&H) - 1;
+		if(D[u] >= INF)
+			break; //the remaining nodes cannot reach target
+
+		/* relax the edges coming into u */
+		for(e = in_start[u]; e < in_start[u+1]; e++)
+		{
+			j = in_tail[e];
+			w = in_W[e];
+
+			if(Indexed_Heap_Contains(&H, j+1) == FALSE || w >= INF)
+				continue;
+
+			if(D[j] > w + D[u])
+			{
+				D[j] = w + D[u];
+				S[j] = in_V[e] + S[u];
+				N[j] = u;
+				Indexed_Heap_Decrease_Key(&H, j+1, D[j]);
+			}
+		}
+	}
+
+	Indexed_Heap_Free(&H);
+	free(in_start);
+	free(in_tail);
+	free(in_W);
+	free(in_V);
+}
+
+void Reverse_Dijkstra_Construct_Vectors_For_EDD(struct_graph_node *G, int G_size, int target, double *D, int *N, double *S, parameter_t *param)
+{ //construct the shortest path weight vector D, the next node vector N, and the supplementary metric vector S towards node target for EDD
+	Reverse_Dijkstra_Construct_Vectors(G, G_size, target, D, N, S, REVERSE_DIJKSTRA_WEIGHT_EDD, param);
+}
+
+void Reverse_Dijkstra_Construct_Vectors_For_EDD_VAR(struct_graph_node *G, int G_size, int target, double *D, int *N, double *S, parameter_t *param)
+{ //construct the shortest path weight vector D, the next node vector N, and the supplementary metric vector S towards node target for EDD_VAR
+	Reverse_Dijkstra_Construct_Vectors(G, G_size, target, D, N, S, REVERSE_DIJKSTRA_WEIGHT_EDD_VAR, param);
+}
+
+void Reverse_Dijkstra_Construct_Vectors_For_EDC(struct_graph_node *G, int G_size, int target, double *D, int *N, double *S, parameter_t *param)
+{ //construct the shortest path weight vector D, the next node vector N, and the supplementary metric vector S towards node target for EDC
+	Reverse_Dijkstra_Construct_Vectors(G, G_size, target, D, N, S, REVERSE_DIJKSTRA_WEIGHT_EDC, param);
+}
+
 int Floyd_Warshall_Construct_Matrices_For_Hop(struct_graph_node *G, int G_size, int ***D, int ***M, int *matrix_size)
 { //construct the hop shortest path weight matrix D and predecessor matrix M
 
@@ -1413,12 +1932,251 @@ int Floyd_Warshall_Construct_Matrices_For_Hop(struct_graph_node *G, int G_size,
 
 ///////////////////////////////////////////////////////////////////
 
+/** Floyd-Warshall kernels shared by the shortest path computations for movement, EDD, EDD_VAR, EDC and hop */
+#if defined(__GNUC__)
+#define FW_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define FW_RESTRICT __restrict
+#else
+#define FW_RESTRICT
+#endif
+
+typedef struct floyd_warshall_kernel_matrices
+{
+	double **D; //shortest path matrix of type double
+	int **H; //shortest path matrix of type int, such as hop number
+	int **M; //predecessor matrix
+	double **S; //supplementary metric matrix; NULL if there is no supplementary metric
+} floyd_warshall_kernel_matrices_t;
+
+typedef void (*floyd_warshall_tile_function_t)(floyd_warshall_kernel_matrices_t *A, int i_begin, int i_end, int j_begin, int j_end, int k_begin, int k_end);
+
+static void Floyd_Warshall_Relax_Row_Of_Type_Double(double *FW_RESTRICT Di, int *FW_RESTRICT Mi, const double *FW_RESTRICT Dk, const int *FW_RESTRICT Mk, double dik, int j_begin, int j_end)
+{ //relax D[i][j] with D[i][k] + D[k][j] for j in [j_begin, j_end); the SSE2 loop handles two columns at a time with compare-and-select instead of branches
+	int j = j_begin;
+	double d;
+#ifdef FLOYD_WARSHALL_SSE2_KERNEL
+	__m128d vdik = _mm_set1_pd(dik), vd, vo, vc;
+	__m128i vcm, vmk, vmi;
+
+	for(; j + 2 <= j_end; j += 2)
+	{
+		vd = _mm_add_pd(vdik, _mm_loadu_pd(Dk + j));
+		vo = _mm_loadu_pd(Di + j);
+		vc = _mm_cmpgt_pd(vo, vd);
+		if(_mm_movemask_pd(vc) == 0)
+			continue; //most of the pairs are not shortened, so skip the stores
+
+		_mm_storeu_pd(Di + j, _mm_or_pd(_mm_and_pd(vc, vd), _mm_andnot_pd(vc, vo)));
+
+		/* narrow the two 64-bit masks to 32-bit masks for the predecessors */
+		vcm = _mm_shuffle_epi32(_mm_castpd_si128(vc), _MM_SHUFFLE(2, 0, 2, 0));
+		vmk = _mm_loadl_epi64((const __m128i*)(Mk + j));
+		vmi = _mm_loadl_epi64((const __m128i*)(Mi + j));
+		_mm_storel_epi64((__m128i*)(Mi + j), _mm_or_si128(_mm_and_si128(vcm, vmk), _mm_andnot_si128(vcm, vmi)));
+	}
+#endif
+
+	for(; j < j_end; j++)
+	{
+		d = dik + Dk[j];
+		if(Di[j] > d)
+		{
+			Di[j] = d; //update the length of path(i,j)
+			Mi[j] = Mk[j]; //update the predecessor of node j
+		}
+	}
+}
+
+static void Floyd_Warshall_Relax_Row_Of_Type_Double_With_Supplementary_Metric(double *FW_RESTRICT Di, int *FW_RESTRICT Mi, double *FW_RESTRICT Si, const double *FW_RESTRICT Dk, const int *FW_RESTRICT Mk, const double *FW_RESTRICT Sk, double dik, double sik, int j_begin, int j_end)
+{ //relax D[i][j] with D[i][k] + D[k][j] for j in [j_begin, j_end) along with the supplementary metric S
+	int j = j_begin;
+	double d;
+#ifdef FLOYD_WARSHALL_SSE2_KERNEL
+	__m128d vdik = _mm_set1_pd(dik), vsik = _mm_set1_pd(sik), vd, vo, vc, vs;
+	__m128i vcm, vmk, vmi;
+
+	for(; j + 2 <= j_end; j += 2)
+	{
+		vd = _mm_add_pd(vdik, _mm_loadu_pd(Dk + j));
+		vo = _mm_loadu_pd(Di + j);
+		vc = _mm_cmpgt_pd(vo, vd);
+		if(_mm_movemask_pd(vc) == 0)
+			continue; //most of the pairs are not shortened, so skip the stores
+
+		_mm_storeu_pd(Di + j, _mm_or_pd(_mm_and_pd(vc, vd), _mm_andnot_pd(vc, vo)));
+
+		vs = _mm_add_pd(vsik, _mm_loadu_pd(Sk + j));
+		_mm_storeu_pd(Si + j, _mm_or_pd(_mm_and_pd(vc, vs), _mm_andnot_pd(vc, _mm_loadu_pd(Si + j))));
+
+		/* narrow the two 64-bit masks to 32-bit masks for the predecessors */
+		vcm = _mm_shuffle_epi32(_mm_castpd_si128(vc), _MM_SHUFFLE(2, 0, 2, 0));
+		vmk = _mm_loadl_epi64((const __m128i*)(Mk + j));
+		vmi = _mm_loadl_epi64((const __m128i*)(Mi + j));
+		_mm_storel_epi64((__m128i*)(Mi + j), _mm_or_si128(_mm_and_si128(vcm, vmk), _mm_andnot_si128(vcm, vmi)));
+	}
+#endif
+
+	for(; j < j_end; j++)
+	{
+		d = dik + Dk[j];
+		if(Di[j] > d)
+		{
+			Di[j] = d; //update the length of path(i,j)
+			Si[j] = sik + Sk[j]; //update the supplementary metric for path(i,j)
+			Mi[j] = Mk[j]; //update the predecessor of node j
+		}
+	}
+}
+
+static void Floyd_Warshall_Relax_Row_Of_Type_Int(int *FW_RESTRICT Hi, int *FW_RESTRICT Mi, const int *FW_RESTRICT Hk, const int *FW_RESTRICT Mk, int hik, int j_begin, int j_end)
+{ //relax H[i][j] with H[i][k] + H[k][j] for j in [j_begin, j_end); the SSE2 loop handles four columns at a time
+	int j = j_begin;
+	int h;
+#ifdef FLOYD_WARSHALL_SSE2_KERNEL
+	__m128i vhik = _mm_set1_epi32(hik), vh, vo, vc, vmi;
+
+	for(; j + 4 <= j_end; j += 4)
+	{
+		vh = _mm_add_epi32(vhik, _mm_loadu_si128((const __m128i*)(Hk + j)));
+		vo = _mm_loadu_si128((const __m128i*)(Hi + j));
+		vc = _mm_cmpgt_epi32(vo, vh);
+		if(_mm_movemask_epi8(vc) == 0)
+			continue; //most of the pairs are not shortened, so skip the stores
+
+		_mm_storeu_si128((__m128i*)(Hi + j), _mm_or_si128(_mm_and_si128(vc, vh), _mm_andnot_si128(vc, vo)));
+
+		vmi = _mm_loadu_si128((const __m128i*)(Mi + j));
+		_mm_storeu_si128((__m128i*)(Mi + j), _mm_or_si128(_mm_and_si128(vc, _mm_loadu_si128((const __m128i*)(Mk + j))), _mm_andnot_si128(vc, vmi)));
+	}
+#endif
+
+	for(; j < j_end; j++)
+	{
+		h = hik + Hk[j];
+		if(Hi[j] > h)
+		{
+			Hi[j] = h; //update the length of path(i,j)
+			Mi[j] = Mk[j]; //update the predecessor of node j
+		}
+	}
+}
+
+static void Floyd_Warshall_Relax_Tile_Of_Type_Double(floyd_warshall_kernel_matrices_t *A, int i_begin, int i_end, int j_begin, int j_end, int k_begin, int k_end)
+{ //relax the tile [i_begin, i_end) x [j_begin, j_end) of D through the intermediate nodes in [k_begin, k_end)
+	int i, k;
+	double dik;
+
+	for(k = k_begin; k < k_end; k++)
+	{
+		for(i = i_begin; i < i_end; i++)
+		{
+			dik = A->D[i][k];
+
+			/* row k cannot be shortened through node k itself, and node k unreachable from node i cannot shorten row i */
+			if(i == k || dik >= INF)
+				continue;
+
+			if(A->S == NULL)
+				Floyd_Warshall_Relax_Row_Of_Type_Double(A->D[i], A->M[i], A->D[k], A->M[k], dik, j_begin, j_end);
+			else
+				Floyd_Warshall_Relax_Row_Of_Type_Double_With_Supplementary_Metric(A->D[i], A->M[i], A->S[i], A->D[k], A->M[k], A->S[k], dik, A->S[i][k], j_begin, j_end);
+		}
+	}
+}
+
+static void Floyd_Warshall_Relax_Tile_Of_Type_Int(floyd_warshall_kernel_matrices_t *A, int i_begin, int i_end, int j_begin, int j_end, int k_begin, int k_end)
+{ //relax the tile [i_begin, i_end) x [j_begin, j_end) of H through the intermediate nodes in [k_begin, k_end)
+	int i, k;
+	int hik;
+
+	for(k = k_begin; k < k_end; k++)
+	{
+		for(i = i_begin; i < i_end; i++)
+		{
+			hik = A->H[i][k];
+
+			/* row k cannot be shortened through node k itself, and node k unreachable from node i cannot shorten row i */
+			if(i == k || hik >= INF)
+				continue;
+
+			Floyd_Warshall_Relax_Row_Of_Type_Int(A->H[i], A->M[i], A->H[k], A->M[k], hik, j_begin, j_end);
+		}
+	}
+}
+
+static void Floyd_Warshall_Run_Kernel(floyd_warshall_kernel_matrices_t *A, int n, floyd_warshall_tile_function_t relax_tile)
+{ //compute all-pairs shortest paths over the weight matrix in A with relax_tile;
+  //up to FLOYD_WARSHALL_BLOCKED_KERNEL_NODE_NUMBER_THRESHOLD nodes, the textbook k-i-j order is kept as it is;
+  //beyond it, the blocked Floyd-Warshall algorithm processes each block of intermediate nodes in three phases:
+  //(1) the diagonal tile, (2) the tiles in the same block row and block column, and (3) the remaining tiles
+	int B = FLOYD_WARSHALL_BLOCK_SIZE; //tile size
+	int kb, ke; //range of the intermediate nodes
+	int ib, ie, jb, je; //ranges of the rows and columns of a tile
+
+	if(n <= FLOYD_WARSHALL_BLOCKED_KERNEL_NODE_NUMBER_THRESHOLD)
+	{
+		relax_tile(A, 0, n, 0, n, 0, n);
+		return;
+	}
+
+	for(kb = 0; kb < n; kb += B)
+	{
+		ke = MIN(kb + B, n);
+
+		/* phase 1: the diagonal tile */
+		relax_tile(A, kb, ke, kb, ke, kb, ke);
+
+		/* phase 2: the tiles in the block row kb and the block column kb */
+		for(jb = 0; jb < n; jb += B)
+		{
+			if(jb == kb)
+				continue;
+
+			je = MIN(jb + B, n);
+			relax_tile(A, kb, ke, jb, je, kb, ke);
+			relax_tile(A, jb, je, kb, ke, kb, ke);
+		}
+
+		/* phase 3: the remaining tiles */
+		for(ib = 0; ib < n; ib += B)
+		{
+			if(ib == kb)
+				continue;
+
+			ie = MIN(ib + B, n);
+			for(jb = 0; jb < n; jb += B)
+			{
+				if(jb == kb)
+					continue;
+
+				je = MIN(jb + B, n);
+				relax_tile(A, ib, ie, jb, je, kb, ke);
+			}
+		}
+	}
+}
+
+static void Floyd_Warshall_Compute_Shortest_Paths_Of_Type_Double(double **D, int **M, double **S, int n)
+{ //compute the distance matrix D, the predecessor matrix M, and the supplementary metric matrix S (if S is not NULL) from the edge weight matrix D
+	floyd_warshall_kernel_matrices_t A = {D, NULL, M, S};
+
+	Floyd_Warshall_Run_Kernel(&A, n, Floyd_Warshall_Relax_Tile_Of_Type_Double);
+}
+
+static void Floyd_Warshall_Compute_Shortest_Paths_Of_Type_Int(int **H, int **M, int n)
+{ //compute the distance matrix H and the predecessor matrix M from the edge weight matrix H
+	floyd_warshall_kernel_matrices_t A = {NULL, H, M, NULL};
+
+	Floyd_Warshall_Run_Kernel(&A, n, Floyd_Warshall_Relax_Tile_Of_Type_Int);
+}
+
 int Floyd_Warshall_Construct_Shortest_PathInfo_For_Movement(double** D, int** M, int n)
 { //compute the matrix for all-pairs shortest-paths using the Floyd-Warshall algorithm for vehicle's movement
   //where D is regarded as a dynamically allocated 2-dimensional array
   //input:= D: edge weight matrix, n: number of nodes 
   //output:= D: distance matrix, M: predecessor matrix
-	int i, j, k;
+	int i, j;
 
 	/* initialize the precessor matrix M */
 	for(i = 0; i < n; i++) //for-1
@@ -1459,20 +2217,7 @@ int Floyd_Warshall_Construct_Shortest_PathInfo_For_Movement(double** D, int** M,
 	} //end of for-1
 
 	/** compute all-pairs shortest paths */
-	for(k = 0; k < n; k++) //for-1
-	{
-		for(i = 0; i < n; i++) //for-2
-		{
-			for(j = 0; j < n; j++) //for-3
-			{
-				if(D[i][j] > D[i][k] + D[k][j])
-				{
-					D[i][j] = D[i][k] + D[k][j]; //update the length of path(i,j)
-					M[i][j] = M[k][j]; //update the predecessor of node j
-				}
-			} //end of for-3
-  		} //end of for-2
-    } //end of for-1
+	Floyd_Warshall_Compute_Shortest_Paths_Of_Type_Double(D, M, NULL, n);
 
     return 0;
 }
@@ -1610,7 +2355,7 @@ int Floyd_Warshall_Construct_Shortest_PathInfo_For_EDD(double** D, int** M, doub
   //where D is regarded as a dynamically allocated 2-dimensional array
   //input:= D: edge weight matrix, n: number of nodes 
   //output:= D: distance matrix, M: predecessor matrix, S: supplementary metric matrix
-	int i, j, k;
+	int i, j;
 
 	/* initialize the precessor matrix M */
 	for(i = 0; i < n; i++) //for-1
@@ -1651,21 +2396,7 @@ int Floyd_Warshall_Construct_Shortest_PathInfo_For_EDD(double** D, int** M, doub
 	} //end of for-1
 
 	/** compute all-pairs shortest paths */
-	for(k = 0; k < n; k++) //for-1
-	{
-		for(i = 0; i < n; i++) //for-2
-		{
-			for(j = 0; j < n; j++) //for-3
-			{
-				if(D[i][j] > D[i][k] + D[k][j])
-				{
-					D[i][j] = D[i][k] + D[k][j]; //update the delay of path(i,j)
-					S[i][j] = S[i][k] + S[k][j]; //update the supplementary metric for path(i,j), such as E2E delay variance  
-					M[i][j] = M[k][j]; //update the predecessor of node j
-				}
-			} //end of for-3
-  		} //end of for-2
-    } //end of for-1
+	Floyd_Warshall_Compute_Shortest_Paths_Of_Type_Double(D, M, S, n);
 
     return 0;
 }
@@ -1675,7 +2406,7 @@ int Floyd_Warshall_Construct_Shortest_PathInfo_For_EDD_VAR(double** D, int** M,
   //where D is regarded as a dynamically allocated 2-dimensional array
   //input:= D: edge weight matrix, n: number of nodes 
   //output:= D: distance matrix, M: predecessor matrix, S: supplementary metric matrix
-	int i, j, k;
+	int i, j;
 
 	/* initialize the precessor matrix M */
 	for(i = 0; i < n; i++) //for-1
@@ -1716,21 +2447,7 @@ int Floyd_Warshall_Construct_Shortest_PathInfo_For_EDD_VAR(double** D, int** M,
 	} //end of for-1
 
 	/** compute all-pairs shortest paths */
-	for(k = 0; k < n; k++) //for-1
-	{
-		for(i = 0; i < n; i++) //for-2
-		{
-			for(j = 0; j < n; j++) //for-3
-			{
-				if(D[i][j] > D[i][k] + D[k][j])
-				{
-					D[i][j] = D[i][k] + D[k][j]; //update the length of path(i,j)
-                                        S[i][j] = S[i][k] + S[k][j]; //update the supplementary metric for path(i,j), such as E2E delay
-					M[i][j] = M[k][j]; //update the predecessor of node j
-				}
-			} //end of for-3
-  		} //end of for-2
-    } //end of for-1
+	Floyd_Warshall_Compute_Shortest_Paths_Of_Type_Double(D, M, S, n);
 
     return 0;
 }
@@ -1740,7 +2457,7 @@ int Floyd_Warshall_Construct_Shortest_PathInfo_For_EDC(double** D, int** M, doub
   //where D is regarded as a dynamically allocated 2-dimensional array
   //input:= D: edge weight matrix, n: number of nodes 
   //output:= D: distance matrix, M: predecessor matrix, S: supplementary metric matrix
-	int i, j, k;
+	int i, j;
 
 	/* initialize the precessor matrix M */
 	for(i = 0; i < n; i++) //for-1
@@ -1781,21 +2498,7 @@ int Floyd_Warshall_Construct_Shortest_PathInfo_For_EDC(double** D, int** M, doub
 	} //end of for-1
 
 	/** compute all-pairs shortest paths */
-	for(k = 0; k < n; k++) //for-1
-	{
-		for(i = 0; i < n; i++) //for-2
-		{
-			for(j = 0; j < n; j++) //for-3
-			{
-				if(D[i][j] > D[i][k] + D[k][j])
-				{
-					D[i][j] = D[i][k] + D[k][j]; //update the cost of path(i,j)
-					S[i][j] = S[i][k] + S[k][j]; //update the supplementary metric for path(i,j), such as E2E cost variance  
-					M[i][j] = M[k][j]; //update the predecessor of node j
-				}
-			} //end of for-3
-  		} //end of for-2
-    } //end of for-1
+	Floyd_Warshall_Compute_Shortest_Paths_Of_Type_Double(D, M, S, n);
 
     return 0;
 }
@@ -1805,7 +2508,7 @@ int Floyd_Warshall_Construct_Shortest_PathInfo_For_Hop(int** D, int** M, int n)
   //where D is regarded as a dynamically allocated 2-dimensional array
   //input:= D: edge weight matrix, n: number of nodes 
   //output:= D: distance matrix, M: predecessor matrix
-	int i, j, k;
+	int i, j;
 
 	/* initialize the precessor matrix M */
 	for(i = 0; i < n; i++) //for-1
@@ -1846,20 +2549,7 @@ int Floyd_Warshall_Construct_Shortest_PathInfo_For_Hop(int** D, int** M, int n)
 	} //end of for-1
 
 	/** compute all-pairs shortest paths */
-	for(k = 0; k < n; k++) //for-1
-	{
-		for(i = 0; i < n; i++) //for-2
-		{
-			for(j = 0; j < n; j++) //for-3
-			{
-				if(D[i][j] > D[i][k] + D[k][j])
-				{
-					D[i][j] = D[i][k] + D[k][j]; //update the length of path(i,j)
-					M[i][j] = M[k][j]; //update the predecessor of node j
-				}
-			} //end of for-3
-  		} //end of for-2
-    } //end of for-1
+	Floyd_Warshall_Compute_Shortest_Paths_Of_Type_Int(D, M, n);
 
     return 0;
 }
@@ -2032,6 +2722,7 @@ void Floyd_Warshall_Set_Shortest_Path(int** M, int n, int src, int dst, struct_p
 		tmp_path_node = (struct_path_node*) calloc(1, sizeof(struct_path_node));
 		assert_memory(tmp_path_node);	
 		itoa(tmp_path[i],tmp_path_node->vertex);
+		tmp_path_node->vertex_id = tmp_path[i];
 		tmp_path_node->next = path_list->next;
 		path_list->next->prev = tmp_path_node;
 		path_list->next = tmp_path_node;
@@ -2562,7 +3253,7 @@ void Floyd_Warshall_Make_VirtualGraph_With_Graph_And_ComponentVertexQueues(struc
 
 		while(ptr != NULL)
 		{
-			j = atoi(ptr->vertex) - 1; 
+			j = ptr->vertex_id - 1; 
 			//node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 			
 			/* set the head_node's edge_cost to (*A)[i][j] */
@@ -2623,7 +3314,7 @@ int** Floyd_Warshall_Make_Connectivity_Adjacency_Matrix_For_Movement(int **W, in
 
 		while(ptr != NULL)
 		{
-			j = atoi(ptr->vertex) - 1; 
+			j = ptr->vertex_id - 1; 
 			//node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 			W[i][j] = 1;
 			ptr = ptr->next;
@@ -2665,7 +3356,7 @@ int** Floyd_Warshall_Make_Connectivity_Adjacency_Matrix_For_EDD(int **W, int W_s
 
 		while(ptr != NULL)
 		{
-			j = atoi(ptr->vertex) - 1; 
+			j = ptr->vertex_id - 1; 
 			//node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 
 			/* check whether both intersection i and intersection j have stationary nodes or not */
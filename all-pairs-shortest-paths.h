@@ -160,6 +160,30 @@ int Floyd_Warshall_Construct_Matrices_For_EDD_VAR(struct_graph_node *G, int G_si
 int Floyd_Warshall_Construct_Matrices_For_EDC(struct_graph_node *G, int G_size, double ***W, double ***D, int ***M, double ***S, int *matrix_size, parameter_t *param);
 //construct the adjacency matrix W, the shortest path weight matrix D and predecessor matrix M for EDC
 
+int Floyd_Warshall_Construct_Matrices_For_EDD_Incrementally(struct_graph_node *G, int G_size, double ***D, int ***M, double ***S, int *matrix_size, double ***W_prev, double ***V_prev, int *n_prev, parameter_t *param);
+//construct the matrices D, M and S for EDD by repairing the ones of the previous update with the edges whose weights changed since W_prev and V_prev
+
+int Floyd_Warshall_Construct_Matrices_For_EDC_Incrementally(struct_graph_node *G, int G_size, double ***W, double ***D, int ***M, double ***S, int *matrix_size, double ***W_prev, double ***V_prev, int *n_prev, parameter_t *param);
+//construct the matrices W, D, M and S for EDC by repairing the ones of the previous update with the edges whose weights changed since W_prev and V_prev
+
+int Floyd_Warshall_Free_Weight_Matrices_For_Incremental_Update(double ***W_prev, double ***V_prev, int *n_prev);
+//free the edge weight matrices remembered for the incremental update
+
+void Floyd_Warshall_Free_Scratch_Matrices_For_Incremental_Update();
+//free the calling thread's scratch matrices for the new edge weights
+
+void Floyd_Warshall_Report_Incremental_Update_Statistics(FILE *fp);
+//report the counters of the incremental update of the all-pairs shortest path matrices
+
+void Reverse_Dijkstra_Construct_Vectors_For_EDD(struct_graph_node *G, int G_size, int target, double *D, int *N, double *S, parameter_t *param);
+//construct the shortest path weight vector D, the next node vector N, and the supplementary metric vector S towards node target for EDD
+
+void Reverse_Dijkstra_Construct_Vectors_For_EDD_VAR(struct_graph_node *G, int G_size, int target, double *D, int *N, double *S, parameter_t *param);
+//construct the shortest path weight vector D, the next node vector N, and the supplementary metric vector S towards node target for EDD_VAR
+
+void Reverse_Dijkstra_Construct_Vectors_For_EDC(struct_graph_node *G, int G_size, int target, double *D, int *N, double *S, parameter_t *param);
+//construct the shortest path weight vector D, the next node vector N, and the supplementary metric vector S towards node target for EDC
+
 int Floyd_Warshall_Construct_Matrices_For_Hop(struct_graph_node *G, int G_size, int ***D, int ***M, int *matrix_size);
 //construct the hop shortest path weight matrix D and predecessor matrix M in physical road network
 
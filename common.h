@@ -78,9 +78,170 @@
 /* File name for vehicle trajectory information */
 #define TPD_TRAJECTORY_FILE_NAME "vehicle-trajectory.txt"
 
+/* Flag to determine whether to find the encounter candidates of a vehicle through the trajectory edge index instead of computing the encounter probability against every vehicle in the construction of a predicted encounter graph */
+#define TPD_TRAJECTORY_EDGE_INDEX_FLAG 1
+
 /* Flag to determine whether to print the error messages related to GSL functions */
 #define GSL_ERROR_DISPLAY_FLAG 0
 
+/* Flag to determine whether to run the benchmark of vehicle_search() for 1k, 10k and 100k vehicles instead of the simulation */
+#define VEHICLE_SEARCH_BENCHMARK_FLAG 0
+
+/* Number of synthetic events dispatched per vehicle population in the benchmark of vehicle_search() */
+#define VEHICLE_SEARCH_BENCHMARK_EVENT_NUMBER 10000000
+
+/* Maximum number of vehicle nodes visited by the linear walk of vehicle_list in the benchmark of vehicle_search() */
+#define VEHICLE_SEARCH_BENCHMARK_LINEAR_WALK_BUDGET 1e9
+
+/* Initial number of slots in the vehicle registry indexed by vehicle id */
+#define VEHICLE_REGISTRY_INITIAL_SIZE 1024
+
+/* Flag to determine whether to repair the EDD/EDC all-pairs shortest path matrices incrementally with the changed edge weights at each EDD update instead of rebuilding them with the Floyd-Warshall algorithm */
+#ifndef APSP_INCREMENTAL_UPDATE_FLAG
+#define APSP_INCREMENTAL_UPDATE_FLAG 1
+#endif
+
+/* Ratio of changed edges to all the edges beyond which the all-pairs shortest path matrices are rebuilt with the Floyd-Warshall algorithm */
+#ifndef APSP_INCREMENTAL_UPDATE_CHANGE_RATIO_THRESHOLD
+#define APSP_INCREMENTAL_UPDATE_CHANGE_RATIO_THRESHOLD 0.1
+#endif
+
+/* Flag to determine whether to compare each incremental repair of the all-pairs shortest path matrices with the Floyd-Warshall rebuild */
+#ifndef APSP_INCREMENTAL_UPDATE_SELF_CHECK_FLAG
+#define APSP_INCREMENTAL_UPDATE_SELF_CHECK_FLAG 0
+#endif
+
+/* Node number beyond which the Floyd-Warshall algorithm runs over square tiles of the matrices so that the tiles stay in cache */
+#define FLOYD_WARSHALL_BLOCKED_KERNEL_NODE_NUMBER_THRESHOLD 256
+
+/* Tile size (i.e., number of nodes per tile side) for the blocked Floyd-Warshall algorithm */
+#define FLOYD_WARSHALL_BLOCK_SIZE 64
+
+/* Number of directional edges beyond which the linear systems of the VADD stochastic model are solved with the sparse SOR solver instead of the dense Gaussian elimination */
+#define VADD_SPARSE_SOLVER_EDGE_NUMBER_THRESHOLD 1000
+
+/* Relative tolerance of the maximum change of the solution in an SOR iteration for the VADD stochastic model */
+#define VADD_SPARSE_SOLVER_TOLERANCE 0.000000001
+
+/* Relaxation factor of the SOR solver for the VADD stochastic model, where 1 is Gauss-Seidel */
+#define VADD_SPARSE_SOLVER_RELAXATION_FACTOR 1.0
+
+/* Maximum number of SOR iterations before falling back to the dense Gaussian elimination for the VADD stochastic model */
+#define VADD_SPARSE_SOLVER_MAXIMUM_ITERATION_NUMBER 10000
+
+/* Number of GSL integration workspaces kept for reuse instead of being allocated and freed per integral */
+#define GSL_INTEGRATION_WORKSPACE_POOL_SIZE 4
+
+/* Flag to determine whether to memoize the delivery and encounter probabilities computed with the GSL numerical integration */
+#define GSL_PROBABILITY_MEMO_FLAG 1
+
+/* Number of entries in the memo table of the delivery and encounter probabilities; this must be a power of 2 */
+#define GSL_PROBABILITY_MEMO_TABLE_SIZE 65536
+
+/* Relative quantum to which the delay parameters and integral interval of a memoized probability are rounded, where 0 keys the memo table on the exact parameters */
+#define GSL_PROBABILITY_MEMO_RELATIVE_QUANTUM 0
+
+/* Flag to determine whether to recompute each memoized probability and record the largest error of the memo table */
+#ifndef GSL_PROBABILITY_MEMO_SELF_CHECK_FLAG
+#define GSL_PROBABILITY_MEMO_SELF_CHECK_FLAG 0
+#endif
+
+/* Absolute error of a memoized probability against its recomputation beyond which the self-check stops the run; with a nonzero GSL_PROBABILITY_MEMO_RELATIVE_QUANTUM this must allow for the rounding of the memo keys */
+#define GSL_PROBABILITY_MEMO_SELF_CHECK_TOLERANCE 1e-6
+
+/* Flag to determine whether to print the counters of the GSL workspace pool and the probability memo table at the end of a run */
+#ifndef GSL_PROBABILITY_MEMO_STATISTICS_FLAG
+#define GSL_PROBABILITY_MEMO_STATISTICS_FLAG 0
+#endif
+
+/* Flag to determine whether to allocate queue nodes from per-queue-type slabs with free lists instead of calloc() and free() per queue node */
+#define QUEUE_NODE_SLAB_FLAG 1
+
+/* Number of queue nodes carved out of a chunk when a queue node slab runs out of free queue nodes */
+#define QUEUE_NODE_SLAB_CHUNK_NODE_NUMBER 64
+
+/* Flag to determine whether to print the allocation counters of the queue node slabs per queue type at the end of a run */
+#ifndef QUEUE_NODE_ALLOCATION_STATISTICS_FLAG
+#define QUEUE_NODE_ALLOCATION_STATISTICS_FLAG 1
+#endif
+
+/* Flag to determine whether to keep an offset-ordered index of the vehicles per directional edge so that the next-carrier lookup visits only the vehicles within the communication range */
+#define VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG 1
+
+/* Initial number of vehicle movement queue node pointers in the offset index of a directional edge */
+#define VEHICLE_MOVEMENT_OFFSET_INDEX_INITIAL_CAPACITY 16
+
+/* Margin by which an offset range query is widened so that the caller's own distance check decides the vehicles on the range boundary */
+#define VEHICLE_MOVEMENT_OFFSET_INDEX_RANGE_MARGIN 0.000001
+
+/* Flag to determine whether a vehicle movement queue counts its out-of-order neighbor pairs so that convoy_update() sorts the queue only after some vehicle has passed its neighbor, and whether a vehicle list already in offset order skips its sort */
+#define CONVOY_LAZY_SORT_FLAG 1
+
+/* Flag to determine whether convoy_update() recounts the out-of-order neighbor pairs of the vehicle movement queue and exits on a difference from the maintained count */
+#define CONVOY_LAZY_SORT_SELF_CHECK_FLAG 0
+
+/* Flag to determine whether UpdateForwardingTableQueue() can compute the forwarding tables of the intersections with worker threads */
+#define FORWARDING_TABLE_THREAD_POOL_FLAG 1
+
+/* Default number of worker threads for UpdateForwardingTableQueue(), where 1 keeps the serial computation; option -% overrides it */
+#define FORWARDING_TABLE_DEFAULT_THREAD_NUMBER 1
+
+/* Flag to determine whether the shortest path model keeps only the EDD/EDC vectors towards its target point in each forwarding table, computed by one reverse Dijkstra pass, instead of per-table all-pairs matrices */
+#define FORWARDING_TABLE_REVERSE_SHORTEST_PATH_FLAG 1
+
+/* Flag to determine whether the forwarding tables share one forwarding graph with its edge queues per worker thread and each table keeps only its per-target forwarding probabilities, EDDs and EDCs of the graph nodes instead of its own graph copy */
+#define FORWARDING_TABLE_SHARED_GRAPH_FLAG 1
+
+/* Flag to determine whether GetForwardingTableGraph() exits when a caller still holds the shared forwarding graph of another table, i.e., when a lookup would overwrite the values under a graph pointer in use */
+#ifndef FORWARDING_TABLE_LOOKUP_SELF_CHECK_FLAG
+#define FORWARDING_TABLE_LOOKUP_SELF_CHECK_FLAG 0
+#endif
+
+/* Flag to determine whether Dijkstra's algorithm keeps its priority queue as an indexed heap of vertex ids instead of searching the heap by vertex name */
+#define DIJKSTRA_INDEXED_HEAP_FLAG 1
+
+/* Flag to determine whether option -+ runs a seed/parameter sweep with one forked simulation process per sweep point, forked after the shared road network setup for a sweep over seeds or a packet parameter */
+#define SIMULATION_SWEEP_FLAG 1
+
+/* Default number of concurrent sweep processes, where 0 means the number of online processors; a suffix of @<number> in the sweep spec overrides it */
+#define SIMULATION_SWEEP_DEFAULT_WORKER_NUMBER 0
+
+/* Maximum number of seeds or parameter values in one axis of a sweep spec */
+#define SIMULATION_SWEEP_VALUE_MAX 256
+
+/* Flag to determine whether option -^ runs the comparison of forwarding schemes from one shared warm-up with one forked simulation process per scheme; the warm-up ends at the first EDD update and is not saved for another run */
+#define SIMULATION_CHECKPOINT_FLAG 1
+
+/* Flag to determine whether the copies of a packet in Epidemic routing and multi-target-point forwarding share the predicted encounter graph of their source packet until one of them rebuilds it (copy-on-write) */
+#define PACKET_COPY_ON_WRITE_FLAG 1
+
+/* Flag to determine whether the multi-target-point selection prunes the combinations of target points that cannot beat the best set found so far instead of evaluating every combination */
+#define TARGET_POINT_BRANCH_AND_BOUND_FLAG 1
+
+/* Flag to determine whether to compare every branch-and-bound target point selection with the exhaustive one and exit on a difference */
+#ifndef TARGET_POINT_BRANCH_AND_BOUND_SELF_CHECK_FLAG
+#define TARGET_POINT_BRANCH_AND_BOUND_SELF_CHECK_FLAG 0
+#endif
+
+/* Flag to determine whether the target point selection collects the candidates on the destination vehicle's trajectory into arrays and scores them in one sweep, computing the delivery probabilities in the ascending order of EAD only until a candidate satisfies the threshold */
+#define TARGET_POINT_BATCH_EVALUATION_FLAG 1
+
+/* Flag to determine whether to compare every batched target point selection with the per-candidate one and exit on a difference */
+#ifndef TARGET_POINT_BATCH_EVALUATION_SELF_CHECK_FLAG
+#define TARGET_POINT_BATCH_EVALUATION_SELF_CHECK_FLAG 0
+#endif
+
+/* Flag to determine whether a packet's vehicle trajectory and a vehicle's path list keep the prefix sums of the edge lengths and a vertex-to-hop hash table so that the distance, travel time and hop queries along the trajectory do not walk its linked list */
+#define TRAJECTORY_PREFIX_SUM_FLAG 1
+
+/* Flag to determine whether to compare every prefix-sum trajectory query with the linked-list walk and exit on a difference */
+#ifndef TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG
+#define TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG 0
+#endif
+
+/* Relative tolerance for TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG, since the prefix sums add the edge lengths in another order than the walk */
+#define TRAJECTORY_PREFIX_SUM_SELF_CHECK_TOLERANCE 0.000001
+
 //@Library support
 #define __GSL_LIBRARY_SUPPORT__
 //@GSL library support for GNU scientific library
@@ -879,6 +879,7 @@ boolean EPIDEMIC_Is_There_Next_Carrier_On_One_Way_Road_Segment(parameter_t *para
 		exit(1);
 	}
   
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
@@ -1129,6 +1130,7 @@ boolean EPIDEMIC_Is_There_Next_Carrier_On_Two_Way_Road_Segment(parameter_t *para
 		exit(1);
 	}
   
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
@@ -1327,6 +1329,7 @@ boolean EPIDEMIC_Is_There_Next_Carrier_On_Two_Way_Road_Segment(parameter_t *para
 		exit(1);
 	}
   
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
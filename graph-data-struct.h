@@ -107,6 +107,7 @@ typedef enum _boolean{
 typedef struct _struct_graph_node
 {
         char vertex[NAME_SIZE]; //vertex name
+        int vertex_id; //vertex id that is the integer value of vertex, which is used instead of parsing vertex with atoi()
         USAGE_STATUS status; //status to indicate that this graph node is not used any more, so it can be used for another graph node
         double weight; //the number of edges in the node array or the edge length in the neighbor list
 	GRAPH_NODE_TYPE type; //graph node type = {INTERSECTION_GRAPH_NODE, NONINTERSECTION_GRAPH_NODE, ENTRANCE_GRAPH_NODE, PROTECTION_GRAPH_NODE, HOLE_GRAPH_NODE, ACCESS_POINT_GRAPH_NODE};
@@ -229,6 +230,7 @@ typedef struct _struct_sensor_table
 typedef struct _struct_path_node
 {
 	char vertex[NAME_SIZE];
+	int vertex_id; //vertex id that is the integer value of vertex, which is used instead of parsing vertex with atoi()
 	double weight;
 	double edge_travel_delay; //the mean travel delay for the edge
 	double edge_travel_delay_standard_deviation; //the travel delay standard deviation for the edge
@@ -239,6 +241,25 @@ typedef struct _struct_path_node
 	struct _struct_path_node *next; //next node on the path towards the destination
 } struct_path_node;
 
+/* Prefix sums along a vehicle trajectory that is either a vehicle's path list or a packet's vehicle trajectory queue */
+typedef struct _trajectory_prefix_sum_t
+{
+        boolean valid_flag; //flag to indicate whether the arrays reflect the current trajectory
+        void *trajectory; //pointer to the path list or the trajectory queue for which the arrays were built
+        int version; //vehicle's trajectory version for which the arrays of a path list were built
+        int size; //number of hops
+        int capacity; //number of hops that the arrays can hold
+        double *distance; //distance[k] is the sum of the edge lengths of the first k hops
+        double *distance_square; //distance_square[k] is the sum of the squared edge lengths of the first k hops, which is the travel time variance divided by the unit-length variance
+        void **node; //node[k] is the path node or the trajectory queue node of hop k
+        char **vertex; //vertex[k] is the vertex reached by hop k
+        char **tail_vertex; //tail_vertex[k] is the vertex that hop k starts from
+        int *vertex_next_hop; //the next hop reaching the same vertex as hop k, or -1
+        int *vertex_table; //hash table from a vertex to the first hop reaching it, where -1 is an empty slot
+        int *tail_vertex_table; //hash table from a vertex to the first hop starting from it, where -1 is an empty slot
+        int table_size; //number of slots in each hash table that is a power of two
+} trajectory_prefix_sum_t;
+
 /* Schedule Table for Traffic Sources */
 typedef struct _struct_schedule_entry
 {
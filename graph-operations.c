@@ -1169,7 +1169,7 @@ int GO_Find_RedundantTargetPoint_From_EdgeSetQueue_AlongWith_Queue_Adjustment(in
 			//Adjust_NodeDegreeInformation_In_EdgeSetQueue(ESQ, T, T_size);
 
 			/* free the memory of edge set queue node */
-			free(pQueueNode);
+			FreeQueueNode(ESQ->type, (queue_node_t*)pQueueNode);
 
 			/* set pQueueNode to pParentQueueNode */
 			if(flag_for_parent_edge)
@@ -7,12 +7,173 @@
 #include "common.h"
 
 #include "gsl-util.h"
+#include "util.h" //assert_memory()
 
 //#include <math.h> //for tgamma()
 #include <gsl/gsl_sf_gamma.h> //gsl_sf_gamma()
 #include <gsl/gsl_randist.h> //the functions for random variates and probability density functions 
 
 #include <stdlib.h> //strtoll() - convert a string to a long integer
+#include <string.h> //memcmp(), memcpy()
+
+/** Integration Workspace Pool */
+static gsl_integration_workspace *gsl_workspace_pool[GSL_INTEGRATION_WORKSPACE_POOL_SIZE]; //idle workspaces
+static int gsl_workspace_pool_count = 0; //number of idle workspaces in the pool
+static unsigned long gsl_workspace_allocation_count = 0; //number of workspaces allocated by gsl_integration_workspace_alloc()
+static unsigned long gsl_workspace_reuse_count = 0; //number of workspaces taken from the pool
+
+/** Probability Memo Table */
+static gsl_probability_memo_entry_t *gsl_probability_memo_table = NULL; //open-addressing hash table of probabilities
+#define GSL_PROBABILITY_MEMO_PROBE_NUMBER 4 //number of slots probed for a key before evicting its home slot
+static unsigned long gsl_probability_memo_lookup_count = 0; //number of lookups
+static unsigned long gsl_probability_memo_hit_count = 0; //number of hits
+static unsigned long gsl_probability_memo_eviction_count = 0; //number of entries overwritten by other keys
+static double gsl_probability_memo_maximum_error = 0; //largest error of a memoized probability found by the self-check
+
+gsl_integration_workspace* GSL_Acquire_Integration_Workspace()
+{ //take an integration workspace of MAXIMUM_SUBINTERVAL_NUNBER subintervals from the workspace pool, allocating one if the pool is empty
+	/* note that gsl_integration_qags() reinitializes the workspace, so a reused workspace gives the same result as a new one */
+	if(gsl_workspace_pool_count > 0)
+	{
+		gsl_workspace_reuse_count++;
+		return gsl_workspace_pool[--gsl_workspace_pool_count];
+	}
+
+	gsl_workspace_allocation_count++;
+	return gsl_integration_workspace_alloc(MAXIMUM_SUBINTERVAL_NUNBER);
+}
+
+void GSL_Release_Integration_Workspace(gsl_integration_workspace *w)
+{ //return the integration workspace w to the workspace pool, freeing it if the pool is full
+	if(gsl_workspace_pool_count < GSL_INTEGRATION_WORKSPACE_POOL_SIZE)
+		gsl_workspace_pool[gsl_workspace_pool_count++] = w;
+	else
+		gsl_integration_workspace_free(w);
+}
+
+void GSL_Free_Integration_Workspace_Pool()
+{ //free the integration workspaces kept in the workspace pool
+	while(gsl_workspace_pool_count > 0)
+		gsl_integration_workspace_free(gsl_workspace_pool[--gsl_workspace_pool_count]);
+}
+
+static unsigned int GSL_Hash_Probability_Memo_Key(gsl_probability_memo_type_t type, double *key)
+{ //compute the hash value of type and key with FNV-1a over the bytes of the keys
+	unsigned char *byte = (unsigned char*)key;
+	unsigned int h = 2166136261u ^ (unsigned int)type;
+	size_t i;
+
+	for(i = 0; i < sizeof(double)*GSL_PROBABILITY_MEMO_KEY_NUMBER; i++)
+	{
+		h ^= byte[i];
+		h *= 16777619u;
+	}
+
+	return h;
+}
+
+int GSL_Lookup_Probability_Memo(gsl_probability_memo_type_t type, double *key, double *value)
+{ //look up the probability for type and key in the memo table; return 1 with *value on a hit, and 0 otherwise
+	unsigned int h = 0; //home slot
+	int i;
+	gsl_probability_memo_entry_t *e = NULL;
+
+	gsl_probability_memo_lookup_count++;
+
+	if(gsl_probability_memo_table == NULL)
+		return 0;
+
+	h = GSL_Hash_Probability_Memo_Key(type, key);
+	for(i = 0; i < GSL_PROBABILITY_MEMO_PROBE_NUMBER; i++)
+	{
+		e = &(gsl_probability_memo_table[(h + i) & (GSL_PROBABILITY_MEMO_TABLE_SIZE - 1)]);
+		if(e->type == GSL_PROBABILITY_MEMO_TYPE_EMPTY)
+			break;
+		else if(e->type == type && memcmp(e->key, key, sizeof(e->key)) == 0)
+		{
+			gsl_probability_memo_hit_count++;
+			*value = e->value;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+void GSL_Store_Probability_Memo(gsl_probability_memo_type_t type, double *key, double value)
+{ //store the probability value for type and key into the memo table
+	unsigned int h = 0; //home slot
+	int i;
+	gsl_probability_memo_entry_t *e = NULL;
+
+	if(gsl_probability_memo_table == NULL)
+	{
+		gsl_probability_memo_table = (gsl_probability_memo_entry_t*) calloc(GSL_PROBABILITY_MEMO_TABLE_SIZE, sizeof(gsl_probability_memo_entry_t));
+		assert_memory(gsl_probability_memo_table);
+	}
+
+	h = GSL_Hash_Probability_Memo_Key(type, key);
+	for(i = 0; i < GSL_PROBABILITY_MEMO_PROBE_NUMBER; i++)
+	{
+		e = &(gsl_probability_memo_table[(h + i) & (GSL_PROBABILITY_MEMO_TABLE_SIZE - 1)]);
+		if(e->type == GSL_PROBABILITY_MEMO_TYPE_EMPTY)
+			break;
+	}
+
+	/* when all the probed slots are occupied, the home slot is overwritten */
+	if(i == GSL_PROBABILITY_MEMO_PROBE_NUMBER)
+	{
+		e = &(gsl_probability_memo_table[h & (GSL_PROBABILITY_MEMO_TABLE_SIZE - 1)]);
+		gsl_probability_memo_eviction_count++;
+	}
+
+	e->type = type;
+	memcpy(e->key, key, sizeof(e->key));
+	e->value = value;
+}
+
+double GSL_Quantize_Probability_Memo_Key(double x)
+{ //round the mantissa of x to a multiple of GSL_PROBABILITY_MEMO_RELATIVE_QUANTUM
+	/* the probability is computed at the rounded parameters, so each memoized value is the exact probability for parameters within the relative error GSL_PROBABILITY_MEMO_RELATIVE_QUANTUM of the requested ones; a relative quantum keeps a small standard deviation from being rounded to zero */
+	double quantum = GSL_PROBABILITY_MEMO_RELATIVE_QUANTUM; //relative quantum of the memo keys
+	double mantissa = 0; //mantissa of x in [0.5, 1)
+	int exponent = 0; //exponent of x
+
+	if(quantum <= 0 || x == 0 || !isfinite(x))
+		return x;
+
+	mantissa = frexp(x, &exponent);
+	mantissa = floor(mantissa/quantum + 0.5)*quantum;
+	return ldexp(mantissa, exponent);
+}
+
+void GSL_Record_Probability_Memo_Error(double error)
+{ //record the error of a memoized probability against its recomputation for the self-check
+	if(fabs(error) > gsl_probability_memo_maximum_error)
+		gsl_probability_memo_maximum_error = fabs(error);
+
+	if(fabs(error) > GSL_PROBABILITY_MEMO_SELF_CHECK_TOLERANCE)
+	{
+		printf("GSL_Record_Probability_Memo_Error(): the memoized probability differs from its recomputation by %g\n", error);
+		exit(1);
+	}
+}
+
+void GSL_Free_Probability_Memo_Table()
+{ //free the probability memo table
+	if(gsl_probability_memo_table != NULL)
+	{
+		free(gsl_probability_memo_table);
+		gsl_probability_memo_table = NULL;
+	}
+}
+
+void GSL_Report_Probability_Memo_Statistics(FILE *fp)
+{ //report the counters of the workspace pool and the probability memo table
+	fprintf(fp, "gsl_workspace_pool: allocated=%lu, reused=%lu\n", gsl_workspace_allocation_count, gsl_workspace_reuse_count);
+	fprintf(fp, "gsl_probability_memo: lookups=%lu, hits=%lu, evictions=%lu, maximum_error=%g\n", gsl_probability_memo_lookup_count, gsl_probability_memo_hit_count, gsl_probability_memo_eviction_count, gsl_probability_memo_maximum_error);
+}
+
 
 void GSL_test()
 { //test function for gsl library
@@ -232,8 +393,8 @@ double GSL_function_integral(struct H_params *params, double interval_start, dou
     F.function = &H; //probability function to calculate the probability for argument y
     F.params = params; //parameters
 
-    /* allocate a workspace sufficient to hold n double precision intervals, their integration results and error estimates. */
-    w = gsl_integration_workspace_alloc(limit);
+    /* take a workspace sufficient to hold n double precision intervals, their integration results and error estimates from the workspace pool */
+    w = GSL_Acquire_Integration_Workspace();
 
     /* perform the integration for the function F for the interval (interval_start, interval_end) */
     gsl_integration_qags(&F, interval_start, interval_end, 0, 1e-7, limit, w, &result, &error);
@@ -241,8 +402,8 @@ double GSL_function_integral(struct H_params *params, double interval_start, dou
     //integral = gsl_cdf_gaussian_P((y-mu)/sigma, sigma) - gsl_cdf_gaussian_P(-mu/sigma, sigma);
     integral = gsl_cdf_gaussian_P((y-mu)/sigma, 1) - gsl_cdf_gaussian_P(-mu/sigma, 1);
 
-    /* free the memory for the workspace */
-    gsl_integration_workspace_free(w);
+    /* return the workspace to the workspace pool */
+    GSL_Release_Integration_Workspace(w);
 
     return result;
 }
@@ -269,8 +430,8 @@ double GSL_function_integral_for_gamma(struct H_params *params, double interval_
     F.function = &H_for_gamma; //probability function to calculate the probability for argument y
     F.params = params; //parameters
 
-    /* allocate a workspace sufficient to hold n double precision intervals, their integration results and error estimates. */
-    w = gsl_integration_workspace_alloc(limit);
+    /* take a workspace sufficient to hold n double precision intervals, their integration results and error estimates from the workspace pool */
+    w = GSL_Acquire_Integration_Workspace();
 
     /** perform the integration for the function F for the interval (interval_start, interval_end) */
     gsl_integration_qags(&F, interval_start, interval_end, 0, 1e-7, limit, w, &result, &error);
@@ -307,8 +468,8 @@ double GSL_function_integral_for_gamma(struct H_params *params, double interval_
     printf("gsl_integration_qags()'s result=%.3f\n", (float)result);
     printf("cdf difference =%.3f\n", (float)integral);
 
-    /* free the memory for the workspace */
-    gsl_integration_workspace_free(w);
+    /* return the workspace to the workspace pool */
+    GSL_Release_Integration_Workspace(w);
 
     return result;
 }
@@ -324,14 +485,14 @@ double GSL_function_integral_for_mean(struct H_params *params, double interval_s
     F.function = &H_for_mean; //probability function to calculate the mean for argument y
     F.params = params; //parameters
 
-    /* allocate a workspace sufficient to hold n double precision intervals, their integration results and error estimates. */
-    w = gsl_integration_workspace_alloc(limit);
+    /* take a workspace sufficient to hold n double precision intervals, their integration results and error estimates from the workspace pool */
+    w = GSL_Acquire_Integration_Workspace();
 
     /* perform the integration for the function F for the interval (interval_start, interval_end) */
     gsl_integration_qags(&F, interval_start, interval_end, 0, 1e-7, limit, w, &result, &error);
 
-    /* free the memory for the workspace */
-    gsl_integration_workspace_free(w);
+    /* return the workspace to the workspace pool */
+    GSL_Release_Integration_Workspace(w);
 
     return result;
 }
@@ -347,14 +508,14 @@ double GSL_function_integral_for_second_moment(struct H_params *params, double i
     F.function = &H_for_second_moment; //probability function to calculate the second moment for argument y
     F.params = params; //parameters
 
-    /* allocate a workspace sufficient to hold n double precision intervals, their integration results and error estimates. */
-    w = gsl_integration_workspace_alloc(limit);
+    /* take a workspace sufficient to hold n double precision intervals, their integration results and error estimates from the workspace pool */
+    w = GSL_Acquire_Integration_Workspace();
 
     /* perform the integration for the function F for the interval (interval_start, interval_end) */
     gsl_integration_qags(&F, interval_start, interval_end, 0, 1e-7, limit, w, &result, &error);
 
-    /* free the memory for the workspace */
-    gsl_integration_workspace_free(w);
+    /* return the workspace to the workspace pool */
+    GSL_Release_Integration_Workspace(w);
 
     return result;
 }
@@ -387,14 +548,14 @@ double  GSL_Vanet_Function_Integral_For_Gaussian_Distribution(vanet_opt_params_t
     F.function = &GSL_Vanet_Probability_Function_For_Gaussian_Distribution; //Vanet probability function to calculate the delivery probability for argument y using the Gaussian Distribution
     F.params = params; //parameters
 
-    /* allocate a workspace sufficient to hold n double precision intervals, their integration results and error estimates. */
-    w = gsl_integration_workspace_alloc(limit);
+    /* take a workspace sufficient to hold n double precision intervals, their integration results and error estimates from the workspace pool */
+    w = GSL_Acquire_Integration_Workspace();
 
     /* perform the integration for the function F for the interval (interval_start, interval_end) */
     gsl_integration_qags(&F, interval_start, interval_end, 0, 1e-7, limit, w, &result, &error);
 
-    /* free the memory for the workspace */
-    gsl_integration_workspace_free(w);
+    /* return the workspace to the workspace pool */
+    GSL_Release_Integration_Workspace(w);
 
     return result;
 }
@@ -444,7 +605,34 @@ double GSL_Vanet_Delivery_Probability_For_Gamma_Distribution(double mu_p, double
     vanet_opt_params_t params = {mu_p, sigma_p, mu_v, sigma_v};
     double result = 0;
 
-#if 1 /* [ */
+#if GSL_PROBABILITY_MEMO_FLAG /* [ */
+	double key[GSL_PROBABILITY_MEMO_KEY_NUMBER] = {0}; //memo key
+	double P_memo = 0; //memoized delivery probability
+
+	key[0] = GSL_Quantize_Probability_Memo_Key(mu_p);
+	key[1] = GSL_Quantize_Probability_Memo_Key(sigma_p);
+	key[2] = GSL_Quantize_Probability_Memo_Key(mu_v);
+	key[3] = GSL_Quantize_Probability_Memo_Key(sigma_v);
+	key[4] = GSL_Quantize_Probability_Memo_Key(interval_start);
+	key[5] = GSL_Quantize_Probability_Memo_Key(interval_end);
+
+	if(GSL_Lookup_Probability_Memo(GSL_PROBABILITY_MEMO_TYPE_VANET_DELIVERY, key, &P_memo))
+	{
+#if GSL_PROBABILITY_MEMO_SELF_CHECK_FLAG /* [[ */
+		P = GSL_Vanet_Function_Integral_For_Gamma_Distribution_v2(&params, interval_start, interval_end);
+		GSL_Record_Probability_Memo_Error(P_memo - P);
+#endif /* ]] */
+		return P_memo;
+	}
+
+	/* compute the probability at the quantized parameters so that the memoized value does not depend on which caller stored it */
+	params.mu_p = key[0];
+	params.sigma_p = key[1];
+	params.mu_v = key[2];
+	params.sigma_v = key[3];
+	P = GSL_Vanet_Function_Integral_For_Gamma_Distribution_v2(&params, key[4], key[5]);
+	GSL_Store_Probability_Memo(GSL_PROBABILITY_MEMO_TYPE_VANET_DELIVERY, key, P);
+#elif 1
 	P = GSL_Vanet_Function_Integral_For_Gamma_Distribution_v2(&params, interval_start, interval_end);
 #else
     P = GSL_Vanet_Function_Integral_For_Gamma_Distribution(&params, interval_start, interval_end);
@@ -469,8 +657,8 @@ double  GSL_Vanet_Function_Integral_For_Gamma_Distribution(vanet_opt_params_t *p
     F.function = &GSL_Vanet_Probability_Function_For_Gamma_Distribution; //Vanet probability function to calculate the delivery probability for argument y using the Gamma Distribution
     F.params = params; //parameters
 
-    /* allocate a workspace sufficient to hold n double precision intervals, their integration results and error estimates. */
-    w = gsl_integration_workspace_alloc(limit);
+    /* take a workspace sufficient to hold n double precision intervals, their integration results and error estimates from the workspace pool */
+    w = GSL_Acquire_Integration_Workspace();
 
     /* perform the integration for the function F for the interval (interval_start, interval_end) */
 #ifdef __DEBUG_LEVEL_GSL_FUNCTION__
@@ -478,8 +666,8 @@ double  GSL_Vanet_Function_Integral_For_Gamma_Distribution(vanet_opt_params_t *p
 #endif
     status = gsl_integration_qags(&F, interval_start, interval_end, 0, 1e-7, limit, w, &result, &error);
 
-    /* free the memory for the workspace */
-    gsl_integration_workspace_free(w);
+    /* return the workspace to the workspace pool */
+    GSL_Release_Integration_Workspace(w);
 
     return result;
 }
@@ -501,8 +689,8 @@ double  GSL_Vanet_Function_Integral_For_Gamma_Distribution_v2(vanet_opt_params_t
     F.function = &GSL_Vanet_Probability_Function_For_Gamma_Distribution; //Vanet probability function to calculate the delivery probability for argument y using the Gamma Distribution
     F.params = params; //parameters
 
-    /* allocate a workspace sufficient to hold n double precision intervals, their integration results and error estimates. */
-    w = gsl_integration_workspace_alloc(limit);
+    /* take a workspace sufficient to hold n double precision intervals, their integration results and error estimates from the workspace pool */
+    w = GSL_Acquire_Integration_Workspace();
 
     /* perform the integration for the function F for the interval (interval_start, interval_end) */
 #ifdef __DEBUG_LEVEL_GSL_FUNCTION__
@@ -521,8 +709,8 @@ double  GSL_Vanet_Function_Integral_For_Gamma_Distribution_v2(vanet_opt_params_t
 	gsl_set_error_handler(old_handler); //restore the old error handler
 #endif /* ] */
 
-    /* free the memory for the workspace */
-    gsl_integration_workspace_free(w);
+    /* return the workspace to the workspace pool */
+    GSL_Release_Integration_Workspace(w);
 
     return result;
 }
@@ -766,7 +954,40 @@ double GSL_TPD_Encounter_Probability_For_Gamma_Distribution(double mu_y,
     tpd_opt_params_t params = {mu_y, sigma_y, mu_x, sigma_x, link_delay_a, link_delay_b};
     double result = 0;
 
+#if GSL_PROBABILITY_MEMO_FLAG /* [ */
+	double key[GSL_PROBABILITY_MEMO_KEY_NUMBER] = {0}; //memo key
+	double P_memo = 0; //memoized encounter probability
+
+	key[0] = GSL_Quantize_Probability_Memo_Key(mu_y);
+	key[1] = GSL_Quantize_Probability_Memo_Key(sigma_y);
+	key[2] = GSL_Quantize_Probability_Memo_Key(mu_x);
+	key[3] = GSL_Quantize_Probability_Memo_Key(sigma_x);
+	key[4] = GSL_Quantize_Probability_Memo_Key(interval_start);
+	key[5] = GSL_Quantize_Probability_Memo_Key(interval_end);
+	key[6] = GSL_Quantize_Probability_Memo_Key(link_delay_a);
+	key[7] = GSL_Quantize_Probability_Memo_Key(link_delay_b);
+
+	if(GSL_Lookup_Probability_Memo(GSL_PROBABILITY_MEMO_TYPE_TPD_ENCOUNTER, key, &P_memo))
+	{
+#if GSL_PROBABILITY_MEMO_SELF_CHECK_FLAG /* [[ */
+		P = GSL_TPD_Function_Integral_For_Gamma_Distribution(&params, interval_start, interval_end, link_delay_a, link_delay_b);
+		GSL_Record_Probability_Memo_Error(P_memo - P);
+#endif /* ]] */
+		return P_memo;
+	}
+
+	/* compute the probability at the quantized parameters so that the memoized value does not depend on which caller stored it */
+	params.mu_y = key[0];
+	params.sigma_y = key[1];
+	params.mu_x = key[2];
+	params.sigma_x = key[3];
+	params.link_delay_a = key[6];
+	params.link_delay_b = key[7];
+	P = GSL_TPD_Function_Integral_For_Gamma_Distribution(&params, key[4], key[5], key[6], key[7]);
+	GSL_Store_Probability_Memo(GSL_PROBABILITY_MEMO_TYPE_TPD_ENCOUNTER, key, P);
+#else
     P = GSL_TPD_Function_Integral_For_Gamma_Distribution(&params, interval_start, interval_end, link_delay_a, link_delay_b);
+#endif /* ] */
 
 #ifdef __DEBUG_LEVEL_GSL_FUNCTION_PROBABILITY__
     printf("encounter probability P=%.4f\n", (float)P);
@@ -797,8 +1018,8 @@ double  GSL_TPD_Function_Integral_For_Gamma_Distribution(tpd_opt_params_t *param
     F.function = &GSL_TPD_Probability_Function_For_Gamma_Distribution; //TPD probability function to calculate the encounter probability for argument y using the Gamma Distribution
     F.params = params; //parameters
 
-    /* allocate a workspace sufficient to hold n double precision intervals, their integration results and error estimates. */
-    w = gsl_integration_workspace_alloc(limit);
+    /* take a workspace sufficient to hold n double precision intervals, their integration results and error estimates from the workspace pool */
+    w = GSL_Acquire_Integration_Workspace();
 
     /* perform the integration for the function F for the interval (interval_start, interval_end) */
 #ifdef __DEBUG_LEVEL_GSL_FUNCTION__
@@ -839,8 +1060,8 @@ double  GSL_TPD_Function_Integral_For_Gamma_Distribution(tpd_opt_params_t *param
 #endif /* ]] */
 #endif /* ] */
 
-    /* free the memory for the workspace */
-    gsl_integration_workspace_free(w);
+    /* return the workspace to the workspace pool */
+    GSL_Release_Integration_Workspace(w);
 
     return result;
 }
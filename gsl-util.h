@@ -53,8 +53,56 @@ typedef struct _tpd_opt_params_t
 	double link_delay_b; //link delay of Vehicle_b on the edge (n_j, n_i)
 } tpd_opt_params_t;
 
+/* type of the probability stored in an entry of the probability memo table */
+typedef enum _gsl_probability_memo_type_t
+{
+	GSL_PROBABILITY_MEMO_TYPE_EMPTY = 0, //empty entry
+	GSL_PROBABILITY_MEMO_TYPE_VANET_DELIVERY = 1, //delivery probability of GSL_Vanet_Delivery_Probability_For_Gamma_Distribution()
+	GSL_PROBABILITY_MEMO_TYPE_TPD_ENCOUNTER = 2 //encounter probability of GSL_TPD_Encounter_Probability_For_Gamma_Distribution()
+} gsl_probability_memo_type_t;
+
+/* number of keys in an entry of the probability memo table */
+#define GSL_PROBABILITY_MEMO_KEY_NUMBER 8
+
+/* entry of the probability memo table */
+typedef struct _gsl_probability_memo_entry_t
+{
+	gsl_probability_memo_type_t type; //probability type
+	double key[GSL_PROBABILITY_MEMO_KEY_NUMBER]; //(quantized) distribution parameters, integral interval and link delays
+	double value; //probability for the keys
+} gsl_probability_memo_entry_t;
+
 /** function predeclarations */
 
+/** Integration Workspace Pool */
+gsl_integration_workspace* GSL_Acquire_Integration_Workspace();
+//take an integration workspace of MAXIMUM_SUBINTERVAL_NUNBER subintervals from the workspace pool, allocating one if the pool is empty
+
+void GSL_Release_Integration_Workspace(gsl_integration_workspace *w);
+//return the integration workspace w to the workspace pool, freeing it if the pool is full
+
+void GSL_Free_Integration_Workspace_Pool();
+//free the integration workspaces kept in the workspace pool
+
+/** Probability Memo Table */
+int GSL_Lookup_Probability_Memo(gsl_probability_memo_type_t type, double *key, double *value);
+//look up the probability for type and key in the memo table; return 1 with *value on a hit, and 0 otherwise
+
+void GSL_Store_Probability_Memo(gsl_probability_memo_type_t type, double *key, double value);
+//store the probability value for type and key into the memo table
+
+double GSL_Quantize_Probability_Memo_Key(double x);
+//round the mantissa of x to a multiple of GSL_PROBABILITY_MEMO_RELATIVE_QUANTUM
+
+void GSL_Record_Probability_Memo_Error(double error);
+//record the error of a memoized probability against its recomputation for the self-check
+
+void GSL_Free_Probability_Memo_Table();
+//free the probability memo table
+
+void GSL_Report_Probability_Memo_Statistics(FILE *fp);
+//report the counters of the workspace pool and the probability memo table
+
 void GSL_test();
 //test function for gsl library
 
@@ -7,6 +7,7 @@
 
 #include "stdafx.h"
 #include "heap.h"
+#include "util.h" //assert_memory()
 //#include "stdio.h"
 
 int Parent(int i)
@@ -116,3 +117,137 @@ void Min_Heap_Insert(struct_shortest_path_node *Q, int Q_size, struct_shortest_p
 	Q[Q_size].dist = INF;
 	Heap_Decrease_Key(Q, Q_size, Q_size, new_node->dist);
 }
+
+/** Indexed Heap Operations */
+static void Indexed_Heap_Exchange(indexed_heap_t *H, int i, int j)
+{ //exchange the ids at the positions i and j in H
+	int id = H->heap[i];
+
+	H->heap[i] = H->heap[j];
+	H->heap[j] = id;
+	H->position[H->heap[i]] = i;
+	H->position[H->heap[j]] = j;
+}
+
+static void Indexed_Heap_Heapify(indexed_heap_t *H, int i)
+{ //heapify H downward from position i
+	int l, r, smallest;
+
+	do
+	{
+		l = Left(i);
+		r = Right(i);
+
+		if((l <= H->size) && (H->key[H->heap[l]] < H->key[H->heap[i]]))
+			smallest = l;
+		else
+			smallest = i;
+
+		if((r <= H->size) && (H->key[H->heap[r]] < H->key[H->heap[smallest]]))
+			smallest = r;
+
+		if(smallest == i)
+			break;
+
+		Indexed_Heap_Exchange(H, i, smallest);
+		i = smallest;
+	} while(1);
+}
+
+void Indexed_Heap_Init(indexed_heap_t *H, int capacity)
+{ //initialize an empty indexed heap H for the ids from 1 to capacity
+	H->size = 0;
+	H->capacity = capacity;
+
+	H->heap = (int*) calloc(capacity+1, sizeof(int));
+	assert_memory(H->heap);
+	H->position = (int*) calloc(capacity+1, sizeof(int));
+	assert_memory(H->position);
+	H->key = (double*) calloc(capacity+1, sizeof(double));
+	assert_memory(H->key);
+}
+
+void Indexed_Heap_Free(indexed_heap_t *H)
+{ //release the memory occupied by the indexed heap H
+	free(H->heap);
+	free(H->position);
+	free(H->key);
+	memset(H, 0, sizeof(indexed_heap_t));
+}
+
+void Indexed_Heap_Append(indexed_heap_t *H, int id, double key)
+{ //append id with key to the end of H without keeping the heap property; Indexed_Heap_Build() should be called after the appends
+	if(id < 1 || id > H->capacity || H->position[id] != 0)
+	{
+		printf("Indexed_Heap_Append(): id (%d) is out of range or already in the heap\n", id);
+		exit(1);
+	}
+
+	H->size++;
+	H->heap[H->size] = id;
+	H->position[id] = H->size;
+	H->key[id] = key;
+}
+
+void Indexed_Heap_Build(indexed_heap_t *H)
+{ //build minimum priority heap with the ids appended to H
+	int i;
+
+	for(i = (int)H->size/2; i >= 1; i--)
+		Indexed_Heap_Heapify(H, i);
+}
+
+void Indexed_Heap_Insert(indexed_heap_t *H, int id, double key)
+{ //insert id with key into H
+	Indexed_Heap_Append(H, id, INF);
+	Indexed_Heap_Decrease_Key(H, id, key);
+}
+
+int Indexed_Heap_Extract_Min(indexed_heap_t *H)
+{ //extract the id with the minimum key from H; return 0 if H is empty
+	int id;
+
+	if(H->size < 1)
+		return 0;
+
+	id = H->heap[1];
+	H->heap[1] = H->heap[H->size];
+	H->position[H->heap[1]] = 1;
+	H->position[id] = 0;
+	H->size--;
+	Indexed_Heap_Heapify(H, 1);
+
+	return id;
+}
+
+void Indexed_Heap_Decrease_Key(indexed_heap_t *H, int id, double key)
+{ //decrease the key of id in H to key
+	int i = H->position[id];
+
+	if(i == 0)
+	{
+		printf("Indexed_Heap_Decrease_Key(): id (%d) is not in the heap\n", id);
+		return;
+	}
+
+	if(key > H->key[id])
+	{
+		printf("Indexed_Heap_Decrease_Key(): new key is greater than current key\n");
+		return;
+	}
+
+	H->key[id] = key;
+	while(i > 1 && H->key[H->heap[Parent(i)]] > H->key[H->heap[i]])
+	{
+		Indexed_Heap_Exchange(H, i, Parent(i));
+		i = Parent(i);
+	}
+}
+
+boolean Indexed_Heap_Contains(indexed_heap_t *H, int id)
+{ //return TRUE if id is in H
+	if(id < 1 || id > H->capacity)
+		return FALSE;
+
+	return (H->position[id] != 0) ? TRUE : FALSE;
+}
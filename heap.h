@@ -37,4 +37,38 @@ void Heap_Decrease_Key(struct_shortest_path_node *Q, int Q_size, int i, double k
 void Min_Heap_Insert(struct_shortest_path_node *Q, int Q_size, struct_shortest_path_node *new_node);
 //insert a new node into heap Q
 
+/** indexed minimum priority queue whose elements are integer ids from 1 to capacity */
+typedef struct _indexed_heap_t
+{
+	int size; //number of ids in the heap
+	int capacity; //maximum id
+	int *heap; //heap of ids where heap[1] has the minimum key
+	int *position; //position[id] is the index of id in heap; 0 means that id is not in the heap
+	double *key; //key[id] is the key of id
+} indexed_heap_t;
+
+void Indexed_Heap_Init(indexed_heap_t *H, int capacity);
+//initialize an empty indexed heap H for the ids from 1 to capacity
+
+void Indexed_Heap_Free(indexed_heap_t *H);
+//release the memory occupied by the indexed heap H
+
+void Indexed_Heap_Append(indexed_heap_t *H, int id, double key);
+//append id with key to the end of H without keeping the heap property; Indexed_Heap_Build() should be called after the appends
+
+void Indexed_Heap_Build(indexed_heap_t *H);
+//build minimum priority heap with the ids appended to H
+
+void Indexed_Heap_Insert(indexed_heap_t *H, int id, double key);
+//insert id with key into H
+
+int Indexed_Heap_Extract_Min(indexed_heap_t *H);
+//extract the id with the minimum key from H; return 0 if H is empty
+
+void Indexed_Heap_Decrease_Key(indexed_heap_t *H, int id, double key);
+//decrease the key of id in H to key
+
+boolean Indexed_Heap_Contains(indexed_heap_t *H, int id);
+//return TRUE if id is in H
+
 #endif
@@ -441,3 +441,237 @@ void LA_Log_LinearSystem_And_Solution(char *filename, double **A, int row_size,
     /* close the log file */
     fclose(fp);
 }
+
+void LA_Test_Sparse_SOR_1()
+{ //Test-1: test the sparse SOR solver against Gaussian Elimination and Backward Substitution with the system (P - E)x = -d of the stochastic model
+  double **A = NULL; //n x (n+1) augmented matrix
+  LA_sparse_matrix_t *S = NULL; //sparse matrix for P - E
+  double b[4] = {-10, -20, -30, -40}; //right-hand side -d
+  double x[4] = {0, 0, 0, 0}; //solution vector for SOR
+  double y[4] = {0, 0, 0, 0}; //solution vector for Gaussian elimination
+  int p[4]; //permutation vector
+  double P[4][4] = {{0, 0.5, 0.3, 0}, {0.2, 0, 0.4, 0.3}, {0, 0.6, 0, 0.2}, {0.1, 0, 0, 0}}; //forwarding probabilities
+  int row_size = 4, column_size = 5; //row size and column size of a matrix
+  int i = 0, j = 0; //indices of for-loops
+  int iteration_number = 0; //number of SOR iterations
+
+  A = LA_Allocate_Matrix_Of_Type_Double(row_size, column_size);
+  S = LA_Allocate_Sparse_Matrix(row_size, 0);
+
+  for(i = 0; i < row_size; i++)
+  {
+    for(j = 0; j < row_size; j++)
+    {
+      if(P[i][j] > 0)
+      {
+        A[i][j] = P[i][j];
+        LA_Set_Sparse_Matrix_Entry(S, i, j, P[i][j]);
+      }
+    }
+
+    A[i][i] = -1;
+    LA_Set_Sparse_Matrix_Entry(S, i, i, -1);
+
+    A[i][row_size] = b[i];
+  }
+  LA_Compress_Sparse_Matrix(S);
+
+  LA_Perform_Gaussian_Elimination_For_Nonsingular_Case(A, row_size, column_size, p);
+  LA_Perform_Backward_Substitution(A, row_size, p, y);
+
+  iteration_number = LA_Perform_Sparse_SOR(S, b, x, 1.0, 1e-12, 1000);
+
+  /** print the solutions */
+  printf("SOR iterations=%d\n", iteration_number);
+  for(i = 0; i < row_size; i++)
+  {
+    printf("x[%d]=%f (Gaussian elimination: %f)\n", i, (float)x[i], (float)y[i]);
+  }
+  printf("\n\n");
+
+  LA_Free_Matrix_Of_Type_Double(A, row_size);
+  LA_Free_Sparse_Matrix(S);
+}
+
+LA_sparse_matrix_t* LA_Allocate_Sparse_Matrix(int row_size, int entry_capacity)
+{ //allocate the memory of row_size x row_size sparse matrix with the room for entry_capacity entries
+  LA_sparse_matrix_t *A = NULL;
+
+  A = (LA_sparse_matrix_t*)calloc(1, sizeof(LA_sparse_matrix_t));
+  assert_memory(A);
+
+  A->row_size = row_size;
+  A->entry_capacity = MAX(entry_capacity, row_size);
+  if(A->entry_capacity == 0)
+    A->entry_capacity = 1;
+
+  A->entry_row = (int*)calloc(A->entry_capacity, sizeof(int));
+  assert_memory(A->entry_row);
+  A->entry_column = (int*)calloc(A->entry_capacity, sizeof(int));
+  assert_memory(A->entry_column);
+  A->entry_value = (double*)calloc(A->entry_capacity, sizeof(double));
+  assert_memory(A->entry_value);
+
+  return A;
+}
+
+void LA_Set_Sparse_Matrix_Entry(LA_sparse_matrix_t *A, int row, int column, double value)
+{ //set A[row][column] to value; like the dense matrix, the last value set for the same entry is kept
+  if(row < 0 || row >= A->row_size || column < 0 || column >= A->row_size)
+  {
+    printf("LA_Set_Sparse_Matrix_Entry(): (%d,%d) is out of the %d x %d matrix\n", row, column, A->row_size, A->row_size);
+    exit(1);
+  }
+
+  if(A->entry_number == A->entry_capacity)
+  {
+    A->entry_capacity *= 2;
+
+    A->entry_row = (int*)realloc(A->entry_row, A->entry_capacity*sizeof(int));
+    assert_memory(A->entry_row);
+    A->entry_column = (int*)realloc(A->entry_column, A->entry_capacity*sizeof(int));
+    assert_memory(A->entry_column);
+    A->entry_value = (double*)realloc(A->entry_value, A->entry_capacity*sizeof(double));
+    assert_memory(A->entry_value);
+  }
+
+  A->entry_row[A->entry_number] = row;
+  A->entry_column[A->entry_number] = column;
+  A->entry_value[A->entry_number] = value;
+  A->entry_number++;
+}
+
+void LA_Compress_Sparse_Matrix(LA_sparse_matrix_t *A)
+{ //convert the entries set so far into the CSR format
+  int n = A->row_size;
+  int *next = NULL; //next free index per row while distributing the entries
+  int *position = NULL; //position[j] is the index of the entry of column j already stored for the current row
+  int i = 0, k = 0, e = 0; //indices for for-loops
+  int row_begin = 0, row_end = 0; //range of the current row before merging
+  int write = 0; //index to store the next merged entry
+
+  free(A->row_start);
+  free(A->column_index);
+  free(A->value);
+
+  A->row_start = (int*)calloc(n+1, sizeof(int));
+  assert_memory(A->row_start);
+  A->column_index = (int*)calloc(MAX(A->entry_number, 1), sizeof(int));
+  assert_memory(A->column_index);
+  A->value = (double*)calloc(MAX(A->entry_number, 1), sizeof(double));
+  assert_memory(A->value);
+
+  /** distribute the entries to their rows in the order of setting */
+  for(e = 0; e < A->entry_number; e++)
+    A->row_start[A->entry_row[e]+1]++;
+
+  for(i = 0; i < n; i++)
+    A->row_start[i+1] += A->row_start[i];
+
+  next = (int*)calloc(n+1, sizeof(int));
+  assert_memory(next);
+  memcpy(next, A->row_start, n*sizeof(int));
+
+  for(e = 0; e < A->entry_number; e++)
+  {
+    k = next[A->entry_row[e]]++;
+    A->column_index[k] = A->entry_column[e];
+    A->value[k] = A->entry_value[e];
+  }
+
+  /** merge the entries of the same column in each row so that the last value set is kept */
+  position = (int*)calloc(n+1, sizeof(int));
+  assert_memory(position);
+  for(i = 0; i < n; i++)
+    position[i] = -1;
+
+  for(i = 0; i < n; i++)
+  {
+    row_end = A->row_start[i+1];
+    A->row_start[i] = write;
+
+    for(k = row_begin; k < row_end; k++)
+    {
+      if(position[A->column_index[k]] >= A->row_start[i])
+      { //the column already appeared in this row
+        A->value[position[A->column_index[k]]] = A->value[k];
+      }
+      else
+      {
+        position[A->column_index[k]] = write;
+        A->column_index[write] = A->column_index[k];
+        A->value[write] = A->value[k];
+        write++;
+      }
+    }
+
+    row_begin = row_end;
+  }
+  A->row_start[n] = write;
+  A->nonzero_number = write;
+
+  /** the entries are consumed */
+  A->entry_number = 0;
+
+  free(position);
+  free(next);
+}
+
+void LA_Free_Sparse_Matrix(LA_sparse_matrix_t *A)
+{ //free the memory for sparse matrix A
+  free(A->row_start);
+  free(A->column_index);
+  free(A->value);
+  free(A->entry_row);
+  free(A->entry_column);
+  free(A->entry_value);
+  free(A);
+}
+
+int LA_Perform_Sparse_SOR(LA_sparse_matrix_t *A, double *b, double *x, double omega, double tolerance, int maximum_iteration_number)
+{ //solve Ax = b with Successive Over-Relaxation (SOR) starting from the initial guess in x, where omega is the relaxation factor (1 for Gauss-Seidel); return the number of iterations, or -1 if the maximum change of x in an iteration does not fall to tolerance times the magnitude of x within maximum_iteration_number iterations
+  int n = A->row_size;
+  int i = 0, k = 0; //indices for for-loops
+  int iteration = 0; //iteration count
+  double diagonal = 0; //diagonal entry A[i][i]
+  double sum = 0; //sum of A[i][j]*x[j] for j != i
+  double x_new = 0; //new value of x[i]
+  double max_change = 0; //maximum change of x in an iteration
+  double max_magnitude = 0; //maximum magnitude of x in an iteration
+
+  for(iteration = 1; iteration <= maximum_iteration_number; iteration++)
+  {
+    max_change = 0;
+    max_magnitude = 0;
+
+    for(i = 0; i < n; i++)
+    {
+      diagonal = 0;
+      sum = 0;
+      for(k = A->row_start[i]; k < A->row_start[i+1]; k++)
+      {
+        if(A->column_index[k] == i)
+          diagonal = A->value[k];
+        else
+          sum += A->value[k]*x[A->column_index[k]];
+      }
+
+      if(fabs(diagonal) <= LA_ERROR_TOLERANCE_FOR_REAL_ARITHMETIC)
+        return -1; //SOR needs a nonzero diagonal
+
+      x_new = (1 - omega)*x[i] + omega*(b[i] - sum)/diagonal;
+
+      max_change = MAX(max_change, fabs(x_new - x[i]));
+      max_magnitude = MAX(max_magnitude, fabs(x_new));
+      x[i] = x_new;
+    }
+
+    if(max_change != max_change)
+      return -1; //x has diverged to infinity or NaN
+
+    if(max_change <= tolerance*MAX(1, max_magnitude))
+      return iteration;
+  }
+
+  return -1;
+}
@@ -15,6 +15,21 @@
 //error tolerance for real number arithmetic for the equality comparison of two real numbers: 10^-7
 
 /** definition of structures */
+typedef struct _LA_sparse_matrix_t
+{ //sparse matrix in the Compressed Sparse Row (CSR) format
+  int row_size; //number of rows (and columns) of the square matrix
+  int nonzero_number; //number of stored entries
+  int *row_start; //row_start[i] is the index of the first entry of row i in column_index and value, and row_start[row_size] is nonzero_number
+  int *column_index; //column index of each entry
+  double *value; //value of each entry
+
+  /* entries set before LA_Compress_Sparse_Matrix() in the coordinate (i.e., row, column, value) format */
+  int entry_number; //number of the entries set so far
+  int entry_capacity; //capacity of the arrays for the entries
+  int *entry_row; //row index of each entry
+  int *entry_column; //column index of each entry
+  double *entry_value; //value of each entry
+} LA_sparse_matrix_t;
 
 
 /** declaration of functions */
@@ -52,6 +67,24 @@ void LA_Perform_Backward_Substitution(double **A, int row_size, int *p, double *
 void LA_Log_LinearSystem_And_Solution(char *filename, double **A, int row_size,  double *x);
 //log the linear system of augmented matrix A and its solution vector x
 
+void LA_Test_Sparse_SOR_1();
+//Test-1: test the sparse SOR solver against Gaussian Elimination and Backward Substitution
+
+LA_sparse_matrix_t* LA_Allocate_Sparse_Matrix(int row_size, int entry_capacity);
+//allocate the memory of row_size x row_size sparse matrix with the room for entry_capacity entries
+
+void LA_Set_Sparse_Matrix_Entry(LA_sparse_matrix_t *A, int row, int column, double value);
+//set A[row][column] to value; like the dense matrix, the last value set for the same entry is kept
+
+void LA_Compress_Sparse_Matrix(LA_sparse_matrix_t *A);
+//convert the entries set so far into the CSR format
+
+void LA_Free_Sparse_Matrix(LA_sparse_matrix_t *A);
+//free the memory for sparse matrix A
+
+int LA_Perform_Sparse_SOR(LA_sparse_matrix_t *A, double *b, double *x, double omega, double tolerance, int maximum_iteration_number);
+//solve Ax = b with Successive Over-Relaxation (SOR) starting from the initial guess in x, where omega is the relaxation factor (1 for Gauss-Seidel); return the number of iterations, or -1 if the maximum change of x in an iteration does not fall to tolerance times the magnitude of x within maximum_iteration_number iterations
+
 #endif
 
 
@@ -36,6 +36,7 @@
 
 #ifdef _LINUX_
 #include <unistd.h> //getopt(), opterr
+#include <sys/wait.h> //waitpid()
 #endif
 
 #include <stdlib.h> //srand48()
@@ -362,21 +363,8 @@ void gnuplot_vehicle_point(double currenttime)
 }
 
 struct_vehicle* get_vehicle(int vid)
-{ //show the vehicle trajectory along with the arrival time per path node along the vehicle trajectory for all the vehicles in vehicle_list
-
-	struct struct_vehicle *local_vehicle_list = get_vehicle_list();
-	struct struct_vehicle *vehicle = NULL;
-
-	vehicle = local_vehicle_list->next;
-	while(vehicle != local_vehicle_list)
-	{
-		if (vehicle->id == 1)
-			break;
-
-		vehicle = vehicle->next;
-	}
-
-	return vehicle;
+{ //return the vehicle node corresponding to vid in vehicle_list
+	return vehicle_search(vid);
 }
 
 /** run simulation */
@@ -405,6 +393,7 @@ int main(int argc, char** argv)
 	//unsigned int seed = 2; //seed for initializing rand(): this guarantees no hole initially
 	time_t start_time, end_time, computation_time; //time variables for measuring computation time
 	int result = 0;
+	simulation_context_t *context = NULL; //simulation context owning the event list, the random number streams and the vehicle registry of the run
 	int trajectory_for_graph_with_2_nodes[] = {1, 2}; //trajectory for stationary vehicle in a graph with 2 nodes
 	int trajectory_for_graph_with_3_nodes[] = {1, 2, 3}; //trajectory for stationary vehicle in a graph with 3 nodes
 	int trajectory_for_graph_with_4_nodes[] = {1, 2, 4}; //trajectory for stationary vehicle in a graph with 4 nodes
@@ -506,6 +495,9 @@ int main(int argc, char** argv)
 	vanet_edd_computation_model_type_t edd_computation_model = VANET_EDD_COMPUTATION_BASED_ON_STOCHASTIC_MODEL; //VANET EDD computation model
 	boolean flag_edd_computation_model = FALSE;
 
+	int forwarding_table_thread_number = FORWARDING_TABLE_DEFAULT_THREAD_NUMBER; //number of worker threads for the forwarding table update
+	boolean flag_forwarding_table_thread_number = FALSE;
+
 	vanet_tbd_edd_computation_type_t tbd_edd_computation_type = VANET_EDD_BASED_ON_TBD_WITH_PARTIAL_PATH; //VANET TBD's EDD computation type
 	boolean flag_tbd_edd_computation_type = FALSE;
 
@@ -599,6 +591,9 @@ int main(int argc, char** argv)
 	vanet_forwarding_scheme_t vanet_forwarding_scheme = VANET_FORWARDING_UNKNOWN; //vanet forwarding scheme
 	boolean flag_vanet_forwarding_scheme = FALSE;
 
+	char checkpoint_scheme_list[BUF_SIZE] = ""; //comma-separated list of forwarding schemes sharing one warm-up
+	boolean flag_checkpoint_scheme_list = FALSE;
+
 	/***********************************************************************/
 
 	/**@for debugging */
@@ -606,12 +601,28 @@ int main(int argc, char** argv)
 	//test_get_position_on_linear_curve();
         //test whether get_position_on_linear_curve() works well or not
 
+#if VEHICLE_SEARCH_BENCHMARK_FLAG
+	benchmark_vehicle_search(1000, VEHICLE_SEARCH_BENCHMARK_EVENT_NUMBER);
+	benchmark_vehicle_search(10000, VEHICLE_SEARCH_BENCHMARK_EVENT_NUMBER);
+	benchmark_vehicle_search(100000, VEHICLE_SEARCH_BENCHMARK_EVENT_NUMBER);
+	//compare vehicle_search() with the linear walk of vehicle_list
+	return 0;
+#endif
+
 	/******************/
 
 #ifdef _LINUX_
+#if SIMULATION_SWEEP_FLAG /* [ */
+	/** run the seed/parameter sweep of option -+ where each sweep point parses its own argument list below */
+	if(run_sweep(&argc, &argv) == FALSE)
+	{
+		return 0;
+	}
+#endif /* ] */
+
 	opterr = 0; //we don't want getopt() to write an error message to stderr.
 
-	while((c = getopt(argc, argv, "#:@:*:a:b:c:d:e:f:g:h:i:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:A:B:C:D:E:F:G:H:I:J:K:L:M:N:O:P:Q:R:S:T:U:V:W:X:Y:Z:")) != -1) //c: means that option character c has an argument
+	while((c = getopt(argc, argv, "#:@:*:a:b:c:d:e:f:g:h:i:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:A:B:C:D:E:F:G:H:I:J:K:L:M:N:O:P:Q:R:S:T:U:V:W:X:Y:Z:%:^:")) != -1) //c: means that option character c has an argument
 	{
 	    switch(c)
 	    {
@@ -627,6 +638,14 @@ int main(int argc, char** argv)
 				// 2 - vehicle movement
 				g_gnuplot_option = atoi(optarg);
 				break;
+			case '%': //number of worker threads for the forwarding table update
+				forwarding_table_thread_number = atoi(optarg);
+				flag_forwarding_table_thread_number = TRUE;
+				break;
+			case '^': //forwarding schemes compared from one shared warm-up, e.g., -^ 3,5; the warm-up always ends at the first EDD update and is kept only in the memory of this run, so it can neither be taken at another time nor restored by another run
+				snprintf(checkpoint_scheme_list, sizeof(checkpoint_scheme_list), "%s", optarg);
+				flag_checkpoint_scheme_list = TRUE;
+				break;
 		    case 'a': //Comparison target type
                 comparison_target_type = (comparison_target_type_t)atoi(optarg);
                 flag_comparison_target_type = TRUE;
@@ -985,6 +1004,26 @@ int main(int argc, char** argv)
 	if(flag_edd_computation_model) //VANET EDD computation model
 	  param.vehicle_vanet_edd_computation_model = edd_computation_model;
 
+	if(flag_forwarding_table_thread_number) //number of worker threads for the forwarding table update
+	  param.forwarding_table_thread_number = MAX(forwarding_table_thread_number, 1);
+
+#if SIMULATION_CHECKPOINT_FLAG /* [ */
+	if(flag_checkpoint_scheme_list) //forwarding schemes compared from one shared warm-up
+	{
+		for(ptr = strtok(checkpoint_scheme_list, ","); ptr != NULL; ptr = strtok(NULL, ","))
+		{
+			if(atoi(ptr) <= VANET_FORWARDING_UNKNOWN || atoi(ptr) >= NUMBER_OF_VANET_FORWARDING_SCHEME || param.simulation_checkpoint_scheme_number == NUMBER_OF_VANET_FORWARDING_SCHEME)
+			{
+				printf("%s:%d: forwarding scheme \"%s\" of option -^ is invalid or one too many!\n",
+						__FUNCTION__, __LINE__,
+						ptr);
+				exit(1);
+			}
+			param.simulation_checkpoint_scheme[param.simulation_checkpoint_scheme_number++] = (vanet_forwarding_scheme_t)atoi(ptr);
+		}
+	}
+#endif /* ] */
+
 	if(flag_tbd_edd_computation_type) //VANET TBD's EDD computation type
 	  param.vehicle_vanet_tbd_edd_computation_type = tbd_edd_computation_type;
 
@@ -1049,21 +1088,7 @@ int main(int argc, char** argv)
 	}
 
 	/** update param.vehicle_vanet_edd_model accoring to param.vanet_forwarding_scheme */
-	switch(param.vanet_forwarding_scheme)
-	{
-		case VANET_FORWARDING_VADD:
-		case VANET_FORWARDING_EPIDEMIC:	
-		case VANET_FORWARDING_TADB:
-			param.vehicle_vanet_edd_model = VANET_EDD_PER_INTERSECTION_MODEL;
-			break;
-
-		case VANET_FORWARDING_TBD:
-			param.vehicle_vanet_edd_model = VANET_EDD_PER_VEHICLE_MODEL;
-			break;
-
-		default:
-			break;
-	}
+	update_vanet_edd_model_for_forwarding_scheme(&param);
 
 	/* select graph configuration file */
 	if(flag_graph_node_number) //graph node number
@@ -1445,8 +1470,10 @@ int main(int argc, char** argv)
 	//LA_Test_Gaussian_Elimination_2();
 	/*************/
 
-	/** run simulation according to a given scenario */
-	run(seed, &param, graph_file, schedule_file, vanet_file, pathlist_file, output_file_1, output_file_2, trace_file_of_vehicle_convoy_length, trajectory, trajectory_size, vanet_packet_carrier_trace_file);
+	/** run simulation according to a given scenario in its own simulation context */
+	context = simulation_context_create();
+	run(context, seed, &param, graph_file, schedule_file, vanet_file, pathlist_file, output_file_1, output_file_2, trace_file_of_vehicle_convoy_length, trajectory, trajectory_size, vanet_packet_carrier_trace_file);
+	simulation_context_destroy(context);
 	
 #if defined(__DEBUG_INTERACTIVE_MODE__) || defined(__DEBUG_SIMULATION_TIME__)
 	end_time = time(NULL);
@@ -1487,7 +1514,7 @@ int main(int argc, char** argv)
 }
 
 /** run simulation */
-int run(unsigned int seed, struct parameter *param, char *graph_file, char *schedule_file, char *vanet_file, char *pathlist_file, char *output_file_1, char *output_file_2, char *trace_file_of_vehicle_convoy_length, int *trajectory, int trajectory_size, char *vanet_packet_carrier_trace_file)
+int run(simulation_context_t *context, unsigned int seed, struct parameter *param, char *graph_file, char *schedule_file, char *vanet_file, char *pathlist_file, char *output_file_1, char *output_file_2, char *trace_file_of_vehicle_convoy_length, int *trajectory, int trajectory_size, char *vanet_packet_carrier_trace_file)
 { //run simulation according to a given scenario
 
 #ifdef __LOG_LEVEL_TRACE_OF_VEHICLE_CONVOY_LENGTH__
@@ -1632,6 +1659,10 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 	double vehicle_arrival_duration = 0; //duration when vehicles arrive at road network
 	double arrival_time = 0; //vehicle arrival time
 	int number_of_vehicles = 0; //number of vehicles arriving at one entrance
+#if RAND_GENERATOR_TYPE == RAND_GENERATOR_PHILOX /* [ */
+	rand_substream_t arrival_substream; //substream of an entrance for its vehicle arrival schedule
+	double *arrival_times = NULL; //vehicle arrival times at an entrance
+#endif /* ] */
 	STATE event; //event indicating state
 	STATE state; //state of sensor or vehicle
 	double delay; //delay for simulation schedule
@@ -1790,11 +1821,14 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 	//LA_Test_Gaussian_Elimination_3();
 	//Test-3: test Gaussian Elimination function and Backward Substitution function
 
-	/** set the seed for rand() */
+	/** bind the simulation context of this run to this thread so that smpl, the random number generator and the vehicle registry use it */
+	simulation_context_bind(context);
+
+	/** set the seed for the random number generator of the simulation context */
 	if(param->simulation_seed == SEED_TIME)
-	  srand48((unsigned)time(NULL));
+	  seed_random((unsigned)time(NULL));
 	else if(param->simulation_seed == SEED_DEFAULT)
-	  srand48(seed);
+	  seed_random(seed);
 	else
 	{
 		printf("run(): param->simulation_seed of type %d is not supported!\n", param->simulation_seed);
@@ -1952,6 +1986,16 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 	/** Initialize Target Point Queue TPQ */
 	InitQueue((queue_t*) &TPQ, QTYPE_TARGET_POINT);
 
+#if SIMULATION_SWEEP_FLAG /* [ */
+	/** fork the sweep points of option -+ over seeds or a packet parameter here so that they share the setup of Gr, DEr and the movement APSP above */
+	if(run_sweep_after_setup(param, &seed, &fp_1, &fp_2) == FALSE)
+	{
+		fclose(fp_1);
+		fclose(fp_2);
+		exit(0);
+	}
+#endif /* ] */
+
 	/*** Simulation Parts ***/
 
 	/** initialize the statistics */
@@ -2082,10 +2126,22 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 			//traffic_source = src_table_for_Gr.list[i];
 			traffic_source = src_table_for_Gr.list[i].vertex;
 
+#if RAND_GENERATOR_TYPE == RAND_GENERATOR_PHILOX /* [ */
+			/* draw the arrival schedule of the entrance at once from the entrance's own substream */
+			arrival_times = (double*) realloc(arrival_times, MAX(number_of_vehicles, 1)*sizeof(double));
+			assert_memory(arrival_times);
+			rand_substream_init(&arrival_substream, rand_current_seed(), RAND_ENTITY_TRAFFIC_SOURCE, atoi(traffic_source));
+			uniform_batch(arrival_times, number_of_vehicles, param->vehicle_initial_arrival_time, param->simulation_time, &arrival_substream);
+#endif /* ] */
+
 			for(j = 0; j < number_of_vehicles; j++)
 			{
 				/* determine vehicle arrival time from uniform distribution */
+#if RAND_GENERATOR_TYPE == RAND_GENERATOR_PHILOX /* [ */
+				arrival_time = arrival_times[j];
+#else
 				arrival_time = dist_func(param->vehicle_interarrival_time_distribution, param->vehicle_initial_arrival_time, param->simulation_time);
+#endif /* ] */
 
 				/* register a new vehicle to vehicle list */
 				register_vehicle(new_simulation_node_id, traffic_source, arrival_time, &dst_table_for_Gr, &ap_table_for_Gr, param, &path_table, Gr, Gr_size, &Er, Dr_move, Mr_move);
@@ -2120,6 +2176,11 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 		}
 	}
 
+#if RAND_GENERATOR_TYPE == RAND_GENERATOR_PHILOX /* [ */
+	free(arrival_times);
+	arrival_times = NULL;
+#endif /* ] */
+
 	/** initialize statistics variables */
 	
 	if(param->simulation_mode == TIME)
@@ -2194,7 +2255,7 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 			case VANET_EDD_UPDATE: 
 				/** process the vehicular traffic statistics for building both the forwarding probability and the Expected Delivery Delay (EDD) */
 				current_time = smpl_time();			
-			
+
 
 #ifdef __DEBUG_LEVEL_VANET_EDD_UPDATE__
                                 printf("[%.2f] VANET_EDD_UPDATE: EDD Table has been updated!\n", (float)current_time);
@@ -2239,7 +2300,7 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 					}
 					
 					/** compute EDD and EDD_SD for VADD, TBD, Epidemic Routing so that they can work for the V2V data delivery */
-					if((param->data_forwarding_mode == DATA_FORWARDING_MODE_V2V) && (param->vanet_forwarding_scheme == VANET_FORWARDING_VADD || param->vanet_forwarding_scheme == VANET_FORWARDING_TBD || param->vanet_forwarding_scheme == VANET_FORWARDING_EPIDEMIC || param->vanet_forwarding_scheme == VANET_FORWARDING_TADB))
+					if((param->data_forwarding_mode == DATA_FORWARDING_MODE_V2V) && is_v2v_edd_needed_for_forwarding_scheme(param))
 					{
 						VADD_Compute_EDD_And_EDD_SD_Based_On_Stochastic_Model_For_V2V_Data_Delivery(param, Gr, Gr_size, Gr_set, Gr_set_size, DEr_set);
 					}
@@ -2265,6 +2326,32 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 						}
 
 						flag_packet_log = TRUE; //set flag_packet_log to TRUE in order to let vehicle perform packet forwarding
+
+#if SIMULATION_CHECKPOINT_FLAG /* [[ */
+						/** at the end of the warm-up, i.e., after the first EDD update, continue each forwarding scheme of option -^ in its own process from the shared state */
+						if(param->simulation_checkpoint_scheme_number > 0)
+						{
+							vanet_edd_model_type_t warm_up_edd_model = param->vehicle_vanet_edd_model; //vehicle EDD model used in the warm-up
+							boolean warm_up_v2v_edd_flag = is_v2v_edd_needed_for_forwarding_scheme(param); //whether the warm-up computed the EDDs for the V2V data delivery
+
+							if(run_checkpoint(param, output_file_1, output_file_2, &fp_1, &fp_2) == FALSE)
+							{
+								fclose(fp_1);
+								fclose(fp_2);
+								exit(0);
+							}
+
+							/* redo the scheme-dependent part of the first EDD update for the scheme of this process; the EDD computation for Gr, the vehicle movement registration and the convoys do not depend on the scheme */
+							if((param->data_forwarding_mode == DATA_FORWARDING_MODE_V2V) && (warm_up_v2v_edd_flag == FALSE) && is_v2v_edd_needed_for_forwarding_scheme(param))
+							{
+								VADD_Compute_EDD_And_EDD_SD_Based_On_Stochastic_Model_For_V2V_Data_Delivery(param, Gr, Gr_size, Gr_set, Gr_set_size, DEr_set);
+								warm_up_edd_model = VANET_EDD_UNKNOWN_MODEL; //let the vehicles' EDDs be updated with the EDDs for the V2V data delivery
+							}
+
+							if(param->vehicle_vanet_edd_model != warm_up_edd_model)
+								update_all_vehicle_edd_and_edd_sd(current_time, param, Gr, Gr_size, &ap_table_for_Gr);
+						}
+#endif /* ]] */
 					}
 					else
 					{
@@ -2354,7 +2441,7 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 				packet.dst_id = pAP->id;
 				packet.carry_src_id = id;
 				packet.carry_dst_id = id;
-				//packet.target_dst_ap_id = atoi(ap_table_for_Gr.list[0].vertex);
+				//packet.target_dst_ap_id = ap_table_for_Gr.list[0].vertex_id;
 
                                 /* determine the packet's target point */
 				packet.target_point_id = atoi(pAP->vertex); //target point is the AP's intersection id
@@ -2630,7 +2717,7 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 				  }				  
 				  packet.dst_node_type = VANET_NODE_AP;
 				  packet.dst_id = pAP->id;
-				  //packet.dst_id = atoi(ap_table_for_Gr.list[0].vertex);
+				  //packet.dst_id = ap_table_for_Gr.list[0].vertex_id;
 
 				  packet.carry_src_id = id;
 				  packet.carry_dst_id = 0;
@@ -2736,7 +2823,7 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 				pGraphNode->number_of_arrivals++;
                                 /*******************************/
 
-/* 				/\** update the statistics for branch probability and vehicular traffic densidy *\/							 //index = atoi(vehicle->path_ptr->vertex) - 1; //index for the graph node G[index] corresponding to the current intersection node */
+/* 				/\** update the statistics for branch probability and vehicular traffic densidy *\/							 //index = vehicle->path_ptr->vertex_id - 1; //index for the graph node G[index] corresponding to the current intersection node */
 /* 				pGraphNode = LookupGraph(Gr, Gr_size, vehicle->path_ptr->vertex); //return the pointer to graph node corresponding to vertex vehicle->path_ptr->vertex */
 				
 /* 				if(pGraphNode->number_of_branching == 0) */
@@ -3014,6 +3101,17 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 					movement_time = diff/vehicle->speed;
 					delay = MIN(movement_time, param->vehicle_step_time);
 				  }
+				  else if(param->vehicle_step_mode == STEP_ANALYTIC)
+				  {
+				    /* schedule only the edge exit; the offset on the way is computed on demand by update_vehicle_position_on_demand() */
+					if(vehicle->move_type == MOVE_FORWARD)
+					  diff = vehicle->edge_length - vehicle->current_pos_in_Gr.offset;
+					else
+					  diff = vehicle->current_pos_in_Gr.offset;
+
+					delay = diff/vehicle->speed;
+					start_vehicle_analytic_movement(vehicle);
+				  }
 				  else if(param->vehicle_step_mode == STEP_EDGE)
 					delay = vehicle->edge_length/vehicle->speed;
 				  else if(param->vehicle_step_mode == STEP_PATH)
@@ -3078,6 +3176,9 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 				/** reset intersection_flag to FALSE when vehicle is leaving from an intersection */
 				intersection_visit_flag = FALSE;
 
+				/** under STEP_ANALYTIC, rewind the on-demand position to move_start_time so that the whole step is applied below */
+				finish_vehicle_analytic_movement(vehicle);
+
 				/* update vehicle's state and state_time */
 				vehicle->state = VEHICLE_MOVE;
 				vehicle->state_time = current_time;
@@ -3114,7 +3215,7 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 
 					if(param->vehicle_vanet_acl_measurement_flag)
 					{
-						vehicle->ptr_vehicle_movement_queue_node->offset = vehicle->current_pos_in_Gr.offset; //update the offset in vehicle movement list
+						UpdateVehicleMovementOffset(vehicle->ptr_vehicle_movement_queue_node, vehicle->current_pos_in_Gr.offset); //update the offset in vehicle movement list and its offset index
 						vehicle->current_pos_in_digraph.offset = vehicle->ptr_vehicle_movement_queue_node->offset; //update the offset in vehicle's current_pos_in_digraph
 					}
 
@@ -3122,7 +3223,7 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 					{
 						if(param->vehicle_vanet_acl_measurement_flag != TRUE)
 						{
-							vehicle->ptr_vehicle_movement_queue_node->offset = vehicle->current_pos_in_Gr.offset; //update the offset in vehicle movement list
+							UpdateVehicleMovementOffset(vehicle->ptr_vehicle_movement_queue_node, vehicle->current_pos_in_Gr.offset); //update the offset in vehicle movement list and its offset index
 							vehicle->current_pos_in_digraph.offset = vehicle->ptr_vehicle_movement_queue_node->offset; //update the offset in vehicle's current_pos_in_digraph
 						}
 
@@ -3154,7 +3255,7 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 
 					if(param->vehicle_vanet_acl_measurement_flag)
 					{
-						vehicle->ptr_vehicle_movement_queue_node->offset = vehicle->edge_length - vehicle->current_pos_in_Gr.offset; //update the offset in vehicle movement list
+						UpdateVehicleMovementOffset(vehicle->ptr_vehicle_movement_queue_node, vehicle->edge_length - vehicle->current_pos_in_Gr.offset); //update the offset in vehicle movement list and its offset index
 						vehicle->current_pos_in_digraph.offset = vehicle->ptr_vehicle_movement_queue_node->offset; //update the offset in vehicle's current_pos_in_digraph
 					}
 
@@ -3162,7 +3263,7 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 					{
 						if(param->vehicle_vanet_acl_measurement_flag != TRUE)
 						{
-							vehicle->ptr_vehicle_movement_queue_node->offset = vehicle->edge_length - vehicle->current_pos_in_Gr.offset; //update the offset in vehicle movement list
+							UpdateVehicleMovementOffset(vehicle->ptr_vehicle_movement_queue_node, vehicle->edge_length - vehicle->current_pos_in_Gr.offset); //update the offset in vehicle movement list and its offset index
 							vehicle->current_pos_in_digraph.offset = vehicle->ptr_vehicle_movement_queue_node->offset; //update the offset in vehicle's current_pos_in_digraph
 						}
 
@@ -3684,6 +3785,7 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 
 						/* vehicle moves to the next vertex on the path by updating the path position and increase path_current_hop by one */
 						vehicle->path_ptr = vehicle->path_ptr->next;
+						vehicle->tpd_trajectory_version++; //let the prefix sums along vehicle's trajectory become stale
 						vehicle->path_current_hop++;
 
 						/** For the branch probability computation, we increment the visiting count of the vertex corresponding to vehicle->path_ptr->prev */
@@ -4067,6 +4169,7 @@ int run(unsigned int seed, struct parameter *param, char *graph_file, char *sche
 
 						/* vehicle moves to the next vertex on the path by updating the path position and increase path_current_hop by one */
 						vehicle->path_ptr = vehicle->path_ptr->next;
+						vehicle->tpd_trajectory_version++; //let the prefix sums along vehicle's trajectory become stale
 						vehicle->path_current_hop++;
 
 						/** For the branch probability computation, we increment the visiting count of the vertex corresponding to vehicle->path_ptr->prev */
@@ -5559,6 +5662,41 @@ Note that for the static forwarding, the path from the AP to the target point in
 
         /****************************************/
 
+#if APSP_INCREMENTAL_UPDATE_FLAG
+	Floyd_Warshall_Report_Incremental_Update_Statistics(stdout);
+	//report how many EDD/EDC shortest path updates were skipped, repaired or rebuilt
+#endif
+
+#if GSL_PROBABILITY_MEMO_STATISTICS_FLAG
+	GSL_Report_Probability_Memo_Statistics(stdout);
+	//report how often the GSL integration workspaces and the memoized probabilities were reused
+#endif
+
+#if TARGET_POINT_BRANCH_AND_BOUND_SELF_CHECK_FLAG
+	report_target_point_branch_and_bound_self_check(stdout);
+	//report how many branch-and-bound target point selections were compared with the exhaustive search
+#endif
+
+#if TARGET_POINT_BATCH_EVALUATION_FLAG && TARGET_POINT_BATCH_EVALUATION_SELF_CHECK_FLAG
+	Report_TargetPoint_Batch_Self_Check(stdout);
+	//report how many batched target point selections were compared with the per-candidate selection
+#endif
+
+#if TRAJECTORY_PREFIX_SUM_FLAG && TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG
+	Report_Trajectory_PrefixSum_Self_Check(stdout);
+	//report how many trajectory query values of the prefix sums were compared with the linked-list walk
+#endif
+
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG && FORWARDING_TABLE_LOOKUP_SELF_CHECK_FLAG
+	ReportForwardingTableLookupSelfCheck(stdout);
+	//report how many forwarding table lookups were checked against the graphs still held by their callers
+#endif
+
+#if QUEUE_NODE_ALLOCATION_STATISTICS_FLAG
+	ReportQueueNodeAllocationStatistics(stdout);
+	//report how many queue nodes of each queue type were allocated, released and reused
+#endif
+
 	/** release dynamic memory for data structures */
 	Free_Traffic_Table(&src_table_for_Gr); //release the memory occupied by the traffic source table in real graph Gr
 	Free_Traffic_Table(&dst_table_for_Gr); //release the memory occupied by the traffic destination table in real graph Gr
@@ -5568,6 +5706,12 @@ Note that for the static forwarding, the path from the AP to the target point in
 	Free_Path_Table(&path_table); //release the memory occupied by the path table
 	Free_Schedule_Table(&sched_table); //release the memory occupied by the schedule table
 
+	GSL_Free_Integration_Workspace_Pool(); //release the GSL integration workspaces kept for reuse
+	GSL_Free_Probability_Memo_Table(); //release the memo table of the delivery and encounter probabilities
+#if TARGET_POINT_BATCH_EVALUATION_FLAG
+	Free_TargetPoint_Batch(); //release the batch of target point candidates
+#endif
+
         /** destroy the data structures in vanet information table in param, such as road network graph Gr, the movement shortest path matrices, the EDD shortest path matrices, etc.; Note that these data structures can be reallocated memory, so the original pointers may not point to the actual memory. */
 	destroy_vanet_information_table_in_parameter(param); 
 
@@ -5619,6 +5763,8 @@ Note that for the static forwarding, the path from the AP to the target point in
 	/* release dynamic memory for vehicle_list */
 	free_vehicle_list();
 
+	/* release the chunks of the queue node slabs whose queue nodes are all released */
+	FreeQueueNodeSlabs();
 
 	/* delete the AP by freeing the memory allocated to AP only when data_forwarding_mode is download */
 	//if(param->data_forwarding_mode == DATA_FORWARDING_MODE_DOWNLOAD)
@@ -5655,3 +5801,549 @@ Note that for the static forwarding, the path from the AP to the target point in
 	return 0;
 }
 
+
+#if SIMULATION_SWEEP_FLAG /* [ */
+static int parse_sweep_value_list(char *list, char values[][NUMBER_STRING_LEN])
+{ //parse a comma-separated list of values or a range of <start>:<step>:<end> into values and return the number of values
+	int count = 0; //number of values
+	double start = 0, step = 0, end = 0; //range of values
+	double value = 0; //value in the range
+	char *token = NULL; //token in list
+	char *saveptr = NULL; //context for strtok_r()
+
+	if(sscanf(list, "%lf:%lf:%lf", &start, &step, &end) == 3)
+	{
+		if(step <= 0)
+		{
+			printf("%s:%d: step(%f) of range \"%s\" must be positive!\n",
+					__FUNCTION__, __LINE__,
+					step, list);
+			exit(1);
+		}
+
+		for(value = start; value <= end + step/2 && count < SIMULATION_SWEEP_VALUE_MAX; value += step)
+		{
+			snprintf(values[count++], NUMBER_STRING_LEN, "%g", value);
+		}
+	}
+	else
+	{
+		for(token = strtok_r(list, ",", &saveptr); token != NULL && count < SIMULATION_SWEEP_VALUE_MAX; token = strtok_r(NULL, ",", &saveptr))
+		{
+			snprintf(values[count++], NUMBER_STRING_LEN, "%s", token);
+		}
+	}
+
+	if(count == 0 || (token != NULL && count == SIMULATION_SWEEP_VALUE_MAX))
+	{
+		printf("%s:%d: value list \"%s\" must have between 1 and %d values!\n",
+				__FUNCTION__, __LINE__,
+				list, SIMULATION_SWEEP_VALUE_MAX);
+		exit(1);
+	}
+
+	return count;
+}
+
+static void make_sweep_output_file_name(char *file_name, char *base_file_name, char *seed, char axis_option, char *axis_value)
+{ //make the output file name of a sweep point, such as ./output/output#3#8.txt for ./output/output.txt, seed 3 and axis value 8
+	char *ext = rindex(base_file_name, '.'); //extension of base_file_name
+	int prefix_len = (ext == NULL) ? (int)strlen(base_file_name) : (int)(ext - base_file_name); //length of the file name prefix
+
+	if(axis_option == '\0')
+	{
+		snprintf(file_name, BUF_SIZE, "%.*s#%s%s", prefix_len, base_file_name, seed, (ext == NULL) ? "" : ext);
+	}
+	else
+	{
+		snprintf(file_name, BUF_SIZE, "%.*s#%s#%s%s", prefix_len, base_file_name, seed, axis_value, (ext == NULL) ? "" : ext);
+	}
+}
+
+/* state of the sweep of option -+ that is parsed by run_sweep() and used by the sweep processes */
+static char sweep_seeds[SIMULATION_SWEEP_VALUE_MAX][NUMBER_STRING_LEN]; //seeds of the sweep
+static char sweep_axis_values[SIMULATION_SWEEP_VALUE_MAX][NUMBER_STRING_LEN]; //values of the parameter axis of the sweep
+static int sweep_seed_number = 0; //number of seeds
+static int sweep_axis_value_number = 1; //number of axis values
+static char sweep_axis_option = '\0'; //option character of the parameter axis
+static int sweep_worker_number = SIMULATION_SWEEP_DEFAULT_WORKER_NUMBER; //maximum number of concurrent sweep processes
+static char sweep_output_file_1[BUF_SIZE] = OUTPUT_FILE_1; //base output file in the format of text (.txt)
+static char sweep_output_file_2[BUF_SIZE] = OUTPUT_FILE_2; //base output file in the format of excel (.xls)
+static boolean sweep_shared_setup_flag = FALSE; //flag to indicate whether the sweep points are forked by run_sweep_after_setup() from the road network setup in run()
+
+static pid_t fork_sweep_process(int *running_number, int *failure_number)
+{ //fork a sweep process after waiting for a running one to finish if sweep_worker_number processes are running; it returns 0 to the sweep process and its process id to the parent
+	pid_t pid = 0; //process id
+	int status = 0; //exit status of a sweep process
+
+	if(*running_number == sweep_worker_number)
+	{
+		pid = wait(&status);
+		if(pid > 0 && (!WIFEXITED(status) || WEXITSTATUS(status) != 0))
+			(*failure_number)++;
+		(*running_number)--;
+	}
+
+	pid = fork();
+	if(pid < 0)
+	{
+		perror("fork_sweep_process(): fork() failed");
+		exit(1);
+	}
+	else if(pid > 0)
+		(*running_number)++;
+
+	return pid;
+}
+
+static void finish_sweep(FILE *fp, int running_number, int failure_number)
+{ //wait for the running sweep processes and aggregate the first line of the .xls file of each sweep point into fp; it exits with 1 if any sweep point has not finished normally
+	int point_number = sweep_seed_number*sweep_axis_value_number; //number of sweep points
+	char point_output_file[BUF_SIZE]; //output file of a sweep point
+	char line[BUF_SIZE*16]; //first line of the .xls file of a sweep point
+	FILE *fp_point = NULL; //file pointer to the .xls file of a sweep point
+	pid_t pid = 0; //process id
+	int status = 0; //exit status of a sweep process
+	int i = 0, j = 0, p = 0; //indices
+
+	while(running_number > 0)
+	{
+		pid = wait(&status);
+		if(pid < 0)
+			break;
+		if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			failure_number++;
+		running_number--;
+	}
+
+	for(p = 0; p < point_number; p++)
+	{
+		i = p / sweep_axis_value_number;
+		j = p % sweep_axis_value_number;
+		make_sweep_output_file_name(point_output_file, sweep_output_file_2, sweep_seeds[i], sweep_axis_option, sweep_axis_values[j]);
+
+		fp_point = fopen(point_output_file, "r");
+		if(fp_point == NULL || fgets(line, sizeof(line), fp_point) == NULL)
+		{
+			printf("finish_sweep(): sweep point of seed=%s has no result in \"%s\"\n", sweep_seeds[i], point_output_file);
+		}
+		else
+		{
+			fputs(line, fp);
+			if(line[strlen(line) - 1] != '\n')
+				fputc('\n', fp);
+		}
+
+		if(fp_point != NULL)
+			fclose(fp_point);
+	}
+
+	fflush(fp);
+
+	printf("finish_sweep(): %d of %d sweep points finished normally; the results are aggregated into \"%s\"\n", point_number - failure_number, point_number, sweep_output_file_2);
+
+	if(failure_number > 0)
+		exit(1);
+}
+
+static void set_sweep_packet_parameter(struct parameter *param, char axis_option, char *axis_value)
+{ //set the packet parameter of param given by the option character of a shared-setup sweep axis to axis_value in the same way as the option itself
+	switch(axis_option)
+	{
+		case 'i': //packet interarrival time
+			param->communication_packet_interarrival_time = atof(axis_value);
+			break;
+
+		case 'j': //maximum number of generated packets
+			param->communication_packet_maximum_number = atoi(axis_value);
+			break;
+
+		case 't': //packet TTL
+			param->communication_packet_ttl = atof(axis_value);
+			break;
+
+		case 'E': //packet delivery probability threshold
+			param->communication_packet_delivery_probability_threshold = atof(axis_value);
+			/* check the validity of the delivery probability threshold */
+			if((param->communication_packet_delivery_probability_threshold < 0) || (param->communication_packet_delivery_probability_threshold > 1))
+			{
+				printf("set_sweep_packet_parameter(): param->communication_packet_delivery_probability_threshold(%.4f) must be between 0 and 1\n", (float)param->communication_packet_delivery_probability_threshold);
+				exit(1);
+			}
+			break;
+
+		case 'H': //packet hop limit
+			param->communication_packet_hop_limit = atoi(axis_value);
+			break;
+
+		default:
+			printf("%s:%d: option -%c is not a shared-setup sweep axis!\n",
+					__FUNCTION__, __LINE__,
+					axis_option);
+			exit(1);
+	}
+}
+
+boolean run_sweep(int *argc, char ***argv)
+{ //run the sweep given by option -+; it returns TRUE to a caller that should continue with a single simulation under *argc and *argv, that is, without the option -+, inside a sweep process or for the shared setup of run_sweep_after_setup(), and FALSE after all the sweep points have finished
+	/* The sweep spec is <seed list>[/<option>=<value list>][@<process number>] where a list is either
+	   comma-separated values or a range of <start>:<step>:<end>; e.g., "-+ 3:5:48/N=4,8,12@4" runs the 30
+	   points of run.sh with 4 concurrent processes. Since the simulator keeps its state in globals, each
+	   point runs as a forked process with its own copy of that state and writes its own
+	   <prefix>#<seed>#<value>.txt/.xls; the first line of every .xls is aggregated into the -y file.
+	   A sweep over seeds only or over a packet parameter (-i, -j, -t, -E or -H) does not change param.conf,
+	   Gr, DEr or the movement APSP, so it continues as one simulation whose run() builds them once and then
+	   forks the points by run_sweep_after_setup(); a sweep over any other option forks each point here,
+	   before the option parsing. */
+	char sweep_spec[BUF_SIZE] = ""; //sweep spec
+	boolean flag_sweep_spec = FALSE; //flag to indicate whether the sweep spec is passed from argv
+	int point_number = 0; //number of sweep points
+	int running_number = 0; //number of running sweep processes
+	int failure_number = 0; //number of sweep points that have not finished normally
+	char **point_argv = NULL; //argument list of a sweep point
+	int point_argc = 0; //number of arguments of a sweep point
+	char point_output_file[BUF_SIZE]; //output file of a sweep point
+	char *opt = NULL, *optval = NULL; //option and its argument in argv
+	char *seed_list = NULL, *axis_list = NULL, *worker_str = NULL; //fields of sweep_spec
+	FILE *fp = NULL; //file pointer to the aggregated .xls file
+	pid_t pid = 0; //process id
+	char axis_option_str[3] = ""; //axis option in the form of -<option>
+	int i = 0, j = 0, k = 0, p = 0; //indices
+
+	/** find the sweep spec and the base output files in argv, where every option of vanet takes an argument */
+	for(i = 1; i < *argc; i++)
+	{
+		opt = (*argv)[i];
+		if(opt[0] != '-' || opt[1] == '\0')
+			continue;
+
+		optval = (opt[2] != '\0') ? &opt[2] : ((i + 1 < *argc) ? (*argv)[++i] : NULL);
+		if(optval == NULL)
+			break;
+
+		if(opt[1] == '+')
+		{
+			snprintf(sweep_spec, sizeof(sweep_spec), "%s", optval);
+			flag_sweep_spec = TRUE;
+		}
+		else if(opt[1] == 'x')
+			snprintf(sweep_output_file_1, sizeof(sweep_output_file_1), "%s", optval);
+		else if(opt[1] == 'y')
+			snprintf(sweep_output_file_2, sizeof(sweep_output_file_2), "%s", optval);
+	}
+
+	if(flag_sweep_spec == FALSE)
+		return TRUE;
+
+	/** parse the sweep spec */
+	worker_str = index(sweep_spec, '@');
+	if(worker_str != NULL)
+	{
+		*worker_str++ = '\0';
+		sweep_worker_number = atoi(worker_str);
+	}
+
+	if(sweep_worker_number <= 0)
+		sweep_worker_number = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+	if(sweep_worker_number <= 0)
+		sweep_worker_number = 1;
+
+	seed_list = sweep_spec;
+	axis_list = index(sweep_spec, '/');
+	if(axis_list != NULL)
+	{
+		*axis_list++ = '\0';
+		if(axis_list[0] == '\0' || axis_list[1] != '=' || index("+sxy", axis_list[0]) != NULL)
+		{
+			printf("%s:%d: parameter axis \"%s\" must be <option>=<value list> for an option other than -+, -s, -x and -y!\n",
+					__FUNCTION__, __LINE__,
+					axis_list);
+			exit(1);
+		}
+		sweep_axis_option = axis_list[0];
+		sweep_axis_value_number = parse_sweep_value_list(&axis_list[2], sweep_axis_values);
+	}
+
+	sweep_seed_number = parse_sweep_value_list(seed_list, sweep_seeds);
+	point_number = sweep_seed_number*sweep_axis_value_number;
+	sweep_shared_setup_flag = (sweep_axis_option == '\0' || index("ijtEH", sweep_axis_option) != NULL) ? TRUE : FALSE;
+
+	printf("run_sweep(): %d sweep points with %d concurrent processes%s\n", point_number, sweep_worker_number, (sweep_shared_setup_flag == TRUE) ? " after the shared road network setup" : "");
+	fflush(stdout); //avoid duplicating buffered output in the sweep processes
+
+	/** build the argument list without the option -+; a sweep point appends its own seed, axis value and output files unless it is forked after the shared setup */
+	point_argv = (char**)calloc(*argc + 9, sizeof(char*));
+	assert_memory(point_argv);
+
+	point_argv[point_argc++] = (*argv)[0];
+	for(k = 1; k < *argc; k++)
+	{
+		opt = (*argv)[k];
+		if(opt[0] == '-' && opt[1] == '+')
+		{
+			if(opt[2] == '\0')
+				k++; //skip the sweep spec
+			continue;
+		}
+		point_argv[point_argc++] = opt;
+	}
+
+	if(sweep_shared_setup_flag == TRUE)
+	{
+		/* the shared setup runs under the first seed, and run_sweep_after_setup() sets the seed and the axis value of each point */
+		point_argv[point_argc++] = (char*)"-s";
+		point_argv[point_argc++] = sweep_seeds[0];
+		point_argv[point_argc] = NULL;
+
+		*argc = point_argc;
+		*argv = point_argv;
+		return TRUE;
+	}
+
+	/** run the sweep points, keeping at most sweep_worker_number processes running */
+	for(p = 0; p < point_number; p++)
+	{
+		pid = fork_sweep_process(&running_number, &failure_number);
+		if(pid == 0)
+		{
+			/* sweep process: argv without the option -+, followed by the options of this sweep point */
+			i = p / sweep_axis_value_number;
+			j = p % sweep_axis_value_number;
+
+			point_argv[point_argc++] = (char*)"-s";
+			point_argv[point_argc++] = sweep_seeds[i];
+			snprintf(axis_option_str, sizeof(axis_option_str), "-%c", sweep_axis_option);
+			point_argv[point_argc++] = strdup(axis_option_str); //axis_option_str is gone after the return
+			point_argv[point_argc++] = sweep_axis_values[j];
+
+			make_sweep_output_file_name(point_output_file, sweep_output_file_1, sweep_seeds[i], sweep_axis_option, sweep_axis_values[j]);
+			point_argv[point_argc++] = (char*)"-x";
+			point_argv[point_argc++] = strdup(point_output_file);
+
+			make_sweep_output_file_name(point_output_file, sweep_output_file_2, sweep_seeds[i], sweep_axis_option, sweep_axis_values[j]);
+			point_argv[point_argc++] = (char*)"-y";
+			point_argv[point_argc++] = strdup(point_output_file);
+			point_argv[point_argc] = NULL;
+
+			*argc = point_argc;
+			*argv = point_argv;
+			return TRUE;
+		}
+	}
+
+	/** aggregate the first line of the .xls file of each sweep point into the base .xls file */
+	fp = fopen(sweep_output_file_2, "w");
+	if(!fp)
+	{
+		fprintf(stderr, "Error: unable to open file \"%s\"\n", sweep_output_file_2);
+		exit(1);
+	}
+
+	finish_sweep(fp, running_number, failure_number);
+	fclose(fp);
+
+	return FALSE;
+}
+
+boolean run_sweep_after_setup(struct parameter *param, unsigned int *seed, FILE **fp_1, FILE **fp_2)
+{ //fork one simulation process per sweep point of option -+ from the road network setup shared by the sweep points; it returns TRUE to a caller that should continue the simulation, that is, without a shared-setup sweep or inside a sweep process with its own seed, axis value and output files, and FALSE after all the sweep points have finished
+	int point_number = sweep_seed_number*sweep_axis_value_number; //number of sweep points
+	int running_number = 0; //number of running sweep processes
+	int failure_number = 0; //number of sweep points that have not finished normally
+	char point_output_file[BUF_SIZE]; //output file of a sweep point
+	pid_t pid = 0; //process id
+	int i = 0, j = 0, p = 0; //indices
+
+	if(sweep_shared_setup_flag == FALSE)
+		return TRUE;
+
+	/** flush the setup output so that forked processes neither lose it nor write it twice */
+	fflush(NULL);
+
+	for(p = 0; p < point_number; p++)
+	{
+		pid = fork_sweep_process(&running_number, &failure_number);
+		if(pid == 0)
+		{ //the sweep process continues the simulation with the seed and the axis value of its point
+			i = p / sweep_axis_value_number;
+			j = p % sweep_axis_value_number;
+			sweep_shared_setup_flag = FALSE;
+
+			/* the setup draws no random numbers, so reseeding here gives the same stream as a single simulation with -s <seed> */
+			*seed = (unsigned int)atoi(sweep_seeds[i]);
+			if(param->simulation_seed == SEED_DEFAULT)
+				seed_random(*seed);
+
+			if(sweep_axis_option != '\0')
+				set_sweep_packet_parameter(param, sweep_axis_option, sweep_axis_values[j]);
+
+			make_sweep_output_file_name(point_output_file, sweep_output_file_1, sweep_seeds[i], sweep_axis_option, sweep_axis_values[j]);
+			fclose(*fp_1);
+			*fp_1 = fopen(point_output_file, "w");
+			if(!*fp_1)
+			{
+				fprintf(stderr, "Error: unable to open file \"%s\"\n", point_output_file);
+				exit(1);
+			}
+			sendto(*fp_1); //redirect simulation messages to the output file of the sweep point
+
+			make_sweep_output_file_name(point_output_file, sweep_output_file_2, sweep_seeds[i], sweep_axis_option, sweep_axis_values[j]);
+			fclose(*fp_2);
+			*fp_2 = fopen(point_output_file, "w");
+			if(!*fp_2)
+			{
+				fprintf(stderr, "Error: unable to open file \"%s\"\n", point_output_file);
+				exit(1);
+			}
+
+			return TRUE;
+		}
+	}
+
+	/** aggregate the first line of the .xls file of each sweep point into the base .xls file opened by run() */
+	finish_sweep(*fp_2, running_number, failure_number);
+
+	return FALSE;
+}
+#endif /* ] */
+
+boolean is_v2v_edd_needed_for_forwarding_scheme(struct parameter *param)
+{ //check whether the forwarding scheme of param needs the EDDs and EDD_SDs computed for the V2V data delivery
+	switch(param->vanet_forwarding_scheme)
+	{
+		case VANET_FORWARDING_VADD:
+		case VANET_FORWARDING_TBD:
+		case VANET_FORWARDING_EPIDEMIC:
+		case VANET_FORWARDING_TADB:
+			return TRUE;
+
+		default:
+			return FALSE;
+	}
+}
+
+#if SIMULATION_CHECKPOINT_FLAG /* [ */
+static void make_checkpoint_output_file_name(char *file_name, char *base_file_name, vanet_forwarding_scheme_t scheme)
+{ //make the output file name of a forwarding scheme, such as ./output/output#TPD.txt for ./output/output.txt and TPD
+	char *ext = rindex(base_file_name, '.'); //extension of base_file_name
+	int prefix_len = (ext == NULL) ? (int)strlen(base_file_name) : (int)(ext - base_file_name); //length of the file name prefix
+
+	snprintf(file_name, BUF_SIZE, "%.*s#%s%s", prefix_len, base_file_name, get_vanet_forwarding_scheme_name(scheme), (ext == NULL) ? "" : ext);
+}
+
+static FILE* open_checkpoint_output_file(char *file_name, char *warm_up_file_name)
+{ //open file_name for a forwarding scheme and copy into it what has been written to warm_up_file_name during the warm-up
+	FILE *fp = NULL; //file pointer to file_name
+	FILE *fp_warm_up = NULL; //file pointer to warm_up_file_name
+	char buf[BUFSIZ]; //copy buffer
+	size_t n = 0; //number of bytes read into buf
+
+	fp = fopen(file_name, "w");
+	if(!fp)
+	{
+		fprintf(stderr, "Error: unable to open file \"%s\"\n", file_name);
+		exit(1);
+	}
+
+	fp_warm_up = fopen(warm_up_file_name, "r");
+	if(fp_warm_up != NULL)
+	{
+		while((n = fread(buf, 1, sizeof(buf), fp_warm_up)) > 0)
+			fwrite(buf, 1, n, fp);
+
+		fclose(fp_warm_up);
+	}
+
+	return fp;
+}
+
+boolean run_checkpoint(struct parameter *param, char *output_file_1, char *output_file_2, FILE **fp_1, FILE **fp_2)
+{ //fork one simulation process per forwarding scheme of option -^ from the current warm-up state; it returns TRUE to a forked process that should continue the simulation with its own scheme and output files, and FALSE to the parent after all the schemes have finished, or exits with 1 if any scheme has not finished normally
+	/* The warm-up up to the first EDD update, i.e., vehicle arrivals, the first measurement of the vehicular
+	   traffic statistics, the first EDD computation, the vehicle movement registration and the convoy
+	   construction, does not depend on the forwarding scheme except for the vehicle EDD model and the EDDs
+	   for the V2V data delivery, which the caller redoes in each forked process.
+	   Rather than serializing the event list, vehicles, DEr and the RNG state into a file, the warm-up state is
+	   kept in memory and shared copy-on-write by forking; each process continues as if it had been started
+	   with -f <scheme> and writes its own <prefix>#<scheme>.txt/.xls, and the first line of every .xls is
+	   aggregated into the -y file. The snapshot is therefore fixed at the first EDD update and lives only as
+	   long as this run; it cannot be taken at another time or restored by a later run. */
+	pid_t pid = 0; //process id
+	int status = 0; //exit status of a scheme process
+	int failure_number = 0; //number of scheme processes that did not finish normally
+	int i = 0; //index for for-loop
+	char scheme_output_file[BUF_SIZE]; //output file of a forwarding scheme
+	char line[BUF_SIZE]; //first line of the .xls file of a forwarding scheme
+	FILE *fp_scheme = NULL; //file pointer to the .xls file of a forwarding scheme
+
+	/** flush the warm-up output so that forked processes neither lose it nor write it twice */
+	fflush(NULL);
+
+	for(i = 0; i < param->simulation_checkpoint_scheme_number; i++)
+	{
+		pid = fork();
+		if(pid < 0)
+		{
+			printf("%s:%d: fork() failed for forwarding scheme %s!\n",
+					__FUNCTION__, __LINE__,
+					get_vanet_forwarding_scheme_name(param->simulation_checkpoint_scheme[i]));
+			exit(1);
+		}
+		else if(pid == 0)
+		{ //the process of the forwarding scheme continues the simulation
+			param->vanet_forwarding_scheme = param->simulation_checkpoint_scheme[i];
+			update_vanet_edd_model_for_forwarding_scheme(param);
+			param->simulation_checkpoint_scheme_number = 0;
+
+			make_checkpoint_output_file_name(scheme_output_file, output_file_1, param->vanet_forwarding_scheme);
+			fclose(*fp_1);
+			*fp_1 = open_checkpoint_output_file(scheme_output_file, output_file_1);
+			sendto(*fp_1); //redirect simulation messages to the output file of the scheme
+
+			make_checkpoint_output_file_name(scheme_output_file, output_file_2, param->vanet_forwarding_scheme);
+			fclose(*fp_2);
+			*fp_2 = open_checkpoint_output_file(scheme_output_file, output_file_2);
+
+			return TRUE;
+		}
+	}
+
+	for(i = 0; i < param->simulation_checkpoint_scheme_number; i++)
+	{
+		pid = wait(&status);
+		if(pid < 0)
+			break;
+		if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			failure_number++;
+	}
+
+	/** aggregate the first line of the .xls file of each forwarding scheme into output_file_2 */
+	for(i = 0; i < param->simulation_checkpoint_scheme_number; i++)
+	{
+		make_checkpoint_output_file_name(scheme_output_file, output_file_2, param->simulation_checkpoint_scheme[i]);
+
+		fp_scheme = fopen(scheme_output_file, "r");
+		if(fp_scheme == NULL || fgets(line, sizeof(line), fp_scheme) == NULL)
+		{
+			printf("run_checkpoint(): forwarding scheme %s has no result in \"%s\"\n", get_vanet_forwarding_scheme_name(param->simulation_checkpoint_scheme[i]), scheme_output_file);
+		}
+		else
+		{
+			fputs(line, *fp_2);
+			if(line[strlen(line) - 1] != '\n')
+				fputc('\n', *fp_2);
+		}
+
+		if(fp_scheme != NULL)
+			fclose(fp_scheme);
+	}
+
+	printf("run_checkpoint(): %d of %d forwarding schemes finished normally from the shared warm-up; the results are aggregated into \"%s\"\n", param->simulation_checkpoint_scheme_number - failure_number, param->simulation_checkpoint_scheme_number, output_file_2);
+
+	if(failure_number > 0)
+		exit(1);
+
+	return FALSE;
+}
+#endif /* ] */
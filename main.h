@@ -11,7 +11,23 @@
 #include "common.h"
 //#include "matlab-operation.h"
 
-int run(unsigned int seed, struct parameter *param, char *graph_file, char *schedule_file, char *vanet_file, char *pathlist_file, char *output_file_1, char *output_file_2, char *trace_file_of_vehicle_convoy_length, int *trajectory, int trajectory_size, char *vanet_packet_carrier_trace_file);
-//run simulation according to a given scenario
+int run(simulation_context_t *context, unsigned int seed, struct parameter *param, char *graph_file, char *schedule_file, char *vanet_file, char *pathlist_file, char *output_file_1, char *output_file_2, char *trace_file_of_vehicle_convoy_length, int *trajectory, int trajectory_size, char *vanet_packet_carrier_trace_file);
+//run simulation according to a given scenario within the simulation context bound to the calling thread during the run
+
+#if SIMULATION_SWEEP_FLAG /* [ */
+boolean run_sweep(int *argc, char ***argv);
+//run the sweep given by option -+; it returns TRUE to a caller that should continue with a single simulation under *argc and *argv, that is, without the option -+, inside a sweep process or for the shared setup of run_sweep_after_setup(), and FALSE after all the sweep points have finished
+
+boolean run_sweep_after_setup(struct parameter *param, unsigned int *seed, FILE **fp_1, FILE **fp_2);
+//fork one simulation process per sweep point of option -+ from the road network setup shared by the sweep points; it returns TRUE to a caller that should continue the simulation, that is, without a shared-setup sweep or inside a sweep process with its own seed, axis value and output files, and FALSE after all the sweep points have finished
+#endif /* ] */
+
+boolean is_v2v_edd_needed_for_forwarding_scheme(struct parameter *param);
+//check whether the forwarding scheme of param needs the EDDs and EDD_SDs computed for the V2V data delivery
+
+#if SIMULATION_CHECKPOINT_FLAG /* [ */
+boolean run_checkpoint(struct parameter *param, char *output_file_1, char *output_file_2, FILE **fp_1, FILE **fp_2);
+//fork one simulation process per forwarding scheme of option -^ from the current warm-up state; it returns TRUE to a forked process that should continue the simulation with its own scheme and output files, and FALSE to the parent after all the schemes have finished, or exits with 1 if any scheme has not finished normally
+#endif /* ] */
 
 #endif
@@ -247,6 +247,9 @@ void init_parameter(struct parameter *param, char* conf_file)
 	/* initialize param with zeroes */
 	memset(param, 0, sizeof(*param));
 
+	/* set the parameters that are given only by command-line options to their default values */
+	param->forwarding_table_thread_number = FORWARDING_TABLE_DEFAULT_THREAD_NUMBER;
+
 	/* open conf_file */
 	fp = fopen(conf_file, "r");
 	if(!fp)
@@ -521,6 +524,12 @@ void init_parameter(struct parameter *param, char* conf_file)
 					enum_flag = TRUE;
 					break;
 				}
+				else if(strcmp(token, "STEP_ANALYTIC") == 0)
+				{
+					value = STEP_ANALYTIC;
+					enum_flag = TRUE;
+					break;
+				}
 				else if(strcmp(token, "UNIT_METER") == 0)
 				{
 					value = UNIT_METER;
@@ -2888,9 +2897,13 @@ void destroy_vanet_information_table_in_parameter(parameter_t *param)
 
   Floyd_Warshall_Free_Matrices_For_EDD(&(param->vanet_table.Dr_edd), &(param->vanet_table.Mr_edd), &(param->vanet_table.Sr_edd), &(param->vanet_table.matrix_size_for_edd_in_Gr));
 
+  Floyd_Warshall_Free_Weight_Matrices_For_Incremental_Update(&(param->vanet_table.Dr_edd_weight), &(param->vanet_table.Sr_edd_weight), &(param->vanet_table.node_number_for_edd_weight_in_Gr));
+
   /* free matrices for EDC in Gr */
   Floyd_Warshall_Free_Matrices_For_EDC(&(param->vanet_table.Wr_edc), &(param->vanet_table.Dr_edc), &(param->vanet_table.Mr_edc), &(param->vanet_table.Sr_edc), &(param->vanet_table.matrix_size_for_edc_in_Gr));
 
+  Floyd_Warshall_Free_Weight_Matrices_For_Incremental_Update(&(param->vanet_table.Dr_edc_weight), &(param->vanet_table.Sr_edc_weight), &(param->vanet_table.node_number_for_edc_weight_in_Gr));
+
   /* destory forwarding table queue FTQ */
   DestroyQueue((queue_t*)param->vanet_table.FTQ);
 }
@@ -2913,3 +2926,22 @@ void update_vehicle_maximum_and_minimum_speeds(parameter_t *param)
   param->vehicle_maximum_speed_in_km_per_hour = convert_mile_per_hour_to_km_per_hour(param->vehicle_maximum_speed_in_mile_per_hour);
   param->vehicle_maximum_speed = convert_mile_per_hour_to_meter_per_sec(param->vehicle_maximum_speed_in_mile_per_hour);
 }
+
+void update_vanet_edd_model_for_forwarding_scheme(parameter_t *param)
+{ //update the vehicle EDD model according to the vanet forwarding scheme
+	switch(param->vanet_forwarding_scheme)
+	{
+		case VANET_FORWARDING_VADD:
+		case VANET_FORWARDING_EPIDEMIC:	
+		case VANET_FORWARDING_TADB:
+			param->vehicle_vanet_edd_model = VANET_EDD_PER_INTERSECTION_MODEL;
+			break;
+
+		case VANET_FORWARDING_TBD:
+			param->vehicle_vanet_edd_model = VANET_EDD_PER_VEHICLE_MODEL;
+			break;
+
+		default:
+			break;
+	}
+}
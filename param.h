@@ -100,7 +100,8 @@ typedef enum _vehicle_step_mode_type_t
 { UNKNOWN_STEP_MODE = 0,
   STEP_TIME = 1, //vehicle moves by step time
   STEP_EDGE = 2, //vehicle moves by the movement time for the edge corresponding to each road segment	
-  STEP_PATH = 3  //vehicle moves by the movement time for the path from the source to the destination	
+  STEP_PATH = 3, //vehicle moves by the movement time for the path from the source to the destination	
+  STEP_ANALYTIC = 4 //vehicle is scheduled only at edge exits and its position on the edge is computed on demand
 
 } vehicle_step_mode_type_t;
 
@@ -466,6 +467,9 @@ typedef struct _vanet_information_table_t
     int **Mr_edd; //predecessor matrix for all-pairs shortest paths in terms of E2E delivery delay or delay variance in real graph Gr
     double **Sr_edd; //supplementary matrix for all-pairs shortest paths in terms of E2E delivery delay or delay variance in real graph Gr
     int matrix_size_for_edd_in_Gr; //matrix size of matrices Dr_edd, Mr_edd, and Sr_edd for E2E delivery delay or delay variance in Gr    
+    double **Dr_edd_weight; //edge weight matrix used in the last computation of Dr_edd; this is kept for the incremental update of Dr_edd
+    double **Sr_edd_weight; //supplementary edge weight matrix used in the last computation of Sr_edd; this is kept for the incremental update of Sr_edd
+    int node_number_for_edd_weight_in_Gr; //number of nodes in Dr_edd_weight and Sr_edd_weight; zero means that there is no last computation
 
     /** the EDC shortest path matrices */
 	double **Wr_edc; //the adjacency matrix of road network graph based on delivery cost mean
@@ -473,6 +477,9 @@ typedef struct _vanet_information_table_t
     int **Mr_edc; //predecessor matrix for all-pairs shortest paths in terms of E2E delivery cost or cost variance in real graph Gr
     double **Sr_edc; //supplementary matrix for all-pairs shortest paths in terms of E2E delivery cost or cost variance in real graph Gr
     int matrix_size_for_edc_in_Gr; //matrix size of matrices Dr_edc, Mr_edc, and Sr_edc for E2E delivery cost or cost variance in Gr    
+    double **Dr_edc_weight; //edge weight matrix used in the last computation of Dr_edc; this is kept for the incremental update of Dr_edc
+    double **Sr_edc_weight; //supplementary edge weight matrix used in the last computation of Sr_edc; this is kept for the incremental update of Sr_edc
+    int node_number_for_edc_weight_in_Gr; //number of nodes in Dr_edc_weight and Sr_edc_weight; zero means that there is no last computation
 
     /** forwarding table queue */
     struct _forwarding_table_queue_t *FTQ; //pointer to the forwarding table queue
@@ -493,6 +500,13 @@ typedef struct parameter
 /* VANET Information Table */
         vanet_information_table_t vanet_table; //this table contains the pointers to data structures used in the data forwarding in VANET, such as road network graph Gr, the EDD shortest path matrix Dr_edd, etc.
 
+/* Forwarding Table Update */
+        int forwarding_table_thread_number; //number of worker threads computing the forwarding tables of the intersections in UpdateForwardingTableQueue(), where 1 means the serial computation
+
+/* Simulation Checkpoint */
+        int simulation_checkpoint_scheme_number; //number of forwarding schemes that continue from the shared warm-up state given by option -^, where 0 means no checkpoint
+        vanet_forwarding_scheme_t simulation_checkpoint_scheme[NUMBER_OF_VANET_FORWARDING_SCHEME]; //forwarding schemes that continue from the shared warm-up state
+
 /* Simulation Logging Options */
         boolean forwarding_probability_and_statistics_flag; //flag to indicate whether the forwarding probability_and_statistics information is logged every EDD update or not
 
@@ -765,6 +779,9 @@ void init_parameter(parameter_t *param, char* conf_file);
 void update_vehicle_maximum_and_minimum_speeds(parameter_t *param);
 //update the vehicle maximum and minimum speed bounds for the speed generation
 
+void update_vanet_edd_model_for_forwarding_scheme(parameter_t *param);
+//update the vehicle EDD model according to the vanet forwarding scheme
+
 void create_vanet_information_table_in_parameter(parameter_t *param, struct_graph_node *Gr, int Gr_size, double **Dr_move, int **Mr_move, int matrix_size_for_movement_in_Gr, int **Ar_edd, double **Dr_edd, int **Mr_edd, double **Sr_edd, int matrix_size_for_edd_in_Gr, double **Wr_edc, double **Dr_edc, int **Mr_edc, double **Sr_edc, int matrix_size_for_edc_in_Gr, struct _forwarding_table_queue_t *FTQ);
 //create vanet information table containing the data structures used in the data forwarding in the VANET, such as road network graph Gr, the movement shortest path matrices, the EDD shortest path matrices, the EDC shortest path matrices, the forwarding table queue FTQ, etc.
   /*@ Note: Whenever a new data structure is added to vanet information table, the memory for the data structure must be destroyed in destroy_vanet_information_table_in_parameter() */
@@ -15,6 +15,15 @@
 #include "all-pairs-shortest-paths.h" //Floyd_Warshall_Allocate_Matrices_For_EDD()
 #include "tpd.h" //TPD_Allocate_Predicted_Encounter_Graph_For_Packet()
 
+#if defined(_LINUX_) && FORWARDING_TABLE_THREAD_POOL_FLAG /* [ */
+#include <pthread.h> //pthread_create(), pthread_mutex_lock()
+#endif /* ] */
+
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+static void FreeForwardingTableGraph(forwarding_table_graph_t *graph);
+//free the forwarding graph G along with its edge queue EQ and directional edge queue DEQ
+#endif /* ] */
+
 /** Note3: whenever we support another queue type, we need to add another case statement for it */
 void InitQueue(queue_t *Q, queue_type_t queue_type)
 { //initialize queue Q
@@ -182,233 +191,413 @@ void InitQueue(queue_t *Q, queue_type_t queue_type)
 	Q->head.next = Q->head.prev = &(Q->head);
 }
 
-/** Note3: whenever we support another queue type, we need to add another case statement for it */
-queue_node_t* MakeQueueNode(queue_type_t queue_type, queue_node_t *node)
-{ //make a queue node corresponding to queue type and copy the data of node into its data portion
+/** Queue Node Slabs */
+static queue_node_slab_t queue_node_slab_table[QUEUE_TYPE_NUMBER]; //slab per queue type
+
+#if defined(_LINUX_) && FORWARDING_TABLE_THREAD_POOL_FLAG /* [ */
+static pthread_mutex_t queue_node_slab_mutex = PTHREAD_MUTEX_INITIALIZER; //mutex for the slabs shared by the forwarding table workers
+static boolean queue_node_slab_lock_flag = FALSE; //flag to indicate whether the forwarding table workers are running, so that the slabs must be locked
+#define LOCK_QUEUE_NODE_SLAB() do { if(queue_node_slab_lock_flag) pthread_mutex_lock(&queue_node_slab_mutex); } while(0)
+#define UNLOCK_QUEUE_NODE_SLAB() do { if(queue_node_slab_lock_flag) pthread_mutex_unlock(&queue_node_slab_mutex); } while(0)
+#else
+#define LOCK_QUEUE_NODE_SLAB()
+#define UNLOCK_QUEUE_NODE_SLAB()
+#endif /* ] */
+
+/* header of a slab chunk that keeps the queue nodes after it aligned for any member type */
+typedef union _queue_node_slab_chunk_header_t {
+	void *next; //next chunk
+	long double alignment; //alignment of the queue nodes
+} queue_node_slab_chunk_header_t;
+
+static void GrowQueueNodeSlab(queue_node_slab_t *slab)
+{ //add a chunk of QUEUE_NODE_SLAB_CHUNK_NODE_NUMBER queue nodes to slab whose nodes are carved out in the address order
+	queue_node_slab_chunk_header_t *chunk = NULL;
+
+	chunk = (queue_node_slab_chunk_header_t*) malloc(sizeof(queue_node_slab_chunk_header_t) + QUEUE_NODE_SLAB_CHUNK_NODE_NUMBER*slab->node_size);
+	assert_memory(chunk);
+
+	chunk->next = slab->chunk_list;
+	slab->chunk_list = chunk;
+	slab->chunk_count++;
+
+	slab->chunk_cursor = (char*)(chunk + 1);
+	slab->chunk_end = slab->chunk_cursor + QUEUE_NODE_SLAB_CHUNK_NODE_NUMBER*slab->node_size;
+}
+
+queue_node_t* AllocateQueueNode(queue_type_t queue_type)
+{ //allocate an uninitialized queue node of queue type from its slab
+	queue_node_slab_t *slab = &(queue_node_slab_table[queue_type]);
 	queue_node_t *p = NULL;
 
+	LOCK_QUEUE_NODE_SLAB();
+
+	if(slab->node_size == 0)
+	{
+		/* round the node size up to the alignment of the chunk header */
+		slab->node_size = (SizeofQueueNode(queue_type) + sizeof(queue_node_slab_chunk_header_t) - 1)/sizeof(queue_node_slab_chunk_header_t)*sizeof(queue_node_slab_chunk_header_t);
+	}
+
+#if QUEUE_NODE_SLAB_FLAG /* [ */
+	if(slab->free_list != NULL)
+	{ //reuse a released queue node
+		p = slab->free_list;
+		slab->free_list = p->next;
+		slab->reuse_count++;
+	}
+	else
+	{ //carve a new queue node out of the current chunk
+		if(slab->chunk_cursor == slab->chunk_end)
+			GrowQueueNodeSlab(slab);
+
+		p = (queue_node_t*)slab->chunk_cursor;
+		slab->chunk_cursor += slab->node_size;
+	}
+#else
+	p = (queue_node_t*) calloc(1, slab->node_size);
+	assert_memory(p);
+#endif /* ] */
+
+	slab->allocation_count++;
+	if(++slab->live_count > slab->peak_live_count)
+		slab->peak_live_count = slab->live_count;
+
+	UNLOCK_QUEUE_NODE_SLAB();
+
+	return p;
+}
+
+void FreeQueueNode(queue_type_t queue_type, queue_node_t *p)
+{ //release queue node p of queue type to its slab without destroying the queue(s) in p
+	queue_node_slab_t *slab = &(queue_node_slab_table[queue_type]);
+
+	LOCK_QUEUE_NODE_SLAB();
+
+#if QUEUE_NODE_SLAB_FLAG /* [ */
+	p->next = slab->free_list;
+	slab->free_list = p;
+#else
+	free(p);
+#endif /* ] */
+
+	slab->release_count++;
+	slab->live_count--;
+
+	UNLOCK_QUEUE_NODE_SLAB();
+}
+
+static void SpliceQueueNodesIntoSlab(queue_t *Q)
+{ //release all the queue nodes of Q to the slab of Q's type at once by linking Q's node list into the free list
+	queue_node_slab_t *slab = &(queue_node_slab_table[Q->type]);
+
+	LOCK_QUEUE_NODE_SLAB();
+
+	/* the nodes are already linked by their next pointers from Q->head.next to Q->head.prev */
+	Q->head.prev->next = slab->free_list;
+	slab->free_list = Q->head.next;
+
+	slab->release_count += Q->size;
+	slab->live_count -= Q->size;
+	slab->splice_count++;
+
+	UNLOCK_QUEUE_NODE_SLAB();
+}
+
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+static void InsertVehicleMovementIntoOffsetIndex(vehicle_movement_queue_t *Q, vehicle_movement_queue_node_t *p)
+{ //insert vehicle movement queue node p into the offset index of Q after the nodes with the same or smaller offsets
+	vehicle_movement_queue_node_t **A = NULL; //offset index
+	int low = 0, high = 0, mid = 0; //indices for binary search
+	int i = 0; //index for for-loop
+
+	/* enlarge the offset index if it is full */
+	if(Q->offset_index_size == Q->offset_index_capacity)
+	{
+		if(Q->offset_index_capacity == 0)
+			Q->offset_index_capacity = VEHICLE_MOVEMENT_OFFSET_INDEX_INITIAL_CAPACITY;
+		else
+			Q->offset_index_capacity *= 2;
+
+		Q->offset_index = (vehicle_movement_queue_node_t**) realloc(Q->offset_index, Q->offset_index_capacity*sizeof(vehicle_movement_queue_node_t*));
+		assert_memory(Q->offset_index);
+	}
+	A = Q->offset_index;
+
+	/* find the first position whose node has a greater offset than p */
+	high = Q->offset_index_size;
+	while(low < high)
+	{
+		mid = (low + high)/2;
+		if(A[mid]->offset <= p->offset)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	/* shift the nodes from the position to the right by one */
+	for(i = Q->offset_index_size; i > low; i--)
+	{
+		A[i] = A[i-1];
+		A[i]->offset_index_position = i;
+	}
+
+	A[low] = p;
+	p->offset_index_position = low;
+	Q->offset_index_size++;
+}
+
+static void DeleteVehicleMovementFromOffsetIndex(vehicle_movement_queue_t *Q, vehicle_movement_queue_node_t *p)
+{ //delete vehicle movement queue node p from the offset index of Q
+	vehicle_movement_queue_node_t **A = Q->offset_index; //offset index
+	int i = 0; //index for for-loop
+
+	/* shift the nodes after p's position to the left by one */
+	for(i = p->offset_index_position; i < Q->offset_index_size - 1; i++)
+	{
+		A[i] = A[i+1];
+		A[i]->offset_index_position = i;
+	}
+
+	Q->offset_index_size--;
+}
+#endif /* ] */
+
+#if CONVOY_LAZY_SORT_FLAG /* [ */
+static int IsVehicleMovementDescent(vehicle_movement_queue_t *Q, vehicle_movement_queue_node_t *p)
+{ //return 1 if p and its next node in Q are out of ascending order of offset, and 0 otherwise
+	if(p == &(Q->head) || p->next == &(Q->head))
+		return 0;
+
+	if(p->offset > p->next->offset)
+		return 1;
+	else
+		return 0;
+}
+#endif /* ] */
+
+boolean IsQueueNodeWithoutDestructor(queue_type_t queue_type)
+{ //return TRUE if DestroyQueueNode() has no work for a queue node of queue type other than releasing its memory
+	/* Note that this must agree with the case statements of DestroyQueueNode() */
 	switch(queue_type)
 	{
-	case QTYPE_SCHEDULE: 
-		p = (queue_node_t*) calloc(1, sizeof(schedule_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(schedule_queue_node_t));
+	case QTYPE_VERTEX_SET:
+	case QTYPE_EDGE:
+	case QTYPE_DIRECTIONAL_EDGE:
+	case QTYPE_DELAY:
+	case QTYPE_CONVOY:
+	case QTYPE_VEHICLE:
+	case QTYPE_VEHICLE_MOVEMENT:
+	case QTYPE_DESTINATION_VEHICLE:
+	case QTYPE_ACCESS_POINT:
+	case QTYPE_PACKET:
+	case QTYPE_FORWARDING_TABLE:
+	case QTYPE_STATIONARY_NODE:
+	case QTYPE_PROBABILITY_AND_STATISTICS:
+	case QTYPE_MINIMUM_PRIORITY:
+	case QTYPE_ADJACENCY_LIST:
+	case QTYPE_GLOBAL_PACKET:
+		return FALSE;
+
+	default:
+		return TRUE;
+	}
+}
+
+void FreeQueueNodeSlabs()
+{ //free the chunks of the slabs whose queue nodes are all released
+	queue_node_slab_t *slab = NULL;
+	queue_node_slab_chunk_header_t *chunk = NULL;
+	int i;
+
+	for(i = 0; i < QUEUE_TYPE_NUMBER; i++)
+	{
+		slab = &(queue_node_slab_table[i]);
+
+		/* the chunks of a slab with live queue nodes are kept because those nodes may still be referenced */
+		if(slab->live_count > 0)
+			continue;
+
+		while(slab->chunk_list != NULL)
+		{
+			chunk = (queue_node_slab_chunk_header_t*)slab->chunk_list;
+			slab->chunk_list = chunk->next;
+			free(chunk);
+		}
+
+		slab->free_list = NULL;
+		slab->chunk_cursor = slab->chunk_end = NULL;
+		slab->chunk_count = 0;
+	}
+}
+
+void ReportQueueNodeAllocationStatistics(FILE *fp)
+{ //report the allocation counters of the queue node slabs per queue type
+	queue_node_slab_t *slab = NULL;
+	int i;
+
+	for(i = 0; i < QUEUE_TYPE_NUMBER; i++)
+	{
+		slab = &(queue_node_slab_table[i]);
+		if(slab->allocation_count == 0)
+			continue;
+
+		fprintf(fp, "queue_node_slab[%d]: node_size=%u, allocated=%lu, released=%lu, reused=%lu, spliced_queues=%lu, live=%lu, peak_live=%lu, chunks=%lu\n", i, (unsigned int)slab->node_size, slab->allocation_count, slab->release_count, slab->reuse_count, slab->splice_count, slab->live_count, slab->peak_live_count, slab->chunk_count);
+	}
+}
+
+/** Note3: whenever we support another queue type, we need to add another case statement for it */
+size_t SizeofQueueNode(queue_type_t queue_type)
+{ //return the size of the queue node corresponding to queue type
+	size_t size = 0;
+
+	switch(queue_type)
+	{
+	case QTYPE_SCHEDULE:
+		size = sizeof(schedule_queue_node_t);
 		break;
 
-	case QTYPE_SENSOR: 
-		p = (queue_node_t*) calloc(1, sizeof(sensor_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(sensor_queue_node_t));
+	case QTYPE_SENSOR:
+		size = sizeof(sensor_queue_node_t);
 		break;
 
-	case QTYPE_PATH: 
-		p = (queue_node_t*) calloc(1, sizeof(path_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(path_queue_node_t));
+	case QTYPE_PATH:
+		size = sizeof(path_queue_node_t);
 		break;
 
-	case QTYPE_EDGE: 
-		p = (queue_node_t*) calloc(1, sizeof(edge_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(edge_queue_node_t));
+	case QTYPE_EDGE:
+		size = sizeof(edge_queue_node_t);
 		break;
 
-	case QTYPE_SUBEDGE: 
-		p = (queue_node_t*) calloc(1, sizeof(subedge_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(subedge_queue_node_t));
+	case QTYPE_SUBEDGE:
+		size = sizeof(subedge_queue_node_t);
 		break;
 
-	case QTYPE_LOCATION: 
-		p = (queue_node_t*) calloc(1, sizeof(location_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(location_queue_node_t));
+	case QTYPE_LOCATION:
+		size = sizeof(location_queue_node_t);
 		break;
 
-	case QTYPE_HOLE_SEGMENT: 
-		p = (queue_node_t*) calloc(1, sizeof(hole_segment_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(hole_segment_queue_node_t));
+	case QTYPE_HOLE_SEGMENT:
+		size = sizeof(hole_segment_queue_node_t);
 		break;
 
-	case QTYPE_HOLE_ENDPOINT: 
-		p = (queue_node_t*) calloc(1, sizeof(hole_endpoint_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(hole_endpoint_queue_node_t));
+	case QTYPE_HOLE_ENDPOINT:
+		size = sizeof(hole_endpoint_queue_node_t);
 		break;
 
 	case QTYPE_VERTEX_SET:
-		p = (queue_node_t*) calloc(1, sizeof(vertex_set_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(vertex_set_queue_node_t));
+		size = sizeof(vertex_set_queue_node_t);
 		break;
 
 	case QTYPE_EDGE_SET:
-		p = (queue_node_t*) calloc(1, sizeof(edge_set_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(edge_set_queue_node_t));
+		size = sizeof(edge_set_queue_node_t);
 		break;
 
 	case QTYPE_ANGLE:
-		p = (queue_node_t*) calloc(1, sizeof(angle_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(angle_queue_node_t));
+		size = sizeof(angle_queue_node_t);
 		break;
 
 	case QTYPE_DIRECTIONAL_EDGE:
-		p = (queue_node_t*) calloc(1, sizeof(directional_edge_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(directional_edge_queue_node_t));
+		size = sizeof(directional_edge_queue_node_t);
 		break;
 
 	case QTYPE_DELAY_COMPONENT:
-		p = (queue_node_t*) calloc(1, sizeof(delay_component_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(delay_component_queue_node_t));
+		size = sizeof(delay_component_queue_node_t);
 		break;
 
 	case QTYPE_DELAY:
-		p = (queue_node_t*) calloc(1, sizeof(delay_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(delay_queue_node_t));
+		size = sizeof(delay_queue_node_t);
 		break;
 
 	case QTYPE_PACKET:
-		p = (queue_node_t*) calloc(1, sizeof(packet_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(packet_queue_node_t));
+		size = sizeof(packet_queue_node_t);
 		break;
 
 	case QTYPE_VEHICLE:
-		p = (queue_node_t*) calloc(1, sizeof(vehicle_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(vehicle_queue_node_t));
+		size = sizeof(vehicle_queue_node_t);
 		break;
 
 	case QTYPE_VEHICLE_MOVEMENT:
-		p = (queue_node_t*) calloc(1, sizeof(vehicle_movement_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(vehicle_movement_queue_node_t));
+		size = sizeof(vehicle_movement_queue_node_t);
 		break;
 
 	case QTYPE_INTERSECTION_EDD:
-		p = (queue_node_t*) calloc(1, sizeof(intersection_edd_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(intersection_edd_queue_node_t));	  
+		size = sizeof(intersection_edd_queue_node_t);
 		break;
 
 	case QTYPE_CONVOY:
-		p = (queue_node_t*) calloc(1, sizeof(convoy_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(convoy_queue_node_t));
+		size = sizeof(convoy_queue_node_t);
 		break;
 
 	case QTYPE_MOBILITY:
-		p = (queue_node_t*) calloc(1, sizeof(mobility_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(mobility_queue_node_t));
+		size = sizeof(mobility_queue_node_t);
 		break;
 
 	case QTYPE_DESTINATION_VEHICLE:
-		p = (queue_node_t*) calloc(1, sizeof(destination_vehicle_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(destination_vehicle_queue_node_t));
+		size = sizeof(destination_vehicle_queue_node_t);
 		break;
 
 	case QTYPE_ACCESS_POINT:
-		p = (queue_node_t*) calloc(1, sizeof(access_point_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(access_point_queue_node_t));
+		size = sizeof(access_point_queue_node_t);
 		break;
 
 	case QTYPE_VEHICLE_TRAJECTORY:
-		p = (queue_node_t*) calloc(1, sizeof(vehicle_trajectory_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(vehicle_trajectory_queue_node_t));
+		size = sizeof(vehicle_trajectory_queue_node_t);
 		break;
 
 	case QTYPE_CARRIER_TRACE:
-		p = (queue_node_t*) calloc(1, sizeof(carrier_trace_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(carrier_trace_queue_node_t));
+		size = sizeof(carrier_trace_queue_node_t);
 		break;
 
 	case QTYPE_FORWARDING_TABLE:
-		p = (queue_node_t*) calloc(1, sizeof(forwarding_table_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(forwarding_table_queue_node_t));
+		size = sizeof(forwarding_table_queue_node_t);
 		break;
 
 	case QTYPE_GLOBAL_PACKET:
-		p = (queue_node_t*) calloc(1, sizeof(global_packet_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(global_packet_queue_node_t));
-	    break;
+		size = sizeof(global_packet_queue_node_t);
+		break;
 
 	case QTYPE_STATIONARY_NODE:
-		p = (queue_node_t*) calloc(1, sizeof(stationary_node_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(stationary_node_queue_node_t));
-	    break;
+		size = sizeof(stationary_node_queue_node_t);
+		break;
 
 	case QTYPE_PACKET_TRAJECTORY:
-		p = (queue_node_t*) calloc(1, sizeof(packet_trajectory_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(packet_trajectory_queue_node_t));
-	    break;
+		size = sizeof(packet_trajectory_queue_node_t);
+		break;
 
 	case QTYPE_PROBABILITY_AND_STATISTICS:
-		p = (queue_node_t*) calloc(1, sizeof(probability_and_statistics_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(probability_and_statistics_queue_node_t));
-	    break;
+		size = sizeof(probability_and_statistics_queue_node_t);
+		break;
 
 	case QTYPE_CONDITIONAL_FORWARDING_PROBABILITY:
-		p = (queue_node_t*) calloc(1, sizeof(conditional_forwarding_probability_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(conditional_forwarding_probability_queue_node_t));
-	    break;
+		size = sizeof(conditional_forwarding_probability_queue_node_t);
+		break;
 
 	case QTYPE_TARGET_POINT:
-		p = (queue_node_t*) calloc(1, sizeof(target_point_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(target_point_queue_node_t));
-	    break;
+		size = sizeof(target_point_queue_node_t);
+		break;
 
 	case QTYPE_MINIMUM_PRIORITY:
-		p = (queue_node_t*) calloc(1, sizeof(minimum_priority_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(minimum_priority_queue_node_t));
-	    break;
+		size = sizeof(minimum_priority_queue_node_t);
+		break;
 
 	case QTYPE_NEIGHBOR_LIST:
-		p = (queue_node_t*) calloc(1, sizeof(neighbor_list_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(neighbor_list_queue_node_t));
-	    break;
+		size = sizeof(neighbor_list_queue_node_t);
+		break;
 
 	case QTYPE_PARENT_LIST:
-		p = (queue_node_t*) calloc(1, sizeof(parent_list_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(parent_list_queue_node_t));
-	    break;
+		size = sizeof(parent_list_queue_node_t);
+		break;
 
 	case QTYPE_ADJACENCY_LIST:
-		p = (queue_node_t*) calloc(1, sizeof(adjacency_list_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(adjacency_list_queue_node_t));
-	    break;
+		size = sizeof(adjacency_list_queue_node_t);
+		break;
 
 	case QTYPE_ADJACENCY_LIST_POINTER:
-		p = (queue_node_t*) calloc(1, sizeof(adjacency_list_pointer_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(adjacency_list_pointer_queue_node_t));
-	    break;
+		size = sizeof(adjacency_list_pointer_queue_node_t);
+		break;
 
 	case QTYPE_PACKET_POINTER:
-		p = (queue_node_t*) calloc(1, sizeof(packet_pointer_queue_node_t));
-		assert_memory(p);
-		memcpy(p, node, sizeof(packet_pointer_queue_node_t));
+		size = sizeof(packet_pointer_queue_node_t);
 		break;
 
 	default:
@@ -417,6 +606,17 @@ queue_node_t* MakeQueueNode(queue_type_t queue_type, queue_node_t *node)
 		exit(1);
 	}
 
+	return size;
+}
+
+queue_node_t* MakeQueueNode(queue_type_t queue_type, queue_node_t *node)
+{ //make a queue node corresponding to queue type and copy the data of node into its data portion
+	queue_node_t *p = NULL;
+	size_t size = SizeofQueueNode(queue_type); //size of the queue node
+
+	p = AllocateQueueNode(queue_type);
+	memcpy(p, node, size);
+
 	return p;
 }
 
@@ -454,8 +654,15 @@ queue_node_t* Enqueue(queue_t *Q, queue_node_t *node)
 		((edge_set_queue_node_t*)p)->representative = (edge_set_queue_node_t*)Q->head.next;
 		break;
 
-	case QTYPE_VEHICLE_MOVEMENT: //let the vehicle_movement_queue_node's ptr_queue point to its vehicle_movement_queue
+	case QTYPE_VEHICLE_MOVEMENT: //let the vehicle_movement_queue_node's ptr_queue point to its vehicle_movement_queue and register the node in the offset index
 	        ((vehicle_movement_queue_node_t*)p)->ptr_queue = (vehicle_movement_queue_t*)Q;
+	        ((vehicle_movement_queue_node_t*)p)->sequence = (((vehicle_movement_queue_t*)Q)->sequence_number)++;
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	        InsertVehicleMovementIntoOffsetIndex((vehicle_movement_queue_t*)Q, (vehicle_movement_queue_node_t*)p);
+#endif /* ] */
+#if CONVOY_LAZY_SORT_FLAG /* [ */
+	        ((vehicle_movement_queue_t*)Q)->descent_count += IsVehicleMovementDescent((vehicle_movement_queue_t*)Q, (vehicle_movement_queue_node_t*)p->prev);
+#endif /* ] */
 	        break;
 
 	case QTYPE_CONVOY:
@@ -495,6 +702,12 @@ queue_node_t* Enqueue(queue_t *Q, queue_node_t *node)
 		/* initialize packet_trajectory queue for the packet trajectory */
 		InitQueue((queue_t*) &(((packet_queue_node_t*)p)->packet_trajectory), QTYPE_PACKET_TRAJECTORY);
                
+#if PACKET_COPY_ON_WRITE_FLAG /* [ */
+		/* a copy of a packet shares the predicted encounter graph of the packet until either of them rebuilds it */
+		if(TPD_Share_Predicted_Encounter_Graph_For_Packet((packet_queue_node_t*)p))
+			break;
+#endif /* ] */
+
 		/* allocate the memory of a predicted encounter graph for a packet */
 		TPD_Allocate_Predicted_Encounter_Graph_For_Packet((packet_queue_node_t*)p);
 		break;
@@ -503,6 +716,9 @@ queue_node_t* Enqueue(queue_t *Q, queue_node_t *node)
 	        ((vehicle_trajectory_queue_node_t*)p)->ptr_queue = (vehicle_trajectory_queue_t*)Q;
                 ((vehicle_trajectory_queue_node_t*)p)->order =  Q->size - 1;
 
+		/* let the prefix sums along the trajectory be rebuilt at the next query */
+		((vehicle_trajectory_queue_t*)Q)->prefix_sum.valid_flag = FALSE;
+
 		/* let the current_order_qnode point to the first queue node */
 		if(Q->size == 1)
 		{
@@ -529,6 +745,9 @@ queue_node_t* Enqueue(queue_t *Q, queue_node_t *node)
 	case QTYPE_GLOBAL_PACKET:
 	        ((global_packet_queue_node_t*)p)->ptr_queue = (global_packet_queue_t*)Q;
                 ((global_packet_queue_node_t*)p)->order =  Q->size - 1;
+
+		/* initialize the packet pointer list for the packet copies */
+		InitQueue((queue_t*) &(((global_packet_queue_node_t*)p)->packet_pointer_list), QTYPE_PACKET_POINTER);
 		break;
 
 	case QTYPE_STATIONARY_NODE:
@@ -637,8 +856,15 @@ queue_node_t* Enqueue_With_QueueNodePointer(queue_t *Q, queue_node_t *p)
 		((edge_set_queue_node_t*)p)->representative = (edge_set_queue_node_t*)Q->head.next;
 		break;
 
-	case QTYPE_VEHICLE_MOVEMENT: //let the vehicle_movement_queue_node's ptr_queue point to its vehicle_movement_queue
+	case QTYPE_VEHICLE_MOVEMENT: //let the vehicle_movement_queue_node's ptr_queue point to its vehicle_movement_queue and register the node in the offset index
 	        ((vehicle_movement_queue_node_t*)p)->ptr_queue = (vehicle_movement_queue_t*)Q;
+	        ((vehicle_movement_queue_node_t*)p)->sequence = (((vehicle_movement_queue_t*)Q)->sequence_number)++;
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	        InsertVehicleMovementIntoOffsetIndex((vehicle_movement_queue_t*)Q, (vehicle_movement_queue_node_t*)p);
+#endif /* ] */
+#if CONVOY_LAZY_SORT_FLAG /* [ */
+	        ((vehicle_movement_queue_t*)Q)->descent_count += IsVehicleMovementDescent((vehicle_movement_queue_t*)Q, (vehicle_movement_queue_node_t*)p->prev);
+#endif /* ] */
 	        break;
 
 	case QTYPE_CONVOY:
@@ -680,6 +906,9 @@ queue_node_t* Enqueue_With_QueueNodePointer(queue_t *Q, queue_node_t *p)
 	        ((vehicle_trajectory_queue_node_t*)p)->ptr_queue = (vehicle_trajectory_queue_t*)Q;
                 ((vehicle_trajectory_queue_node_t*)p)->order =  Q->size - 1;
 
+		/* let the prefix sums along the trajectory be rebuilt at the next query */
+		((vehicle_trajectory_queue_t*)Q)->prefix_sum.valid_flag = FALSE;
+
 		/* let the current_order_qnode point to the first queue node */
 		if(Q->size == 1)
 		{
@@ -801,7 +1030,7 @@ queue_node_t* Enqueue_By_KeyAscendingOrder(queue_t *Q, queue_node_t *node)
 		printf("%s:%d queue type(%d) is not supported!\n",
 				__FUNCTION__, __LINE__,
 				Q->type);
-		free(p);
+		FreeQueueNode(Q->type, p);
 		exit(1);	
 	}
 
@@ -920,6 +1149,9 @@ queue_node_t* Dequeue(queue_t *Q)
 		break;
 
 	case QTYPE_VEHICLE_TRAJECTORY: //update the pointer to the first queue node
+		/* let the prefix sums along the trajectory be rebuilt at the next query */
+		((vehicle_trajectory_queue_t*)Q)->prefix_sum.valid_flag = FALSE;
+
 		/* let the current_order_qnode point to the first queue node */
 		//if(Q->size > 0)
 		//{
@@ -979,6 +1211,9 @@ queue_node_t* Dequeue_With_QueueNodePointer(queue_t *Q, queue_node_t *p)
 		break;
 
 	case QTYPE_VEHICLE_TRAJECTORY: //update the pointer to the first queue node
+		/* let the prefix sums along the trajectory be rebuilt at the next query */
+		((vehicle_trajectory_queue_t*)Q)->prefix_sum.valid_flag = FALSE;
+
 		/* let the current_order_qnode point to the first queue node */
 		//if(Q->size > 0)
 		//{
@@ -998,6 +1233,17 @@ void EmptyQueue(queue_t *Q)
 	if(Q == NULL || Q->size == 0)
 		return;
 
+#if QUEUE_NODE_SLAB_FLAG /* [ */
+	/* release the whole node list in O(1) when its queue nodes have no queue(s) or references to clean up */
+	if(IsQueueNodeWithoutDestructor(Q->type))
+	{
+		SpliceQueueNodesIntoSlab(Q);
+		Q->size = 0;
+		Q->head.next = Q->head.prev = &(Q->head);
+		return;
+	}
+#endif /* ] */
+
 	for(p = Q->head.next; p != &(Q->head);) //for-1
 	{
 		q = p;
@@ -1009,13 +1255,33 @@ void EmptyQueue(queue_t *Q)
 	/* reset Q->size to 0 */
 	Q->size = 0;
 
+	/* perform work specific to queue type */
+	if(Q->type == QTYPE_VEHICLE_MOVEMENT) //empty the offset index while keeping its memory for the next vehicles
+	{
+		((vehicle_movement_queue_t*)Q)->offset_index_size = 0;
+		((vehicle_movement_queue_t*)Q)->descent_count = 0;
+	}
+
 	/* reorganize the pointers in Q */
 	Q->head.next = Q->head.prev = &(Q->head);
 }
 
 void DestroyQueue(queue_t *Q)
 { //destory queue Q
-	if(Q == NULL || Q->size == 0)
+	int i = 0; //for-loop index
+
+	if(Q == NULL)
+		return;
+
+	/* free the offset index of a vehicle movement queue even if no vehicle is on the edge */
+	if(Q->type == QTYPE_VEHICLE_MOVEMENT)
+		FreeVehicleMovementOffsetIndex((vehicle_movement_queue_t*)Q);
+
+	/* free the prefix sums along a vehicle trajectory even if the trajectory is empty */
+	if(Q->type == QTYPE_VEHICLE_TRAJECTORY)
+		Free_Trajectory_PrefixSum(&(((vehicle_trajectory_queue_t*)Q)->prefix_sum));
+
+	if(Q->size == 0)
 		return;
 
 	/* perform work specific to queue type */
@@ -1026,6 +1292,13 @@ void DestroyQueue(queue_t *Q)
 	    {
 	      free(((forwarding_table_queue_t*)Q)->index_table);
 	    }
+
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+	    /* free the shared forwarding graphs */
+	    for(i = 0; i < ((forwarding_table_queue_t*)Q)->graph_set_size; i++)
+	      FreeForwardingTableGraph(&(((forwarding_table_queue_t*)Q)->graph_set[i]));
+	    free(((forwarding_table_queue_t*)Q)->graph_set);
+#endif /* ] */
 	    break;
 
 	case QTYPE_GLOBAL_PACKET: //free the memory of packet vectors
@@ -1164,15 +1437,31 @@ void DestroyQueueNode(queue_type_t type, queue_node_t *q)
 		break;
 
 	case QTYPE_FORWARDING_TABLE:
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+		free(((forwarding_table_queue_node_t*)q)->value); //release the per-target values of the shared forwarding graph
+#else
 		Free_Graph(((forwarding_table_queue_node_t*)q)->G, ((forwarding_table_queue_node_t*)q)->G_size); //release the memory allocated to real graph Gr
 		DestroyQueue((queue_t*) &(((forwarding_table_queue_node_t*)q)->EQ)); //delete undirectional edge queue EQ
 		DestroyQueue((queue_t*) &(((forwarding_table_queue_node_t*)q)->DEQ)); //delete directional edge queue DEQ
+#endif /* ] */
 
+#if FORWARDING_TABLE_REVERSE_SHORTEST_PATH_FLAG /* [ */
+		/** deallocate the shortest delay and cost vectors */
+		free(((forwarding_table_queue_node_t*)q)->Dv_edd);
+		free(((forwarding_table_queue_node_t*)q)->Nv_edd);
+		free(((forwarding_table_queue_node_t*)q)->Sv_edd);
+		free(((forwarding_table_queue_node_t*)q)->Dv_edc);
+		free(((forwarding_table_queue_node_t*)q)->Nv_edc);
+		free(((forwarding_table_queue_node_t*)q)->Sv_edc);
+#else
 		/** deallocate the shortest delay matrices */
 		Floyd_Warshall_Free_Matrices_For_EDD(&(((forwarding_table_queue_node_t*)q)->Dr_edd), &(((forwarding_table_queue_node_t*)q)->Mr_edd), &(((forwarding_table_queue_node_t*)q)->Sr_edd), &(((forwarding_table_queue_node_t*)q)->matrix_size_for_edd_in_Gr));
+		Floyd_Warshall_Free_Weight_Matrices_For_Incremental_Update(&(((forwarding_table_queue_node_t*)q)->Dr_edd_weight), &(((forwarding_table_queue_node_t*)q)->Sr_edd_weight), &(((forwarding_table_queue_node_t*)q)->node_number_for_edd_weight_in_Gr));
 
 		/** deallocate the shortest cost matrices */
 		Floyd_Warshall_Free_Matrices_For_EDC(&(((forwarding_table_queue_node_t*)q)->Wr_edc), &(((forwarding_table_queue_node_t*)q)->Dr_edc), &(((forwarding_table_queue_node_t*)q)->Mr_edc), &(((forwarding_table_queue_node_t*)q)->Sr_edc), &(((forwarding_table_queue_node_t*)q)->matrix_size_for_edc_in_Gr));
+		Floyd_Warshall_Free_Weight_Matrices_For_Incremental_Update(&(((forwarding_table_queue_node_t*)q)->Dr_edc_weight), &(((forwarding_table_queue_node_t*)q)->Sr_edc_weight), &(((forwarding_table_queue_node_t*)q)->node_number_for_edc_weight_in_Gr));
+#endif /* ] */
 		break;
 
 	case QTYPE_STATIONARY_NODE:
@@ -1193,6 +1482,9 @@ void DestroyQueueNode(queue_type_t type, queue_node_t *q)
 		break;
 
 	case QTYPE_GLOBAL_PACKET: //delete the packet pointer queue
+#if PACKET_COPY_ON_WRITE_FLAG /* [ */
+		Empty_PacketPointerList((global_packet_queue_node_t*)q);
+#endif /* ] */
 		DestroyQueue((queue_t*)&((global_packet_queue_node_t*)q)->packet_pointer_list);
 		//delete packet_pointer_list 
 		break;
@@ -1201,8 +1493,8 @@ void DestroyQueueNode(queue_type_t type, queue_node_t *q)
 		break;
 	} //end of switch
 
-	/* free the memory of q */
-	free(q);
+	/* release the memory of q to its slab */
+	FreeQueueNode(type, q);
 }
 
 int SizeofQueue(queue_t *Q)
@@ -1502,7 +1794,7 @@ void SortVehicleMovementQueues_In_Graph(struct_graph_node *G, int G_size)
 
 		while(ptr != NULL)
 		{
-			j = atoi(ptr->vertex) - 1; 
+			j = ptr->vertex_id - 1; 
 			//node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
                         SortVehicleMovementQueue(&(ptr->ptr_directional_edge_node->vehicle_movement_list));
                         //sort vehicle movement queue nodes in ascending order according to vehicle's offset in the directional edge <v_i,v_j>
@@ -1558,11 +1850,154 @@ void RearrangeVehicleMovementQueue(vehicle_movement_queue_t* Q, vehicle_movement
 		/* set the order of the queue node according to its vehicle offset */
 		p->order = i;
 
+		/* renumber the sequence along the new list order */
+		p->sequence = i;
+
 		p->prev = Q->head.prev;
 		p->next = &(Q->head);
 		Q->head.prev->next = p;
 		Q->head.prev = p;
 	}
+
+	Q->sequence_number = vehicle_num;
+
+#if CONVOY_LAZY_SORT_FLAG /* [ */
+	/* the list is now in ascending order of offset */
+	Q->descent_count = 0;
+#endif /* ] */
+}
+
+void UpdateVehicleMovementOffset(vehicle_movement_queue_node_t *p, double offset)
+{ //set the offset of vehicle movement queue node p to offset and move p to its place in the offset index of its vehicle movement queue
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	vehicle_movement_queue_node_t **A = NULL; //offset index
+	int size = 0; //number of nodes in the offset index
+	int i = 0; //position of p in the offset index
+#endif /* ] */
+
+#if CONVOY_LAZY_SORT_FLAG /* [ */
+	/* take p's pairs with its neighbors out of the descent count before the offset changes and put them back after */
+	if(p->ptr_queue != NULL)
+		p->ptr_queue->descent_count -= IsVehicleMovementDescent(p->ptr_queue, p->prev) + IsVehicleMovementDescent(p->ptr_queue, p);
+#endif /* ] */
+
+	p->offset = offset;
+
+#if CONVOY_LAZY_SORT_FLAG /* [ */
+	if(p->ptr_queue != NULL)
+		p->ptr_queue->descent_count += IsVehicleMovementDescent(p->ptr_queue, p->prev) + IsVehicleMovementDescent(p->ptr_queue, p);
+#endif /* ] */
+
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	if(p->ptr_queue == NULL)
+		return;
+
+	A = p->ptr_queue->offset_index;
+	size = p->ptr_queue->offset_index_size;
+	i = p->offset_index_position;
+
+	/* since a vehicle moves little between two updates, swap p with its neighbors until the order is restored */
+	while(i > 0 && A[i-1]->offset > offset)
+	{
+		A[i] = A[i-1];
+		A[i]->offset_index_position = i;
+		i--;
+	}
+
+	while(i < size - 1 && A[i+1]->offset < offset)
+	{
+		A[i] = A[i+1];
+		A[i]->offset_index_position = i;
+		i++;
+	}
+
+	A[i] = p;
+	p->offset_index_position = i;
+#endif /* ] */
+}
+
+int GetVehicleMovementsInOffsetRange(vehicle_movement_queue_t *Q, double lower_offset, double upper_offset, vehicle_movement_queue_node_t ***A)
+{ //get the vehicle movement queue nodes of Q whose offsets are in [lower_offset, upper_offset] into array *A in the order of the vehicle movement list and return the number of them; the caller frees *A
+	vehicle_movement_queue_node_t *p = NULL; //pointer to a vehicle movement queue node
+	int start = 0, end = 0; //range of the positions in the offset index
+	int low = 0, high = 0, mid = 0; //indices for binary search
+	int n = 0; //number of the nodes in the range
+	int i = 0, j = 0; //indices for for-loops
+
+	*A = NULL;
+
+	/* widen the range so that the caller's own distance check decides the nodes on the boundary */
+	lower_offset -= VEHICLE_MOVEMENT_OFFSET_INDEX_RANGE_MARGIN;
+	upper_offset += VEHICLE_MOVEMENT_OFFSET_INDEX_RANGE_MARGIN;
+
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	/* find the first position whose offset is not less than lower_offset */
+	low = 0;
+	high = Q->offset_index_size;
+	while(low < high)
+	{
+		mid = (low + high)/2;
+		if(Q->offset_index[mid]->offset < lower_offset)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	start = low;
+
+	/* find the first position whose offset is greater than upper_offset */
+	high = Q->offset_index_size;
+	while(low < high)
+	{
+		mid = (low + high)/2;
+		if(Q->offset_index[mid]->offset <= upper_offset)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	end = low;
+
+	n = end - start;
+	if(n <= 0)
+		return 0;
+
+	*A = (vehicle_movement_queue_node_t**) malloc(n*sizeof(vehicle_movement_queue_node_t*));
+	assert_memory(*A);
+
+	/* sort the nodes in the range by their sequence numbers with insertion sort since the range has a few nodes */
+	for(i = 0; i < n; i++)
+	{
+		p = Q->offset_index[start + i];
+		for(j = i; j > 0 && (*A)[j-1]->sequence > p->sequence; j--)
+			(*A)[j] = (*A)[j-1];
+		(*A)[j] = p;
+	}
+#else
+	/* scan the vehicle movement list */
+	*A = (vehicle_movement_queue_node_t**) malloc(MAX(Q->size, 1)*sizeof(vehicle_movement_queue_node_t*));
+	assert_memory(*A);
+
+	p = &(Q->head);
+	for(i = 0; i < Q->size; i++)
+	{
+		p = p->next;
+		if(p->offset >= lower_offset && p->offset <= upper_offset)
+			(*A)[n++] = p;
+	}
+#endif /* ] */
+
+	return n;
+}
+
+void FreeVehicleMovementOffsetIndex(vehicle_movement_queue_t *Q)
+{ //free the offset index of vehicle movement queue Q
+	if(Q->offset_index != NULL)
+	{
+		free(Q->offset_index);
+		Q->offset_index = NULL;
+	}
+
+	Q->offset_index_size = 0;
+	Q->offset_index_capacity = 0;
 }
 
 void SortVehicleQueue(vehicle_queue_t* Q)
@@ -1571,6 +2006,23 @@ void SortVehicleQueue(vehicle_queue_t* Q)
 	vehicle_queue_node_t **A; //array of vehicle queue node pointers
 	vehicle_queue_node_t *pQueueNode = NULL; //pointer to a vehicle queue node
 	int i; //index for for-loop
+#if CONVOY_LAZY_SORT_FLAG /* [ */
+	boolean sorted_flag = TRUE; //flag to indicate whether the nodes are already in ascending order of offset
+
+	/* refresh the offsets and the orders along the list; if no node has a smaller offset than its previous node, the quick sort would keep this list as it is */
+	pQueueNode = &(Q->head);
+	for(i = 0; i < vehicle_num; i++)
+	{
+		pQueueNode = pQueueNode->next;
+		pQueueNode->offset = pQueueNode->vnode->current_pos_in_digraph.offset;
+		pQueueNode->order = i;
+		if(i > 0 && pQueueNode->prev->offset > pQueueNode->offset)
+			sorted_flag = FALSE;
+	}
+
+	if(sorted_flag)
+		return;
+#endif /* ] */
 
 	/* generate vehicle queue node array containing pointers to all of the nodes in vehicle queue */
 	A = (vehicle_queue_node_t**) calloc(vehicle_num, sizeof(vehicle_queue_node_t*));
@@ -2237,7 +2689,7 @@ void DeleteSubedgeWithEID(subedge_queue_t *Q, int eid)
 
 	Q->size--;
 
-	free(pSubedgeNode);
+	FreeQueueNode(Q->type, (queue_node_t*)pSubedgeNode);
 }
 
 subedge_queue_node_t* GetSubedgeNodeByEID(subedge_queue_t *Q, int eid)
@@ -2504,7 +2956,7 @@ void DeleteHoleEndpointWithEID(hole_endpoint_queue_t *H, int eid, char *node)
 
 	H->size--;
 
-	free(pHoleNode);
+	FreeQueueNode(H->type, (queue_node_t*)pHoleNode);
 }
 
 void UpdateHoleEndpointEID(hole_endpoint_queue_t *H, int old_eid, char *node, int new_eid)
@@ -2606,7 +3058,7 @@ void DeleteVehicleWithVID(vehicle_queue_t *Q, int vid)
 
 	Q->size--;
 
-	free(pQueueNode);
+	FreeQueueNode(Q->type, (queue_node_t*)pQueueNode);
 }
 
 void DeleteVehicleMovementWithVID(vehicle_movement_queue_t *Q, int vid)
@@ -2633,9 +3085,18 @@ void DeleteVehicleMovementWithVID(vehicle_movement_queue_t *Q, int vid)
 		{
 			p = pQueueNode->prev; //p points to the previous node of the node pointed by pQueueNode;
 
+#if CONVOY_LAZY_SORT_FLAG /* [ */
+			/* replace pQueueNode's pairs with its neighbors by the pair of its neighbors in the descent count */
+			Q->descent_count -= IsVehicleMovementDescent(Q, p) + IsVehicleMovementDescent(Q, pQueueNode);
+#endif /* ] */
+
 			/* link the node before pQueueNode's node and the node after pQueueuNode's node each other */
 			p->next = pQueueNode->next;
 			pQueueNode->next->prev = p;
+
+#if CONVOY_LAZY_SORT_FLAG /* [ */
+			Q->descent_count += IsVehicleMovementDescent(Q, p);
+#endif /* ] */
 			break;
 		}
 	}
@@ -2649,7 +3110,11 @@ void DeleteVehicleMovementWithVID(vehicle_movement_queue_t *Q, int vid)
 
 	Q->size--;
 
-	free(pQueueNode);
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	DeleteVehicleMovementFromOffsetIndex(Q, pQueueNode);
+#endif /* ] */
+
+	FreeQueueNode(Q->type, (queue_node_t*)pQueueNode);
 }
 
 void DeleteConvoyWithCID(convoy_queue_t *Q, int cid)
@@ -2696,17 +3161,156 @@ void DeleteConvoyWithCID(convoy_queue_t *Q, int cid)
 	if(pQueueNode->vehicle_list.size > 0)
 	  DestroyQueue((queue_t*) &(pQueueNode->vehicle_list));
 
-	free(pQueueNode);
+	FreeQueueNode(Q->type, (queue_node_t*)pQueueNode);
 }
 
-void MergeTwoConvoys(convoy_queue_t *Q1, convoy_queue_t *Q2)
-{ //merge two convoys moving one the same directional edge into one convoy and delete one between the merged convoys from the convoy queue for the directional edge; note that the new convoy's id is equal to one whose cid is smaller and the convoy with the bigger is deleted
+void MergeTwoConvoys(parameter_t *param, double merge_time, convoy_queue_node_t *src_convoy, convoy_queue_node_t *dst_convoy)
+{ //concatenate src_convoy's vehicle list into dst_convoy's vehicle list, delete src_convoy from its convoy queue and set dst_convoy's head, tail and leader; note that dst_convoy's id becomes the id of its new head vehicle
+	convoy_queue_t *CQ = src_convoy->ptr_queue; //pointer to convoy queue
+	int src_size = src_convoy->vehicle_list.size; //size of the vehicle list in src_convoy
+	vehicle_queue_node_t *src_head = &(src_convoy->vehicle_list.head); //pointer to the head node the vehicle list in src_convoy
+	vehicle_queue_node_t *dst_head = &(dst_convoy->vehicle_list.head); //pointer to the head node the vehicle list in dst_convoy
+	vehicle_queue_node_t *pVehicleNode = NULL; //pointer to vehicle queue node
+	int i = 0; //index for for-loop
+
+	/** concatenate src_convoy's vehicle_list into dst_convoy's vehicle_list */
+	/* link dst_head's rear node and src_head's front node */
+	dst_head->prev->next = src_head->next;
+	src_head->next->prev = dst_head->prev;
+
+	/* link dst_head and src_head's rear node */
+	dst_head->prev = src_head->prev;
+	src_head->prev->next = dst_head;
+
+	/** adjust the pointer to the convoy queue node for each vehicle in src_convoy */
+	pVehicleNode = src_head;
+	for(i = 0; i < src_size; i++)
+	{
+		pVehicleNode = pVehicleNode->next;
+		pVehicleNode->vnode->ptr_convoy_queue_node = dst_convoy;
+		pVehicleNode->vnode->convoy_join_time = merge_time;
+	}
+
+	/** update the size of the vehicle list in dst_convoy and src_convoy */
+	dst_convoy->vehicle_list.size += src_size;
+	src_convoy->vehicle_list.size = 0;
+
+	/* reset src_head->prev and src_head->next to src_head */
+	src_head->prev = src_head;
+	src_head->next = src_head;
+
+	/** delete src_convoy */
+	DeleteConvoyWithCID(CQ, src_convoy->cid);
+
+	/** update the convoy head, tail and leader */
+	/* sort dst_convoy's vehicle list in ascending order of offset */
+	SortVehicleQueue(&(dst_convoy->vehicle_list));
+
+	/* set the convoy head to the rear vehicle in vehicle list and update the convoy's id (i.e., cid) with the new head vehicle's id */
+	dst_convoy->head_vehicle = dst_convoy->vehicle_list.head.prev->vnode;
+	dst_convoy->cid = dst_convoy->head_vehicle->id;
+
+	/* set the convoy tail to the front vehicle in vehicle list */
+	dst_convoy->tail_vehicle = dst_convoy->vehicle_list.head.next->vnode;
 
+	/* set the convoy leader to the vehicle with minimum EDD in vehicle list */
+	Set_NewConvoyLeader(param, dst_convoy); //find a vehicle with minimum EDD as the convoy's new leader in dst_convoy
 }
 
-void SplitConvoy(convoy_queue_t *Q)
-{ //split one convoy into two convoys moving one the same directional edge and register these two convoys into the convoy queue for the directional edge; note that one convoy's id the same as the original one's and another convoy's is set to a unique cid
+convoy_queue_node_t* SplitConvoy(parameter_t *param, double split_time, convoy_queue_node_t *src_convoy, struct_vehicle_t *vehicle)
+{ //split src_convoy into two convoys on the same directional edge by using vehicle as the boundary: the vehicles up to vehicle in ascending order of offset move into a new convoy registered into src_convoy's convoy queue with vehicle as its head and vehicle's id as its cid, and src_convoy keeps the vehicles ahead of vehicle; this returns the new convoy
+	convoy_queue_t *CQ = src_convoy->ptr_queue; //pointer to convoy queue
+	vehicle_queue_node_t *convoy_1_head = &(src_convoy->vehicle_list.head); //pointer to the head for dst_convoy_1's vehicle list where dst_convoy_1 is the convoy consisting of vehicles preceding vehicle
+	vehicle_queue_node_t *convoy_2_head = NULL; //pointer to the head for dst_convoy_2's vehicle list where dst_convoy_2 is the convoy consisting of vehicles following vehicle along with vehicle
+	vehicle_queue_node_t *convoy_1_start = NULL; //pointer to the vehicle queue node for the start of the vehicle list of src_convoy after the split
+	convoy_queue_node_t convoy_node; //convoy queue node
+	convoy_queue_node_t *dst_convoy = NULL; //pointer to the destination convoy separated from src_convoy, having vehicle as the convoy head
+	int src_size = src_convoy->vehicle_list.size; //size of the vehicle list in src_convoy
+	vehicle_queue_node_t *src_head = &(src_convoy->vehicle_list.head); //pointer to the head node the vehicle list in src_convoy
+	vehicle_queue_node_t *pVehicleNode = NULL; //pointer to vehicle queue node
+	int i = 0; //index for for-loop
+	int count = 0; //count for the number of dst_convoy_2
+
+	/** sort vehicle list in ascending order of offset */
+	SortVehicleQueue(&(src_convoy->vehicle_list));
+
+	/** split src_convoy into src_convoy and dst_convoy by using vehicle as the convoy head of dst_convoy */
+	/* obtain the pointer to the vehicle queue node corresponding to vehicle */
+	pVehicleNode = src_head;
+	for(i = 0; i < src_size; i++)
+	{
+		pVehicleNode = pVehicleNode->next;
+		count++; //increment count by one
+		if(vehicle->id == pVehicleNode->vnode->id)
+			break;
+	}
+
+	if(i == src_size)
+	{
+		printf("SplitConvoy(): Error: vehicle(id=%d) does not exist in the convoy(cid=%d)\n", vehicle->id, src_convoy->cid);
+		exit(1);
+	}
+
+	/* let convoy_1_start point to the next node of pVehicleNode */
+	convoy_1_start = pVehicleNode->next;
+
+	/**@ Start of the construction of convoy_2 */
+
+	/* make a convoy queue node for dst_convoy_2 and enqueue it into convoy queue CQ */
+	convoy_node.cid = pVehicleNode->vnode->id; //set the new convoy's id with the head vehicle's id
+	convoy_node.tail_vehicle = pVehicleNode->vnode;
+	convoy_node.head_vehicle = pVehicleNode->vnode;
+	convoy_node.leader_vehicle = pVehicleNode->vnode;
+	dst_convoy = (convoy_queue_node_t*)Enqueue((queue_t*)CQ, (queue_node_t*)&convoy_node);
+
+	/* set convoy_2_head to the pointer to the head for dst_convoy_2's vehicle list where dst_convoy_2 is the convoy consisting of vehicles following vehicle along with vehicle */
+	convoy_2_head = &(dst_convoy->vehicle_list.head);
+
+	/* set convoy_2_head where convoy_2 is the convoy consisting of vehicles following vehicle along with vehicle */
+	convoy_2_head->next = src_head->next;
+	convoy_2_head->prev = pVehicleNode;
+
+	/* let the first vehicle node and the last vehicle node point to convoy_2_head */
+	convoy_2_head->next->prev = convoy_2_head;
+	convoy_2_head->prev->next = convoy_2_head;
+
+	/* set dst_convoy->vehicle_list.size to count */
+	dst_convoy->vehicle_list.size = count;
+
+	/**@ End of the construction of convoy_2 */
+
+
+	/**@ Start of the construction of convoy_1 */
+	/* set convoy_1_head where convoy_1 is the convoy consisting of vehicles preceding vehicle */
+	convoy_1_head->next = convoy_1_start; //note that convoy_1_head->next == src_head->next
+
+	/* let the first vehicle node point to convoy_1_head */
+	convoy_1_head->next->prev = convoy_1_head;
+
+	/* set src_convoy->vehicle_list.size to count */
+	src_convoy->vehicle_list.size -= count;
+
+	/**@ End of the construction of convoy_1 */
+
+
+	/** adjust the pointer to the convoy queue node for each vehicle in dst_convoy */
+	pVehicleNode = &(dst_convoy->vehicle_list.head);
+	for(i = 0; i < count; i++)
+	{
+		pVehicleNode = pVehicleNode->next;
+		pVehicleNode->vnode->ptr_convoy_queue_node = dst_convoy;
+		pVehicleNode->vnode->convoy_join_time = split_time;
+	}
+
+	/** adjust the convoy tail and convoy leader of src_convoy */
+	src_convoy->tail_vehicle = src_convoy->vehicle_list.head.next->vnode; //set convoy tail to the first vehicle node in vehicle list
+	Set_NewConvoyLeader(param, src_convoy); //find a vehicle with minimum EDD as the convoy's new leader in src_convoy
+
+	/** adjust the convoy tail and convoy leader of dst_convoy */
+	dst_convoy->tail_vehicle = dst_convoy->vehicle_list.head.next->vnode; //set convoy tail to the first vehicle node in vehicle list
+	Set_NewConvoyLeader(param, dst_convoy); //find a vehicle with minimum EDD as the convoy's new leader in dst_convoy
 
+	return dst_convoy;
 }
 
 convoy_queue_node_t* GetConvoyClosestToVehicle(parameter_t *param, convoy_queue_t *Q, double vehicle_offset)
@@ -3061,7 +3665,7 @@ void DeleteEdgeWithEID(edge_queue_t *Q, int eid)
 
   Q->size--;
 
-  free(pEdgeNode);
+  FreeQueueNode(Q->type, (queue_node_t*)pEdgeNode);
 }
 
 void DeleteDirectionalEdgeWithEID(directional_edge_queue_t *Q, int eid)
@@ -3099,7 +3703,7 @@ void DeleteDirectionalEdgeWithEID(directional_edge_queue_t *Q, int eid)
 
   Q->size--;
 
-  free(pEdgeNode);
+  FreeQueueNode(Q->type, (queue_node_t*)pEdgeNode);
 }
 
 void FastDeleteEdge(edge_queue_t *Q, char *tail_node, char *head_node, struct_graph_node *G)
@@ -3125,7 +3729,7 @@ void FastDeleteEdge(edge_queue_t *Q, char *tail_node, char *head_node, struct_gr
 
   Q->size--;
 
-  free(pEdgeNode);
+  FreeQueueNode(Q->type, (queue_node_t*)pEdgeNode);
 }
 
 void FastDeleteDirectionalEdge(directional_edge_queue_t *Q, char *tail_node, char *head_node, struct_graph_node *G)
@@ -3150,7 +3754,7 @@ void FastDeleteDirectionalEdge(directional_edge_queue_t *Q, char *tail_node, cha
 
   Q->size--;
 
-  free(pEdgeNode);
+  FreeQueueNode(Q->type, (queue_node_t*)pEdgeNode);
 }
 
 destination_vehicle_queue_node_t* GetDestinationVehicleByVID(destination_vehicle_queue_t *Q, int vid)
@@ -3880,7 +4484,7 @@ void Enqueue_CarrierTraceEntry_For_Upload(parameter_t *param, double current_tim
     carrier_trace_qnode.carry_dst_id = packet->carry_dst_id;
 
     /* set the intersection id to vehicle's tail_node, that is, path_ptr->vertex */
-    carrier_trace_qnode.intersection_id = atoi(carrier_vehicle->path_ptr->vertex);
+    carrier_trace_qnode.intersection_id = carrier_vehicle->path_ptr->vertex_id;
 
     carrier_trace_qnode.EDD = carrier_vehicle->EDD;
     carrier_trace_qnode.EDD_SD = carrier_vehicle->EDD_SD;
@@ -3904,7 +4508,7 @@ void Enqueue_CarrierTraceEntry_For_Upload(parameter_t *param, double current_tim
     carrier_trace_qnode.intersection_id = stationary_node->intersection_id;
 
     /* get the EDD and EDD_SD with the stationary node's intersection id and the packet's target point id */
-    src_id = atoi(stationary_node->gnode->vertex);
+    src_id = stationary_node->gnode->vertex_id;
     dst_id = target_point_id;
 
     VADD_Get_EDD_And_EDD_SD_In_Shortest_Path_Model(param, src_id, dst_id, &EDD, &EDD_SD); //get EDD and EDD_SD from src_id to dst_id
@@ -4068,10 +4672,10 @@ void Enqueue_CarrierTraceEntry_For_Download(parameter_t *param, double current_t
     carrier_trace_qnode.carry_dst_id = packet->carry_dst_id;
 
     /* set the intersection id to vehicle's tail_node, that is, path_ptr->vertex */
-    carrier_trace_qnode.intersection_id = atoi(carrier_vehicle->path_ptr->vertex);
+    carrier_trace_qnode.intersection_id = carrier_vehicle->path_ptr->vertex_id;
 
     /* get the EDD and EDD_SD with the stationary node's intersection id and the packet's target point id */
-    src_id = atoi(carrier_vehicle->path_ptr->vertex);
+    src_id = carrier_vehicle->path_ptr->vertex_id;
     dst_id = target_point_id;
 
     VADD_Get_EDD_And_EDD_SD_For_TargetPoint_At_Carrier(param, dst_id, carrier_vehicle, param->vanet_table.FTQ, &EDD, &EDD_SD); //get the EDD and EDD_SD for a target point towards a destination vehicle, based on VADD Model (i.e., Per-intersection Model) from the position of carrier_vehicle, that is, from carrier's edge offset on the road network graph.
@@ -4112,7 +4716,7 @@ void Enqueue_CarrierTraceEntry_For_Download(parameter_t *param, double current_t
     carrier_trace_qnode.intersection_id = stationary_node->intersection_id;
 
     /* get the EDD and EDD_SD with the stationary node's intersection id and the packet's target point id */
-    src_id = atoi(stationary_node->gnode->vertex);
+    src_id = stationary_node->gnode->vertex_id;
     dst_id = target_point_id;
 
     VADD_Get_EDD_And_EDD_SD_In_Shortest_Path_Model(param, src_id, dst_id, &EDD, &EDD_SD); //get EDD and EDD_SD from src_id to dst_id
@@ -4254,10 +4858,10 @@ void Enqueue_CarrierTraceEntry_For_V2V(parameter_t *param, double current_time,
     carrier_trace_qnode.carry_dst_id = packet->carry_dst_id;
 
     /* set the intersection id to vehicle's tail_node, that is, path_ptr->vertex */
-    carrier_trace_qnode.intersection_id = atoi(carrier_vehicle->path_ptr->vertex);
+    carrier_trace_qnode.intersection_id = carrier_vehicle->path_ptr->vertex_id;
 
     /* get the EDD and EDD_SD with the stationary node's intersection id and the packet's target point id */
-    src_id = atoi(carrier_vehicle->path_ptr->vertex);
+    src_id = carrier_vehicle->path_ptr->vertex_id;
     dst_id = target_point_id;
 
     /* set the euclidean_pos to the current Euclidean position of the vehicle */
@@ -4402,6 +5006,98 @@ void DestroyPacketQueueNode(packet_queue_node_t *packet)
 }
 
 /** Forwarding Table Queue Operations */
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+static void MakeForwardingTableGraph(forwarding_table_graph_t *graph, parameter_t *param, struct_graph_node* Gr, int Gr_size)
+{ //make a forwarding graph G along with its edge queue EQ and directional edge queue DEQ to be shared by the forwarding tables
+  /* create a graph G for the data forwarding towards a destination intersection */
+  graph->G = Make_Forwarding_Graph(Gr, Gr_size, &(graph->G_size));
+
+  /* construct an edge queue EQ containing the information of edges in graph G and associate each physical edge with its edge entry */
+  ConstructEdgeQueue(&(graph->EQ), graph->G, graph->G_size, param);
+  AssociateGraphEdgeWithEdgeEntry(graph->G, graph->G_size, &(graph->EQ));
+
+  /* construct a directional edge queue DEQ containing the information of directional edges in graph G and associate each physical edge with its directional edge entry */
+  ConstructDirectionalEdgeQueue(param, &(graph->DEQ), graph->G, graph->G_size);
+  AssociateGraphEdgeWithDirectionalEdgeEntry(graph->G, graph->G_size, &(graph->DEQ));
+
+  graph->intersection_id = 0;
+}
+
+static void FreeForwardingTableGraph(forwarding_table_graph_t *graph)
+{ //free the forwarding graph G along with its edge queue EQ and directional edge queue DEQ
+  Free_Graph(graph->G, graph->G_size);
+  DestroyQueue((queue_t*) &(graph->EQ));
+  DestroyQueue((queue_t*) &(graph->DEQ));
+}
+
+static int CountForwardingTableValues(forwarding_table_graph_t *graph)
+{ //count the graph nodes in the node array and their neighbor lists of the forwarding graph, i.e., the values of a forwarding table
+  struct_graph_node *pGraphNode = NULL; //pointer to a graph node
+  int count = 0; //number of the values
+  int i = 0; //for-loop index
+
+  for(i = 0; i < graph->G_size; i++)
+  {
+    for(pGraphNode = &(graph->G[i]); pGraphNode != NULL; pGraphNode = pGraphNode->next)
+      count++;
+  }
+
+  return count;
+}
+
+static void StoreForwardingTableValues(forwarding_table_queue_node_t *pFT_QNode, forwarding_table_graph_t *graph)
+{ //store the per-target values of the forwarding graph into the forwarding table of pFT_QNode
+  struct_graph_node *pGraphNode = NULL; //pointer to a graph node
+  forwarding_table_value_t *pValue = pFT_QNode->value; //pointer to a value
+  int i = 0; //for-loop index
+
+  for(i = 0; i < graph->G_size; i++)
+  {
+    for(pGraphNode = &(graph->G[i]); pGraphNode != NULL; pGraphNode = pGraphNode->next, pValue++)
+    {
+      pValue->theta = pGraphNode->theta;
+      pValue->P_prime = pGraphNode->P_prime;
+      pValue->P_prime_pure = pGraphNode->P_prime_pure;
+      pValue->P = pGraphNode->P;
+      pValue->P_pure = pGraphNode->P_pure;
+      pValue->EDD = pGraphNode->EDD;
+      pValue->EDD_SD = pGraphNode->EDD_SD;
+      pValue->EDD_VAR = pGraphNode->EDD_VAR;
+      pValue->EDC = pGraphNode->EDC;
+      pValue->EDC_SD = pGraphNode->EDC_SD;
+      pValue->EDC_VAR = pGraphNode->EDC_VAR;
+    }
+  }
+}
+
+static void LoadForwardingTableValues(forwarding_table_queue_node_t *pFT_QNode, forwarding_table_graph_t *graph)
+{ //load the per-target values of the forwarding table of pFT_QNode into the forwarding graph
+  struct_graph_node *pGraphNode = NULL; //pointer to a graph node
+  forwarding_table_value_t *pValue = pFT_QNode->value; //pointer to a value
+  int i = 0; //for-loop index
+
+  for(i = 0; i < graph->G_size; i++)
+  {
+    for(pGraphNode = &(graph->G[i]); pGraphNode != NULL; pGraphNode = pGraphNode->next, pValue++)
+    {
+      pGraphNode->theta = pValue->theta;
+      pGraphNode->P_prime = pValue->P_prime;
+      pGraphNode->P_prime_pure = pValue->P_prime_pure;
+      pGraphNode->P = pValue->P;
+      pGraphNode->P_pure = pValue->P_pure;
+      pGraphNode->EDD = pValue->EDD;
+      pGraphNode->EDD_SD = pValue->EDD_SD;
+      pGraphNode->EDD_VAR = pValue->EDD_VAR;
+      pGraphNode->EDC = pValue->EDC;
+      pGraphNode->EDC_SD = pValue->EDC_SD;
+      pGraphNode->EDC_VAR = pValue->EDC_VAR;
+    }
+  }
+
+  graph->intersection_id = pFT_QNode->intersection_id;
+}
+#endif /* ] */
+
 void InitForwardingTableQueue(forwarding_table_queue_t *FTQ, parameter_t *param, struct_graph_node* Gr, int Gr_size)
 { //initialize the forwarding table for each intersection in the road network graph Gr
   forwarding_table_queue_node_t table_qnode; //forwarding table queue node
@@ -4415,6 +5111,23 @@ void InitForwardingTableQueue(forwarding_table_queue_t *FTQ, parameter_t *param,
   FTQ->index_table = (forwarding_table_queue_node_t**) calloc(Gr_size, sizeof(forwarding_table_queue_node_t*));
   assert_memory(FTQ->index_table);
 
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+  /** create the forwarding graphs shared by the tables, one per worker thread of UpdateForwardingTableQueue(); the first one is also used for the lookup of the tables */
+#if defined(_LINUX_) && FORWARDING_TABLE_THREAD_POOL_FLAG /* [[ */
+  FTQ->graph_set_size = MAX(1, MIN(param->forwarding_table_thread_number, Gr_size));
+#else
+  FTQ->graph_set_size = 1;
+#endif /* ]] */
+  FTQ->graph_set = (forwarding_table_graph_t*) calloc(FTQ->graph_set_size, sizeof(forwarding_table_graph_t));
+  assert_memory(FTQ->graph_set);
+
+  for(i = 0; i < FTQ->graph_set_size; i++)
+    MakeForwardingTableGraph(&(FTQ->graph_set[i]), param, Gr, Gr_size);
+
+  FTQ->graph_index_for_lookup = 0;
+  FTQ->lookup_hold_count = 0;
+#endif /* ] */
+
   for(i = 0; i < Gr_size; i++)
   {
     memset(&table_qnode, 0, sizeof(table_qnode));
@@ -4424,6 +5137,14 @@ void InitForwardingTableQueue(forwarding_table_queue_t *FTQ, parameter_t *param,
     /* set intersection id to i+1 */
     pQueueNode->intersection_id = i+1;
 
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+    /** allocate the per-target values of the shared forwarding graph and take their initial values from the graph */
+    pQueueNode->G_size = FTQ->graph_set[0].G_size;
+    pQueueNode->value_size = CountForwardingTableValues(&(FTQ->graph_set[0]));
+    pQueueNode->value = (forwarding_table_value_t*) calloc(pQueueNode->value_size, sizeof(forwarding_table_value_t));
+    assert_memory(pQueueNode->value);
+    StoreForwardingTableValues(pQueueNode, &(FTQ->graph_set[0]));
+#else
     /** create a graph G, edge queue EQ, and directional edge queue DEQ for data forwarding */
     /* create a graph G for the data forwarding towards a destination intersection */
     pQueueNode->G = Make_Forwarding_Graph(Gr, Gr_size, &(pQueueNode->G_size));
@@ -4441,7 +5162,24 @@ void InitForwardingTableQueue(forwarding_table_queue_t *FTQ, parameter_t *param,
 
     /* associate each pair of two adjacent graph nodes (i.e., physical edge) with the corresponding directional edge entry in DEQ */
     AssociateGraphEdgeWithDirectionalEdgeEntry(pQueueNode->G, pQueueNode->G_size, &(pQueueNode->DEQ));
+#endif /* ] */
 
+#if FORWARDING_TABLE_REVERSE_SHORTEST_PATH_FLAG /* [ */
+	/** allocate the shortest delay and cost vectors towards this intersection */
+	pQueueNode->vector_size_in_Gr = pQueueNode->G_size;
+	pQueueNode->Dv_edd = (double*) calloc(pQueueNode->vector_size_in_Gr, sizeof(double));
+	assert_memory(pQueueNode->Dv_edd);
+	pQueueNode->Nv_edd = (int*) calloc(pQueueNode->vector_size_in_Gr, sizeof(int));
+	assert_memory(pQueueNode->Nv_edd);
+	pQueueNode->Sv_edd = (double*) calloc(pQueueNode->vector_size_in_Gr, sizeof(double));
+	assert_memory(pQueueNode->Sv_edd);
+	pQueueNode->Dv_edc = (double*) calloc(pQueueNode->vector_size_in_Gr, sizeof(double));
+	assert_memory(pQueueNode->Dv_edc);
+	pQueueNode->Nv_edc = (int*) calloc(pQueueNode->vector_size_in_Gr, sizeof(int));
+	assert_memory(pQueueNode->Nv_edc);
+	pQueueNode->Sv_edc = (double*) calloc(pQueueNode->vector_size_in_Gr, sizeof(double));
+	assert_memory(pQueueNode->Sv_edc);
+#else
 	/** allocate the shortest delay matrices */
 	pQueueNode->matrix_size_for_edd_in_Gr = pQueueNode->G_size;
 	Floyd_Warshall_Allocate_Matrices_For_EDD(&(pQueueNode->Dr_edd), &(pQueueNode->Mr_edd), &(pQueueNode->Sr_edd), pQueueNode->matrix_size_for_edd_in_Gr);
@@ -4449,70 +5187,288 @@ void InitForwardingTableQueue(forwarding_table_queue_t *FTQ, parameter_t *param,
 	/** allocate the shortest cost matrices */
 	pQueueNode->matrix_size_for_edc_in_Gr = pQueueNode->G_size;
 	Floyd_Warshall_Allocate_Matrices_For_EDC(&(pQueueNode->Wr_edc), &(pQueueNode->Dr_edc), &(pQueueNode->Mr_edc), &(pQueueNode->Sr_edc), pQueueNode->matrix_size_for_edc_in_Gr);
+#endif /* ] */
 
     /** set up index table entry with the pointer to graph G */
     FTQ->index_table[i] = pQueueNode;
   }
 }
 
-void UpdateForwardingTableQueue(forwarding_table_queue_t *FTQ, parameter_t *param, struct_graph_node* Gr, int Gr_size, access_point_queue_t *APQ)
-{ //update the forwarding table for each intersection in the road network graph Gr with the vehicular traffic statistics for Gr
-  forwarding_table_queue_node_t *pFT_QNode = NULL; //pointer to a forwarding table queue node
+void UpdateForwardingTableQueueNode(forwarding_table_queue_node_t *pFT_QNode, forwarding_table_queue_t *FTQ, parameter_t *param, struct_graph_node* Gr, int Gr_size, access_point_queue_t *APQ, struct_traffic_table *traffic_table_for_target_point, forwarding_table_graph_t *graph)
+{ //update the forwarding table of the intersection for pFT_QNode with the vehicular traffic statistics for Gr, using traffic_table_for_target_point as the traffic table for the target point; under FORWARDING_TABLE_SHARED_GRAPH_FLAG, the table is computed in the shared forwarding graph of graph
   access_point_queue_node_t *pAP_QNode = NULL; //pointer to a forwarding table queue node
   char target_point[NAME_SIZE]; //target point that is an intersection used for packet target
-  struct_traffic_table traffic_table_for_target_point; //traffic table for a target point  
   int traffic_table_index_for_target_point = 0; //traffic table index for a target point
-  int i = 0, j = 0; //for-loop indices
+  int j = 0; //for-loop index
   double AP_EDD = 0; //EDD at AP
   double AP_EDD_SD = 0; //EDD_SD at AP
+  struct_graph_node *G = NULL; //forwarding graph where the table is computed
+  int G_size = 0; //size of G
+  directional_edge_queue_t *DEQ = NULL; //directional edge queue for G
+
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+  G = graph->G;
+  G_size = graph->G_size;
+  DEQ = &(graph->DEQ);
+
+  /** load the table's values of the last update into the shared forwarding graph */
+  LoadForwardingTableValues(pFT_QNode, graph);
+#else
+  G = pFT_QNode->G;
+  G_size = pFT_QNode->G_size;
+  DEQ = &(pFT_QNode->DEQ);
+#endif /* ] */
+
+  /** copy the vehicular traffic statistics of the edges in Gr into that in G */
+  CopyVehicularTrafficStatistics(Gr, Gr_size, G, G_size);
+
+  /** compute the Expected Delivery Delay (EDD) per intersection as target point */
+  itoa(pFT_QNode->intersection_id, target_point);
+
+  SetTargetPoint_In_TafficTable(traffic_table_for_target_point, target_point);
+
+  traffic_table_index_for_target_point = 0; //the first target point in the traffic table
+
+  if(param->vehicle_vanet_edd_computation_model == VANET_EDD_COMPUTATION_BASED_ON_STOCHASTIC_MODEL)
+  {
+    VADD_Compute_EDD_And_EDD_SD_Based_On_Stochastic_Model(param, G, G_size, DEQ, traffic_table_for_target_point, traffic_table_index_for_target_point);
+  }
+  else
+  {
+    VADD_Compute_EDD_And_EDD_SD_Based_On_Shortest_Path_Model(param, G, G_size, DEQ, traffic_table_for_target_point, traffic_table_index_for_target_point, TRUE);
+
+    VADD_Compute_EDC_And_EDC_SD_Based_On_Shortest_Path_Model(param, G, G_size, DEQ, traffic_table_for_target_point, traffic_table_index_for_target_point, TRUE);
+  }
+
+  /** compute the EDDs at intersections having APs;
+      Note that we compute the EDD and EDD_SD for each intersection only where VANET E2E Delay Model is Stochastic Model, because with VANET E2E Delay Model of Shortest Path Model, the EDD and EDD_SD of each intersection has been computed at VADD_Compute_EDD_And_EDD_SD_Based_On_Shortest_Path_Model_For_Shortest_EDD */
+  if(param->vehicle_vanet_edd_computation_model == VANET_EDD_COMPUTATION_BASED_ON_STOCHASTIC_MODEL)
+  {
+    pAP_QNode = &(APQ->head);
+    for(j = 0; j < APQ->size; j++)
+    {
+      pAP_QNode = pAP_QNode->next;
+
+      VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection(param, pFT_QNode->intersection_id, pAP_QNode->vertex, G, G_size, &AP_EDD, &AP_EDD_SD); //compute the EDDs at the intersection corresponding to pAP_QNode->vertex
+    }
+  }
+
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+  /** keep the table's values out of the shared forwarding graph */
+  StoreForwardingTableValues(pFT_QNode, graph);
+#endif /* ] */
+}
+
+#if FORWARDING_TABLE_LOOKUP_SELF_CHECK_FLAG /* [ */
+static unsigned long forwarding_table_lookup_check_count = 0; //number of the lookups checked against the graphs still held by their callers
+
+void ReportForwardingTableLookupSelfCheck(FILE *fp)
+{ //report how many forwarding table lookups have been checked against the graphs still held by their callers
+  fprintf(fp, "forwarding_table_lookup_self_check: checked=%lu\n", forwarding_table_lookup_check_count);
+}
+#endif /* ] */
+
+struct_graph_node* GetForwardingTableGraph(forwarding_table_queue_t *FTQ, int intersection_id)
+{ //get the forwarding graph holding the forwarding table of the intersection for intersection_id; under FORWARDING_TABLE_SHARED_GRAPH_FLAG, the graph is shared by all the tables and the next lookup of another table overwrites its values, so the caller must not use the graph after ReleaseForwardingTableGraph()
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+  forwarding_table_graph_t *graph = &(FTQ->graph_set[FTQ->graph_index_for_lookup]); //shared forwarding graph for the lookup
+
+#if FORWARDING_TABLE_LOOKUP_SELF_CHECK_FLAG /* [[ */
+  forwarding_table_lookup_check_count++;
+
+  /* a caller holding the graph for another table would read the values of intersection_id after this lookup */
+  if(FTQ->lookup_hold_count > 0 && graph->intersection_id != intersection_id)
+  {
+    printf("%s:%d: Error: the forwarding graph of intersection %d is still held by %d caller(s) at the lookup of intersection %d\n", __FUNCTION__, __LINE__, graph->intersection_id, FTQ->lookup_hold_count, intersection_id);
+    exit(1);
+  }
+
+  FTQ->lookup_hold_count++;
+#endif /* ]] */
+
+  if(graph->intersection_id != intersection_id)
+    LoadForwardingTableValues(FTQ->index_table[intersection_id-1], graph);
+
+  return graph->G;
+#else
+  return FTQ->index_table[intersection_id-1]->G;
+#endif /* ] */
+}
+
+void ReleaseForwardingTableGraph(forwarding_table_queue_t *FTQ)
+{ //release the forwarding graph returned by the last GetForwardingTableGraph() so that the next lookup may load another table into it
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG && FORWARDING_TABLE_LOOKUP_SELF_CHECK_FLAG /* [ */
+  if(FTQ->lookup_hold_count <= 0)
+  {
+    printf("%s:%d: Error: no caller holds the forwarding graph\n", __FUNCTION__, __LINE__);
+    exit(1);
+  }
+
+  FTQ->lookup_hold_count--;
+#endif /* ] */
+}
+
+#if defined(_LINUX_) && FORWARDING_TABLE_THREAD_POOL_FLAG /* [ */
+/** shared state of the forwarding table workers; each worker takes the next intersection until all the intersections are taken */
+typedef struct _forwarding_table_update_job_t
+{
+  forwarding_table_queue_t *FTQ; //forwarding table queue
+  parameter_t *param; //simulation parameters
+  struct_graph_node *Gr; //road network graph
+  int Gr_size; //size of Gr
+  access_point_queue_t *APQ; //access point queue
+  simulation_context_t *context; //simulation context of the thread calling UpdateForwardingTableQueue()
+  int next_index; //index of the next intersection to take in FTQ->index_table
+  int next_graph_index; //index of the next shared forwarding graph to take in FTQ->graph_set
+  int graph_index_for_lookup; //index of a shared forwarding graph that has computed a table in this update
+  pthread_mutex_t mutex; //mutex for next_index, next_graph_index and graph_index_for_lookup
+} forwarding_table_update_job_t;
+
+static void* UpdateForwardingTableQueueWorker(void *arg)
+{ //update the forwarding tables of the intersections taken from the job one by one
+  forwarding_table_update_job_t *job = (forwarding_table_update_job_t*)arg;
+  struct_traffic_table traffic_table_for_target_point; //traffic table for a target point of this worker
+  int index = 0; //index of the intersection taken from the job
+  forwarding_table_graph_t *graph = NULL; //shared forwarding graph of this worker
+  int graph_index = 0; //index of graph in FTQ->graph_set
+  int table_count = 0; //number of the tables computed by this worker
 
-  /* initialize traffic_table_for_target_point */
   memset(&traffic_table_for_target_point, 0, sizeof(traffic_table_for_target_point));
 
-  /*@for debugging */
-  //printf("Before UpdateForwardingTableQueue()\n");
-  /****************/
+  /* the workers read the simulation time and the vehicles of the caller's simulation context */
+  simulation_context_bind(job->context);
 
-  pFT_QNode = &(FTQ->head);
-  for(i = 0; i < Gr_size; i++)
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+  /* each worker computes its tables in its own shared forwarding graph */
+  pthread_mutex_lock(&(job->mutex));
+  graph_index = job->next_graph_index++;
+  pthread_mutex_unlock(&(job->mutex));
+  graph = &(job->FTQ->graph_set[graph_index]);
+#endif /* ] */
+
+  do
   {
-    pFT_QNode = pFT_QNode->next;
+    pthread_mutex_lock(&(job->mutex));
+    index = job->next_index++;
+    pthread_mutex_unlock(&(job->mutex));
 
-    /** copy the vehicular traffic statistics of the edges in Gr into that in G */
-    CopyVehicularTrafficStatistics(Gr, Gr_size, pFT_QNode->G, pFT_QNode->G_size);
+    if(index >= job->Gr_size)
+      break;
 
-    /** compute the Expected Delivery Delay (EDD) per intersection as target point */
-    itoa(pFT_QNode->intersection_id, target_point);
+    /* each intersection writes only its own graph (or values), directional edge queue and matrices, so the result does not depend on which worker takes it */
+    UpdateForwardingTableQueueNode(job->FTQ->index_table[index], job->FTQ, job->param, job->Gr, job->Gr_size, job->APQ, &traffic_table_for_target_point, graph);
+    table_count++;
+  } while(1);
 
-    SetTargetPoint_In_TafficTable(&traffic_table_for_target_point, target_point);
+  /* a graph that has computed a table has the traffic statistics and edge delays of this update, so the tables can be read through it */
+  if(table_count > 0)
+  {
+    pthread_mutex_lock(&(job->mutex));
+    job->graph_index_for_lookup = graph_index;
+    pthread_mutex_unlock(&(job->mutex));
+  }
 
-    traffic_table_index_for_target_point = 0; //the first target point in the traffic table
+  Free_Traffic_Table(&traffic_table_for_target_point);
 
-    if(param->vehicle_vanet_edd_computation_model == VANET_EDD_COMPUTATION_BASED_ON_STOCHASTIC_MODEL)
-	{
-      VADD_Compute_EDD_And_EDD_SD_Based_On_Stochastic_Model(param, pFT_QNode->G, pFT_QNode->G_size, &(pFT_QNode->DEQ), &traffic_table_for_target_point, traffic_table_index_for_target_point);
-	}
-    else
-	{
-      VADD_Compute_EDD_And_EDD_SD_Based_On_Shortest_Path_Model(param, pFT_QNode->G, pFT_QNode->G_size, &(pFT_QNode->DEQ), &traffic_table_for_target_point, traffic_table_index_for_target_point, TRUE);
+  /* the scratch matrices of the incremental all-pairs shortest path update are per thread */
+  Floyd_Warshall_Free_Scratch_Matrices_For_Incremental_Update();
 
-      VADD_Compute_EDC_And_EDC_SD_Based_On_Shortest_Path_Model(param, pFT_QNode->G, pFT_QNode->G_size, &(pFT_QNode->DEQ), &traffic_table_for_target_point, traffic_table_index_for_target_point, TRUE);
-	}
+  return NULL;
+}
+#endif /* ] */
+
+void UpdateForwardingTableQueue(forwarding_table_queue_t *FTQ, parameter_t *param, struct_graph_node* Gr, int Gr_size, access_point_queue_t *APQ)
+{ //update the forwarding table for each intersection in the road network graph Gr with the vehicular traffic statistics for Gr
+  forwarding_table_queue_node_t *pFT_QNode = NULL; //pointer to a forwarding table queue node
+  struct_traffic_table traffic_table_for_target_point; //traffic table for a target point  
+  int i = 0; //for-loop index
+#if defined(_LINUX_) && FORWARDING_TABLE_THREAD_POOL_FLAG /* [ */
+  forwarding_table_update_job_t job; //job shared by the forwarding table workers
+  pthread_t *threads = NULL; //worker threads
+  int thread_number = MIN(param->forwarding_table_thread_number, Gr_size); //number of worker threads including this thread
+#endif /* ] */
 
-    /** compute the EDDs at intersections having APs;
-        Note that we compute the EDD and EDD_SD for each intersection only where VANET E2E Delay Model is Stochastic Model, because with VANET E2E Delay Model of Shortest Path Model, the EDD and EDD_SD of each intersection has been computed at VADD_Compute_EDD_And_EDD_SD_Based_On_Shortest_Path_Model_For_Shortest_EDD */
-    if(param->vehicle_vanet_edd_computation_model == VANET_EDD_COMPUTATION_BASED_ON_STOCHASTIC_MODEL)
+  /*@for debugging */
+  //printf("Before UpdateForwardingTableQueue()\n");
+  /****************/
+
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG && FORWARDING_TABLE_LOOKUP_SELF_CHECK_FLAG /* [ */
+  /* the update computes the tables in the shared forwarding graphs, so no caller may hold the graph of a lookup across it */
+  if(FTQ->lookup_hold_count > 0)
+  {
+    printf("%s:%d: Error: the forwarding graph is still held by %d caller(s) at the update of the forwarding tables\n", __FUNCTION__, __LINE__, FTQ->lookup_hold_count);
+    exit(1);
+  }
+#endif /* ] */
+
+#if defined(_LINUX_) && FORWARDING_TABLE_THREAD_POOL_FLAG /* [ */
+  if(thread_number > 1)
+  {
+    memset(&job, 0, sizeof(job));
+    job.FTQ = FTQ;
+    job.param = param;
+    job.Gr = Gr;
+    job.Gr_size = Gr_size;
+    job.APQ = APQ;
+    job.context = simulation_context_current();
+    job.next_index = 0;
+    job.next_graph_index = 0;
+    job.graph_index_for_lookup = 0;
+    pthread_mutex_init(&(job.mutex), NULL);
+
+    threads = (pthread_t*) calloc(thread_number - 1, sizeof(pthread_t));
+    assert_memory(threads);
+
+    /* let the queue node slabs be locked while the workers share them */
+    queue_node_slab_lock_flag = TRUE;
+
+    for(i = 0; i < thread_number - 1; i++)
     {
-      pAP_QNode = &(APQ->head);
-      for(j = 0; j < APQ->size; j++)
+      if(pthread_create(&(threads[i]), NULL, UpdateForwardingTableQueueWorker, &job) != 0)
       {
-        pAP_QNode = pAP_QNode->next;
-
-        VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection(param, pFT_QNode->intersection_id, pAP_QNode->vertex, FTQ, &AP_EDD, &AP_EDD_SD); //compute the EDDs at the intersection corresponding to pAP_QNode->vertex
+        printf("%s:%d pthread_create() failed for worker %d\n", __FUNCTION__, __LINE__, i);
+        exit(1);
       }
     }
+
+    /* this thread works as the last worker */
+    UpdateForwardingTableQueueWorker(&job);
+
+    /* join the workers so that all the forwarding tables are updated when this function returns */
+    for(i = 0; i < thread_number - 1; i++)
+      pthread_join(threads[i], NULL);
+
+    queue_node_slab_lock_flag = FALSE;
+
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+    FTQ->graph_index_for_lookup = job.graph_index_for_lookup;
+#endif /* ] */
+
+    pthread_mutex_destroy(&(job.mutex));
+    free(threads);
+    return;
+  }
+#endif /* ] */
+
+  /* initialize traffic_table_for_target_point */
+  memset(&traffic_table_for_target_point, 0, sizeof(traffic_table_for_target_point));
+
+  pFT_QNode = &(FTQ->head);
+  for(i = 0; i < Gr_size; i++)
+  {
+    pFT_QNode = pFT_QNode->next;
+
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+    UpdateForwardingTableQueueNode(pFT_QNode, FTQ, param, Gr, Gr_size, APQ, &traffic_table_for_target_point, &(FTQ->graph_set[0]));
+#else
+    UpdateForwardingTableQueueNode(pFT_QNode, FTQ, param, Gr, Gr_size, APQ, &traffic_table_for_target_point, NULL);
+#endif /* ] */
   }
 
+#if FORWARDING_TABLE_SHARED_GRAPH_FLAG /* [ */
+  FTQ->graph_index_for_lookup = 0;
+#endif /* ] */
+
   /*@for debugging */
   //printf("After UpdateForwardingTableQueue()\n");
   /****************/
@@ -4634,14 +5590,77 @@ void DestroyGlobalPacketQueueNode(global_packet_queue_node_t *global_packet)
 	/* if all of the packet copies become deleted, dequeue the global packet queue node */
 	if(global_packet->packet_copy_count == 0)
 	{
+#if PACKET_COPY_ON_WRITE_FLAG /* [ */
+		/* let the packet copies still in the packet pointer list stop referring to it */
+		Empty_PacketPointerList(global_packet);
+#endif /* ] */
+
 		/* dequeue global_packet from global packet queue Q */
 		Dequeue_With_QueueNodePointer((queue_t*)Q, (queue_node_t*)global_packet);
 
 		/* free the memory of the global packet queue node */
-		free(global_packet);
+		FreeQueueNode(QTYPE_GLOBAL_PACKET, (queue_node_t*)global_packet);
 	}
 }
 
+#if PACKET_COPY_ON_WRITE_FLAG /* [ */
+packet_pointer_queue_node_t* Enqueue_Packet_Into_PacketPointerList(packet_queue_node_t *packet)
+{ //enqueue the pointer of packet into the packet pointer list of packet's global packet so that the packet copies sharing a predicted encounter graph can be found
+  packet_pointer_queue_node_t queue_node; //packet pointer queue node
+
+  memset(&queue_node, 0, sizeof(queue_node));
+  queue_node.id = packet->id;
+  queue_node.packet = packet;
+  queue_node.global_packet = packet->global_packet;
+
+  packet->packet_pointer = (packet_pointer_queue_node_t*)Enqueue((queue_t*)&(packet->global_packet->packet_pointer_list), (queue_node_t*)&queue_node);
+
+  /* packet becomes a holder of its predicted encounter graph */
+  packet->predicted_encounter_graph->holder_count++;
+
+  return packet->packet_pointer;
+}
+
+void Dequeue_Packet_From_PacketPointerList(packet_queue_node_t *packet)
+{ //dequeue the pointer of packet from the packet pointer list of packet's global packet
+  packet_pointer_queue_node_t *pQueueNode = packet->packet_pointer; //pointer to packet's entry in the packet pointer list
+
+  Dequeue_With_QueueNodePointer((queue_t*)pQueueNode->ptr_queue, (queue_node_t*)pQueueNode);
+  FreeQueueNode(QTYPE_PACKET_POINTER, (queue_node_t*)pQueueNode);
+
+  /* packet stops being a holder of its predicted encounter graph */
+  packet->predicted_encounter_graph->holder_count--;
+
+  packet->packet_pointer = NULL;
+}
+
+boolean Is_Predicted_Encounter_Graph_Shared_In_PacketPointerList(packet_queue_node_t *packet)
+{ //check with the holder count of packet's predicted encounter graph whether another packet copy in the packet pointer list of packet's global packet holds the graph
+  if(packet->predicted_encounter_graph->holder_count > 1)
+    return TRUE;
+  else
+    return FALSE;
+}
+
+void Empty_PacketPointerList(global_packet_queue_node_t *global_packet)
+{ //empty the packet pointer list of global_packet before global_packet is freed, giving an empty predicted encounter graph of its own to every packet copy still sharing its graph with another one in the list
+  packet_pointer_queue_t *Q = &(global_packet->packet_pointer_list); //packet pointer list
+  packet_pointer_queue_node_t *pQueueNode = NULL; //pointer to a packet pointer queue node
+  packet_queue_node_t *packet = NULL; //pointer to a packet copy
+
+  /* Note that the global packet is freed when its packet_copy_count reaches zero, which happens right before its last packet copy is destroyed; the packet copies still in the list at the end of the simulation may share their graphs */
+  while(Q->size > 0)
+  {
+    pQueueNode = Q->head.next;
+    packet = pQueueNode->packet;
+
+    TPD_Unshare_Predicted_Encounter_Graph_For_Packet(packet); //leave a shared graph to the other packet copies
+
+    Dequeue_Packet_From_PacketPointerList(packet);
+  }
+}
+#endif /* ] */
+
 void ReverseQueue(queue_t *Q)
 { //reverse the order of queue Q, such as packet_trajectory_queue.
 
@@ -4750,7 +5769,7 @@ void InitStationaryNodeQueue(stationary_node_queue_t *SNQ, struct_graph_node *Gr
     {
         /* enqueue a stationary node queue node */
         memset(&qnode, 0, sizeof(qnode));
-        qnode.intersection_id = atoi(Gr[i].vertex);
+        qnode.intersection_id = Gr[i].vertex_id;
         qnode.gnode = &(Gr[i]);
 
         pQueueNode = (stationary_node_queue_node_t*)Enqueue((queue_t*)SNQ, (queue_node_t*)&qnode);
@@ -58,6 +58,9 @@ typedef enum _queue_type_t {
 
 } queue_type_t;
 
+/* number of queue types, i.e., the size of a table indexed by queue_type_t */
+#define QUEUE_TYPE_NUMBER (QTYPE_PACKET_POINTER + 1)
+
 typedef enum _cluster_type_t {
 	CLUSTER_UNKNOWN = 0,    //unknow cluster type
 	CLUSTER_ENTRANCE = 1,   //entrance cluster that is a set of entrance nodes
@@ -253,6 +256,9 @@ typedef struct _vehicle_trajectory_queue_t {
         /* target point information */
         int target_point_id; //id of target point determined by AP for the packet-receiving position of the destination vehicle
         struct_graph_node *target_point_gnode; //pointer to the graph node corresponding to target_point_id
+
+        /* prefix sums along the trajectory */
+        trajectory_prefix_sum_t prefix_sum; //prefix sums of the edge lengths and vertex-to-hop tables that are rebuilt at the first query after the trajectory changes
 } vehicle_trajectory_queue_t;
 
 /** structure for carrier trace queue node for this packet's carrier trace */
@@ -354,6 +360,8 @@ typedef struct _packet_queue_node_t {
 
         struct _global_packet_queue_node_t *global_packet; /* pointer to the global packet queue node corresponding to this packet */
 
+        struct _packet_pointer_queue_node_t *packet_pointer; /* pointer to this packet's entry in the packet_pointer_list of its global packet once this packet has shared its predicted encounter graph with its copies */
+
         data_forwarding_mode_t data_forwarding_mode; /* data forwarding mode: {DATA_FORWARDING_MODE_DOWNLOAD, DATA_FORWARDING_MODE_UPLOAD} */
 
         vehicle_trajectory_queue_t vehicle_trajectory; /* destination vehicle trajectory under download mode */
@@ -489,6 +497,8 @@ typedef struct _vehicle_movement_queue_node_t {
         double offset; //offset from the tail_node of the edge
         int order; //order in terms of offset on the edge; note that the first vehice's order is zero
         struct _vehicle_movement_queue_t *ptr_queue; //pointer to the vehicle movement queue
+        int sequence; //sequence number that increases along the vehicle movement list; it is used to visit the nodes found in the offset index in the list order
+        int offset_index_position; //position of this node in the offset index of the vehicle movement queue
 } vehicle_movement_queue_node_t;
 
 /** structure for intersection EDD queue node */
@@ -723,6 +733,11 @@ typedef struct _vehicle_movement_queue_t {
 	vehicle_movement_queue_node_t head;
         int eid; //directional edge's id
         struct _directional_edge_queue_node_t *enode; //pointer to the directional edge node
+        int sequence_number; //sequence number for the next vehicle movement queue node appended to the list
+        vehicle_movement_queue_node_t **offset_index; //array of the pointers to the vehicle movement queue nodes in ascending order of offset
+        int offset_index_size; //number of the node pointers in offset_index
+        int offset_index_capacity; //number of the node pointers that offset_index can hold
+        int descent_count; //number of the adjacent node pairs in the list whose former node has a greater offset than the latter; zero means that the list is in ascending order of offset
 } vehicle_movement_queue_t;
 
 /** structure for convoy queue node */
@@ -945,6 +960,30 @@ typedef struct _access_point_queue_t {
     access_point_queue_node_t head;
 } access_point_queue_t;
 
+/** structure for the per-target values of a graph node in a forwarding graph under FORWARDING_TABLE_SHARED_GRAPH_FLAG */
+typedef struct _forwarding_table_value_t {
+    double theta; //angle in degrees between the vehicle movement vector and the destination vector
+    double P_prime; //probability of a packet being forwarded to road r_ij at intersection I_i
+    double P_prime_pure; //forwarding probability of a packet being forwarded to road r_ij at intersection I_i in TBD
+    double P; //probability that a packet is forwarded through road r_ij at intersection I_i
+    double P_pure; //pure forwarding probability that a packet is forwarded into a vehicle moving on the branch
+    double EDD; //Expected Delivery Delay (EDD) towards the target intersection
+    double EDD_SD; //EDD standard deviation
+    double EDD_VAR; //EDD variance
+    double EDC; //Expected Delivery Cost (EDC) towards the target intersection
+    double EDC_SD; //EDC standard deviation
+    double EDC_VAR; //EDC variance
+} forwarding_table_value_t;
+
+/** structure for a forwarding graph shared by the forwarding tables under FORWARDING_TABLE_SHARED_GRAPH_FLAG */
+typedef struct _forwarding_table_graph_t {
+    struct_graph_node *G; //forwarding graph that is an adjacency list for a road network graph
+    int G_size; //graph size that is the number of nodes
+    edge_queue_t EQ; //undirectional edge queue for graph G
+    directional_edge_queue_t DEQ; //directional edge queue for graph G
+    int intersection_id; //intersection id of the forwarding table whose values are in G; zero means no table
+} forwarding_table_graph_t;
+
 /** struct for forwarding table queue node for STBD data forwarding */
 typedef struct _forwarding_table_queue_node_t {
     struct _forwarding_table_queue_node_t *next;
@@ -960,6 +999,9 @@ typedef struct _forwarding_table_queue_node_t {
 	int **Mr_edd; //predecessor matrix for Dr_edd
 	double **Sr_edd; //supplementary matrix for Dr_edd
 	int matrix_size_for_edd_in_Gr; //matrix size of matrices Dr_edd, Mr_edd, and Sr_edd
+	double **Dr_edd_weight; //edge weight matrix used in the last computation of Dr_edd for its incremental update
+	double **Sr_edd_weight; //supplementary edge weight matrix used in the last computation of Sr_edd for its incremental update
+	int node_number_for_edd_weight_in_Gr; //number of nodes in Dr_edd_weight and Sr_edd_weight; zero means that there is no last computation
 
 	/* the shortest cost matrices */
 	double **Wr_edc; //the adjacency matrix for edge cost from start-point to end-point
@@ -967,6 +1009,22 @@ typedef struct _forwarding_table_queue_node_t {
 	int **Mr_edc; //predecessor matrix for Dr_edd
 	double **Sr_edc; //supplementary matrix for Dr_edd
 	int matrix_size_for_edc_in_Gr; //matrix size of matrices Dr_edc, Mr_edc, and Sr_edc	
+	double **Dr_edc_weight; //edge weight matrix used in the last computation of Dr_edc for its incremental update
+	double **Sr_edc_weight; //supplementary edge weight matrix used in the last computation of Sr_edc for its incremental update
+	int node_number_for_edc_weight_in_Gr; //number of nodes in Dr_edc_weight and Sr_edc_weight; zero means that there is no last computation
+
+	/* the shortest delay and cost vectors towards this intersection used instead of the matrices under FORWARDING_TABLE_REVERSE_SHORTEST_PATH_FLAG */
+	double *Dv_edd; //the shortest delay from each intersection to this intersection
+	int *Nv_edd; //next intersection index on the shortest path for Dv_edd
+	double *Sv_edd; //supplementary vector for Dv_edd
+	double *Dv_edc; //the shortest cost from each intersection to this intersection
+	int *Nv_edc; //next intersection index on the shortest path for Dv_edc
+	double *Sv_edc; //supplementary vector for Dv_edc
+	int vector_size_in_Gr; //size of the vectors
+
+	/* the per-target values of the shared forwarding graph used instead of G, EQ and DEQ under FORWARDING_TABLE_SHARED_GRAPH_FLAG */
+	forwarding_table_value_t *value; //values of the graph nodes in the order of the node array and their neighbor lists
+	int value_size; //number of the values
 
     struct _forwarding_table_queue_t *ptr_queue; //pointer to the forwarding table queue
 } forwarding_table_queue_node_t;
@@ -977,6 +1035,10 @@ typedef struct _forwarding_table_queue_t {
     int size; //size is the same as the number of nodes in the road network graph
     forwarding_table_queue_node_t head;
     forwarding_table_queue_node_t **index_table; //index table to access a table for intersection id; index_table[0] points to the table corresponding to intersection id == 1
+    forwarding_table_graph_t *graph_set; //forwarding graphs shared by the tables under FORWARDING_TABLE_SHARED_GRAPH_FLAG, one per worker thread of UpdateForwardingTableQueue()
+    int graph_set_size; //number of the shared forwarding graphs
+    int graph_index_for_lookup; //index of the shared forwarding graph through which the tables are read
+    int lookup_hold_count; //number of the callers holding the graph returned by GetForwardingTableGraph() until ReleaseForwardingTableGraph(), counted under FORWARDING_TABLE_LOOKUP_SELF_CHECK_FLAG
 } forwarding_table_queue_t;
 
 /** structure for stationary node queue node */
@@ -1197,14 +1259,52 @@ typedef struct _predicted_encounter_graph_t {
 	struct_vehicle_t *root; //root vehicle in the graph
 	minimum_priority_queue_t Q; //minimum priority queue Q
 	adjacency_list_queue_t G; //adjacency list for graph G
+#if PACKET_COPY_ON_WRITE_FLAG /* [ */
+	int holder_count; //number of the packet copies in a packet pointer list holding this graph; the graph is shared if it is greater than 1
+#endif /* ] */
 } predicted_encounter_graph_t;
 
+/** Slab of queue nodes of the same queue type */
+typedef struct _queue_node_slab_t {
+	size_t node_size; //size of a queue node rounded up to the slab alignment
+	queue_node_t *free_list; //free queue nodes linked by their next pointers
+	void *chunk_list; //chunks of QUEUE_NODE_SLAB_CHUNK_NODE_NUMBER queue nodes linked by their first pointer
+	char *chunk_cursor; //next queue node to carve out of the latest chunk
+	char *chunk_end; //end of the latest chunk
+	unsigned long chunk_count; //number of chunks
+	unsigned long allocation_count; //number of queue nodes allocated
+	unsigned long release_count; //number of queue nodes released
+	unsigned long reuse_count; //number of allocations served from the free list
+	unsigned long splice_count; //number of queues whose whole node list is returned to the free list at once
+	unsigned long live_count; //number of queue nodes in use
+	unsigned long peak_live_count; //maximum of live_count
+} queue_node_slab_t;
+
 /***************************/
 
 /** function declarations **/
 void InitQueue(queue_t *Q, queue_type_t queue_type); 
 //initialize queue Q
 
+queue_node_t* AllocateQueueNode(queue_type_t queue_type);
+//allocate an uninitialized queue node of queue type from its slab
+
+void FreeQueueNode(queue_type_t queue_type, queue_node_t *p);
+//release queue node p of queue type to its slab without destroying the queue(s) in p
+
+boolean IsQueueNodeWithoutDestructor(queue_type_t queue_type);
+//return TRUE if DestroyQueueNode() has no work for a queue node of queue type other than releasing its memory
+
+void FreeQueueNodeSlabs();
+//free the chunks of the slabs whose queue nodes are all released
+
+void ReportQueueNodeAllocationStatistics(FILE *fp);
+//report the allocation counters of the queue node slabs per queue type
+
+/** Note: whenever we support another queue type, we need to add another case statement for it */
+size_t SizeofQueueNode(queue_type_t queue_type);
+//return the size of the queue node corresponding to queue type
+
 /** Note: whenever we support another queue type, we need to add another case statement for it */
 queue_node_t* MakeQueueNode(queue_type_t queue_type, queue_node_t *node);
 //make a queue node corresponding to queue type and copy the data of node into its data portion
@@ -1284,6 +1384,15 @@ void SortVehicleMovementQueue(vehicle_movement_queue_t* Q);
 void RearrangeVehicleMovementQueue(vehicle_movement_queue_t* Q, vehicle_movement_queue_node_t **A);
 //rearrange the pointers of vehicle movement queue Q using A in the ascending order
 
+void UpdateVehicleMovementOffset(vehicle_movement_queue_node_t *p, double offset);
+//set the offset of vehicle movement queue node p to offset and move p to its place in the offset index of its vehicle movement queue
+
+int GetVehicleMovementsInOffsetRange(vehicle_movement_queue_t *Q, double lower_offset, double upper_offset, vehicle_movement_queue_node_t ***A);
+//get the vehicle movement queue nodes of Q whose offsets are in [lower_offset, upper_offset] into array *A in the order of the vehicle movement list and return the number of them; the caller frees *A
+
+void FreeVehicleMovementOffsetIndex(vehicle_movement_queue_t *Q);
+//free the offset index of vehicle movement queue Q
+
 void SortVehicleQueue(vehicle_queue_t* Q);
 //sort vehicle queue nodes in ascending order according to offset in the directional edge
 
@@ -1395,11 +1504,11 @@ void DeleteVehicleMovementWithVID(vehicle_movement_queue_t *Q, int vid);
 void DeleteConvoyWithCID(convoy_queue_t *Q, int cid);
 //delete the convoy node corresponding to cid from convoy queue Q
 
-void MergeTwoConvoys(convoy_queue_t *Q1, convoy_queue_t *Q2);
-//merge two convoys moving one the same directional edge into one convoy and delete one between the merged convoys from the convoy queue for the directional edge; note that the new convoy's id is equal to one whose cid is smaller and the convoy with the bigger is deleted
+void MergeTwoConvoys(parameter_t *param, double merge_time, convoy_queue_node_t *src_convoy, convoy_queue_node_t *dst_convoy);
+//concatenate src_convoy's vehicle list into dst_convoy's vehicle list, delete src_convoy from its convoy queue and set dst_convoy's head, tail and leader; note that dst_convoy's id becomes the id of its new head vehicle
 
-void SplitConvoy(convoy_queue_t *Q);
-//split one convoy into two convoys moving one the same directional edge and register these two convoys into the convoy queue for the directional edge; note that one convoy's id the same as the original one's and another convoy's is set to a unique cid
+convoy_queue_node_t* SplitConvoy(parameter_t *param, double split_time, convoy_queue_node_t *src_convoy, struct_vehicle_t *vehicle);
+//split src_convoy into two convoys on the same directional edge by using vehicle as the boundary: the vehicles up to vehicle in ascending order of offset move into a new convoy registered into src_convoy's convoy queue with vehicle as its head and vehicle's id as its cid, and src_convoy keeps the vehicles ahead of vehicle; this returns the new convoy
 
 convoy_queue_node_t* GetConvoyClosestToVehicle(parameter_t *param, convoy_queue_t *Q, double vehicle_offset);
 //get the pointer to the convoy node closest to the vehicle within the communication range
@@ -1498,8 +1607,22 @@ void DestroyPacketQueueNode(packet_queue_node_t *packet);
 void InitForwardingTableQueue(forwarding_table_queue_t *FTQ, parameter_t *param, struct_graph_node* Gr, int Gr_size);
 //initialize the forwarding table for each intersection in the road network graph Gr
 
+void UpdateForwardingTableQueueNode(forwarding_table_queue_node_t *pFT_QNode, forwarding_table_queue_t *FTQ, parameter_t *param, struct_graph_node* Gr, int Gr_size, access_point_queue_t *APQ, struct_traffic_table *traffic_table_for_target_point, forwarding_table_graph_t *graph);
+//update the forwarding table of the intersection for pFT_QNode with the vehicular traffic statistics for Gr, using traffic_table_for_target_point as the traffic table for the target point; graph is the shared forwarding graph used under FORWARDING_TABLE_SHARED_GRAPH_FLAG
+
+struct_graph_node* GetForwardingTableGraph(forwarding_table_queue_t *FTQ, int intersection_id);
+//get the forwarding graph holding the forwarding table of the intersection for intersection_id; under FORWARDING_TABLE_SHARED_GRAPH_FLAG, the graph is shared by all the tables and the next lookup of another table overwrites its values, so the caller must not use the graph after ReleaseForwardingTableGraph()
+
+void ReleaseForwardingTableGraph(forwarding_table_queue_t *FTQ);
+//release the forwarding graph returned by the last GetForwardingTableGraph() so that the next lookup may load another table into it
+
+#if FORWARDING_TABLE_LOOKUP_SELF_CHECK_FLAG /* [ */
+void ReportForwardingTableLookupSelfCheck(FILE *fp);
+//report how many forwarding table lookups have been checked against the graphs still held by their callers
+#endif /* ] */
+
 void UpdateForwardingTableQueue(forwarding_table_queue_t *FTQ, parameter_t *param, struct_graph_node* Gr, int Gr_size, access_point_queue_t *APQ);
-//update the forwarding table for each intersection in the road network graph Gr with the vehicular traffic statistics for Gr
+//update the forwarding table for each intersection in the road network graph Gr with the vehicular traffic statistics for Gr; with param->forwarding_table_thread_number > 1, the intersections are shared by worker threads
 
 /** Global Packet Queue Operations */
 void InitGlobalPacketQueue_With_VanetInformationTable(global_packet_queue_t *GPQ, parameter_t *param);
@@ -1517,6 +1640,20 @@ global_packet_queue_node_t* Enqueue_Packet_Into_GlobalPacketQueue_With_TargetPoi
 void DestroyGlobalPacketQueueNode(global_packet_queue_node_t *global_packet);
 //dequeue global packet queue node, destroy global packet queue node, and then free the memory of global packet queue node
 
+#if PACKET_COPY_ON_WRITE_FLAG /* [ */
+packet_pointer_queue_node_t* Enqueue_Packet_Into_PacketPointerList(packet_queue_node_t *packet);
+//enqueue the pointer of packet into the packet pointer list of packet's global packet so that the packet copies sharing a predicted encounter graph can be found
+
+void Dequeue_Packet_From_PacketPointerList(packet_queue_node_t *packet);
+//dequeue the pointer of packet from the packet pointer list of packet's global packet
+
+boolean Is_Predicted_Encounter_Graph_Shared_In_PacketPointerList(packet_queue_node_t *packet);
+//check with the holder count of packet's predicted encounter graph whether another packet copy in the packet pointer list of packet's global packet holds the graph
+
+void Empty_PacketPointerList(global_packet_queue_node_t *global_packet);
+//empty the packet pointer list of global_packet before global_packet is freed, giving an empty predicted encounter graph of its own to every packet copy still sharing its graph with another one in the list
+#endif /* ] */
+
 void ReverseQueue(queue_t *Q);
 //reverse the order of queue Q, such as packet_trajectory_queue. 
 
@@ -19,20 +19,29 @@ typedef double real;
 #define then
 */
 
-static long In[16]= {0L,   /* seeds for streams 1 thru 15  */
-  1973272912L,  747177549L,   20464843L,  640830765L, 1098742207L,
-    78126602L,   84743774L,  831312807L,  124667236L, 1172177002L,
-  1124933064L, 1223960546L, 1878892440L, 1449793615L,  553303732L};
+/* the stream seeds, the current stream and the state of the drand48() */
+/* generator are kept in the current simulation context (see smpl.h)   */
+#if RAND_GENERATOR_TYPE == RAND_GENERATOR_PHILOX
+static double rand_stream_uniform01();
+#define drand48() rand_stream_uniform01()
+#elif !defined(_WIN32)
+#define drand48() erand48(simulation_context_current()->xsubi)
+#endif
 
-static int strm=1;         /* index of current stream */
+/* Philox4x32-10 constants (Salmon et al., SC'11) */
+#define PHILOX_M0 0xD2511F53U  /* multiplier of the first word pair  */
+#define PHILOX_M1 0xCD9E8D57U  /* multiplier of the second word pair */
+#define PHILOX_W0 0x9E3779B9U  /* key schedule increment of key[0]   */
+#define PHILOX_W1 0xBB67AE85U  /* key schedule increment of key[1]   */
+#define PHILOX_ROUNDS 10
 
 /*--------------------  SELECT GENERATOR STREAM  ---------------------*/
 int stream(int n)
   //int n;
     { /* set stream for 1<=n<=15, return stream for n=0 */
       if ((n<0)||(n>15)) then error(0,"stream Argument Error");
-      if (n) then strm=n;
-      return(strm);
+      if (n) then simulation_context_current()->strm=n;
+      return(simulation_context_current()->strm);
     }
 
 /*--------------------------  SET/GET SEED  --------------------------*/
@@ -40,10 +49,39 @@ long seed(long Ik, int n)
   //long Ik; int n;
     { /* set seed of stream n for Ik>0, return current seed for Ik=0  */
       if ((n<1)||(n>15)) then error(0,"seed Argument Error");
-      if (Ik>0L) then  In[n]=Ik;
-      return(In[n]);
+      if (Ik>0L) then  simulation_context_current()->In[n]=Ik;
+#if RAND_GENERATOR_TYPE == RAND_GENERATOR_PHILOX
+      if (Ik>0L) then
+        rand_substream_init(&simulation_context_current()->streams[n],Ik,RAND_ENTITY_STREAM,n);
+#endif
+      return(simulation_context_current()->In[n]);
     }
 
+/*---------------------  SET DRAND48() STATE  ------------------------*/
+void seed_random(long seedval)
+  { /* initialize the drand48() generator of the current simulation   */
+    /* context in the same way as srand48(seedval)                    */
+    simulation_context_t *ctx=simulation_context_current();
+#if RAND_GENERATOR_TYPE == RAND_GENERATOR_PHILOX
+    int n;
+    for (n=1; n<16; n++)
+      rand_substream_init(&ctx->streams[n],seedval,RAND_ENTITY_STREAM,n);
+#elif defined(_WIN32)
+    srand48(seedval);
+#else
+    ctx->xsubi[0]=0x330E;
+    ctx->xsubi[1]=(unsigned short)(seedval & 0xFFFF);
+    ctx->xsubi[2]=(unsigned short)((seedval >> 16) & 0xFFFF);
+#endif
+    ctx->rand_seed=(unsigned long)seedval;
+  }
+
+/*-----------------------  CURRENT SEED  -----------------------------*/
+unsigned long rand_current_seed()
+  {
+    return(simulation_context_current()->rand_seed);
+  }
+
 /*------------  UNIFORM [a, b] RANDOM VARIATE GENERATOR  -------------*/
 double uniform(double a, double b)
   //double a,b;
@@ -155,15 +193,139 @@ real normal(real x, real s)
   //real x,s;
     { /* 'normal' returns a psuedo-random variate from a normal dis-  */
       /* tribution with mean x and standard deviation s.              */
-      real v1,v2,w,z1; static real z2=0.0;
-      if (z2!=0.0)
-        then {z1=z2; z2=0.0;}  /* use value from previous call */
+      real v1,v2,w,z1; real *z2=&(simulation_context_current()->normal_spare);
+      if (*z2!=0.0)
+        then {z1=*z2; *z2=0.0;}  /* use value from previous call */
         else
           {
             do
               {v1=2.0*drand48()-1.0; v2=2.0*drand48()-1.0; w=v1*v1+v2*v2;}
             while (w>=1.0);
-            w=sqrt((-2.0*log(w))/w); z1=v1*w; z2=v2*w;
+            w=sqrt((-2.0*log(w))/w); z1=v1*w; *z2=v2*w;
           }
       return(x+z1*s);
   }
+
+/*------------------  PHILOX4X32-10 BLOCK FUNCTION  ------------------*/
+static void philox4x32_10(unsigned int ctr[4], const unsigned int key[2])
+  { /* replace the counter block ctr by its random block under key    */
+    unsigned int k0=key[0],k1=key[1],c0=ctr[0],c1=ctr[1],c2=ctr[2],c3=ctr[3];
+    unsigned long long p0,p1; int r;
+    for (r=0; r<PHILOX_ROUNDS; r++)
+      {
+        if (r>0) then {k0+=PHILOX_W0; k1+=PHILOX_W1;}
+        p0=(unsigned long long)PHILOX_M0*c0;
+        p1=(unsigned long long)PHILOX_M1*c2;
+        c0=(unsigned int)(p1>>32)^c1^k0; c1=(unsigned int)p1;
+        c2=(unsigned int)(p0>>32)^c3^k1; c3=(unsigned int)p0;
+      }
+    ctr[0]=c0; ctr[1]=c1; ctr[2]=c2; ctr[3]=c3;
+  }
+
+/*-----------  UNIFORM (0, 1) VARIATE FROM TWO RANDOM WORDS  ---------*/
+static double rand_words_to_uniform01(unsigned int a, unsigned int b)
+  { /* 53 random bits centered in their interval, so never 0 or 1    */
+    return(((double)(a>>5)*67108864.0+(double)(b>>6)+0.5)*(1.0/9007199254740992.0));
+  }
+
+/*------------------  INITIALIZE COUNTER SUBSTREAM  ------------------*/
+void rand_substream_init(rand_substream_t *s, unsigned long seedval, int entity_type, int entity_id)
+  {
+    s->key[0]=(unsigned int)(seedval & 0xFFFFFFFFUL);
+    s->key[1]=(unsigned int)(((unsigned long long)seedval >> 32) & 0xFFFFFFFFUL);
+    s->entity[0]=(unsigned int)entity_type;
+    s->entity[1]=(unsigned int)entity_id;
+    s->counter=0;
+  }
+
+/*------------------  RANDOM ACCESS DRAW OF SUBSTREAM  ---------------*/
+double rand_counter_uniform01(rand_substream_t *s, unsigned long long index)
+  { /* a block of four words gives the draws 2k and 2k+1 */
+    unsigned long long block=index>>1;
+    unsigned int ctr[4];
+    ctr[0]=(unsigned int)block; ctr[1]=(unsigned int)(block>>32);
+    ctr[2]=s->entity[0]; ctr[3]=s->entity[1];
+    philox4x32_10(ctr,s->key);
+    return((index & 1)? rand_words_to_uniform01(ctr[2],ctr[3])
+                      : rand_words_to_uniform01(ctr[0],ctr[1]));
+  }
+
+/*----------------------  NEXT DRAW OF SUBSTREAM  --------------------*/
+double rand_substream_uniform01(rand_substream_t *s)
+  {
+    return(rand_counter_uniform01(s,s->counter++));
+  }
+
+/*----------------------  SELECT SUBSTREAM  --------------------------*/
+rand_substream_t* rand_use_substream(rand_substream_t *s)
+  {
+    simulation_context_t *ctx=simulation_context_current();
+    rand_substream_t *prev=ctx->substream;
+    ctx->substream=s;
+    return(prev);
+  }
+
+#if RAND_GENERATOR_TYPE == RAND_GENERATOR_PHILOX
+/*------------------  NEXT DRAW OF CURRENT STREAM  -------------------*/
+static double rand_stream_uniform01()
+  { /* the selected substream, if any, replaces the current stream */
+    simulation_context_t *ctx=simulation_context_current();
+    if (ctx->substream!=NULL) then return(rand_substream_uniform01(ctx->substream));
+    return(rand_substream_uniform01(&ctx->streams[ctx->strm]));
+  }
+#endif
+
+/*------------------  FILL UNIFORM (0, 1) VARIATES  ------------------*/
+static void rand_substream_fill(rand_substream_t *s, double *v, int n)
+  { /* v[i] is the draw s->counter+i; every block is independent */
+    unsigned long long first=s->counter,block;
+    unsigned int ctr[4];
+    int i=0;
+    if ((first & 1) && (n>0)) then {v[i++]=rand_counter_uniform01(s,first);}
+    for (; i+1<n; i+=2)
+      {
+        block=(first+i)>>1;
+        ctr[0]=(unsigned int)block; ctr[1]=(unsigned int)(block>>32);
+        ctr[2]=s->entity[0]; ctr[3]=s->entity[1];
+        philox4x32_10(ctr,s->key);
+        v[i]=rand_words_to_uniform01(ctr[0],ctr[1]);
+        v[i+1]=rand_words_to_uniform01(ctr[2],ctr[3]);
+      }
+    if (i<n) then v[i]=rand_counter_uniform01(s,first+i);
+    s->counter=first+n;
+  }
+
+/*--------------------  BATCHED UNIFORM VARIATES  --------------------*/
+void uniform_batch(real *v, int n, real a, real b, rand_substream_t *s)
+  {
+    int i;
+    if (a>b) then error(0,"uniform_batch Argument Error: a > b");
+    rand_substream_fill(s,v,n);
+    for (i=0; i<n; i++) v[i]=a+(b-a)*v[i];
+  }
+
+/*------------------  BATCHED EXPONENTIAL VARIATES  ------------------*/
+void expntl_batch(real *v, int n, real x, rand_substream_t *s)
+  {
+    int i;
+    rand_substream_fill(s,v,n);
+    for (i=0; i<n; i++) v[i]=-x*log(v[i]);
+  }
+
+/*--------------------  BATCHED NORMAL VARIATES  ---------------------*/
+void normal_batch(real *v, int n, real x, real sd, rand_substream_t *s)
+  { /* Box-Muller on the pairs (v[2k], v[2k+1]) of uniform draws; an  */
+    /* odd n takes one more draw for the pair of the last variate      */
+    int i; real r,t,u[2];
+    rand_substream_fill(s,v,n-(n&1));
+    for (i=0; i+1<n; i+=2)
+      {
+        r=sqrt(-2.0*log(v[i])); t=2.0*M_PI*v[i+1];
+        v[i]=x+sd*r*cos(t); v[i+1]=x+sd*r*sin(t);
+      }
+    if (n&1) then
+      {
+        rand_substream_fill(s,u,2);
+        v[n-1]=x+sd*sqrt(-2.0*log(u[0]))*cos(2.0*M_PI*u[1]);
+      }
+  }
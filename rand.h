@@ -23,9 +23,26 @@
 //typedef double real;
 #define then
 
+/* generator behind the streams of stream(), selected at build time     */
+/* with -DRAND_GENERATOR_TYPE=n (see RAND_GENERATOR in Makefile)         */
+#define RAND_GENERATOR_DRAND48 0  /* one drand48() state per simulation context */
+#define RAND_GENERATOR_PHILOX  1  /* counter-based Philox4x32-10 substream per stream */
+
+#ifndef RAND_GENERATOR_TYPE
+#define RAND_GENERATOR_TYPE RAND_GENERATOR_DRAND48
+#endif
+
+/* entity types of the counter-based substreams */
+#define RAND_ENTITY_STREAM 0          /* stream 1 thru 15 of stream()        */
+#define RAND_ENTITY_VEHICLE 1         /* vehicle with its vehicle id         */
+#define RAND_ENTITY_AP 2              /* access point with its AP id         */
+#define RAND_ENTITY_PACKET_SOURCE 3   /* packet source with its vehicle id   */
+#define RAND_ENTITY_TRAFFIC_SOURCE 4  /* vehicle entrance with its intersection id */
+
 /* function declarations */
 int stream(int n);
 long seed(long Ik, int n);
+void seed_random(long seedval); //initialize the drand48() generator of the current simulation context as srand48() does
 double uniform(double a, double b);
 
 int smpl_random(int i, int n); //return a random integer with uniform distribution
@@ -37,4 +54,19 @@ real erlang(real x, real s);
 real hyperx(real x, real s);
 real normal(real x, real s);
 
+/* counter-based substreams: the draw of index i of the substream of   */
+/* (seed, entity type, entity id) is the same regardless of the order  */
+/* in which the entities draw, so it can also be computed in parallel  */
+void rand_substream_init(rand_substream_t *s, unsigned long seedval, int entity_type, int entity_id); //initialize substream s of entity (entity_type, entity_id) under seedval, starting at draw index 0
+double rand_counter_uniform01(rand_substream_t *s, unsigned long long index); //return the uniform (0, 1) variate of draw index in substream s without changing its position
+double rand_substream_uniform01(rand_substream_t *s); //return the uniform (0, 1) variate of the next draw in substream s
+rand_substream_t* rand_use_substream(rand_substream_t *s); //let the random variate generators draw from substream s instead of the current stream until it is called with NULL; it returns the substream used so far
+unsigned long rand_current_seed(); //return the seed given to seed_random() in the current simulation context
+
+/* batched variate generation from a substream: the draws are computed */
+/* block by block in a loop without dependencies between iterations   */
+void uniform_batch(real *v, int n, real a, real b, rand_substream_t *s); //fill v[0..n-1] with uniform [a, b] variates
+void expntl_batch(real *v, int n, real x, rand_substream_t *s); //fill v[0..n-1] with exponential variates with mean x
+void normal_batch(real *v, int n, real x, real sd, rand_substream_t *s); //fill v[0..n-1] with normal variates with mean x and standard deviation sd by the Box-Muller transform
+
 #endif
@@ -89,7 +89,7 @@ struct_path_node* Random_Path_Make_Path_List(int src, int dst, struct_graph_node
 				Count--;
 			}
 
-			Z = atoi(Z_Node->vertex);
+			Z = Z_Node->vertex_id;
 			Weight = Random_Path_Get_Weight(X, Z, G, G_size); //obtain the length of edge (X,Z) 
 			TotalDistance = Weight + LengthFromSrc + LengthFromDst + D[Z-1][Y-1];
 			if((TotalDistance > Length) || (Z == Y))
@@ -120,7 +120,7 @@ struct_path_node* Random_Path_Make_Path_List(int src, int dst, struct_graph_node
 				Count--;
 			} //end of while-2
 
-			Z = atoi(Z_Node->vertex);
+			Z = Z_Node->vertex_id;
 			Weight = Random_Path_Get_Weight(Y, Z, G, G_size);
 			TotalDistance = Weight + LengthFromSrc + LengthFromDst + D[Z-1][X-1];
 			if((TotalDistance > Length) || (Z == X))
@@ -223,7 +223,7 @@ struct_path_node* Random_Path_Make_Path_List_Before_The_Closest_Protection_Point
 				Count--;
 			}
 
-			Z = atoi(Z_Node->vertex);
+			Z = Z_Node->vertex_id;
 			Weight = Random_Path_Get_Weight(X, Z, G, G_size);
 			TotalDistance = Weight + LengthFromSrc + LengthFromDst + D[Z-1][Y-1];
 			if((TotalDistance > Length) || (Z == Y))
@@ -253,7 +253,7 @@ struct_path_node* Random_Path_Make_Path_List_Before_The_Closest_Protection_Point
 				Count--;
 			} //end of while-2
 
-			Z = atoi(Z_Node->vertex);
+			Z = Z_Node->vertex_id;
 			Weight = Random_Path_Get_Weight(Y, Z, G, G_size);
 			TotalDistance = Weight + LengthFromSrc + LengthFromDst + D[Z-1][X-1];
 			if((TotalDistance > Length) || (Z == X))
@@ -323,6 +323,7 @@ struct_path_node* Random_Path_List_Backward_Insert(struct_path_node* h, struct_p
 	
 	//_itoa(u, path_node->vertex, 10);
 	sprintf(path_node->vertex, "%d", u);	
+	path_node->vertex_id = u;
 	path_node->weight = 0;
 
 	if(h != y) //y indicates a node different from the path list's head h whose weight indicates the number of nodes in the path
@@ -355,6 +356,7 @@ struct_path_node* Random_Path_List_Forward_Insert(struct_path_node* h, struct_pa
 	
 	//_itoa(u, path_node->vertex, 10);
 	sprintf(path_node->vertex, "%d", u);	
+	path_node->vertex_id = u;
 	path_node->weight = w;
 	
 	path_node->next = path_list->next;
@@ -379,8 +381,8 @@ struct_path_node* Random_Path_List_Middle_Insert(struct_path_node* h, struct_pat
 	int i, j; //node index = node ID - 1
 	double w; //edge weight
 
-	i = atoi(x->vertex) - 1;
-	j = atoi(y->vertex) - 1;
+	i = x->vertex_id - 1;
+	j = y->vertex_id - 1;
 
 	if(i == j) //there is no node to insert in the middle of the path from x to y
 		return h;
@@ -394,7 +396,7 @@ struct_path_node* Random_Path_List_Middle_Insert(struct_path_node* h, struct_pat
 		{
 			//update the weight of edge <u,v> 
 			v = j + 1;
-			u = atoi(y->vertex);
+			u = y->vertex_id;
 			w = Random_Path_Get_Weight(u, v, G, G_size);
 			y->weight = w; //set edge (u,v)'s weight to w
 
@@ -426,7 +428,7 @@ double Random_Path_Get_Weight(int u, int v, struct_graph_node *G, int G_size)
 	}
 
 	node = &G[u-1];
-	while(atoi(node->vertex) != v)
+	while(node->vertex_id != v)
 	{
 		node = node->next;
 	}
@@ -236,7 +236,7 @@ void ConstructScheduleTable(schedule_table_t *T, parameter_t *param, struct_grap
 				Enqueue((queue_t *)&Q, (queue_node_t *)&queue_node); //enqueue queue_node into Q		
 		} //end of for
 
-		free(pQueueNode); //free the memory allocated to pQueueNode
+		FreeQueueNode(Q.type, (queue_node_t*)pQueueNode); //free the memory allocated to pQueueNode
 	} //end of while
 }
 
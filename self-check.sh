@@ -0,0 +1,92 @@
+#!/bin/sh
+#@self-check.sh: rebuild the simulator with each self-check flag turned on and run a small scenario per flag
+#usage: sh self-check.sh [GSL_INCLUDE] [GSL_LIBRARY], or make selfcheck
+#each self-check compares an optimized path with its reference computation during the run and exits with a nonzero status on a mismatch
+
+GSL_INCLUDE=${1:-"-I $HOME/usr/include"}
+GSL_LIBRARY=${2:-"-L $HOME/usr/lib"}
+
+SRC_DIR=$(cd "$(dirname "$0")" && pwd)
+WORK_DIR=$(mktemp -d "${TMPDIR:-/tmp}/vanet-self-check.XXXXXX")
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+FAIL_COUNT=0
+
+#run_check name "self-check flags" "vanet options" [pattern that the output must contain]
+run_check() {
+	name=$1
+	flags=$2
+	options=$3
+	pattern=$4
+	build_dir=$WORK_DIR/$name
+
+	mkdir -p "$build_dir/output"
+	(cd "$SRC_DIR" && tar cf - --exclude=.git --exclude=output --exclude='*.o' --exclude='*.do' --exclude=./vanet --exclude=./vanet.db .) | (cd "$build_dir" && tar xf -)
+
+	if ! make -C "$build_dir" vanet GSL_INCLUDE="$GSL_INCLUDE" GSL_LIBRARY="$GSL_LIBRARY" SELF_CHECK="$flags" > "$build_dir/make.log" 2>&1; then
+		echo "$name: FAIL (build; see $build_dir/make.log)"
+		tail -20 "$build_dir/make.log"
+		FAIL_COUNT=$((FAIL_COUNT + 1))
+		return
+	fi
+
+	if ! (cd "$build_dir" && ./vanet $options -x ./output/output.txt -y ./output/output.xls > run.log 2>&1); then
+		echo "$name: FAIL (run)"
+		grep -i "check\|error" "$build_dir/run.log" | grep -v "absolute_y" | tail -20
+		FAIL_COUNT=$((FAIL_COUNT + 1))
+		return
+	fi
+
+	if [ -n "$pattern" ] && ! grep -q "$pattern" "$build_dir/run.log" "$build_dir/output/output.txt"; then
+		echo "$name: FAIL (the run did not exercise the check: no \"$pattern\")"
+		FAIL_COUNT=$((FAIL_COUNT + 1))
+		return
+	fi
+
+	echo "$name: OK"
+}
+
+#incremental repair of the EDD/EDC all-pairs shortest path matrices vs. the Floyd-Warshall rebuild at each EDD update with changed edge weights;
+#the change ratio threshold is lifted so that every update is repaired instead of rebuilt
+run_check apsp-incremental-update \
+	"-DAPSP_INCREMENTAL_UPDATE_FLAG=1 -DAPSP_INCREMENTAL_UPDATE_SELF_CHECK_FLAG=1 -DAPSP_INCREMENTAL_UPDATE_CHANGE_RATIO_THRESHOLD=1.0" \
+	"-F 1 -j 3" \
+	"repaired=[1-9]"
+
+#memoized delivery probabilities vs. their recomputation with the GSL numerical integration at each memo hit
+run_check gsl-probability-memo \
+	"-DGSL_PROBABILITY_MEMO_SELF_CHECK_FLAG=1 -DGSL_PROBABILITY_MEMO_STATISTICS_FLAG=1" \
+	"-f 2 -j 3" \
+	"hits=[1-9]"
+
+#branch-and-bound multi-target-point selection vs. the exhaustive search over all the combinations of target points
+run_check target-point-branch-and-bound \
+	"-DTARGET_POINT_BRANCH_AND_BOUND_SELF_CHECK_FLAG=1" \
+	"-F 1 -W 1 -j 10" \
+	"branch_and_bound_self_check: checked=[1-9]"
+
+#batched target point selection vs. the per-candidate selection with Compute_TargetPoint_OptimizationValue() for every destination vehicle trajectory
+run_check target-point-batch-evaluation \
+	"-DTARGET_POINT_BATCH_EVALUATION_SELF_CHECK_FLAG=1" \
+	"-F 1 -j 10" \
+	"target_point_batch_self_check: checked=[1-9]"
+
+#prefix-sum distance, travel time and hop queries along the vehicle trajectories and path lists vs. the walk of their linked lists
+run_check trajectory-prefix-sum \
+	"-DTRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG=1" \
+	"-F 1 -j 3" \
+	"trajectory_prefix_sum_self_check: checked=[1-9]"
+
+#lookups of the shared forwarding graph vs. the callers still holding the graph of another forwarding table
+run_check forwarding-table-lookup \
+	"-DFORWARDING_TABLE_LOOKUP_SELF_CHECK_FLAG=1" \
+	"-F 1 -j 3" \
+	"forwarding_table_lookup_self_check: checked=[1-9]"
+
+if [ $FAIL_COUNT -ne 0 ]; then
+	echo "self-check: $FAIL_COUNT check(s) failed"
+	exit 1
+fi
+
+echo "self-check: all checks passed"
+exit 0
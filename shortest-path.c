@@ -282,6 +282,7 @@ struct_graph_node* Initialize_Graph(parameter_t *param, char *graph_file_name, i
 			G[i].gnode = ptr; //gnode points to itself
 			strcpy(vertex_buf, token); //vertex name
 			strcpy(G[i].vertex, vertex_buf);
+			G[i].vertex_id = atoi(G[i].vertex);
 			G[i].type = default_type; //graph node type
 			G[i].role = default_role; //graph node role
 			G[i].weight = 0; //indicate the degree (i.e., number of neighbors)
@@ -427,7 +428,7 @@ struct_graph_node* Initialize_Graph(parameter_t *param, char *graph_file_name, i
 				ptr->next = node;
 				ptr = node;
 				
-				node_id = atoi(node->vertex); //obtain the node id corresponding to node->vertex
+				node_id = node->vertex_id; //obtain the node id corresponding to node->vertex
 				ptr->gnode = &(G[node_id-1]); //let ptr->gnode point to the graph node in G[] corresponding to node_id in order to access the information (such as coordinate) of the graph node corresponding to node_id
 
 			        /** enqueue the angle queue node corresponding to the edge <G[i].vertex,ptr->vertex> into angle queue */
@@ -617,6 +618,7 @@ struct_graph_node* Make_Graph_Node(char *vertex, char *weight, char *density, GR
 	}
 
 	strcpy(node->vertex, vertex);
+	node->vertex_id = atoi(node->vertex);
 
 	/* set graph node's type */
 	node->type = type; //graph node's type
@@ -666,6 +668,7 @@ struct_graph_node* Make_Graph_Node2(char *vertex, double weight, double density,
 
 	/* set vertex name */
 	strcpy(node->vertex, vertex);
+	node->vertex_id = atoi(node->vertex);
 
 	/* set graph node's type */
 	node->type = type; //graph node's type
@@ -720,6 +723,65 @@ void Free_Graph(struct_graph_node *G, int G_size)
 	free(G); //free the node array
 }
 
+#if DIJKSTRA_INDEXED_HEAP_FLAG /* [ */
+struct_set_node* Dijkstra(struct_graph_node *G, int G_size, char *src)
+{ //run Dijkstra's algorithm to compute the single-source shortest path with an indexed heap keyed by vertex id
+	struct_set_node *S = NULL; //set for nodes included in the spanning tree set
+	struct_shortest_path_node *u = NULL, *v = NULL;
+	struct_graph_node *neighbor = NULL; //neighbor node for a given node u
+	struct_shortest_path_node *Q = NULL; //shortest path node for each vertex where Q[i] corresponds to G[i]
+	indexed_heap_t H; //minimum priority queue of the vertex ids not yet in set S
+	double weight; //edge weight between nodes u and v
+	int i;
+
+	Q = (struct_shortest_path_node*) calloc(G_size, sizeof(struct_shortest_path_node));
+	assert_memory(Q);
+	Indexed_Heap_Init(&H, G_size);
+
+	for(i = 0; i < G_size; i++)
+	{
+		if(strcmp(G[i].vertex, src) == 0)
+			Q[i].dist = 0;
+		else
+			Q[i].dist = INF;
+
+		strcpy(Q[i].vertex, G[i].vertex);
+		Q[i].gnode = &G[i]; //gnode indicates the position of graph node in order to use the pointer in Dijkstra's algorithm.
+		Q[i].pnode = NULL; //pnode indicates the position of the neighbor node towards source whose type is struct_set_node*.
+
+		Indexed_Heap_Append(&H, i+1, Q[i].dist);
+	}
+	Indexed_Heap_Build(&H); //build minimum priority heap
+
+	S = Set_Init(); //initialize set S
+
+	while(H.size > 0)
+	{
+		u = &Q[Indexed_Heap_Extract_Min(&H)-1]; //return the node with the minimum distance for source s
+		S = Set_Insert(S, u); //insert node u into SET
+		for(neighbor = u->gnode->next; neighbor != NULL; neighbor = neighbor->next)
+		{
+			if(Indexed_Heap_Contains(&H, neighbor->vertex_id) == FALSE)
+				continue; //the neighor node is already in set S, so we don't need to update the distance
+
+			v = &Q[neighbor->vertex_id-1];
+			weight = neighbor->weight; //edge weight between nodes u and v
+			if(v->dist > u->dist + weight)
+			{
+				v->dist = u->dist + weight;
+				strcpy(v->parent, u->vertex);
+				v->pnode = S->prev;
+				Indexed_Heap_Decrease_Key(&H, neighbor->vertex_id, v->dist);
+			}
+		}
+	} //end of while
+
+	Indexed_Heap_Free(&H);
+	free(Q);
+
+	return S;
+}
+#else
 struct_set_node* Dijkstra(struct_graph_node *G, int G_size, char *src)
 { //run Dijkstra's algorithm to compute the single-source shortest path
 	struct_set_node *S = NULL; //set for nodes included in the spanning tree set
@@ -752,6 +814,7 @@ struct_set_node* Dijkstra(struct_graph_node *G, int G_size, char *src)
 
 	return S;
 }
+#endif /* ] */
 
 struct_shortest_path_node* Initialize_MIN_Priority_Queue(struct_graph_node *G, int G_size, char *src)
 { //initialize a minimum priority queue based on heap for Dijkstra's algorithm
@@ -947,6 +1010,7 @@ struct_path_node* Path_List_Reverse_Insert(struct_path_node *path_list, struct_s
         path_node = (struct_path_node*) calloc(1, sizeof(struct_path_node));
 	assert_memory(path_node); //assert the memory allocation
 	strcpy(path_node->vertex, u->node.vertex);
+	path_node->vertex_id = atoi(path_node->vertex);
 	gnode = u->node.gnode;
 	pnode = u->node.pnode;
 
@@ -977,6 +1041,7 @@ struct_path_node* Path_List_Add(struct_path_node *path_list, struct_path_node *u
         path_node = (struct_path_node*) calloc(1, sizeof(struct_path_node));
 	assert_memory(path_node); //assert the memory allocation
 	strcpy(path_node->vertex, u->vertex);
+	path_node->vertex_id = atoi(path_node->vertex);
 	
 	path_node->prev = path_list->prev;
 	path_list->prev->next = path_node;
@@ -1155,6 +1220,7 @@ struct_path_node* Make_Path_List_For_Given_Trajectory(int *trajectory, int traje
 	  memset(node_name, 0, sizeof(node_name));
 	  sprintf(node_name, "%d", node_id);
 	  strcpy(path_node->vertex, node_name);
+	  path_node->vertex_id = node_id;
 	  if(i == 0)
 	    path_node->weight = 0;
 	  else
@@ -1206,6 +1272,7 @@ struct_path_node* Make_Forward_Path_List_With_Mobility_List(mobility_queue_t *Q,
     memset(node_name, 0, sizeof(node_name));
     sprintf(node_name, "%d", node_id);
     strcpy(path_node->vertex, node_name);
+    path_node->vertex_id = node_id;
     if(i == 0)
       path_node->weight = 0;
     else
@@ -1262,6 +1329,7 @@ struct_path_node* Make_Backward_Path_List_With_Mobility_List(mobility_queue_t *Q
     memset(node_name, 0, sizeof(node_name));
     sprintf(node_name, "%d", node_id);
     strcpy(path_node->vertex, node_name);
+    path_node->vertex_id = node_id;
     if(i == 0)
       path_node->weight = 0;
     else
@@ -1415,7 +1483,7 @@ boolean IsNeighbor(int X, int Y, struct_graph_node *G, int G_size)
 
 	while(node != NULL)
 	{
-		v = atoi(node->vertex);
+		v = node->vertex_id;
 		if(v == Y)
 		{
 			flag = TRUE;
@@ -1828,7 +1896,7 @@ double** Construct_Adjacency_Matrix(struct_graph_node *G, int G_size)
 
 		while(ptr != NULL)
 		{
-			j = atoi(ptr->vertex) - 1; 
+			j = ptr->vertex_id - 1; 
 			//node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 			W[i][j] = ptr->weight;
 			ptr = ptr->next;
@@ -4103,7 +4171,7 @@ void  DeleteIntersection_EDD_Queue_Node(struct_graph_node *G, int G_size, char *
 
   Q->size--;
 
-  free(pQueueNode);
+  FreeQueueNode(Q->type, (queue_node_t*)pQueueNode);
 }
 
 void InitTrafficTable(struct_traffic_table* table)
@@ -4663,6 +4731,7 @@ struct_graph_node* GetUnusedGraphNode(struct_graph_node **Gv, int *Gv_size)
 
   /* initialize the available graph node for the new usage */
   sprintf(ptr_graph_node->vertex, "%d", index+1);
+  ptr_graph_node->vertex_id = index+1;
   ptr_graph_node->status = USAGE_USED;
   ptr_graph_node->type = HOLE_GRAPH_NODE; //graph node that is a sensing hole
   ptr_graph_node->role = ROLE_HOLE_ENDPOINT; //graph node role as a sensing hole  
@@ -4935,6 +5004,7 @@ void CopyGraphNodeAndNeighborList(struct_graph_node* src, struct_graph_node* dst
   /** initialize node information */
   dst->gnode = dst; //gnode points to itself
   strcpy(dst->vertex, src->vertex); //vertex name
+  dst->vertex_id = src->vertex_id; //vertex id
   dst->type = src->type; //graph node type
   dst->role = src->role; //graph node role
   dst->weight = 0; //number of neighboring vertices
@@ -5020,6 +5090,7 @@ void Make_Intersection_EDD_Queue_And_NeighborList_For_VirtualNode(int virtual_no
   itoa(virtual_node_id, virtual_node);
   dst->gnode = dst; //gnode points to itself
   strcpy(dst->vertex, virtual_node); //virtual node name
+  dst->vertex_id = virtual_node_id; //virtual node id
   dst->type = virtual_node_type; //graph node type
   dst->role = virtual_node_role; //graph node role
   dst->weight = 0; //number of neighboring vertices
@@ -5606,6 +5677,9 @@ int GetTargetPoint_For_Multiple_APs(parameter_t *param, double current_time, acc
        3. LTP (Last Trajectory Point): select the AP that has the shortest delivery delay to the last trajectory point of the destination vehicle; this allows the packet to arrive at the last trajectory point earlier than the destination vehicle.
     */
 
+    /* bring the offsets of the vehicles up to date under STEP_ANALYTIC before the target point selection reads the destination vehicle's position */
+    update_all_vehicle_positions_on_demand(param, current_time);
+
     /* determine the target point (i.e., intersection id) towards which this packet is sent */
     if((param->vehicle_vanet_target_point_computation_method == VANET_TARGET_POINT_COMPUTATION_METHOD_PACKET_TRAJECTORY_STATIC_FORWARDING) || (param->vehicle_vanet_target_point_computation_method == VANET_TARGET_POINT_COMPUTATION_METHOD_PACKET_TRAJECTORY_PARTIALLY_DYNAMIC_FORWARDING) || (param->vehicle_vanet_target_point_computation_method == VANET_TARGET_POINT_COMPUTATION_METHOD_PACKET_TRAJECTORY_FULLY_DYNAMIC_FORWARDING))
     {
@@ -5639,6 +5713,9 @@ int GetTargetPoint_For_AP(parameter_t *param, double current_time, char *AP_vert
 { // get the intersection id of a target point for AP where the target point is on the vehicle trajectory used to deliver a packet towards vehicle that is a destination vehicle
   int target_point_id = 0; //target point id
 
+  /* bring the offsets of the vehicles up to date under STEP_ANALYTIC before the target point selection reads the destination vehicle's position */
+  update_all_vehicle_positions_on_demand(param, current_time);
+
   /* determine the target point (i.e., intersection id) towards which this packet is sent */
   if(param->vehicle_vanet_target_point_computation_method == VANET_TARGET_POINT_COMPUTATION_METHOD_OPTIMAL_INTERSECTION)
   {
@@ -5690,6 +5767,9 @@ int GetMultipleTargetPoints_For_AP(parameter_t *param, double current_time, char
 	DestroyQueue((queue_t*)TPQ);
   }
 
+  /* bring the offsets of the vehicles up to date under STEP_ANALYTIC before the target point selection reads the destination vehicle's position */
+  update_all_vehicle_positions_on_demand(param, current_time);
+
   /* determine the list of target points (i.e., intersection ids) towards which the copies of this packet are sent */
   if(param->vehicle_vanet_target_point_computation_method == VANET_TARGET_POINT_COMPUTATION_METHOD_RANDOM_INTERSECTION)
   {
@@ -5719,6 +5799,9 @@ int GetTargetPoint_For_Carrier(parameter_t *param, double current_time, struct_v
 { // get the intersection id of a target point for carrier vehicle where the target point is on the destination vehicle trajectory in the carrier's packet
   int target_point_id = 0; //target point id
 
+  /* bring the offsets of the vehicles up to date under STEP_ANALYTIC before the target point selection reads the destination vehicle's position */
+  update_all_vehicle_positions_on_demand(param, current_time);
+
   /* determine the target point (i.e., intersection id) towards which this packet is sent */
   if(param->vehicle_vanet_target_point_computation_method == VANET_TARGET_POINT_COMPUTATION_METHOD_OPTIMAL_INTERSECTION)
   {
@@ -5760,6 +5843,9 @@ int GetTargetPoint_For_Carrier_At_TrajectoryIntersection_Before_DestinationVehic
 { // get the intersection id of a target point for carrier vehicle that is within the communication range of an intersection on the destination vehicle trajectory where the intersection is before the destination vehicle on the trajectory
   int target_point_id = 0; //target point id
 
+  /* bring the offsets of the vehicles up to date under STEP_ANALYTIC before the target point selection reads the destination vehicle's position */
+  update_all_vehicle_positions_on_demand(param, current_time);
+
   /* determine the target point (i.e., intersection id) towards which this packet is sent */
   if(param->vehicle_vanet_target_point_computation_method == VANET_TARGET_POINT_COMPUTATION_METHOD_OPTIMAL_INTERSECTION)
   {
@@ -5803,9 +5889,12 @@ int GetTargetPoint_For_StationaryNode(parameter_t *param, double current_time, s
   double EAD_VAR_p = 0; //EAD_VAR_p is the variance of the destination vehicle's arrival delay to target point p
   double EAD_SD_p = 0; //EAD_SD_p is the standard deviation of the destination vehicle's arrival delay to target point p
 
+#if !TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
   double value = 0 ;//value used for selecting an optimal intersection based on (EDD_p, EDD_SD_p) and (EAD_p, EAD_SD_p)
+#endif /* ] */
   double min_value = INF; //minimum value for selecting an optimal intersection
   char min_value_target_point[NAME_SIZE] = ""; //target point with min_value
+  int min_value_target_point_id = 0; //target point id with min_value
 
   int i = 0; //for-loop index
   char current_edge_tail_node[NAME_SIZE] = ""; //tail node of the current edge pointed by vehicle->path_ptr
@@ -5830,6 +5919,9 @@ int GetTargetPoint_For_StationaryNode(parameter_t *param, double current_time, s
   double packet_ttl = 0; //packet's TTL
   /**********************************************************************/
 
+  /* bring the offsets of the vehicles up to date under STEP_ANALYTIC before the target point selection reads the destination vehicle's position */
+  update_all_vehicle_positions_on_demand(param, current_time);
+
   /** check whether this stationary node has packets or not; if there is no packet, return the stationary node's latest target point */
   if(stationary_node->packet_queue.size == 0)
   {
@@ -5896,6 +5988,9 @@ int GetTargetPoint_For_StationaryNode(parameter_t *param, double current_time, s
   pTrajectory_QNode = pCurrent_Trajectory_QNode; //Note that the first point to check is the tail node of the current edge
 
 
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+  Reset_TargetPoint_Batch();
+#endif /* ] */
   for(i = 0; i < path_node_number; i++)
   {
     /* For infinite trajectory length type, if pTrajectory_QNode is the queue head, then let pTrajectory_QNode point to head->next */
@@ -5958,6 +6053,10 @@ int GetTargetPoint_For_StationaryNode(parameter_t *param, double current_time, s
 
     /* update min_value and min_value_target_point */ 
     //value = fabs(EDD_p - EAD_p);
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+    /* collect the candidate into the batch scored after the pass over the trajectory */
+    Append_TargetPoint_To_Batch(target_point_id, EDD_p, EDD_SD_p, EAD_p, EAD_SD_p);
+#else
     value = Compute_TargetPoint_OptimizationValue(param, target_point_id, EDD_p, EDD_SD_p, EAD_p, EAD_SD_p, packet_ttl, &max_constraint_value, &max_constraint_value_target_point_id); //compute the optimization value for an intersection i that is an optimal target point candidate given the the packet delivery delay distribution (EDD_p, EDD_SD_p) and the destination vehicle arrival delay distribution (EAD_p, EAD_SD_p).
 
 #ifdef __DEBUG_LEVEL_TARGET_POINT_SEARCH_BY_STATIONARY_NODE__
@@ -5971,10 +6070,18 @@ int GetTargetPoint_For_StationaryNode(parameter_t *param, double current_time, s
       *EDD_p_for_optimal_target_point = EDD_p;
       *EAD_p_for_optimal_target_point = EAD_p;
     }
+#endif /* ] */
 
     pTrajectory_QNode = pTrajectory_QNode->next; //pTrajectory_QNode points to the next node on the trajectory
   }
 
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+  /* score all the candidates on the trajectory in one sweep */
+  Select_TargetPoint_From_Batch(param, packet_ttl, &min_value, &min_value_target_point_id, EDD_p_for_optimal_target_point, EAD_p_for_optimal_target_point, &max_constraint_value, &max_constraint_value_target_point_id);
+  if(min_value < INF)
+    itoa(min_value_target_point_id, min_value_target_point);
+#endif /* ] */
+
 #ifdef __DEBUG_LEVEL_TARGET_POINT_SEARCH_BY_STATIONARY_NODE__
   printf("GetTargetPoint_For_StationaryNode(): optimal target point=%s, min_value=%.2f\n", min_value_target_point, min_value);
   fgetc(stdin);
@@ -6017,9 +6124,12 @@ int GetTargetPoint_For_Packet(parameter_t *param, double current_time, packet_qu
   double EAD_VAR_p = 0; //EAD_VAR_p is the variance of the destination vehicle's arrival delay to target point p
   double EAD_SD_p = 0; //EAD_SD_p is the standard deviation of the destination vehicle's arrival delay to target point p
 
+#if !TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
   double value = 0 ;//value used for selecting an optimal intersection based on (EDD_p, EDD_SD_p) and (EAD_p, EAD_SD_p)
+#endif /* ] */
   double min_value = INF; //minimum value for selecting an optimal intersection
   char min_value_target_point[NAME_SIZE] = ""; //target point with min_value
+  int min_value_target_point_id = 0; //target point id with min_value
 
   int i = 0; //for-loop index
   char current_edge_tail_node[NAME_SIZE] = ""; //tail node of the current edge pointed by vehicle->path_ptr
@@ -6044,6 +6154,9 @@ int GetTargetPoint_For_Packet(parameter_t *param, double current_time, packet_qu
   double packet_ttl = packet->ttl; //packet's TTL
   /**********************************************************************/
 
+  /* bring the offsets of the vehicles up to date under STEP_ANALYTIC before the target point selection reads the destination vehicle's position */
+  update_all_vehicle_positions_on_demand(param, current_time);
+
   /** pointer to the destination vehicle for the packet that is used to check whether the trajectory reflects the destination's movement well or not */
   destination_vehicle = packet->dst_vnode; 
 
@@ -6093,6 +6206,9 @@ int GetTargetPoint_For_Packet(parameter_t *param, double current_time, packet_qu
   pTrajectory_QNode = pCurrent_Trajectory_QNode; //Note that the first point to check is the tail node of the current edge
 
 
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+  Reset_TargetPoint_Batch();
+#endif /* ] */
   for(i = 0; i < path_node_number; i++)
   {
     /* For infinite trajectory length type, if pTrajectory_QNode is the queue head, then let pTrajectory_QNode point to head->next */
@@ -6159,6 +6275,10 @@ int GetTargetPoint_For_Packet(parameter_t *param, double current_time, packet_qu
 
     /* update min_value and min_value_target_point */ 
     //value = fabs(EDD_p - EAD_p);
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+    /* collect the candidate into the batch scored after the pass over the trajectory */
+    Append_TargetPoint_To_Batch(target_point_id, EDD_p, EDD_SD_p, EAD_p, EAD_SD_p);
+#else
     value = Compute_TargetPoint_OptimizationValue(param, target_point_id, EDD_p, EDD_SD_p, EAD_p, EAD_SD_p, packet_ttl, &max_constraint_value, &max_constraint_value_target_point_id); //compute the optimization value for an intersection i that is an optimal target point candidate given the the packet delivery delay distribution (EDD_p, EDD_SD_p) and the destination vehicle arrival delay distribution (EAD_p, EAD_SD_p).
 
 #ifdef __DEBUG_LEVEL_TARGET_POINT_SEARCH_BY_STATIONARY_NODE__
@@ -6172,10 +6292,18 @@ int GetTargetPoint_For_Packet(parameter_t *param, double current_time, packet_qu
       *EDD_p_for_optimal_target_point = EDD_p;
       *EAD_p_for_optimal_target_point = EAD_p;
     }
+#endif /* ] */
 
     pTrajectory_QNode = pTrajectory_QNode->next; //pTrajectory_QNode points to the next node on the trajectory
   }
 
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+  /* score all the candidates on the trajectory in one sweep */
+  Select_TargetPoint_From_Batch(param, packet_ttl, &min_value, &min_value_target_point_id, EDD_p_for_optimal_target_point, EAD_p_for_optimal_target_point, &max_constraint_value, &max_constraint_value_target_point_id);
+  if(min_value < INF)
+    itoa(min_value_target_point_id, min_value_target_point);
+#endif /* ] */
+
 #ifdef __DEBUG_LEVEL_TARGET_POINT_SEARCH_BY_STATIONARY_NODE__
   printf("GetTargetPoint_For_Packet(): optimal target point=%s, min_value=%.2f\n", min_value_target_point, min_value);
   fgetc(stdin);
@@ -6863,9 +6991,12 @@ int GetTargetPoint_By_PacketTrajectory_For_AP(parameter_t *param, double current
   double EAD_VAR_p = 0; //EAD_VAR_p is the variance of the destination vehicle's arrival delay to target point p
   double EAD_SD_p = 0; //EAD_SD_p is the standard deviation of the destination vehicle's arrival delay to target point p
 
+#if !TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
   double value = 0 ;//value used for selecting an optimal intersection based on (EDD_p, EDD_SD_p) and (EAD_p, EAD_SD_p)
+#endif /* ] */
   double min_value = INF; //minimum value for selecting an optimal intersection
   char min_value_target_point[NAME_SIZE]; //target point with min_value
+  int min_value_target_point_id = 0; //target point id with min_value
 
   int i = 0; //for-loop index
   char current_edge_tail_node[NAME_SIZE]; //tail node of the current edge pointed by vehicle->path_ptr
@@ -6895,6 +7026,9 @@ int GetTargetPoint_By_PacketTrajectory_For_AP(parameter_t *param, double current
 
   /** search an optimal target point p such that |EDD_p - EAD_p| is minimum. **/
   pPathNode = destination_vehicle->path_ptr; //Note that the first point to check is the tail node of the current edge
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+  Reset_TargetPoint_Batch();
+#endif /* ] */
   for(i = 0; i < path_node_number; i++)
   //for(i = 0; i < remaining_path_hop_count; i++)
   {
@@ -6955,6 +7089,10 @@ int GetTargetPoint_By_PacketTrajectory_For_AP(parameter_t *param, double current
 
     /* update min_value and min_value_target_point */ 
     //value = fabs(EDD_p - EAD_p);
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+    /* collect the candidate into the batch scored after the pass over the trajectory */
+    Append_TargetPoint_To_Batch(target_point_id, EDD_p, EDD_SD_p, EAD_p, EAD_SD_p);
+#else
     value = Compute_TargetPoint_OptimizationValue(param, target_point_id, EDD_p, EDD_SD_p, EAD_p, EAD_SD_p, packet_ttl, &max_constraint_value, &max_constraint_value_target_point_id); //compute the optimization value for an intersection i that is an optimal target point candidate given the the packet delivery delay distribution (EDD_p, EDD_SD_p) and the destination vehicle arrival delay distribution (EAD_p, EAD_SD_p).
 
 #ifdef __DEBUG_LEVEL_TARGET_POINT_SEARCH_BY_AP__
@@ -6968,10 +7106,18 @@ int GetTargetPoint_By_PacketTrajectory_For_AP(parameter_t *param, double current
       *EDD_p_for_optimal_target_point = EDD_p;
       *EAD_p_for_optimal_target_point = EAD_p;
     }
+#endif /* ] */
 
     pPathNode = pPathNode->next; //pPathNode points to the next node on the path
   }
 
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+  /* score all the candidates on the trajectory in one sweep */
+  Select_TargetPoint_From_Batch(param, packet_ttl, &min_value, &min_value_target_point_id, EDD_p_for_optimal_target_point, EAD_p_for_optimal_target_point, &max_constraint_value, &max_constraint_value_target_point_id);
+  if(min_value < INF)
+    itoa(min_value_target_point_id, min_value_target_point);
+#endif /* ] */
+
 #ifdef __DEBUG_LEVEL_TARGET_POINT_SEARCH_BY_AP__
   printf("GetTargetPoint_By_PacketTrajectory_For_AP(): optimal target point=%s, min_value=%.2f\n", min_value_target_point, min_value);
   fgetc(stdin);
@@ -6992,7 +7138,7 @@ int GetTargetPoint_By_PacketTrajectory_For_AP(parameter_t *param, double current
 	else
 	{	
 	    /* set the last intersection on the vehicle trajectory to the target point as last resort when there is no target point with positive max_constraint_value */
-        //last_trajectory_point = atoi(destination_vehicle->path_list->prev->prev->vertex);
+        //last_trajectory_point = destination_vehicle->path_list->prev->prev->vertex_id;
 
 		if(param->communication_multiple_SN_flag == TRUE)
 		{ /* the case where the partial deployment of stationary nodes is performed */
@@ -7005,7 +7151,7 @@ int GetTargetPoint_By_PacketTrajectory_For_AP(parameter_t *param, double current
 
 			do
 			{
-				id = atoi(pPathNode->vertex);
+				id = pPathNode->vertex_id;
 
 #if 0 /* [ */
 				printf("%s:%d packet_id=%d, target_point=%d\n", __FILE__, __LINE__, packet->id, id);
@@ -7039,7 +7185,7 @@ int GetTargetPoint_By_PacketTrajectory_For_AP(parameter_t *param, double current
 			}
 		}
 
-		last_trajectory_point = atoi(pPathNode->vertex);
+		last_trajectory_point = pPathNode->vertex_id;
 
 		/* check the validity of last_trajectory_point*/
 		if(last_trajectory_point == 0)
@@ -7085,9 +7231,12 @@ int GetTargetPoint_For_AP_For_V2V_Data_Delivery(parameter_t *param, double curre
 	double EAD_VAR_p = 0; //EAD_VAR_p is the variance of the destination vehicle's arrival delay to target point p
 	double EAD_SD_p = 0; //EAD_SD_p is the standard deviation of the destination vehicle's arrival delay to target point p
 
+#if !TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
 	double value = 0 ;//value used for selecting an optimal intersection based on (EDD_p, EDD_SD_p) and (EAD_p, EAD_SD_p)
+#endif /* ] */
 	double min_value = INF; //minimum value for selecting an optimal intersection
 	char min_value_target_point[NAME_SIZE]; //target point with min_value
+	int min_value_target_point_id = 0; //target point id with min_value
 
 	int i = 0; //for-loop index
 	char current_edge_tail_node[NAME_SIZE]; //tail node of the current edge pointed by vehicle->path_ptr
@@ -7103,6 +7252,9 @@ int GetTargetPoint_For_AP_For_V2V_Data_Delivery(parameter_t *param, double curre
 	*EDD_p_for_optimal_target_point = 0;
 	*EAD_p_for_optimal_target_point = 0;
 
+	/* bring the offsets of the vehicles up to date under STEP_ANALYTIC before the target point selection reads the destination vehicle's position */
+	update_all_vehicle_positions_on_demand(param, current_time);
+
 	/** copy the tail node of vehicle's current edge to current_edge_tail_node */
 	strcpy(current_edge_tail_node, destination_vehicle->path_ptr->vertex);
 
@@ -7112,6 +7264,9 @@ int GetTargetPoint_For_AP_For_V2V_Data_Delivery(parameter_t *param, double curre
 
 	/** search an optimal target point p such that |EDD_p - EAD_p| is minimum. **/
 	pPathNode = destination_vehicle->path_ptr; //Note that the first point to check is the tail node of the current edge
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+	Reset_TargetPoint_Batch();
+#endif /* ] */
 	for(i = 0; i < path_node_number; i++)
 	{
 		/* if pPathNode points to the path list's head, let it point to head->next */
@@ -7155,6 +7310,10 @@ int GetTargetPoint_For_AP_For_V2V_Data_Delivery(parameter_t *param, double curre
 
 		/* update min_value and min_value_target_point */ 
 		//value = fabs(EDD_p - EAD_p);
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+		/* collect the candidate into the batch scored after the pass over the trajectory */
+		Append_TargetPoint_To_Batch(target_point_id, EDD_p, EDD_SD_p, EAD_p, EAD_SD_p);
+#else
 		value = Compute_TargetPoint_OptimizationValue(param, target_point_id, EDD_p, EDD_SD_p, EAD_p, EAD_SD_p, packet_ttl, &max_constraint_value, &max_constraint_value_target_point_id); //compute the optimization value for an intersection i that is an optimal target point candidate given the the packet delivery delay distribution (EDD_p, EDD_SD_p) and the destination vehicle arrival delay distribution (EAD_p, EAD_SD_p).
 
 #ifdef __DEBUG_LEVEL_TARGET_POINT_SEARCH_BY_AP__
@@ -7168,10 +7327,18 @@ int GetTargetPoint_For_AP_For_V2V_Data_Delivery(parameter_t *param, double curre
 			*EDD_p_for_optimal_target_point = EDD_p;
 			*EAD_p_for_optimal_target_point = EAD_p;
 		}
+#endif /* ] */
 
 		pPathNode = pPathNode->next; //pPathNode points to the next node on the path
 	}
 
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+	/* score all the candidates on the trajectory in one sweep */
+	Select_TargetPoint_From_Batch(param, packet_ttl, &min_value, &min_value_target_point_id, EDD_p_for_optimal_target_point, EAD_p_for_optimal_target_point, &max_constraint_value, &max_constraint_value_target_point_id);
+	if(min_value < INF)
+		itoa(min_value_target_point_id, min_value_target_point);
+#endif /* ] */
+
 #ifdef __DEBUG_LEVEL_TARGET_POINT_SEARCH_BY_AP__
 	printf("GetTargetPoint_By_PacketTrajectory_For_AP(): optimal target point=%s, min_value=%.2f\n", min_value_target_point, min_value);
 	fgetc(stdin);
@@ -7187,7 +7354,7 @@ int GetTargetPoint_For_AP_For_V2V_Data_Delivery(parameter_t *param, double curre
 		else
 		{	
 			/* set the last intersection on the vehicle trajectory to the target point as last resort when there is no target point with positive max_constraint_value */
-			//last_trajectory_point = atoi(destination_vehicle->path_list->prev->prev->vertex);
+			//last_trajectory_point = destination_vehicle->path_list->prev->prev->vertex_id;
 
 			if(param->communication_multiple_SN_flag == TRUE)
 			{ /* the case where the partial deployment of stationary nodes is performed */
@@ -7200,7 +7367,7 @@ int GetTargetPoint_For_AP_For_V2V_Data_Delivery(parameter_t *param, double curre
 
 				do
 				{
-					id = atoi(pPathNode->vertex);
+					id = pPathNode->vertex_id;
 
 #if 0 /* [ */
 					printf("%s:%d packet_id=%d, target_point=%d\n", __FILE__, __LINE__, packet->id, id);
@@ -7234,7 +7401,7 @@ int GetTargetPoint_For_AP_For_V2V_Data_Delivery(parameter_t *param, double curre
 				}
 			}
 
-			last_trajectory_point = atoi(pPathNode->vertex);
+			last_trajectory_point = pPathNode->vertex_id;
 
 			/* check the validity of last_trajectory_point*/
 			if(last_trajectory_point == 0)
@@ -7316,7 +7483,7 @@ int GetMultipleTargetPoints_By_PacketTrajectory_For_AP(parameter_t *param, doubl
 		if(pPathNode == destination_vehicle->path_list)
 			pPathNode = pPathNode->next->next;
 
-		target_point_id = atoi(pPathNode->vertex); //target_point_id is the tail node of an edge
+		target_point_id = pPathNode->vertex_id; //target_point_id is the tail node of an edge
 		w[k] = target_point_id;
 		pPathNode = pPathNode->next;
 
@@ -7338,7 +7505,11 @@ int GetMultipleTargetPoints_By_PacketTrajectory_For_AP(parameter_t *param, doubl
 		/* if there are such k target points for the requirement, 
 		 * stop the searching and return the list of target points 
 		 */
+#if TARGET_POINT_BRANCH_AND_BOUND_FLAG /* [ */
+		branch_and_bound_for_target_points(w, n, k, p, d, param, global_TPQ);
+#else
 		combinations_for_target_points(v, w, 1, n, 1, k, p, d, param, current_time, AP_vertex, destination_vehicle, packet, FTQ, global_TPQ);
+#endif /* ] */
 
 		if(global_TPQ->delivery_success_probability > 
 			param->communication_packet_delivery_probability_threshold)
@@ -7366,7 +7537,7 @@ int GetMultipleTargetPoints_By_PacketTrajectory_For_AP(parameter_t *param, doubl
 		    target_point_id = w[k];
 
 		  	//pPathNode = pPathNode->prev;
-			//target_point_id = atoi(pPathNode->vertex);
+			//target_point_id = pPathNode->vertex_id;
 			
 			/* initialize queue node */
 			memset(&qnode, 0, sizeof(target_point_queue_node_t));
@@ -8752,12 +8923,371 @@ int GetTargetPoint_By_OptimalIntersection_For_Carrier_At_TrajectoryIntersection_
   return target_point_id;
 }
 
+void Free_Trajectory_PrefixSum(trajectory_prefix_sum_t *prefix)
+{ //free the arrays of trajectory prefix sums prefix
+	free(prefix->distance);
+	free(prefix->distance_square);
+	free(prefix->node);
+	free(prefix->vertex);
+	free(prefix->tail_vertex);
+	free(prefix->vertex_next_hop);
+	free(prefix->vertex_table);
+	free(prefix->tail_vertex_table);
+
+	memset(prefix, 0, sizeof(trajectory_prefix_sum_t));
+}
+
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+static unsigned int Hash_Trajectory_Vertex(char *vertex)
+{ //compute the hash value of vertex name for the vertex-to-hop tables of trajectory prefix sums
+	unsigned int hash = 5381; //hash value
+
+	while(*vertex != '\0')
+		hash = hash*33 + (unsigned char)(*vertex++);
+
+	return hash;
+}
+
+static int Lookup_Trajectory_Vertex(int *table, int table_size, char **names, char *vertex)
+{ //return the hop that table keeps for vertex where the key of hop k is names[k], or -1 if vertex is not in table
+	unsigned int mask = table_size - 1; //mask for the slot index
+	unsigned int slot = Hash_Trajectory_Vertex(vertex) & mask; //slot index
+
+	while(table[slot] != -1)
+	{
+		if(strcmp(names[table[slot]], vertex) == 0)
+			return table[slot];
+
+		slot = (slot + 1) & mask;
+	}
+
+	return -1;
+}
+
+static void Insert_Trajectory_Vertex(int *table, int table_size, char **names, int *next_hop, int hop)
+{ //let table keep hop for names[hop] and chain the hop previously kept with next_hop if next_hop is not NULL; hops are inserted in descending order, so table keeps the first hop of each vertex
+	unsigned int mask = table_size - 1; //mask for the slot index
+	unsigned int slot = Hash_Trajectory_Vertex(names[hop]) & mask; //slot index
+
+	while(table[slot] != -1 && strcmp(names[table[slot]], names[hop]) != 0)
+		slot = (slot + 1) & mask;
+
+	if(next_hop != NULL)
+		next_hop[hop] = table[slot];
+
+	table[slot] = hop;
+}
+
+static void Reserve_Trajectory_PrefixSum(trajectory_prefix_sum_t *prefix, int size)
+{ //let the arrays of prefix hold size hops and empty its hash tables
+	int i = 0; //index for for-loop
+
+	if(size + 1 > prefix->capacity)
+	{
+		prefix->capacity = MAX(size + 1, 2*prefix->capacity);
+		prefix->distance = (double*) realloc(prefix->distance, prefix->capacity*sizeof(double));
+		prefix->distance_square = (double*) realloc(prefix->distance_square, prefix->capacity*sizeof(double));
+		prefix->node = (void**) realloc(prefix->node, prefix->capacity*sizeof(void*));
+		prefix->vertex = (char**) realloc(prefix->vertex, prefix->capacity*sizeof(char*));
+		prefix->tail_vertex = (char**) realloc(prefix->tail_vertex, prefix->capacity*sizeof(char*));
+		prefix->vertex_next_hop = (int*) realloc(prefix->vertex_next_hop, prefix->capacity*sizeof(int));
+		assert_memory(prefix->distance);
+		assert_memory(prefix->distance_square);
+		assert_memory(prefix->node);
+		assert_memory(prefix->vertex);
+		assert_memory(prefix->tail_vertex);
+		assert_memory(prefix->vertex_next_hop);
+
+		/* keep the load factor of the hash tables at most one half */
+		for(prefix->table_size = 16; prefix->table_size < 2*prefix->capacity; prefix->table_size *= 2);
+		prefix->vertex_table = (int*) realloc(prefix->vertex_table, prefix->table_size*sizeof(int));
+		prefix->tail_vertex_table = (int*) realloc(prefix->tail_vertex_table, prefix->table_size*sizeof(int));
+		assert_memory(prefix->vertex_table);
+		assert_memory(prefix->tail_vertex_table);
+	}
+
+	for(i = 0; i < prefix->table_size; i++)
+	{
+		prefix->vertex_table[i] = -1;
+		prefix->tail_vertex_table[i] = -1;
+	}
+
+	prefix->size = size;
+}
+
+static int Find_First_Trajectory_VertexHop_From(trajectory_prefix_sum_t *prefix, char *vertex, int start_hop)
+{ //find the first hop reaching vertex at or after start_hop, wrapping around to the first hop reaching vertex if there is none; return -1 if no hop reaches vertex
+	int first_hop = Lookup_Trajectory_Vertex(prefix->vertex_table, prefix->table_size, prefix->vertex, vertex); //first hop reaching vertex
+	int hop = first_hop; //hop in the chain of vertex
+
+	while(hop != -1 && hop < start_hop)
+		hop = prefix->vertex_next_hop[hop];
+
+	if(hop == -1)
+		hop = first_hop;
+
+	return hop;
+}
+
+static trajectory_prefix_sum_t* Get_VehiclePathList_PrefixSum(struct_vehicle_t *vehicle)
+{ //return the prefix sums along vehicle's path list after rebuilding them if the path list has changed since they were built; return NULL if the path list does not have path_hop_count hops
+	trajectory_prefix_sum_t *prefix = &(vehicle->path_prefix_sum); //prefix sums along the path list
+	struct_path_node *path_list = vehicle->path_list; //head of the path list
+	struct_path_node *pPathNode = NULL; //pointer to a path node
+	int hop_count = vehicle->path_hop_count; //number of hops on the path list
+	int k = 0; //index for for-loop
+
+	if(prefix->valid_flag == TRUE && prefix->trajectory == path_list && prefix->version == vehicle->tpd_trajectory_version)
+		return prefix;
+
+	prefix->valid_flag = FALSE;
+	if(path_list == NULL || hop_count <= 0 || path_list->next == path_list)
+		return NULL;
+
+	/** hop k (1 <= k <= hop_count) is the edge reaching the k-th path node; as in the walk of the path list, the vertex reached by the last hop is taken from the first path node */
+	Reserve_Trajectory_PrefixSum(prefix, hop_count);
+	pPathNode = path_list->next;
+	prefix->node[0] = pPathNode;
+	prefix->distance[0] = 0;
+	prefix->distance_square[0] = 0;
+	for(k = 1; k <= hop_count; k++)
+	{
+		pPathNode = pPathNode->next;
+		if(pPathNode == path_list)
+			return NULL;
+
+		prefix->node[k] = pPathNode;
+		prefix->vertex[k] = (k < hop_count ? pPathNode->vertex : path_list->next->vertex);
+		prefix->distance[k] = prefix->distance[k-1] + pPathNode->weight;
+		prefix->distance_square[k] = prefix->distance_square[k-1] + pPathNode->weight*pPathNode->weight;
+	}
+
+	if(pPathNode->next != path_list)
+		return NULL;
+
+	for(k = hop_count; k >= 1; k--)
+		Insert_Trajectory_Vertex(prefix->vertex_table, prefix->table_size, prefix->vertex, prefix->vertex_next_hop, k);
+
+	prefix->trajectory = path_list;
+	prefix->version = vehicle->tpd_trajectory_version;
+	prefix->valid_flag = TRUE;
+
+	return prefix;
+}
+
+static trajectory_prefix_sum_t* Get_VehicleTrajectory_PrefixSum(vehicle_trajectory_queue_t *pTrajectory_Queue)
+{ //return the prefix sums along pTrajectory_Queue after rebuilding them if the queue has changed since they were built
+	trajectory_prefix_sum_t *prefix = &(pTrajectory_Queue->prefix_sum); //prefix sums along the trajectory
+	vehicle_trajectory_queue_node_t *pTrajectory_QNode = &(pTrajectory_Queue->head); //pointer to a vehicle trajectory queue node
+	int size = pTrajectory_Queue->size; //number of hops on the trajectory
+	double edge_length = 0; //edge length
+	int k = 0; //index for for-loop
+
+	if(prefix->valid_flag == TRUE && prefix->trajectory == pTrajectory_Queue && prefix->size == size)
+		return prefix;
+
+	/** hop k (0 <= k < size) is the edge of the k-th trajectory queue node */
+	Reserve_Trajectory_PrefixSum(prefix, size);
+	prefix->distance[0] = 0;
+	prefix->distance_square[0] = 0;
+	for(k = 0; k < size; k++)
+	{
+		pTrajectory_QNode = pTrajectory_QNode->next;
+		edge_length = pTrajectory_QNode->graph_pos.enode->weight;
+
+		prefix->node[k] = pTrajectory_QNode;
+		prefix->vertex[k] = pTrajectory_QNode->graph_pos.enode->head_node;
+		prefix->tail_vertex[k] = pTrajectory_QNode->graph_pos.enode->tail_node;
+		prefix->distance[k+1] = prefix->distance[k] + edge_length;
+		prefix->distance_square[k+1] = prefix->distance_square[k] + edge_length*edge_length;
+	}
+
+	for(k = size - 1; k >= 0; k--)
+	{
+		Insert_Trajectory_Vertex(prefix->vertex_table, prefix->table_size, prefix->vertex, prefix->vertex_next_hop, k);
+		Insert_Trajectory_Vertex(prefix->tail_vertex_table, prefix->table_size, prefix->tail_vertex, NULL, k);
+	}
+
+	prefix->trajectory = pTrajectory_Queue;
+	prefix->valid_flag = TRUE;
+
+	return prefix;
+}
+
+static boolean Get_TargetPoint_Distance_On_VehiclePathList(struct_vehicle_t *vehicle, char *target_point, double *distance, double *distance_square)
+{ //get the sums of the edge lengths and of their squares from the head node of vehicle's current edge to the first target_point ahead on the path list; return FALSE if the prefix sums cannot answer, so that the caller walks the path list
+	trajectory_prefix_sum_t *prefix = Get_VehiclePathList_PrefixSum(vehicle); //prefix sums along the path list
+	int hop_count = 0; //number of hops on the path list
+	int start_hop = 0; //hop reaching the head node of the current edge
+	int hop = 0; //hop reaching target_point
+
+	if(prefix == NULL)
+		return FALSE;
+
+	hop_count = prefix->size;
+	if(vehicle->path_current_hop < 0 || vehicle->path_current_hop >= hop_count || prefix->node[vehicle->path_current_hop] != vehicle->path_ptr)
+		return FALSE;
+
+	start_hop = vehicle->path_current_hop + 1;
+	hop = Find_First_Trajectory_VertexHop_From(prefix, target_point, start_hop);
+	if(hop == -1)
+		return FALSE; //let the walk handle the trajectory of two vertices and report a missing target point
+
+	if(hop >= start_hop)
+	{
+		*distance = prefix->distance[hop] - prefix->distance[start_hop];
+		*distance_square = prefix->distance_square[hop] - prefix->distance_square[start_hop];
+	}
+	else
+	{ //target_point is reached after wrapping around the path list
+		*distance = (prefix->distance[hop_count] - prefix->distance[start_hop]) + prefix->distance[hop];
+		*distance_square = (prefix->distance_square[hop_count] - prefix->distance_square[start_hop]) + prefix->distance_square[hop];
+	}
+
+	return TRUE;
+}
+
+static boolean Get_TargetPoint_Distance_On_VehicleTrajectory(vehicle_trajectory_queue_t *pTrajectory_Queue, vehicle_trajectory_queue_node_t *pCurrent_Trajectory_QNode, char *target_point, double *distance, double *distance_square)
+{ //get the sums of the edge lengths and of their squares from the head node of pCurrent_Trajectory_QNode's edge to the first target_point ahead on pTrajectory_Queue; return FALSE if the prefix sums cannot answer, so that the caller walks the trajectory
+	trajectory_prefix_sum_t *prefix = Get_VehicleTrajectory_PrefixSum(pTrajectory_Queue); //prefix sums along the trajectory
+	int size = prefix->size; //number of hops on the trajectory
+	int current_hop = pCurrent_Trajectory_QNode->order; //hop of the current trajectory queue node
+	int hop = 0; //hop reaching target_point
+
+	if(current_hop < 0 || current_hop >= size || prefix->node[current_hop] != pCurrent_Trajectory_QNode)
+		return FALSE;
+
+	hop = Find_First_Trajectory_VertexHop_From(prefix, target_point, current_hop);
+	if(hop == -1)
+		return FALSE; //let the walk report a missing target point
+
+	if(hop >= current_hop)
+	{
+		*distance = prefix->distance[hop+1] - prefix->distance[current_hop+1];
+		*distance_square = prefix->distance_square[hop+1] - prefix->distance_square[current_hop+1];
+	}
+	else
+	{ //target_point is reached after wrapping around the trajectory
+		*distance = (prefix->distance[size] - prefix->distance[current_hop+1]) + prefix->distance[hop+1];
+		*distance_square = (prefix->distance_square[size] - prefix->distance_square[current_hop+1]) + prefix->distance_square[hop+1];
+	}
+
+	return TRUE;
+}
+
+static boolean Find_VehicleTrajectory_Position_For_TravelDistance(parameter_t *param, vehicle_trajectory_queue_t *pTrajectory_Queue, double travel_distance, vehicle_trajectory_queue_node_t **pCurrent_Trajectory_QNode, int *current_hop, double *current_offset)
+{ //find the trajectory queue node, the hop and the offset where the destination vehicle is after travel_distance from its registered position with binary searches on the prefix sums, where the hop keeps counting after the trajectory wraps around and each wrap skips the first queue node as the walk does; return FALSE if the prefix sums cannot answer, so that the caller walks the trajectory
+	trajectory_prefix_sum_t *prefix = Get_VehicleTrajectory_PrefixSum(pTrajectory_Queue); //prefix sums along the trajectory
+	double *D = prefix->distance; //prefix sums of edge lengths
+	int size = prefix->size; //number of hops on the trajectory
+	double position = 0; //distance from the tail node of the first edge
+	double cycle_length = 0; //length of a wrap from the second edge to the last edge
+	double cycle_number = 0; //number of whole wraps
+	int low = 0, high = 0, mid = 0; //indices for binary search
+
+	position = ((vehicle_trajectory_queue_node_t*)prefix->node[0])->graph_pos.offset + travel_distance;
+
+	/** find the first hop ending beyond position in the first pass */
+	low = 0;
+	high = size;
+	while(low < high)
+	{
+		mid = (low + high)/2;
+		if(D[mid+1] > position)
+			high = mid;
+		else
+			low = mid + 1;
+	}
+
+	if(low < size)
+	{
+		*pCurrent_Trajectory_QNode = (vehicle_trajectory_queue_node_t*)prefix->node[low];
+		*current_hop = low;
+		*current_offset = position - D[low];
+		return TRUE;
+	}
+
+	if(param->vehicle_vanet_vehicle_trajectory_length_type == VANET_VEHICLE_TRAJECTORY_LENGTH_FINITE)
+	{ //the destination vehicle has passed out of its trajectory
+		*pCurrent_Trajectory_QNode = NULL;
+		*current_hop = -1;
+		*current_offset = -1;
+		return TRUE;
+	}
+	else if(param->vehicle_vanet_vehicle_trajectory_length_type != VANET_VEHICLE_TRAJECTORY_LENGTH_INFINITE)
+		return FALSE; //let the walk report the unknown trajectory length type
+
+	cycle_length = D[size] - D[1];
+	if(size < 2 || cycle_length <= 0)
+		return FALSE;
+
+	/** skip the whole wraps and find the first hop ending beyond position in the last wrap */
+	position -= D[size];
+	cycle_number = floor(position/cycle_length);
+	position -= cycle_number*cycle_length;
+	if(position < 0)
+	{
+		cycle_number--;
+		position += cycle_length;
+	}
+	else if(position >= cycle_length)
+	{
+		cycle_number++;
+		position -= cycle_length;
+	}
+
+	low = 1;
+	high = size - 1;
+	while(low < high)
+	{
+		mid = (low + high)/2;
+		if(D[mid+1] - D[1] > position)
+			high = mid;
+		else
+			low = mid + 1;
+	}
+
+	*pCurrent_Trajectory_QNode = (vehicle_trajectory_queue_node_t*)prefix->node[low];
+	*current_hop = size + (int)cycle_number*(size - 1) + (low - 1);
+	*current_offset = position - (D[low] - D[1]);
+
+	return TRUE;
+}
+
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+static unsigned long trajectory_prefix_sum_check_count = 0; //number of the prefix-sum query values compared with the linked-list walk
+
+static void Check_Trajectory_PrefixSum_Query(const char *function, double prefix_sum_value, double walk_value)
+{ //compare the value of a prefix-sum trajectory query with the one of the linked-list walk, and exit on a difference
+	trajectory_prefix_sum_check_count++;
+
+	if(fabs(prefix_sum_value - walk_value) > TRAJECTORY_PREFIX_SUM_SELF_CHECK_TOLERANCE*MAX(1, fabs(walk_value)))
+	{
+		printf("%s(): Error: the prefix sums give %.12f, but the walk gives %.12f\n", function, prefix_sum_value, walk_value);
+		exit(1);
+	}
+}
+
+void Report_Trajectory_PrefixSum_Self_Check(FILE *fp)
+{ //report how many prefix-sum query values have matched the linked-list walk
+	fprintf(fp, "trajectory_prefix_sum_self_check: checked=%lu\n", trajectory_prefix_sum_check_count);
+}
+#endif /* ]] */
+#endif /* ] */
+
 double Compute_PathDistance_From_CurrentPosition_To_TargetPoint_With_VehiclePathList(double current_time, struct_vehicle_t *vehicle, char *target_point)
 { //compute the path distance for the trajectory from the current position to target_point with vehicle's path list
   double path_distance = 0; //path distance
 
   struct_path_node *pPathNode = NULL; //pointer to a path node
   double remaining_edge_length = 0;
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  double hop_distance = 0; //path distance from the head node of the current edge to target_point
+  double hop_distance_square = 0; //sum of the squared edge lengths from the head node of the current edge to target_point
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+  boolean prefix_sum_flag = FALSE; //flag to indicate whether the prefix sums answered the query
+#endif /* ]] */
+#endif /* ] */
 
   /** check whether the current edge's tail node is target point or not */
   if(strcmp(target_point, vehicle->current_pos_in_digraph.enode->tail_node) == 0)
@@ -8768,6 +9298,19 @@ double Compute_PathDistance_From_CurrentPosition_To_TargetPoint_With_VehiclePath
 
   /** compute the part of the current edge to travel */
   path_distance = vehicle->edge_length - vehicle->current_pos_in_digraph.offset;
+
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  /** look up target_point with the prefix sums along the path list, walking the path list only if they cannot answer */
+  if(Get_TargetPoint_Distance_On_VehiclePathList(vehicle, target_point, &hop_distance, &hop_distance_square) == TRUE)
+  {
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+    prefix_sum_flag = TRUE;
+#else /* ][ */
+    return path_distance + hop_distance;
+#endif /* ]] */
+  }
+#endif /* ] */
+
   pPathNode = vehicle->path_ptr->next; //Note that the first point to check is the head node of the current edge
   do
   {
@@ -8800,6 +9343,10 @@ double Compute_PathDistance_From_CurrentPosition_To_TargetPoint_With_VehiclePath
 
   } while(1);
 
+#if TRAJECTORY_PREFIX_SUM_FLAG && TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+  if(prefix_sum_flag == TRUE)
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, vehicle->edge_length - vehicle->current_pos_in_digraph.offset + hop_distance, path_distance);
+#endif /* ] */
 
   return path_distance;
 }
@@ -8828,6 +9375,16 @@ double Compute_PathDistance_From_CurrentPosition_To_TargetPoint_With_VehiclePath
 
   struct_path_node *pPathNode = NULL; //pointer to a path node
   double remaining_edge_length = 0;
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  double hop_distance = 0; //path distance from the head node of the current edge to target_point
+  double hop_distance_square = 0; //sum of the squared edge lengths from the head node of the current edge to target_point
+  double prefix_sum_path_distance = 0; //path distance given by the prefix sums
+  double prefix_sum_travel_time = 0; //path travel time given by the prefix sums
+  double prefix_sum_travel_time_deviation = 0; //path travel time deviation given by the prefix sums
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+  boolean prefix_sum_flag = FALSE; //flag to indicate whether the prefix sums answered the query
+#endif /* ]] */
+#endif /* ] */
   
   /** compute the mean and standard deviation of the travel time for the unit length */
   //GSL_Vanet_Compute_TravelTime_And_Deviation(param, unit_length, &unit_length_travel_time, &unit_length_travel_time_deviation);
@@ -8873,6 +9430,23 @@ double Compute_PathDistance_From_CurrentPosition_To_TargetPoint_With_VehiclePath
   path_travel_time_variance += edge_travel_time_variance; //path travel time variance
   path_travel_time_deviation = sqrt(path_travel_time_variance); //path travel time standard deviation
 
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  /** look up target_point with the prefix sums along the path list, walking the path list only if they cannot answer */
+  if(Get_TargetPoint_Distance_On_VehiclePathList(vehicle, target_point, &hop_distance, &hop_distance_square) == TRUE)
+  {
+    prefix_sum_path_distance = path_distance + hop_distance;
+    prefix_sum_travel_time = path_travel_time + hop_distance*unit_length_travel_time;
+    prefix_sum_travel_time_deviation = sqrt(path_travel_time_variance + hop_distance_square*unit_length_travel_time_variance);
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+    prefix_sum_flag = TRUE;
+#else /* ][ */
+    *travel_time = prefix_sum_travel_time;
+    *travel_time_deviation = prefix_sum_travel_time_deviation;
+    return prefix_sum_path_distance;
+#endif /* ]] */
+  }
+#endif /* ] */
+
   pPathNode = vehicle->path_ptr->next; //Note that the first point to check is the head node of the current edge
   do
   {
@@ -8917,6 +9491,15 @@ double Compute_PathDistance_From_CurrentPosition_To_TargetPoint_With_VehiclePath
     path_travel_time_deviation = sqrt(path_travel_time_variance); //path travel time standard deviation
   } while(1);
 
+#if TRAJECTORY_PREFIX_SUM_FLAG && TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+  if(prefix_sum_flag == TRUE)
+  {
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_path_distance, path_distance);
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_travel_time, path_travel_time);
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_travel_time_deviation, path_travel_time_deviation);
+  }
+#endif /* ] */
+
   /** set the path travel time and deviation */
   *travel_time = path_travel_time;
   *travel_time_deviation = path_travel_time_deviation;
@@ -8932,6 +9515,13 @@ double Compute_PathDistance_From_CurrentPosition_To_TargetPoint_With_VehicleTraj
   double edge_length = 0; //edge length
   vehicle_trajectory_queue_node_t *pTrajectory_QNode = NULL; //pointer to a vehicle trajectory queue node
   int i = 0; //for-loop index
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  double hop_distance = 0; //path distance from the head node of the current edge to target_point
+  double hop_distance_square = 0; //sum of the squared edge lengths from the head node of the current edge to target_point
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+  boolean prefix_sum_flag = FALSE; //flag to indicate whether the prefix sums answered the query
+#endif /* ]] */
+#endif /* ] */
 
   /** check whether the current trajectory queue node's tail node is target point or not */
   if(strcmp(target_point, pCurrent_Trajectory_QNode->graph_pos.enode->tail_node) == 0)
@@ -8942,6 +9532,19 @@ double Compute_PathDistance_From_CurrentPosition_To_TargetPoint_With_VehicleTraj
 
   /** compute the part of the current edge to travel */
   path_distance = pCurrent_Trajectory_QNode->graph_pos.enode->weight - offset_in_current_edge;
+
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  /** look up target_point with the prefix sums along the trajectory, walking the trajectory only if they cannot answer */
+  if(Get_TargetPoint_Distance_On_VehicleTrajectory(pTrajectory_Queue, pCurrent_Trajectory_QNode, target_point, &hop_distance, &hop_distance_square) == TRUE)
+  {
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+    prefix_sum_flag = TRUE;
+#else /* ][ */
+    return path_distance + hop_distance;
+#endif /* ]] */
+  }
+#endif /* ] */
+
   pTrajectory_QNode = pCurrent_Trajectory_QNode;
   do
   {
@@ -8964,6 +9567,11 @@ double Compute_PathDistance_From_CurrentPosition_To_TargetPoint_With_VehicleTraj
     path_distance += pTrajectory_QNode->graph_pos.enode->weight;
   } while(1);
 
+#if TRAJECTORY_PREFIX_SUM_FLAG && TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+  if(prefix_sum_flag == TRUE)
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, pCurrent_Trajectory_QNode->graph_pos.enode->weight - offset_in_current_edge + hop_distance, path_distance);
+#endif /* ] */
+
   return path_distance;
 }
 
@@ -8994,6 +9602,16 @@ double Compute_PathDistance_From_CurrentPosition_To_TargetPoint_With_VehicleTraj
   double offset_start = 0; //destination vehicle's offset in the first edge on its trajectory
   vehicle_trajectory_queue_node_t *pTrajectory_QNode = NULL; //pointer to a vehicle trajectory queue node
   int i = 0; //for-loop index
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  double hop_distance = 0; //path distance from the head node of the current edge to target_point
+  double hop_distance_square = 0; //sum of the squared edge lengths from the head node of the current edge to target_point
+  double prefix_sum_path_distance = 0; //path distance given by the prefix sums
+  double prefix_sum_travel_time = 0; //path travel time given by the prefix sums
+  double prefix_sum_travel_time_deviation = 0; //path travel time deviation given by the prefix sums
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+  boolean prefix_sum_flag = FALSE; //flag to indicate whether the prefix sums answered the query
+#endif /* ]] */
+#endif /* ] */
 
   /** compute the mean and standard deviation of the travel time for the unit length */
   //GSL_Vanet_Compute_TravelTime_And_Deviation(param, unit_length, &unit_length_travel_time, &unit_length_travel_time_deviation);
@@ -9040,6 +9658,23 @@ double Compute_PathDistance_From_CurrentPosition_To_TargetPoint_With_VehicleTraj
   path_travel_time_variance += edge_travel_time_variance; //path travel time variance
   path_travel_time_deviation = sqrt(path_travel_time_variance); //path travel time standard deviation
 
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  /** look up target_point with the prefix sums along the trajectory, walking the trajectory only if they cannot answer */
+  if(Get_TargetPoint_Distance_On_VehicleTrajectory(pTrajectory_Queue, pCurrent_Trajectory_QNode, target_point, &hop_distance, &hop_distance_square) == TRUE)
+  {
+    prefix_sum_path_distance = path_distance + hop_distance;
+    prefix_sum_travel_time = path_travel_time + hop_distance*unit_length_travel_time;
+    prefix_sum_travel_time_deviation = sqrt(path_travel_time_variance + hop_distance_square*unit_length_travel_time_variance);
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+    prefix_sum_flag = TRUE;
+#else /* ][ */
+    *travel_time = prefix_sum_travel_time;
+    *travel_time_deviation = prefix_sum_travel_time_deviation;
+    return prefix_sum_path_distance;
+#endif /* ]] */
+  }
+#endif /* ] */
+
   pTrajectory_QNode = pCurrent_Trajectory_QNode;
   do
   {
@@ -9076,6 +9711,15 @@ double Compute_PathDistance_From_CurrentPosition_To_TargetPoint_With_VehicleTraj
     path_travel_time_deviation = sqrt(path_travel_time_variance); //path travel time standard deviation 
   } while(1);
 
+#if TRAJECTORY_PREFIX_SUM_FLAG && TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+  if(prefix_sum_flag == TRUE)
+  {
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_path_distance, path_distance);
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_travel_time, path_travel_time);
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_travel_time_deviation, path_travel_time_deviation);
+  }
+#endif /* ] */
+
   /** set the path travel time and deviation */
   *travel_time = path_travel_time;
   *travel_time_deviation = path_travel_time_deviation;
@@ -9114,6 +9758,16 @@ double Compute_PathDistance_From_CurrentPosition_To_EndPosition_With_VehicleTraj
   double offset_start = 0; //destination vehicle's offset in the first edge on its trajectory
   vehicle_trajectory_queue_node_t *pTrajectory_QNode = NULL; //pointer to a vehicle trajectory queue node
   int i = 0; //for-loop index
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  double hop_distance = 0; //path distance from the head node of the current edge to target_point
+  double hop_distance_square = 0; //sum of the squared edge lengths from the head node of the current edge to target_point
+  double prefix_sum_path_distance = 0; //path distance given by the prefix sums
+  double prefix_sum_travel_time = 0; //path travel time given by the prefix sums
+  double prefix_sum_travel_time_deviation = 0; //path travel time deviation given by the prefix sums
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+  boolean prefix_sum_flag = FALSE; //flag to indicate whether the prefix sums answered the query
+#endif /* ]] */
+#endif /* ] */
 
   /** compute the mean and standard deviation of the travel time for the unit length */
   //GSL_Vanet_Compute_TravelTime_And_Deviation(param, unit_length, &unit_length_travel_time, &unit_length_travel_time_deviation);
@@ -9134,6 +9788,23 @@ double Compute_PathDistance_From_CurrentPosition_To_EndPosition_With_VehicleTraj
   path_travel_time_variance += edge_travel_time_variance; //path travel time variance
   path_travel_time_deviation = sqrt(path_travel_time_variance); //path travel time standard deviation
 
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  /** look up target_point with the prefix sums along the trajectory, walking the trajectory only if they cannot answer */
+  if(Get_TargetPoint_Distance_On_VehicleTrajectory(pTrajectory_Queue, pCurrent_Trajectory_QNode, target_point, &hop_distance, &hop_distance_square) == TRUE)
+  {
+    prefix_sum_path_distance = path_distance + hop_distance;
+    prefix_sum_travel_time = path_travel_time + hop_distance*unit_length_travel_time;
+    prefix_sum_travel_time_deviation = sqrt(path_travel_time_variance + hop_distance_square*unit_length_travel_time_variance);
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+    prefix_sum_flag = TRUE;
+#else /* ][ */
+    *travel_time = prefix_sum_travel_time;
+    *travel_time_deviation = prefix_sum_travel_time_deviation;
+    return prefix_sum_path_distance;
+#endif /* ]] */
+  }
+#endif /* ] */
+
   pTrajectory_QNode = pCurrent_Trajectory_QNode;
   do
   {
@@ -9170,6 +9841,15 @@ double Compute_PathDistance_From_CurrentPosition_To_EndPosition_With_VehicleTraj
     path_travel_time_deviation = sqrt(path_travel_time_variance); //path travel time standard deviation 
   } while(1);
 
+#if TRAJECTORY_PREFIX_SUM_FLAG && TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+  if(prefix_sum_flag == TRUE)
+  {
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_path_distance, path_distance);
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_travel_time, path_travel_time);
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_travel_time_deviation, path_travel_time_deviation);
+  }
+#endif /* ] */
+
   /** set the path travel time and deviation */
   *travel_time = path_travel_time;
   *travel_time_deviation = path_travel_time_deviation;
@@ -9185,6 +9865,11 @@ double Compute_PathDistance_For_VehicleTrajectory(vehicle_trajectory_queue_t *pT
   vehicle_trajectory_queue_node_t *pTrajectory_QNode = NULL; //pointer to a vehicle trajectory queue node
   int i = 0; //for-loop index
 
+#if TRAJECTORY_PREFIX_SUM_FLAG && !TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+  /** take the trajectory length from the prefix sums */
+  return Get_VehicleTrajectory_PrefixSum(pTrajectory_Queue)->distance[size];
+#endif /* ] */
+
   /** compute the part of the current edge to travel */
   pTrajectory_QNode = &(pTrajectory_Queue->head);
   for(i = 0; i < size; i++)
@@ -9193,6 +9878,10 @@ double Compute_PathDistance_For_VehicleTrajectory(vehicle_trajectory_queue_t *pT
       path_distance += pTrajectory_QNode->graph_pos.enode->weight;
   }
 
+#if TRAJECTORY_PREFIX_SUM_FLAG && TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+  Check_Trajectory_PrefixSum_Query(__FUNCTION__, Get_VehicleTrajectory_PrefixSum(pTrajectory_Queue)->distance[size], path_distance);
+#endif /* ] */
+
   return path_distance;
 }
 
@@ -9351,6 +10040,14 @@ vehicle_trajectory_queue_node_t* Find_Current_VehicleTrajectoryQueueNode_Along_W
   double offset_end = 0; //destination vehicle's offset in the current edge on its trajectory for current_time
   double edge_length = 0; //edge length
   int i = 0; //for-loop index
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  vehicle_trajectory_queue_node_t *pPrefixSum_Trajectory_QNode = NULL; //current trajectory queue node given by the prefix sums
+  int prefix_sum_hop = 0; //current hop given by the prefix sums
+  double prefix_sum_offset = 0; //offset given by the prefix sums
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+  boolean prefix_sum_flag = FALSE; //flag to indicate whether the prefix sums answered the query
+#endif /* ]] */
+#endif /* ] */
 
   /** check whether  carrier_vehicle->latest_packet_ptr is NULL or not */
   if(carrier_vehicle->latest_packet_ptr == NULL)
@@ -9388,6 +10085,22 @@ vehicle_trajectory_queue_node_t* Find_Current_VehicleTrajectoryQueueNode_Along_W
   travel_distance = delivery_time * param->vehicle_speed; //param->vehicle_speed should be used since it is average vehicle speed
   //travel_distance = delivery_time * pTrajectory_Queue->vehicle_speed;
 
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  /** find the position with binary searches on the prefix sums along the trajectory, walking the trajectory only if they cannot answer */
+  if(Find_VehicleTrajectory_Position_For_TravelDistance(param, pTrajectory_Queue, travel_distance, &pPrefixSum_Trajectory_QNode, &prefix_sum_hop, &prefix_sum_offset) == TRUE)
+  {
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+    prefix_sum_flag = TRUE;
+#else /* ][ */
+    /** set the output parameters */
+    *current_offset = prefix_sum_offset;
+    *current_hop = prefix_sum_hop;
+
+    return pPrefixSum_Trajectory_QNode;
+#endif /* ]] */
+  }
+#endif /* ] */
+
   pTrajectory_QNode = &(pTrajectory_Queue->head);
  
   while(1)
@@ -9450,6 +10163,19 @@ vehicle_trajectory_queue_node_t* Find_Current_VehicleTrajectoryQueueNode_Along_W
     i++;
   }
 
+#if TRAJECTORY_PREFIX_SUM_FLAG && TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+  if(prefix_sum_flag == TRUE)
+  {
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_hop, path_current_hop);
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_offset, offset_end);
+    if(pPrefixSum_Trajectory_QNode != pCurrent_Trajectory_QNode)
+    {
+      printf("%s(): Error: the prefix sums give another trajectory queue node than the walk\n", __FUNCTION__);
+      exit(1);
+    }
+  }
+#endif /* ] */
+
   /** set the output parameters */
   *current_offset = offset_end;
   *current_hop = path_current_hop;
@@ -9472,6 +10198,14 @@ vehicle_trajectory_queue_node_t* Find_Current_VehicleTrajectoryQueueNode_Along_W
   double offset_end = 0; //destination vehicle's offset in the current edge on its trajectory for current_time
   double edge_length = 0; //edge length
   int i = 0; //for-loop index
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  vehicle_trajectory_queue_node_t *pPrefixSum_Trajectory_QNode = NULL; //current trajectory queue node given by the prefix sums
+  int prefix_sum_hop = 0; //current hop given by the prefix sums
+  double prefix_sum_offset = 0; //offset given by the prefix sums
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+  boolean prefix_sum_flag = FALSE; //flag to indicate whether the prefix sums answered the query
+#endif /* ]] */
+#endif /* ] */
 
   /** check whether stationary_node->latest_packet_ptr is NULL or not */
   if(stationary_node->latest_packet_ptr == NULL)
@@ -9509,6 +10243,22 @@ vehicle_trajectory_queue_node_t* Find_Current_VehicleTrajectoryQueueNode_Along_W
   travel_distance = delivery_time * param->vehicle_speed; //param->vehicle_speed should be used since it is average vehicle speed
   //travel_distance = delivery_time * pTrajectory_Queue->vehicle_speed;
 
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  /** find the position with binary searches on the prefix sums along the trajectory, walking the trajectory only if they cannot answer */
+  if(Find_VehicleTrajectory_Position_For_TravelDistance(param, pTrajectory_Queue, travel_distance, &pPrefixSum_Trajectory_QNode, &prefix_sum_hop, &prefix_sum_offset) == TRUE)
+  {
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+    prefix_sum_flag = TRUE;
+#else /* ][ */
+    /** set the output parameters */
+    *current_offset = prefix_sum_offset;
+    *current_hop = prefix_sum_hop;
+
+    return pPrefixSum_Trajectory_QNode;
+#endif /* ]] */
+  }
+#endif /* ] */
+
   pTrajectory_QNode = &(pTrajectory_Queue->head);
  
   while(1)
@@ -9571,6 +10321,19 @@ vehicle_trajectory_queue_node_t* Find_Current_VehicleTrajectoryQueueNode_Along_W
     i++;
   }
 
+#if TRAJECTORY_PREFIX_SUM_FLAG && TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+  if(prefix_sum_flag == TRUE)
+  {
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_hop, path_current_hop);
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_offset, offset_end);
+    if(pPrefixSum_Trajectory_QNode != pCurrent_Trajectory_QNode)
+    {
+      printf("%s(): Error: the prefix sums give another trajectory queue node than the walk\n", __FUNCTION__);
+      exit(1);
+    }
+  }
+#endif /* ] */
+
   /** set the output parameters */
   *current_offset = offset_end;
   *current_hop = path_current_hop;
@@ -9592,6 +10355,14 @@ vehicle_trajectory_queue_node_t* Find_Current_VehicleTrajectoryQueueNode_Along_W
   double offset_end = 0; //destination vehicle's offset in the current edge on its trajectory for current_time
   double edge_length = 0; //edge length
   int i = 0; //for-loop index
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  vehicle_trajectory_queue_node_t *pPrefixSum_Trajectory_QNode = NULL; //current trajectory queue node given by the prefix sums
+  int prefix_sum_hop = 0; //current hop given by the prefix sums
+  double prefix_sum_offset = 0; //offset given by the prefix sums
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+  boolean prefix_sum_flag = FALSE; //flag to indicate whether the prefix sums answered the query
+#endif /* ]] */
+#endif /* ] */
 
   /** check whether pPacket is NULL or not */
   if(pPacket == NULL)
@@ -9628,6 +10399,22 @@ vehicle_trajectory_queue_node_t* Find_Current_VehicleTrajectoryQueueNode_Along_W
   travel_distance = delivery_time * param->vehicle_speed; //param->vehicle_speed should be used since it is average vehicle speed
   //travel_distance = delivery_time * pTrajectory_Queue->vehicle_speed;
 
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  /** find the position with binary searches on the prefix sums along the trajectory, walking the trajectory only if they cannot answer */
+  if(Find_VehicleTrajectory_Position_For_TravelDistance(param, pTrajectory_Queue, travel_distance, &pPrefixSum_Trajectory_QNode, &prefix_sum_hop, &prefix_sum_offset) == TRUE)
+  {
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+    prefix_sum_flag = TRUE;
+#else /* ][ */
+    /** set the output parameters */
+    *current_offset = prefix_sum_offset;
+    *current_hop = prefix_sum_hop;
+
+    return pPrefixSum_Trajectory_QNode;
+#endif /* ]] */
+  }
+#endif /* ] */
+
   pTrajectory_QNode = &(pTrajectory_Queue->head);
  
   while(1)
@@ -9690,6 +10477,19 @@ vehicle_trajectory_queue_node_t* Find_Current_VehicleTrajectoryQueueNode_Along_W
     i++;
   }
 
+#if TRAJECTORY_PREFIX_SUM_FLAG && TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+  if(prefix_sum_flag == TRUE)
+  {
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_hop, path_current_hop);
+    Check_Trajectory_PrefixSum_Query(__FUNCTION__, prefix_sum_offset, offset_end);
+    if(pPrefixSum_Trajectory_QNode != pCurrent_Trajectory_QNode)
+    {
+      printf("%s(): Error: the prefix sums give another trajectory queue node than the walk\n", __FUNCTION__);
+      exit(1);
+    }
+  }
+#endif /* ] */
+
   /** set the output parameters */
   *current_offset = offset_end;
   *current_hop = path_current_hop;
@@ -9703,6 +10503,15 @@ int Find_VertexHop_On_VehicleTrajectory(vehicle_trajectory_queue_t *pTrajectory_
   vehicle_trajectory_queue_node_t *pTrajectory_QNode = NULL; //pointer to the vehicle trajectory queue node
   int size = pTrajectory_Queue->size; //trajectory queue size
   int i = 0; //for-loop index
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  trajectory_prefix_sum_t *prefix = Get_VehicleTrajectory_PrefixSum(pTrajectory_Queue); //prefix sums along the trajectory
+
+  /** look up the first hop starting from vertex in the hash table of the prefix sums */
+  vertex_hop = Lookup_Trajectory_Vertex(prefix->tail_vertex_table, prefix->table_size, prefix->tail_vertex, vertex);
+#if !TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+  return vertex_hop;
+#endif /* ]] */
+#endif /* ] */
 
   pTrajectory_QNode = &(pTrajectory_Queue->head);
   for(i = 0; i < size; i++)
@@ -9713,6 +10522,10 @@ int Find_VertexHop_On_VehicleTrajectory(vehicle_trajectory_queue_t *pTrajectory_
       break;
   }
 
+#if TRAJECTORY_PREFIX_SUM_FLAG && TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+  Check_Trajectory_PrefixSum_Query(__FUNCTION__, vertex_hop, (i < size ? i : -1));
+#endif /* ] */
+
   /* check whether there exists a queue node corresponding to vertex or not */
   if(i < size)
     vertex_hop = i;
@@ -9728,6 +10541,15 @@ vehicle_trajectory_queue_node_t* Find_VehicleTrajectoryQueueNode_For_VertexHop_O
   vehicle_trajectory_queue_node_t *pTrajectory_QNode = NULL; //pointer to the vehicle trajectory queue node
   int size = pTrajectory_Queue->size; //trajectory queue size
   int i = 0; //for-loop index
+#if TRAJECTORY_PREFIX_SUM_FLAG /* [ */
+  trajectory_prefix_sum_t *prefix = Get_VehicleTrajectory_PrefixSum(pTrajectory_Queue); //prefix sums along the trajectory
+
+  /** look up the first hop starting from vertex in the hash table of the prefix sums */
+  vertex_hop = Lookup_Trajectory_Vertex(prefix->tail_vertex_table, prefix->table_size, prefix->tail_vertex, vertex);
+#if !TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [[ */
+  return (vertex_hop == -1 ? NULL : (vehicle_trajectory_queue_node_t*)prefix->node[vertex_hop]);
+#endif /* ]] */
+#endif /* ] */
 
   pTrajectory_QNode = &(pTrajectory_Queue->head);
   for(i = 0; i < size; i++)
@@ -9738,6 +10560,10 @@ vehicle_trajectory_queue_node_t* Find_VehicleTrajectoryQueueNode_For_VertexHop_O
       break;
   }
 
+#if TRAJECTORY_PREFIX_SUM_FLAG && TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+  Check_Trajectory_PrefixSum_Query(__FUNCTION__, vertex_hop, (i < size ? i : -1));
+#endif /* ] */
+
   /* check whether there exists a queue node corresponding to vertex or not */
   if(i == size)
     pTrajectory_QNode = NULL;
@@ -9758,7 +10584,7 @@ void Update_LinkDelay_Information(parameter_t *param, struct_graph_node *G, int
 
     while(ptr != NULL)
     {
-      j = atoi(ptr->vertex) - 1;
+      j = ptr->vertex_id - 1;
       //node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
       ptr->edge_delay = VADD_Compute_Edge_Delay(param, ptr); //compute the edge delay for the road segment r_ij
       ptr->edge_delay_standard_deviation = VADD_Compute_Edge_Delay_Standard_Deviation(param, ptr); //compute the edge delay standard deviation for the road segment r_ij
@@ -9848,6 +10674,226 @@ double Compute_TargetPoint_OptimizationValue(parameter_t *param, int target_poin
     return optimization_value;
 }
 
+#if TARGET_POINT_BATCH_EVALUATION_FLAG /* [ */
+/* the batch is scratch state of the simulation on the calling thread (see smpl.h) */
+static SMPL_THREAD_LOCAL int target_point_batch_capacity = 0; //capacity of the arrays below
+static SMPL_THREAD_LOCAL int target_point_batch_size = 0; //number of target point candidates collected in the batch
+static SMPL_THREAD_LOCAL int *target_point_batch_id = NULL; //intersection id of a target point candidate
+static SMPL_THREAD_LOCAL double *target_point_batch_EDD = NULL; //packet's expected delivery delay EDD_p to a target point candidate
+static SMPL_THREAD_LOCAL double *target_point_batch_EDD_SD = NULL; //standard deviation EDD_SD_p of the packet's delivery delay
+static SMPL_THREAD_LOCAL double *target_point_batch_EAD = NULL; //destination vehicle's expected arrival delay EAD_p to a target point candidate
+static SMPL_THREAD_LOCAL double *target_point_batch_EAD_SD = NULL; //standard deviation EAD_SD_p of the destination vehicle's arrival delay
+static SMPL_THREAD_LOCAL double *target_point_batch_constraint = NULL; //constraint value of a target point candidate
+static SMPL_THREAD_LOCAL double *target_point_batch_value = NULL; //optimization value of a target point candidate
+static SMPL_THREAD_LOCAL int *target_point_batch_order = NULL; //indices of the target point candidates in the ascending order of EAD_p
+
+static void Grow_TargetPoint_Batch(int n)
+{ //grow the batch of target point candidates to hold n candidates
+	if(n <= target_point_batch_capacity)
+		return;
+
+	target_point_batch_capacity = MAX(n, 2*target_point_batch_capacity);
+	target_point_batch_id = (int*) realloc(target_point_batch_id, target_point_batch_capacity*sizeof(int));
+	target_point_batch_EDD = (double*) realloc(target_point_batch_EDD, target_point_batch_capacity*sizeof(double));
+	target_point_batch_EDD_SD = (double*) realloc(target_point_batch_EDD_SD, target_point_batch_capacity*sizeof(double));
+	target_point_batch_EAD = (double*) realloc(target_point_batch_EAD, target_point_batch_capacity*sizeof(double));
+	target_point_batch_EAD_SD = (double*) realloc(target_point_batch_EAD_SD, target_point_batch_capacity*sizeof(double));
+	target_point_batch_constraint = (double*) realloc(target_point_batch_constraint, target_point_batch_capacity*sizeof(double));
+	target_point_batch_value = (double*) realloc(target_point_batch_value, target_point_batch_capacity*sizeof(double));
+	target_point_batch_order = (int*) realloc(target_point_batch_order, target_point_batch_capacity*sizeof(int));
+	assert_memory(target_point_batch_id);
+	assert_memory(target_point_batch_EDD);
+	assert_memory(target_point_batch_EDD_SD);
+	assert_memory(target_point_batch_EAD);
+	assert_memory(target_point_batch_EAD_SD);
+	assert_memory(target_point_batch_constraint);
+	assert_memory(target_point_batch_value);
+	assert_memory(target_point_batch_order);
+}
+
+void Reset_TargetPoint_Batch()
+{ //empty the batch of target point candidates before a pass over a destination vehicle's trajectory
+	target_point_batch_size = 0;
+}
+
+void Append_TargetPoint_To_Batch(int target_point_id, double EDD_p, double EDD_SD_p, double EAD_p, double EAD_SD_p)
+{ //append a target point candidate with the packet delivery delay distribution (EDD_p, EDD_SD_p) and the destination vehicle arrival delay distribution (EAD_p, EAD_SD_p) to the batch
+	int i = target_point_batch_size; //index of the new candidate
+
+	Grow_TargetPoint_Batch(i + 1);
+
+	target_point_batch_id[i] = target_point_id;
+	target_point_batch_EDD[i] = EDD_p;
+	target_point_batch_EDD_SD[i] = EDD_SD_p;
+	target_point_batch_EAD[i] = EAD_p;
+	target_point_batch_EAD_SD[i] = EAD_SD_p;
+	target_point_batch_size++;
+}
+
+#if TARGET_POINT_BATCH_EVALUATION_SELF_CHECK_FLAG /* [[ */
+static unsigned long target_point_batch_check_count = 0; //number of the batch selections compared with the per-candidate selection
+
+static void Check_TargetPoint_Batch_Selection(parameter_t *param, double packet_ttl, double min_value, int min_value_target_point_id, double max_constraint_value, int max_constraint_value_target_point_id)
+{ //compare the selection of the batch with the one made by Compute_TargetPoint_OptimizationValue() for each candidate in order, and exit on a difference
+	double value = 0; //optimization value of a candidate
+	double check_min_value = INF; //minimum optimization value
+	int check_min_value_target_point_id = 0; //target point with check_min_value
+	double check_max_constraint_value = 0; //maximum constraint value
+	int check_max_constraint_value_target_point_id = 0; //target point with check_max_constraint_value
+	int i = 0; //index for for-loop
+
+	target_point_batch_check_count++;
+
+	for(i = 0; i < target_point_batch_size; i++)
+	{
+		value = Compute_TargetPoint_OptimizationValue(param, target_point_batch_id[i], target_point_batch_EDD[i], target_point_batch_EDD_SD[i], target_point_batch_EAD[i], target_point_batch_EAD_SD[i], packet_ttl, &check_max_constraint_value, &check_max_constraint_value_target_point_id);
+		if(check_min_value > value)
+		{
+			check_min_value = value;
+			check_min_value_target_point_id = target_point_batch_id[i];
+		}
+	}
+
+	if((check_min_value != min_value) || (check_min_value < INF && check_min_value_target_point_id != min_value_target_point_id) || (check_min_value == INF && (check_max_constraint_value != max_constraint_value || check_max_constraint_value_target_point_id != max_constraint_value_target_point_id)))
+	{
+		printf("%s:%d Check_TargetPoint_Batch_Selection(): batch selection (%d, %.6f, %d, %.6f) differs from (%d, %.6f, %d, %.6f)\n", __FILE__, __LINE__, min_value_target_point_id, min_value, max_constraint_value_target_point_id, max_constraint_value, check_min_value_target_point_id, check_min_value, check_max_constraint_value_target_point_id, check_max_constraint_value);
+		exit(1);
+	}
+}
+
+void Report_TargetPoint_Batch_Self_Check(FILE *fp)
+{ //report how many batch selections have matched the per-candidate selection
+	fprintf(fp, "target_point_batch_self_check: checked=%lu\n", target_point_batch_check_count);
+}
+#endif /* ]] */
+
+void Select_TargetPoint_From_Batch(parameter_t *param, double packet_ttl, double *min_value, int *min_value_target_point_id, double *EDD_p_for_optimal_target_point, double *EAD_p_for_optimal_target_point, double *max_constraint_value, int *max_constraint_value_target_point_id)
+{ //score the target point candidates in the batch with the optimization function in one sweep and select the candidate with the minimum optimization value as Compute_TargetPoint_OptimizationValue() does for the candidates in order. For the delivery probability constraint, the probabilities are computed in the ascending order of EAD_p and only until the first candidate satisfying the threshold, since that candidate is the selected one; so in this case max_constraint_value is updated only when no candidate is selected
+	double *EDD = target_point_batch_EDD; //packet delay averages
+	double *EDD_SD = target_point_batch_EDD_SD; //packet delay standard deviations
+	double *EAD = target_point_batch_EAD; //vehicle delay averages
+	double *EAD_SD = target_point_batch_EAD_SD; //vehicle delay standard deviations
+	double *constraint = target_point_batch_constraint; //constraint values
+	double *value = target_point_batch_value; //optimization values
+	int *order = target_point_batch_order; //candidate indices sorted by EAD_p
+	int n = target_point_batch_size; //number of candidates
+	double c = 3; //coefficient for delay deviation width as in Compute_TargetPoint_OptimizationValue()
+	double interval_start = 0; //the start of the integration interval
+	double interval_end = packet_ttl; //the end of the integration interval
+	int selected = -1; //index of the selected candidate
+	int i = 0, j = 0, k = 0; //indices for for-loops
+
+	switch(param->vehicle_vanet_target_point_optimization_function_type)
+	{
+		case VANET_TARGET_POINT_OPTIMIZATION_FUNCTION_EDD_AND_EAD_DIFFERENCE:
+			for(i = 0; i < n; i++)
+			{
+				constraint[i] = 0;
+				value[i] = fabs(EDD[i] - EAD[i]);
+			}
+			break;
+
+		case VANET_TARGET_POINT_OPTIMIZATION_FUNCTION_EAD_WITH_CONSTRAINT_1:
+			for(i = 0; i < n; i++)
+			{
+				if(EDD[i] <= ERROR_TOLERANCE_FOR_REAL_ARITHMETIC && EAD[i] > ERROR_TOLERANCE_FOR_REAL_ARITHMETIC)
+					constraint[i] = 1;
+				else
+					constraint[i] = EAD[i] - EDD[i];
+				value[i] = (constraint[i] >= c*EAD_SD[i]) ? EAD[i] : INF;
+			}
+			break;
+
+		case VANET_TARGET_POINT_OPTIMIZATION_FUNCTION_EAD_WITH_CONSTRAINT_2:
+			/* sort the candidates by EAD_p with insertion sort keeping the trajectory order among equal EAD_p; the trajectory is short and mostly in the ascending order of EAD_p already */
+			for(i = 0; i < n; i++)
+			{
+				for(j = i; j > 0 && EAD[order[j-1]] > EAD[i]; j--)
+					order[j] = order[j-1];
+				order[j] = i;
+			}
+
+			/* the first candidate satisfying the threshold in this order has the minimum EAD_p among such candidates, so the remaining probabilities are not needed */
+			for(k = 0; k < n; k++)
+			{
+				i = order[k];
+				if(EDD[i] <= ERROR_TOLERANCE_FOR_REAL_ARITHMETIC && EAD[i] > ERROR_TOLERANCE_FOR_REAL_ARITHMETIC)
+					constraint[i] = 1;
+				else
+					constraint[i] = GSL_Vanet_Delivery_Probability_For_Gamma_Distribution(EDD[i], EDD_SD[i], EAD[i], EAD_SD[i], interval_start, interval_end);
+
+				if(constraint[i] >= param->communication_packet_delivery_probability_threshold && EAD[i] < *min_value)
+				{
+					selected = i;
+					break;
+				}
+			}
+
+			if(selected >= 0)
+			{
+				*min_value = EAD[selected];
+				*min_value_target_point_id = target_point_batch_id[selected];
+				*EDD_p_for_optimal_target_point = EDD[selected];
+				*EAD_p_for_optimal_target_point = EAD[selected];
+
+#if TARGET_POINT_BATCH_EVALUATION_SELF_CHECK_FLAG /* [[ */
+				Check_TargetPoint_Batch_Selection(param, packet_ttl, *min_value, *min_value_target_point_id, *max_constraint_value, *max_constraint_value_target_point_id);
+#endif /* ]] */
+				return;
+			}
+
+			/* no candidate is selected, so every probability has been computed and no candidate has a finite optimization value */
+			for(i = 0; i < n; i++)
+				value[i] = INF;
+			break;
+
+		default:
+			printf("Select_TargetPoint_From_Batch(): param->vehicle_vanet_target_point_optimization_function_type(%d) is not supported yet!\n", param->vehicle_vanet_target_point_optimization_function_type);
+			exit(1);
+	}
+
+	/* take the minimum optimization value and the maximum constraint value in the trajectory order */
+	for(i = 0; i < n; i++)
+	{
+		if(constraint[i] > *max_constraint_value)
+		{
+			*max_constraint_value = constraint[i];
+			*max_constraint_value_target_point_id = target_point_batch_id[i];
+		}
+
+		if(*min_value > value[i])
+		{
+			*min_value = value[i];
+			*min_value_target_point_id = target_point_batch_id[i];
+			*EDD_p_for_optimal_target_point = EDD[i];
+			*EAD_p_for_optimal_target_point = EAD[i];
+		}
+	}
+
+#if TARGET_POINT_BATCH_EVALUATION_SELF_CHECK_FLAG /* [[ */
+	Check_TargetPoint_Batch_Selection(param, packet_ttl, *min_value, *min_value_target_point_id, *max_constraint_value, *max_constraint_value_target_point_id);
+#endif /* ]] */
+}
+
+void Free_TargetPoint_Batch()
+{ //free the batch of target point candidates
+	free(target_point_batch_id);
+	free(target_point_batch_EDD);
+	free(target_point_batch_EDD_SD);
+	free(target_point_batch_EAD);
+	free(target_point_batch_EAD_SD);
+	free(target_point_batch_constraint);
+	free(target_point_batch_value);
+	free(target_point_batch_order);
+	target_point_batch_id = target_point_batch_order = NULL;
+	target_point_batch_EDD = target_point_batch_EDD_SD = NULL;
+	target_point_batch_EAD = target_point_batch_EAD_SD = NULL;
+	target_point_batch_constraint = target_point_batch_value = NULL;
+	target_point_batch_capacity = 0;
+	target_point_batch_size = 0;
+}
+#endif /* ] */
+
 boolean Is_Vertex_On_VehicleTrajectory_With_New_Destination(parameter_t *param, double current_time, packet_queue_node_t *packet, int vertex, int *new_dst, boolean *packet_earlier_arrival_flag)
 //check whether vertex is on the destination vehicle's trajectory; if so, this function returns an adjacent vertex closer to the destination vehicle's current position through new_dst
 {
@@ -9927,7 +10973,7 @@ boolean Is_Vertex_On_VehicleTrajectory_With_New_Destination_VERSION_1(parameter_
     if((param->vehicle_vanet_vehicle_trajectory_length_type == VANET_VEHICLE_TRAJECTORY_LENGTH_FINITE) && (pCurrent_Trajectory_QNode == NULL))
     { //choose a random neighboring node of vertex, such that the first neighbor in the adjacency list
         printf("Is_Vertex_On_VehicleTrajectory_With_New_Destination(): the vehicle trajectory has expired, so it cannot be used any mode\n");
-        //*new_dst = atoi(param->vanet_table.Gr[vertex-1].next->vertex);
+        //*new_dst = param->vanet_table.Gr[vertex-1].next->vertex_id;
         *new_dst = vertex; //let the packet stay at vertex since the packet's trajectory has expired
         result = TRUE;
 
@@ -10083,7 +11129,7 @@ boolean Is_Vertex_On_VehicleTrajectory_With_New_Destination_VERSION_2(parameter_
     if((param->vehicle_vanet_vehicle_trajectory_length_type == VANET_VEHICLE_TRAJECTORY_LENGTH_FINITE) && (pCurrent_Trajectory_QNode == NULL))
     { //choose a random neighboring node of vertex, such that the first neighbor in the adjacency list
         printf("Is_Vertex_On_VehicleTrajectory_With_New_Destination(): the vehicle trajectory has expired, so it cannot be used any mode\n");
-        //*new_dst = atoi(param->vanet_table.Gr[vertex-1].next->vertex);
+        //*new_dst = param->vanet_table.Gr[vertex-1].next->vertex_id;
         *new_dst = vertex; //let the packet stay at vertex since the packet's trajectory has expired
         result = TRUE;
 
@@ -10285,7 +11331,7 @@ boolean Has_Packet_Arrived_Earlier_At_TargetPoint_Than_Destination_Vehicle_With_
     if((param->vehicle_vanet_vehicle_trajectory_length_type == VANET_VEHICLE_TRAJECTORY_LENGTH_FINITE) && (pCurrent_Trajectory_QNode == NULL))
     { //choose a random neighboring node of vertex, such that the first neighbor in the adjacency list
         printf("Has_Packet_Arrived_Earlier_At_TargetPoint_Than_Destination_Vehicle_With_New_Destination(): the vehicle trajectory has expired, so it cannot be used any mode\n");
-        //*new_dst = atoi(param->vanet_table.Gr[vertex-1].next->vertex);
+        //*new_dst = param->vanet_table.Gr[vertex-1].next->vertex_id;
         *new_dst = vertex; //new_dst is the same as vertex, letting the packet stay at vertex
 
         return result;
@@ -10436,7 +11482,7 @@ boolean Has_Packet_Arrived_Earlier_At_TargetPoint_Than_Destination_Vehicle_With_
     if((param->vehicle_vanet_vehicle_trajectory_length_type == VANET_VEHICLE_TRAJECTORY_LENGTH_FINITE) && (pCurrent_Trajectory_QNode == NULL))
     { //choose a random neighboring node of vertex, such that the first neighbor in the adjacency list
         printf("Has_Packet_Arrived_Earlier_At_TargetPoint_Than_Destination_Vehicle_With_New_Destination(): the vehicle trajectory has expired, so it cannot be used any mode\n");
-        //*new_dst = atoi(param->vanet_table.Gr[vertex-1].next->vertex);
+        //*new_dst = param->vanet_table.Gr[vertex-1].next->vertex_id;
         *new_dst = vertex; //new_dst is the same as vertex, letting the packet stay at vertex
 
         return result;
@@ -10579,7 +11625,7 @@ void Update_LinkCost_Information(parameter_t *param, struct_graph_node *G, int G
 
     while(ptr != NULL)
     {
-      j = atoi(ptr->vertex) - 1;
+      j = ptr->vertex_id - 1;
       //node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 
 #if 0 /* [ */
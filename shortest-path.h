@@ -109,6 +109,14 @@ struct_path_node* Make_Backward_Path_List_With_Mobility_List(mobility_queue_t *Q
 void Free_Path_List(struct_path_node *path_list);
 //release the memory occupied by the list for the shortest path from source to destination
 
+void Free_Trajectory_PrefixSum(trajectory_prefix_sum_t *prefix);
+//free the arrays of trajectory prefix sums prefix
+
+#if TRAJECTORY_PREFIX_SUM_SELF_CHECK_FLAG /* [ */
+void Report_Trajectory_PrefixSum_Self_Check(FILE *fp);
+//report how many prefix-sum query values have matched the linked-list walk
+#endif /* ] */
+
 void Initialize_Schedule_Table(struct_traffic_table *src_table, struct_schedule_table *sched_table); 
 //initialize the schedule table to generate the traffic according to the source node and the corresponding distribution
 
@@ -431,6 +439,23 @@ void Update_LinkDelay_Information(parameter_t *param, struct_graph_node *G, int
 double Compute_TargetPoint_OptimizationValue(parameter_t *param, int target_point_id, double EDD_p, double EDD_SD_p, double EAD_p, double EAD_SD_p, double packet_ttl, double *max_constraint_value, int *max_constraint_value_target_point_id);
 //compute the optimization value for an intersection p that is an optimal target point candidate given the the packet delivery delay distribution (EDD_p, EDD_SD_p) and the destination vehicle arrival delay distribution (EAD_p, EAD_SD_p). Note that max_constraint_value and max_constraint_value_target_point_id are used only in the case where there is no target point to satisfy the required constraint, such as delivery probability threshold
 
+void Reset_TargetPoint_Batch();
+//empty the batch of target point candidates before a pass over a destination vehicle's trajectory
+
+void Append_TargetPoint_To_Batch(int target_point_id, double EDD_p, double EDD_SD_p, double EAD_p, double EAD_SD_p);
+//append a target point candidate with the packet delivery delay distribution (EDD_p, EDD_SD_p) and the destination vehicle arrival delay distribution (EAD_p, EAD_SD_p) to the batch
+
+void Select_TargetPoint_From_Batch(parameter_t *param, double packet_ttl, double *min_value, int *min_value_target_point_id, double *EDD_p_for_optimal_target_point, double *EAD_p_for_optimal_target_point, double *max_constraint_value, int *max_constraint_value_target_point_id);
+//score the target point candidates in the batch with the optimization function in one sweep and select the candidate with the minimum optimization value as Compute_TargetPoint_OptimizationValue() does for the candidates in order
+
+void Free_TargetPoint_Batch();
+//free the batch of target point candidates
+
+#if TARGET_POINT_BATCH_EVALUATION_SELF_CHECK_FLAG /* [ */
+void Report_TargetPoint_Batch_Self_Check(FILE *fp);
+//report how many batch selections have matched the per-candidate selection
+#endif /* ] */
+
 boolean Is_Vertex_On_VehicleTrajectory_With_New_Destination(parameter_t *param, double current_time, packet_queue_node_t *packet, int vertex, int *new_dst, boolean *packet_earlier_arrival_flag);
 //check whether vertex is on the destination vehicle's trajectory; if so, this function returns an adjacent vertex closer to the destination vehicle's current position through new_dst
 
@@ -9,75 +9,98 @@
 #include "smpl.h"
 #include "rand.h"
 
-//static FILE
-//  *display=stdout,   /* screen display file                 */
-//  *opf=stdout;       /* current output destination          */
-//@ 01/12/2005, added by jaehoon
-//@ according to C compiler syntax, the initializtion of the above two variables with non-constant should be performed in smpl().
-static FILE  *display,   /* screen display file                 */
-  *opf;              /* current output destination          */
-
-static int
-  event,             /* current simulation event            */
-  token,             /* last token dispatched               */
-  blk,               /* next available block index          */
-  avl,               /* available element list header       */
-  evl,               /* event list header                   */
-  fchn,              /* facility descriptor chain header    */
-  avn,               /* next available namespace position   */
-  tr,                /* event trace flag                    */
-  mr,                /* monitor activation flag             */
-  lft=sl;            /* lines left on current page/screen   */
-
-static real
-  clock,             /* current simulation time             */
-  start,             /* simulation interval start time      */
-  tl;                /* last trace message issue time       */
-
-static int
-  l1[nl],
-  l2[nl],            /*       facility descriptor,          */
-  l3[nl];            /*            queue, &                 */
-static real          /*           event list                */
-  l4[nl],            /*          element pool               */
-  l5[nl];
-
-static char
-  name[ns];          /* model and facility name space       */
+/* the state of the simulation subsystem lives in the simulation */
+/* context bound to the calling thread (see smpl.h)              */
+static SMPL_THREAD_LOCAL simulation_context_t
+  *sc=NULL;          /* current simulation context          */
 
 /* declarations for static functions */
+static void grow_pool(int n);
 static int get_blk(int n);
 static int get_elm();
 static void put_elm(int i);
 static int suspend(int tkn);
 static void enlist(int *head, int elm);
+static void evl_init();
+static void evl_insert(int elm, int head_flag);
+static int evl_first();
+static void evl_delete(int elm);
+static int evl_search(int *l, int v);
 static void resetf();
 static void enqueue(int f,int j, int pri, int ev, real te);
 static void msg(int n, int i, char *s, int q1,int q2);
 static void end_line();
 static int rept_page(int fnxt);
 
+/*--------------------  CREATE SIMULATION CONTEXT  -------------------*/
+simulation_context_t* simulation_context_create()
+  {
+    static long In[16]= {0L,   /* seeds for streams 1 thru 15  */
+      1973272912L,  747177549L,   20464843L,  640830765L, 1098742207L,
+        78126602L,   84743774L,  831312807L,  124667236L, 1172177002L,
+      1124933064L, 1223960546L, 1878892440L, 1449793615L,  553303732L};
+    simulation_context_t *ctx; int i;
+    ctx=(simulation_context_t*)calloc(1,sizeof(simulation_context_t));
+    if (ctx==NULL) then
+      {fprintf(stderr,"Simulation Context Allocation Error\n"); exit(1);}
+    ctx->avl=-1; ctx->lft=sl; ctx->rns=1;
+    memcpy(ctx->In,In,sizeof(In)); ctx->strm=1;
+    for (i=1; i<16; i++)  /* counter-based streams keyed by the stream seeds */
+      rand_substream_init(&ctx->streams[i],In[i],RAND_ENTITY_STREAM,i);
+    ctx->xsubi[0]=0x330E;  /* initial state of drand48() without srand48() */
+    ctx->xsubi[1]=0xABCD;
+    ctx->xsubi[2]=0x1234;
+    return(ctx);
+  }
+
+/*-------------------  DESTROY SIMULATION CONTEXT  -------------------*/
+void simulation_context_destroy(simulation_context_t *ctx)
+  {
+    if (ctx==NULL) then return;
+    if (sc==ctx) then sc=NULL;
+    free(ctx->l1); free(ctx->l2); free(ctx->l3); free(ctx->l4); free(ctx->l5);
+    free(ctx->evh); free(ctx->cqb);
+    free(ctx->vehicle_list); free(ctx->vehicle_registry);
+    free(ctx);
+  }
+
+/*---------------------  BIND SIMULATION CONTEXT  --------------------*/
+void simulation_context_bind(simulation_context_t *ctx)
+  {
+    sc=ctx;
+  }
+
+/*--------------------  CURRENT SIMULATION CONTEXT  ------------------*/
+simulation_context_t* simulation_context_current()
+  {
+    if (sc==NULL) then sc=simulation_context_create();
+    return(sc);
+  }
+
 /*---------------  INITIALIZE SIMULATION SUBSYSTEM  ------------------*/
 void smpl(int m, char *s)
   //int m; char *s;
     {
-      int i; static int rns=1;
+      int i;
+
+      if (sc==NULL) then simulation_context_bind(simulation_context_create());
 
 	  //@ 01/13/2005, added by jaehoon
 	  //@ to remove a compile error "initializer element is not constant"
-      display=stdout;   /* screen display file                 */
+      sc->display=stdout;   /* screen display file                 */
       //opf=stdout;       /* current output destination          */
 	  //@ 01/13/2005, jaehoon 
 	  //@ the above comment makes the report be stored into output file 
 
-      blk=1; avl=-1; avn=0;       /* element pool & namespace headers */
-      evl=fchn=0;           /* event list & descriptor chain headers  */
-      clock=start=tl=0.0;   /* sim., interval start, last trace times */
-      event=tr=0;                 /* current event no. & trace flags  */
-      for (i=0; i<nl; i++)  {l1[i]=l2[i]=l3[i]=0; l4[i]=l5[i]=0.0;}
+      sc->blk=1; sc->avl=-1; sc->avn=0;       /* element pool & namespace headers */
+      sc->evl=sc->fchn=0;           /* event list & descriptor chain headers  */
+      sc->clock=sc->start=sc->tl=0.0;   /* sim., interval start, last trace times */
+      sc->event=sc->tr=0;                 /* current event no. & trace flags  */
+      for (i=0; i<sc->pool_size; i++)  {sc->l1[i]=sc->l2[i]=sc->l3[i]=0; sc->l4[i]=sc->l5[i]=0.0;}
+      evl_init();                           /* empty event list backend */
       i=save_name(s,50);                   /* model name -> namespace */
-      rns=stream(rns); rns=++rns>15? 1:rns;  /* set random no. stream */
-      mr=(m>0)? 1:0;                              /* set monitor flag */
+      sc->rns=stream(sc->rns); sc->rns=++sc->rns>15? 1:sc->rns;  /* set random no. stream */
+      sc->mr=(m>0)? 1:0;                              /* set monitor flag */
    /* if (mr) then {opf=display; init_mtr(1);} */
 
 	  return;
@@ -86,7 +109,7 @@ void smpl(int m, char *s)
 /*-----------------------  RESET MEASUREMENTS  -----------------------*/
 void reset()
   {
-    resetf(); start=clock;
+    resetf(); sc->start=sc->clock;
 	return;
   }
 
@@ -99,50 +122,86 @@ int save_name(char *s, int m)
 //      static int i,n;
       int i,n;
       n= (int)strlen(s); if (n>m) then n=m;
-      if (avn+n>ns) then error(2,NULL); /* namespace exhausted */
-      i=avn; avn+=n+1; strncpy(&name[i],s,n);
-      if (n==m) then name[avn++]='\0';
+      if (sc->avn+n>ns) then error(2,NULL); /* namespace exhausted */
+      i=sc->avn; sc->avn+=n+1; strncpy(&sc->name[i],s,n);
+      if (n==m) then sc->name[sc->avn++]='\0';
       return(i);
     }
 
 /*-------------------------  GET MODEL NAME  -------------------------*/
 char *mname()
   {
-    return(name);
+    return(sc->name);
   }
 
 /*------------------------  GET FACILITY NAME  -----------------------*/
 char *fname(int f)
   //int f;
     {
-      return(&name[l3[f+1]]);
+      return(&sc->name[sc->l3[f+1]]);
     }
 
+/*---------------------------  GROW POOL  ----------------------------*/
+static void grow_pool(int n)
+  { /* enlarge the element pool to at least n elements up to nl; the */
+    /* new elements are zeroed as smpl() does for the whole pool     */
+    int size=sc->pool_size;
+    if (n>nl) then error(1,NULL);             /* element pool exhausted */
+    if (size==0) then size=SMPL_POOL_INITIAL_SIZE;
+    while (size<n) size*=2;
+    if (size>nl) then size=nl;
+    sc->l1=(int*)realloc(sc->l1,size*sizeof(int));
+    sc->l2=(int*)realloc(sc->l2,size*sizeof(int));
+    sc->l3=(int*)realloc(sc->l3,size*sizeof(int));
+    sc->l4=(real*)realloc(sc->l4,size*sizeof(real));
+    sc->l5=(real*)realloc(sc->l5,size*sizeof(real));
+    if ((sc->l1==NULL)||(sc->l2==NULL)||(sc->l3==NULL)||(sc->l4==NULL)||(sc->l5==NULL))
+      then error(0,"Element Pool Allocation Error");
+    memset(sc->l1+sc->pool_size,0,(size-sc->pool_size)*sizeof(int));
+    memset(sc->l2+sc->pool_size,0,(size-sc->pool_size)*sizeof(int));
+    memset(sc->l3+sc->pool_size,0,(size-sc->pool_size)*sizeof(int));
+    memset(sc->l4+sc->pool_size,0,(size-sc->pool_size)*sizeof(real));
+    memset(sc->l5+sc->pool_size,0,(size-sc->pool_size)*sizeof(real));
+    sc->pool_size=size;
+  }
+
 /*---------------------------  GET BLOCK  ----------------------------*/
 static int get_blk(int n)
   //int n;
     {
       int i;
-      if (blk==0) then error(3,NULL); /* block request after schedule */
-      i=blk; blk+=n;
-      if (blk>=nl) then error(1,NULL);      /* element pool exhausted */
+      if (sc->blk==0) then error(3,NULL); /* block request after schedule */
+      i=sc->blk; sc->blk+=n;
+      if (sc->blk>=nl) then error(1,NULL);      /* element pool exhausted */
+      if (sc->blk>=sc->pool_size) then grow_pool(sc->blk+1);
       return(i);
     }
 
 /*--------------------------  GET ELEMENT  ---------------------------*/
 static int get_elm()
   {
-    int i;
-    if (avl<=0) then
+    int i,first;
+    if (sc->avl<=0) then
       {
-        if (avl==0) then error(1,NULL);     /* empty element list */
-     /* if (mr && !tr) then init_mtr(2); */
-        /* build the free element list from the block of elements */
-        /* remaining after all facilities have been defined       */
-        for (i=blk; i<(nl-1); i++) l1[i]=i+1;
-        avl=blk; blk=0;
+        if (sc->avl==0) then
+          { /* empty element list: append the elements of a grown pool */
+            first=sc->pool_size;
+            if (first>=nl) then error(1,NULL);  /* empty element list */
+            grow_pool(first+1);
+          }
+        else
+          {
+         /* if (mr && !tr) then init_mtr(2); */
+            /* build the free element list from the block of elements */
+            /* remaining after all facilities have been defined       */
+            if (sc->blk>=sc->pool_size) then grow_pool(sc->blk+1);
+            first=sc->blk; sc->blk=0;
+          }
+        for (i=first; i<(sc->pool_size-1); i++) sc->l1[i]=i+1;
+        sc->l1[sc->pool_size-1]=0;
+        sc->avl=first;
       }
-    i=avl; avl=l1[i];
+    i=sc->avl; sc->avl=sc->l1[i];
     return(i);
   }
 
@@ -150,7 +209,7 @@ static int get_elm()
 static void put_elm(int i)
   //int i;
     {
-      l1[i]=avl; avl=i;
+      sc->l1[i]=sc->avl; sc->avl=i;
 	  return;
     }
 
@@ -160,9 +219,9 @@ void schedule(int ev, real te, int tkn)
     {
       int i;
       if (te<0.0) then error(4,NULL); /* negative event time */
-      i=get_elm(); l2[i]=tkn; l3[i]=ev; l4[i]=0.0; l5[i]=clock+te;
-      enlist(&evl,i);
-      if (tr) then msg(1,tkn,"",ev,0);
+      i=get_elm(); sc->l2[i]=tkn; sc->l3[i]=ev; sc->l4[i]=0.0; sc->l5[i]=sc->clock+te;
+      evl_insert(i,0);
+      if (sc->tr) then msg(1,tkn,"",ev,0);
     }
 
 /*---------------------------  CAUSE EVENT  --------------------------*/
@@ -171,14 +230,14 @@ int cause(int *ev,int *tkn)
   //int *ev,*tkn;
     {
       int i;
-      if (evl==0) 
+      if ((i=evl_first())==0) 
 		  //then error(5,NULL);       /* empty event list  */
 		  return -1; /* empty event list  */
 		  //modified by jaehoon, 10/12/2006
 
-      i=evl; *tkn=token=l2[i]; *ev=event=l3[i]; clock=l5[i];
-      evl=l1[i]; put_elm(i);  /* delink element & return to pool */
-      if (tr) then msg(2,*tkn,"",event,0);
+      *tkn=sc->token=sc->l2[i]; *ev=sc->event=sc->l3[i]; sc->clock=sc->l5[i];
+      evl_delete(i); put_elm(i);  /* delink element & return to pool */
+      if (sc->tr) then msg(2,*tkn,"",sc->event,0);
    /* if (mr && (tr!=3)) then mtr(tr,0); */
 
       return 0; //added by jaehoon, 10/12/2006
@@ -188,20 +247,18 @@ int cause(int *ev,int *tkn)
 real smpl_time()
 //real time()
   {
-    return(clock);
+    return(sc->clock);
   }
 
 /*--------------------------  CANCEL EVENT  --------------------------*/
 int cancel(int ev)
   //int ev;
     {
-      int pred,succ=evl,tkn;
-      while((succ!=0) && (l3[succ]!=ev)) {pred=succ; succ=l1[pred];}
+      int succ,tkn;
+      succ=evl_search(sc->l3,ev);
       if (succ==0) then return(-1);
-      tkn=l2[succ]; if (tr) then msg(3,tkn,"",l3[succ],0);
-      if (succ==evl)
-        then evl=l1[succ];                 /* unlink  event */
-        else l1[pred]=l1[succ];            /* list entry &  */
+      tkn=sc->l2[succ]; if (sc->tr) then msg(3,tkn,"",sc->l3[succ],0);
+      evl_delete(succ);                    /* unlink event list entry & */
       put_elm(succ);                       /* deallocate it */
       return(tkn);
     }
@@ -210,13 +267,11 @@ int cancel(int ev)
 static int suspend(int tkn)
   //int tkn;
     {
-      int pred,succ=evl;
-      while((succ!=0) && (l2[succ]!=tkn)) {pred=succ; succ=l1[pred];}
+      int succ;
+      succ=evl_search(sc->l2,tkn);
       if (succ==0) then error(6,NULL);  /* no event scheduled for tkn */
-      if (succ==evl)
-        then evl=l1[succ];       /* unlink  event */
-        else l1[pred]=l1[succ];  /* list entry    */
-      if (tr) then msg(6,-1,"",l3[succ],0);
+      evl_delete(succ);                 /* unlink event list entry */
+      if (sc->tr) then msg(6,-1,"",sc->l3[succ],0);
       return(succ);
     }
 
@@ -226,7 +281,7 @@ static void enlist(int *head, int elm)
   //int *head,elm;
     { /* 'head' points to head of queue/event list */
       int pred,succ; real arg,v;
-      arg=l5[elm]; succ=*head;
+      arg=sc->l5[elm]; succ=*head;
       while(1)
         { /* scan for position to insert entry:  event list is order- */
           /* ed in ascending 'arg' values, queues in descending order */
@@ -234,8 +289,8 @@ static void enlist(int *head, int elm)
             then break;  /* end of list */
             else
               {
-                v=l5[succ];
-                if (*head==evl)
+                v=sc->l5[succ];
+                if (*head==sc->evl)
                   then
                     { /* event list  */
                       if (v>arg) then break;
@@ -245,26 +300,226 @@ static void enlist(int *head, int elm)
                       /* (l4, the remaining event time, >0), insert   */
                       /* entry at beginning of its priority class;    */
                       /* otherwise, insert it at the end              */
-                      if ((v<arg) || ((v==arg) && (l4[elm]>0.0)))
+                      if ((v<arg) || ((v==arg) && (sc->l4[elm]>0.0)))
                         then break;
                     }
               }
-          pred=succ; succ=l1[pred];
+          pred=succ; succ=sc->l1[pred];
         }
-      l1[elm]=succ; if (succ!=*head) then l1[pred]=elm; else *head=elm;
+      sc->l1[elm]=succ; if (succ!=*head) then sc->l1[pred]=elm; else *head=elm;
     }
 
+/*---------------------  EVENT NUMBER IN EVENT LIST  -----------------*/
+int smpl_event_number()
+  {
+    return(sc->evn);
+  }
+
+/*-------------------  EVENT ORDER OF TWO ELEMENTS  ------------------*/
+#define evl_before(a,b) \
+  ((sc->l5[a]<sc->l5[b]) || ((sc->l5[a]==sc->l5[b]) && (sc->l4[a]<sc->l4[b])))
+
+#if SMPL_EVENT_LIST_TYPE == SMPL_EVENT_LIST_HEAP
+/*-----------------------  HEAP: SIFT UP/DOWN  -----------------------*/
+static void evh_sift_up(int pos)
+  {
+    int elm=sc->evh[pos],parent;
+    while (pos>0)
+      {
+        parent=(pos-1)/SMPL_HEAP_ARITY;
+        if (!evl_before(elm,sc->evh[parent])) then break;
+        sc->evh[pos]=sc->evh[parent]; pos=parent;
+      }
+    sc->evh[pos]=elm;
+  }
+
+static void evh_sift_down(int pos)
+  {
+    int elm=sc->evh[pos],child,min,last;
+    while (1)
+      {
+        child=pos*SMPL_HEAP_ARITY+1;
+        if (child>=sc->evn) then break;
+        last=child+SMPL_HEAP_ARITY; if (last>sc->evn) then last=sc->evn;
+        for (min=child++; child<last; child++)
+          if (evl_before(sc->evh[child],sc->evh[min])) then min=child;
+        if (!evl_before(sc->evh[min],elm)) then break;
+        sc->evh[pos]=sc->evh[min]; pos=min;
+      }
+    sc->evh[pos]=elm;
+  }
+#endif
+
+#if SMPL_EVENT_LIST_TYPE == SMPL_EVENT_LIST_CALENDAR_QUEUE
+/*-----------------  CALENDAR QUEUE: VIRTUAL BUCKET  -----------------*/
+static long long cq_vbucket(real t)
+  { /* index of the day containing time t since time 0 */
+    return((long long)floor(t/sc->cqw));
+  }
+
+/*--------------  CALENDAR QUEUE: ENTER ELEMENT IN DAY  --------------*/
+static void cq_enlist(int elm)
+  { /* each bucket is a list ordered by event time & sequence number */
+    int *head,pred=0,succ;
+    head=&sc->cqb[(int)(cq_vbucket(sc->l5[elm])%sc->cqnb)];
+    succ=*head;
+    while ((succ!=0) && !evl_before(elm,succ)) {pred=succ; succ=sc->l1[succ];}
+    sc->l1[elm]=succ; if (pred) then sc->l1[pred]=elm; else *head=elm;
+  }
+
+/*-------------------  CALENDAR QUEUE: RESIZE  -----------------------*/
+static void cq_resize(int nb)
+  { /* rebuild the calendar with nb buckets; the new bucket width is  */
+    /* three times the mean event separation over the current entries */
+    int *old=sc->cqb,oldnb=sc->cqnb,b,i,next; real tmin=0.0,tmax=0.0; int first=1;
+    for (b=0; b<oldnb; b++)
+      for (i=old[b]; i!=0; i=sc->l1[i])
+        {
+          if (first || (sc->l5[i]<tmin)) then tmin=sc->l5[i];
+          if (first || (sc->l5[i]>tmax)) then tmax=sc->l5[i];
+          first=0;
+        }
+    if ((sc->evn>1) && (tmax>tmin)) then sc->cqw=3.0*(tmax-tmin)/sc->evn;
+    sc->cqb=(int*)calloc(nb,sizeof(int));
+    if (sc->cqb==NULL) then error(0,"Calendar Queue Allocation Error");
+    sc->cqnb=nb; sc->cqvb=cq_vbucket(sc->clock);
+    for (b=0; b<oldnb; b++)
+      for (i=old[b]; i!=0; i=next) {next=sc->l1[i]; cq_enlist(i);}
+    free(old);
+  }
+#endif
+
+/*---------------------  INITIALIZE EVENT LIST  ----------------------*/
+static void evl_init()
+  {
+    sc->evl=0; sc->evn=0; sc->evseq=sc->evhseq=0.0;
+#if SMPL_EVENT_LIST_TYPE == SMPL_EVENT_LIST_HEAP
+    if (sc->evh==NULL) then
+      {
+        sc->evhcap=SMPL_HEAP_INITIAL_SIZE;
+        sc->evh=(int*)malloc(sc->evhcap*sizeof(int));
+        if (sc->evh==NULL) then error(0,"Event Heap Allocation Error");
+      }
+#elif SMPL_EVENT_LIST_TYPE == SMPL_EVENT_LIST_CALENDAR_QUEUE
+    free(sc->cqb);
+    sc->cqnb=SMPL_CQ_INITIAL_BUCKETS; sc->cqw=SMPL_CQ_INITIAL_WIDTH; sc->cqvb=0;
+    sc->cqb=(int*)calloc(sc->cqnb,sizeof(int));
+    if (sc->cqb==NULL) then error(0,"Calendar Queue Allocation Error");
+#endif
+  }
+
+/*---------------------  ENTER ELEMENT IN EVENT LIST  ----------------*/
+static void evl_insert(int elm, int head_flag)
+  { /* head_flag=0: insert after all entries with time <= l5[elm]  */
+    /* head_flag=1: insert at the head of the list (l5[elm]=clock) */
+    sc->l4[elm]=(head_flag)? -(++sc->evhseq):++sc->evseq;
+    sc->evn++;
+#if SMPL_EVENT_LIST_TYPE == SMPL_EVENT_LIST_HEAP
+    if (sc->evn>sc->evhcap) then
+      {
+        sc->evhcap*=2;
+        sc->evh=(int*)realloc(sc->evh,sc->evhcap*sizeof(int));
+        if (sc->evh==NULL) then error(0,"Event Heap Allocation Error");
+      }
+    sc->evh[sc->evn-1]=elm; evh_sift_up(sc->evn-1);
+#elif SMPL_EVENT_LIST_TYPE == SMPL_EVENT_LIST_CALENDAR_QUEUE
+    cq_enlist(elm);
+    if (sc->evn>2*sc->cqnb) then cq_resize(2*sc->cqnb);
+#else
+    if (head_flag)
+      then {sc->l1[elm]=sc->evl; sc->evl=elm;}
+      else enlist(&sc->evl,elm);
+#endif
+  }
+
+/*-----------------------  FIRST EVENT IN LIST  ----------------------*/
+static int evl_first()
+  { /* return the element of the next event, or 0 for an empty list */
+#if SMPL_EVENT_LIST_TYPE == SMPL_EVENT_LIST_HEAP
+    return((sc->evn>0)? sc->evh[0]:0);
+#elif SMPL_EVENT_LIST_TYPE == SMPL_EVENT_LIST_CALENDAR_QUEUE
+    int b,k,i,min=0;
+    if (sc->evn==0) then return(0);
+    /* scan one year of days starting at the day of the last event */
+    for (k=0; k<sc->cqnb; k++)
+      {
+        b=(int)((sc->cqvb+k)%sc->cqnb); i=sc->cqb[b];
+        if ((i!=0) && (cq_vbucket(sc->l5[i])==sc->cqvb+k)) then
+          {sc->cqvb+=k; return(i);}
+      }
+    /* no event within a year: search the earliest bucket head directly */
+    for (b=0; b<sc->cqnb; b++)
+      if ((sc->cqb[b]!=0) && ((min==0) || evl_before(sc->cqb[b],min))) then min=sc->cqb[b];
+    sc->cqvb=cq_vbucket(sc->l5[min]);
+    return(min);
+#else
+    return(sc->evl);
+#endif
+  }
+
+/*------------------  DELETE ELEMENT FROM EVENT LIST  ----------------*/
+static void evl_delete(int elm)
+  {
+#if SMPL_EVENT_LIST_TYPE == SMPL_EVENT_LIST_HEAP
+    int pos;
+    for (pos=0; sc->evh[pos]!=elm; pos++);   /* the head is found at once */
+    sc->evn--;
+    if (pos<sc->evn) then
+      {
+        sc->evh[pos]=sc->evh[sc->evn];
+        if ((pos>0) && evl_before(sc->evh[pos],sc->evh[(pos-1)/SMPL_HEAP_ARITY]))
+          then evh_sift_up(pos);
+          else evh_sift_down(pos);
+      }
+#elif SMPL_EVENT_LIST_TYPE == SMPL_EVENT_LIST_CALENDAR_QUEUE
+    int *head,pred=0,succ;
+    head=&sc->cqb[(int)(cq_vbucket(sc->l5[elm])%sc->cqnb)];
+    for (succ=*head; succ!=elm; succ=sc->l1[succ]) pred=succ;
+    if (pred) then sc->l1[pred]=sc->l1[elm]; else *head=sc->l1[elm];
+    sc->evn--;
+    if ((sc->cqnb>SMPL_CQ_INITIAL_BUCKETS) && (sc->evn<sc->cqnb/2)) then cq_resize(sc->cqnb/2);
+#else
+    int pred=0,succ;
+    for (succ=sc->evl; succ!=elm; succ=sc->l1[succ]) pred=succ;
+    if (pred) then sc->l1[pred]=sc->l1[elm]; else sc->evl=sc->l1[elm];
+    sc->evn--;
+#endif
+  }
+
+/*-------------------  SEARCH ELEMENT IN EVENT LIST  -----------------*/
+static int evl_search(int *l, int v)
+  { /* return the earliest event list element i with l[i]==v, or 0 */
+#if SMPL_EVENT_LIST_TYPE == SMPL_EVENT_LIST_HEAP
+    int pos,found=0;
+    for (pos=0; pos<sc->evn; pos++)
+      if ((l[sc->evh[pos]]==v) && ((found==0) || evl_before(sc->evh[pos],found)))
+        then found=sc->evh[pos];
+    return(found);
+#elif SMPL_EVENT_LIST_TYPE == SMPL_EVENT_LIST_CALENDAR_QUEUE
+    int b,i,found=0;
+    for (b=0; b<sc->cqnb; b++)
+      for (i=sc->cqb[b]; i!=0; i=sc->l1[i])
+        if ((l[i]==v) && ((found==0) || evl_before(i,found))) then
+          {found=i; break;}  /* the rest of this bucket is later */
+    return(found);
+#else
+    int succ=sc->evl;
+    while((succ!=0) && (l[succ]!=v)) succ=sc->l1[succ];
+    return(succ);
+#endif
+  }
+
 /*-------------------------  DEFINE FACILITY  ------------------------*/
 int facility(char *s,int n)
   //char *s; int n;
     {
       int f,i;
-      f=get_blk(n+2); l1[f]=n; l3[f+1]=save_name(s,(n>1 ? 14:17));
-      if (fchn==0)
-        then fchn=f;
-        else {i=fchn; while(l2[i+1]) i=l2[i+1]; l2[i+1]=f;}
-      l2[f+1]=0;
-      if (tr) then msg(13,-1,fname(f),f,0);
+      f=get_blk(n+2); sc->l1[f]=n; sc->l3[f+1]=save_name(s,(n>1 ? 14:17));
+      if (sc->fchn==0)
+        then sc->fchn=f;
+        else {i=sc->fchn; while(sc->l2[i+1]) i=sc->l2[i+1]; sc->l2[i+1]=f;}
+      sc->l2[f+1]=0;
+      if (sc->tr) then msg(13,-1,fname(f),f,0);
       return(f);
     }
 
@@ -272,12 +527,12 @@ int facility(char *s,int n)
 static void resetf()
 //static resetf()
   {
-    int i=fchn,j;
+    int i=sc->fchn,j;
       while(i)
         {
-          l4[i]=l4[i+1]=l5[i+1]=0.0;
-          for (j=i+2; j<=(i+l1[i]+1); j++) {l3[j]=0; l4[j]=0.0;}
-          i=l2[i+1];  /* advance to next facility */
+          sc->l4[i]=sc->l4[i+1]=sc->l5[i+1]=0.0;
+          for (j=i+2; j<=(i+sc->l1[i]+1); j++) {sc->l3[j]=0; sc->l4[j]=0.0;}
+          i=sc->l2[i+1];  /* advance to next facility */
         }
   }
 
@@ -286,17 +541,17 @@ int request(int f, int tkn, int pri)
   //int f,tkn,pri;
     {
       int i,r;
-      if (l2[f]<l1[f])
+      if (sc->l2[f]<sc->l1[f])
         then
           { /* facility nonbusy - reserve 1st-found nonbusy server    */
-            for (i=f+2; l1[i]!=0; i++);
-            l1[i]=tkn; l2[i]=pri; l5[i]=clock; l2[f]++; r=0;
+            for (i=f+2; sc->l1[i]!=0; i++);
+            sc->l1[i]=tkn; sc->l2[i]=pri; sc->l5[i]=sc->clock; sc->l2[f]++; r=0;
           }
         else
           { /* facility busy - enqueue token marked w/event, priority */
-            enqueue(f,tkn,pri,event,0.0); r=1;
+            enqueue(f,tkn,pri,sc->event,0.0); r=1;
           }
-      if (tr) then msg(7,tkn,fname(f),r,l3[f]);
+      if (sc->tr) then msg(7,tkn,fname(f),r,sc->l3[f]);
       return(r);
     }
 
@@ -306,9 +561,9 @@ static void enqueue(int f,int j, int pri, int ev, real te)
 //  int f,j,pri,ev; real te;
     {
       int i;
-      l5[f+1]+=l3[f]*(clock-l5[f]); l3[f]++; l5[f]=clock;
-      i=get_elm(); l2[i]=j; l3[i]=ev; l4[i]=te; l5[i]=(real)pri;
-      enlist(&l1[f+1],i);
+      sc->l5[f+1]+=sc->l3[f]*(sc->clock-sc->l5[f]); sc->l3[f]++; sc->l5[f]=sc->clock;
+      i=get_elm(); sc->l2[i]=j; sc->l3[i]=ev; sc->l4[i]=te; sc->l5[i]=(real)pri;
+      enlist(&sc->l1[f+1],i);
     }
 
 /*------------------------  PREEMPT FACILITY  ------------------------*/
@@ -316,22 +571,22 @@ int preempt(int f, int tkn, int pri)
   //int f,tkn,pri;
     {
       int ev,i,j,k,r; real te;
-      if (l2[f]<l1[f])
+      if (sc->l2[f]<sc->l1[f])
         then
           { /* facility nonbusy - locate 1st-found nonbusy server     */
-            for (k=f+2; l1[k]!=0; k++); r=0;
-            if (tr) then msg(8,tkn,fname(f),0,0);
+            for (k=f+2; sc->l1[k]!=0; k++); r=0;
+            if (sc->tr) then msg(8,tkn,fname(f),0,0);
           }
         else
           { /* facility busy - find server with lowest-priority user  */
-            k=f+2; j=l1[f]+f+1;  /* indices of server elements 1 & n  */
-            for (i=f+2; i<=j; i++) if (l2[i]<l2[k]) then k=i;
-            if (pri<=l2[k])
+            k=f+2; j=sc->l1[f]+f+1;  /* indices of server elements 1 & n  */
+            for (i=f+2; i<=j; i++) if (sc->l2[i]<sc->l2[k]) then k=i;
+            if (pri<=sc->l2[k])
               then
                 { /* requesting token's priority is not higher than   */
                   /* that of any user: enqueue requestor & return r=1 */
-                  enqueue(f,tkn,pri,event,0.0); r=1;
-                  if (tr) then msg(7,tkn,fname(f),1,l3[f]);
+                  enqueue(f,tkn,pri,sc->event,0.0); r=1;
+                  if (sc->tr) then msg(7,tkn,fname(f),1,sc->l3[f]);
                 }
               else
                 { /* preempt user of server k.  suspend event, save   */
@@ -342,19 +597,19 @@ int preempt(int f, int tkn, int pri)
                   /* (see 'enlist').  Update facility & server stati- */
                   /* stics for the preempted token, and set r = 0 to  */
                   /* reserve the facility for the preempting token.   */
-                  if (tr) then msg(8,tkn,fname(f),2,0);
-                  j=l1[k]; i=suspend(j); ev=l3[i]; te=l5[i]-clock;
+                  if (sc->tr) then msg(8,tkn,fname(f),2,0);
+                  j=sc->l1[k]; i=suspend(j); ev=sc->l3[i]; te=sc->l5[i]-sc->clock;
                   if (te==0.0) then te=1.0e-99; put_elm(i);
-                  enqueue(f,j,l2[k],ev,te);
-                  if (tr) then
-                    {msg(10,-1,"",j,l3[f]); msg(12,-1,fname(f),tkn,0);}
-                  l3[k]++; l4[k]+=clock-l5[k];
-                  l2[f]--; l4[f+1]++; r=0;
+                  enqueue(f,j,sc->l2[k],ev,te);
+                  if (sc->tr) then
+                    {msg(10,-1,"",j,sc->l3[f]); msg(12,-1,fname(f),tkn,0);}
+                  sc->l3[k]++; sc->l4[k]+=sc->clock-sc->l5[k];
+                  sc->l2[f]--; sc->l4[f+1]++; r=0;
                 }
           }
       if (r==0) then
         { /* reserve server k of facility */
-          l1[k]=tkn; l2[k]=pri; l5[k]=clock; l2[f]++;
+          sc->l1[k]=tkn; sc->l2[k]=pri; sc->l5[k]=sc->clock; sc->l2[f]++;
         }
       return(r);
     }
@@ -365,32 +620,32 @@ void release(int f, int tkn)
     {
       int i,j=0,k,m; real te;
       /* locate server (j) reserved by releasing token */
-      k=f+1+l1[f];     /* index of last server element */
-      for (i=f+2; i<=k; i++) if (l1[i]==tkn) then {j=i; break;}
+      k=f+1+sc->l1[f];     /* index of last server element */
+      for (i=f+2; i<=k; i++) if (sc->l1[i]==tkn) then {j=i; break;}
       if (j==0) then error(7,NULL); /* no server reserved */
-      l1[j]=0; l3[j]++; l4[j]+=clock-l5[j]; l2[f]--;
-      if (tr) then msg(9,tkn,fname(f),0,0);
-      if (l3[f]>0) then
+      sc->l1[j]=0; sc->l3[j]++; sc->l4[j]+=sc->clock-sc->l5[j]; sc->l2[f]--;
+      if (sc->tr) then msg(9,tkn,fname(f),0,0);
+      if (sc->l3[f]>0) then
         { /* queue not empty:  dequeue request ('k' =  */
           /* index of element) & update queue measures */
-          k=l1[f+1]; l1[f+1]=l1[k]; te=l4[k];
-          l5[f+1]+=l3[f]*(clock-l5[f]); l3[f]--; l4[f]++; l5[f]=clock;
-          if (tr) then msg(11,-1,"",l2[k],l3[f]);
+          k=sc->l1[f+1]; sc->l1[f+1]=sc->l1[k]; te=sc->l4[k];
+          sc->l5[f+1]+=sc->l3[f]*(sc->clock-sc->l5[f]); sc->l3[f]--; sc->l4[f]++; sc->l5[f]=sc->clock;
+          if (sc->tr) then msg(11,-1,"",sc->l2[k],sc->l3[f]);
           if (te==0.0) then
             then
               { /* blocked request:  place request at head of event   */
                 /* list (so its facility request can be re-initiated  */
                 /* before any other requests scheduled for this time) */
-                l5[k]=clock; l1[k]=evl; evl=k; m=4;
+                sc->l5[k]=sc->clock; evl_insert(k,1); m=4;
               }
             else
               { /* return after preemption:  reserve facility for de- */
                 /* queued request & reschedule remaining event time   */
-                l1[j]=l2[k]; l2[j]=(int)l5[k]; l5[j]=clock; l2[f]++;
-                if (tr) then msg(12,-1,fname(f),l2[k],0);
-                l5[k]=clock+te; enlist(&evl,k); m=5;
+                sc->l1[j]=sc->l2[k]; sc->l2[j]=(int)sc->l5[k]; sc->l5[j]=sc->clock; sc->l2[f]++;
+                if (sc->tr) then msg(12,-1,fname(f),sc->l2[k],0);
+                sc->l5[k]=sc->clock+te; evl_insert(k,0); m=5;
               }
-          if (tr) then msg(m,-1,"",l3[k],0);
+          if (sc->tr) then msg(m,-1,"",sc->l3[k],0);
         }
     }
 
@@ -398,24 +653,24 @@ void release(int f, int tkn)
 int status(int f)
   //int f;
     {
-      return(l1[f]==l2[f]? 1:0);
+      return(sc->l1[f]==sc->l2[f]? 1:0);
     }
 
 /*--------------------  GET CURRENT QUEUE LENGTH  --------------------*/
 int inq(int f)
   //int f;
     {
-      return(l3[f]);
+      return(sc->l3[f]);
     }
 
 /*--------------------  GET FACILITY UTILIZATION  --------------------*/
 real U(int f)
   //int f;
     {
-      int i; real b=0.0,t=clock-start;
+      int i; real b=0.0,t=sc->clock-sc->start;
       if (t>0.0) then
         {
-          for (i=f+2; i<=f+l1[f]+1; i++) b+=l4[i];
+          for (i=f+2; i<=f+sc->l1[f]+1; i++) b+=sc->l4[i];
           b/=t;
         }
       return(b);
@@ -426,7 +681,7 @@ real B(int f)
   //int f;
     {
       int i,n=0; real b=0.0;
-      for (i=f+2; i<=f+l1[f]+1; i++) {b+=l4[i]; n+=l3[i];}
+      for (i=f+2; i<=f+sc->l1[f]+1; i++) {b+=sc->l4[i]; n+=sc->l3[i];}
       return((n>0)? b/n:b);
     }
 
@@ -434,8 +689,8 @@ real B(int f)
 real Lq(int f)
   //int f;
     {
-      real t=clock-start;
-      return((t>0.0)? (l5[f+1]/t):0.0);
+      real t=sc->clock-sc->start;
+      return((t>0.0)? (sc->l5[f+1]/t):0.0);
     }
 
 /*-----------------------  TURN TRACE ON/OFF  ------------------------*/
@@ -444,10 +699,10 @@ void trace(int n)
     {
       switch(n)
         {
-          case 0: tr=0; break;
+          case 0: sc->tr=0; break;
           case 1:
           case 2:
-          case 3: tr=n; tl=-1.0; newpage(); break;
+          case 3: sc->tr=n; sc->tl=-1.0; newpage(); break;
           case 4: end_line(); break;
          default: break;
         }
@@ -461,13 +716,13 @@ static void msg(int n, int i, char *s, int q1,int q2)
       static char *m[14] = {"",  "SCHEDULE", "CAUSE", "CANCEL",
         "   RESCHEDULE","   RESUME", "   SUSPEND", "REQUEST", "PREEMPT",
         "RELEASE", "   QUEUE", "   DEQUEUE", "   RESERVE", "FACILITY" };
-      if (clock>tl)     /* print time stamp (if time has advanced) */
-        then {tl=clock; fprintf(opf,"  time %-12.3f  ",clock);}
-        else fprintf(opf,"%21s",m[0]);
+      if (sc->clock>sc->tl)     /* print time stamp (if time has advanced) */
+        then {sc->tl=sc->clock; fprintf(sc->opf,"  time %-12.3f  ",sc->clock);}
+        else fprintf(sc->opf,"%21s",m[0]);
       if (i>=0)         /* print token number if specified */
-        then fprintf(opf,"--  token %-4d  -- ",i);
-        else fprintf(opf,"--              -- ");
-      fprintf(opf,"%s %s",m[n],s);  /* print basic message */
+        then fprintf(sc->opf,"--  token %-4d  -- ",i);
+        else fprintf(sc->opf,"--              -- ");
+      fprintf(sc->opf,"%s %s",m[n],s);  /* print basic message */
       switch(n)
         { /* append qualifier */
           case 1:
@@ -475,51 +730,51 @@ static void msg(int n, int i, char *s, int q1,int q2)
           case 3:
           case 4:
           case 5:
-          case 6:  fprintf(opf," EVENT %d",q1); break;
+          case 6:  fprintf(sc->opf," EVENT %d",q1); break;
           case 7:
           case 8:  switch(q1)
                      {
-                       case 0: fprintf(opf,":  RESERVED"); break;
-                       case 1: fprintf(opf,":  QUEUED  (inq = %d)",q2);
+                       case 0: fprintf(sc->opf,":  RESERVED"); break;
+                       case 1: fprintf(sc->opf,":  QUEUED  (inq = %d)",q2);
                                break;
-                       case 2: fprintf(opf,":  INTERRUPT"); break;
+                       case 2: fprintf(sc->opf,":  INTERRUPT"); break;
                        default: break;
                      }
                    break;
           case 9:  break;
           case 10:
-          case 11: fprintf(opf," token %d  (inq = %d)",q1,q2); break;
-          case 12: fprintf(opf," for token %d",q1); break;
-          case 13: fprintf(opf,":  f = %d",q1); break;
+          case 11: fprintf(sc->opf," token %d  (inq = %d)",q1,q2); break;
+          case 12: fprintf(sc->opf," for token %d",q1); break;
+          case 13: fprintf(sc->opf,":  f = %d",q1); break;
           default: break;
         }
-      fprintf(opf,"\n"); end_line();
+      fprintf(sc->opf,"\n"); end_line();
     }
 
 /*-------------------------  TRACE LINE END  -------------------------*/
 static void end_line()
 //static end_line()
   {
-    if ((--lft)==0) then
+    if ((--sc->lft)==0) then
       { /* end of page/screen.  for trace 1, advance page if print- */
         /* er output;  screen output is free-running.  for trace 2, */
         /* pause on full screen;  for trace 3, pause after line.    */
-        switch(tr)
+        switch(sc->tr)
           {
-            case 1: if (opf==display)
-                      then lft=sl;
+            case 1: if (sc->opf==sc->display)
+                      then sc->lft=sl;
                       else endpage();
                     break;
-            case 2: if (mr)
+            case 2: if (sc->mr)
 	              //then {putchar('\n'); lft=sl; pause();}
-	              then {putchar('\n'); lft=sl; smpl_pause();}
+	              then {putchar('\n'); sc->lft=sl; smpl_pause();}
                       else endpage();
                     break;
-            case 3: lft=sl; break;
+            case 3: sc->lft=sl; break;
           }
       }
     //if (tr==3) then pause();
-      if (tr==3) then smpl_pause();
+      if (sc->tr==3) then smpl_pause();
   }
 
 /*-----------------------------  PAUSE  ------------------------------*/
@@ -543,15 +798,15 @@ void error(int n, char *s)
                    "Empty Event List",
                    "Preempted Token Not in Event List",
                    "Release of Idle/Unowned Facility" };
-      dest=opf;
+      dest=sc->opf;
       while(1)
         { /* send messages to both printer and screen */
-          fprintf(dest,"\n**** %s%.3f\n",m[0],clock);
+          fprintf(dest,"\n**** %s%.3f\n",m[0],sc->clock);
           if (n) then fprintf(dest,"     %s\n",m[n]);
           if (s!=NULL) then fprintf(dest,"     %s\n",s);
-          if (dest==display) then break; else dest=display;
+          if (dest==sc->display) then break; else dest=sc->display;
         }
-      if (opf!=display) then report();
+      if (sc->opf!=sc->display) then report();
    /* if (mr) then mtr(0,1); */
       exit(0);
     }
@@ -568,8 +823,8 @@ void report()
 void reportf()
   {
     int f;
-    if ((f=fchn)==0)
-      then fprintf(opf,"\nno facilities defined:  report abandoned\n");
+    if ((f=sc->fchn)==0)
+      then fprintf(sc->opf,"\nno facilities defined:  report abandoned\n");
       else
         { /* f = 0 at end of facility chain */
           while(f) {f=rept_page(f); if (f>0) then endpage();}
@@ -587,21 +842,21 @@ static int rept_page(int fnxt)
         "MEAN BUSY     MEAN QUEUE        OPERATION COUNTS",
         " FACILITY          UTIL.    ",
         " PERIOD        LENGTH     RELEASE   PREEMPT   QUEUE" };
-      fprintf(opf,"\n%51s\n\n\n",s[0]);
-      fprintf(opf,"%-s%-54s%-s%11.3f\n",s[1],mname(),s[2],clock);
-      fprintf(opf,"%68s%11.3f\n\n",s[3],clock-start);
-      fprintf(opf,"%75s\n",s[4]);
-      fprintf(opf,"%s%s\n",s[5],s[6]);
-      f=fnxt; lft-=8;
-      while(f && lft--)
+      fprintf(sc->opf,"\n%51s\n\n\n",s[0]);
+      fprintf(sc->opf,"%-s%-54s%-s%11.3f\n",s[1],mname(),s[2],sc->clock);
+      fprintf(sc->opf,"%68s%11.3f\n\n",s[3],sc->clock-sc->start);
+      fprintf(sc->opf,"%75s\n",s[4]);
+      fprintf(sc->opf,"%s%s\n",s[5],s[6]);
+      f=fnxt; sc->lft-=8;
+      while(f && sc->lft--)
         {
-          n=0; for (i=f+2; i<=f+l1[f]+1; i++) n+=l3[i];
-          if (l1[f]==1)
+          n=0; for (i=f+2; i<=f+sc->l1[f]+1; i++) n+=sc->l3[i];
+          if (sc->l1[f]==1)
             then sprintf(fn,"%s",fname(f));
-            else sprintf(fn,"%s[%d]",fname(f),l1[f]);
-          fprintf(opf," %-17s%6.4f %10.3f %13.3f %11d %9d %7d\n",
-            fn,U(f),B(f),Lq(f),n,(int)l4[f+1],(int)l4[f]);
-          f=l2[f+1];
+            else sprintf(fn,"%s[%d]",fname(f),sc->l1[f]);
+          fprintf(sc->opf," %-17s%6.4f %10.3f %13.3f %11d %9d %7d\n",
+            fn,U(f),B(f),Lq(f),n,(int)sc->l4[f+1],(int)sc->l4[f]);
+          f=sc->l2[f+1];
         }
       return(f);
     }
@@ -610,22 +865,22 @@ static int rept_page(int fnxt)
 int lns(int i)
   //int i;
     {
-      lft-=i;  if (lft<=0) then endpage();
-      return(lft);
+      sc->lft-=i;  if (sc->lft<=0) then endpage();
+      return(sc->lft);
     }
 
 /*----------------------------  END PAGE  ----------------------------*/
 void endpage()
   {
     //int c;
-    if (opf==display)
+    if (sc->opf==sc->display)
       then
         { /* screen output: push to top of screen & pause */
-          while(lft>0) {putc('\n',opf); lft--;}
+          while(sc->lft>0) {putc('\n',sc->opf); sc->lft--;}
           printf("\n[ENTER] to continue:");  getchar();
        /* if (mr) then clr_scr(); else */ printf("\n\n");
         }
-      else if (lft<pl) then putc(FF,opf);
+      else if (sc->lft<pl) then putc(FF,sc->opf);
     newpage();
   }
 
@@ -633,13 +888,13 @@ void endpage()
 void newpage()
   { /* set line count to top of page/screen after page change/screen  */
     /* clear by 'smpl', another SMPL module, or simulation program    */
-    lft=(opf==display)? sl:pl;
+    sc->lft=(sc->opf==sc->display)? sl:pl;
   }
 
 /*------------------------  REDIRECT OUTPUT  -------------------------*/
 FILE *sendto(FILE *dest)
   //FILE *dest;
     {
-      if (dest!=NULL) then opf=dest;
-      return(opf);
+      if (dest!=NULL) then sc->opf=dest;
+      return(sc->opf);
     }
@@ -20,9 +20,11 @@ typedef double real;
 //@ modified by jaehoon, 01/08/2005
 //@ nl increase for processing fast arrivals of open-loop traffic
 
-/* element pool length */ 
+/* maximum element pool length; the pool of a simulation context is */
+/* allocated on demand from SMPL_POOL_INITIAL_SIZE up to this length   */
 //#define nl (256*10000)   
 #define nl (256*30000)
+#define SMPL_POOL_INITIAL_SIZE 4096   /* initial element pool length */
 
 //#define nl (256*10000)   /* element pool length                 */ 
 //#define nl (256*1000)   /* element pool length                 */ //=> [01/08/08] issues an error of "Empty Pool Element"
@@ -32,6 +34,132 @@ typedef double real;
 #define sl 23        /* screen page length     by 'smpl')   */
 #define FF 12        /* form feed                           */
 
+/* event list implementation, selected at build time with              */
+/* -DSMPL_EVENT_LIST_TYPE=n (see SMPL_EVENT_LIST in Makefile):          */
+/* all three give the same event order; entries with equal time are    */
+/* dispatched in FIFO order of their schedule() calls                  */
+#define SMPL_EVENT_LIST_LINKED_LIST    0 /* legacy sorted linked list, O(n) insert   */
+#define SMPL_EVENT_LIST_HEAP           1 /* 4-ary min-heap, O(log n) insert/remove   */
+#define SMPL_EVENT_LIST_CALENDAR_QUEUE 2 /* calendar queue, O(1) amortized           */
+
+#ifndef SMPL_EVENT_LIST_TYPE
+#define SMPL_EVENT_LIST_TYPE SMPL_EVENT_LIST_HEAP
+#endif
+
+#define SMPL_HEAP_ARITY 4             /* number of children per heap node        */
+#define SMPL_HEAP_INITIAL_SIZE 1024   /* initial heap array length               */
+#define SMPL_CQ_INITIAL_BUCKETS 2     /* initial number of calendar buckets      */
+#define SMPL_CQ_INITIAL_WIDTH 1.0     /* initial calendar bucket width           */
+
+/* simulation context: the state of one simulation, that is, the smpl */
+/* element pool & event list, the random number streams, & the vehicle */
+/* registry of util.c; run() binds its context to the calling thread   */
+/* so that independent simulations can run in one process              */
+struct struct_vehicle;
+
+/* counter-based random number substream (see rand.c): the draws of a  */
+/* substream are the Philox4x32-10 blocks of the counters 0, 1, 2, ... */
+/* under a key made of the seed, the entity type & the entity id        */
+typedef struct rand_substream
+{
+  unsigned int key[2];        /* seed of the substream              */
+  unsigned int entity[2];     /* entity type & entity id            */
+  unsigned long long counter; /* index of the next draw             */
+} rand_substream_t;
+
+typedef struct simulation_context
+{
+  /* smpl simulation subsystem */
+  FILE *display,     /* screen display file                 */
+    *opf;            /* current output destination          */
+  int event,         /* current simulation event            */
+    token,           /* last token dispatched               */
+    blk,             /* next available block index          */
+    avl,             /* available element list header       */
+    evl,             /* event list header                   */
+    fchn,            /* facility descriptor chain header    */
+    avn,             /* next available namespace position   */
+    tr,              /* event trace flag                    */
+    mr,              /* monitor activation flag             */
+    lft,             /* lines left on current page/screen   */
+    rns;             /* random number stream for next smpl() */
+  real clock,        /* current simulation time             */
+    start,           /* simulation interval start time      */
+    tl;              /* last trace message issue time       */
+  int *l1,*l2,*l3;   /* facility descriptor, queue, &       */
+  real *l4,*l5;      /* event list element pool             */
+  int pool_size;     /* allocated length of the element pool */
+  char name[ns];     /* model and facility name space       */
+  real evseq,        /* sequence number of last tail insertion */
+    evhseq;          /* sequence number of last head insertion */
+  int evn;           /* number of entries in event list     */
+  int *evh,          /* heap of element indices             */
+    evhcap;          /* allocated length of evh             */
+  int *cqb,          /* calendar bucket heads               */
+    cqnb;            /* number of buckets                   */
+  real cqw;          /* bucket width (time length of a day) */
+  long long cqvb;    /* virtual bucket of the last dequeued event */
+
+  /* random number generation (rand.c) */
+  long In[16];                /* seeds for streams 1 thru 15        */
+  int strm;                   /* index of current stream            */
+  unsigned short xsubi[3];    /* state of the drand48() generator   */
+  real normal_spare;          /* second variate of normal()         */
+  unsigned long rand_seed;    /* seed given to seed_random()        */
+  rand_substream_t streams[16];  /* counter-based streams 1 thru 15 */
+  rand_substream_t *substream;   /* substream replacing the current stream, if any */
+
+  /* vehicle registry (util.c) */
+  struct struct_vehicle *vehicle_list;        /* head node for vehicle list */
+  struct struct_vehicle **vehicle_registry;   /* vehicles indexed by id     */
+  int vehicle_registry_size;                  /* number of slots            */
+  int vehicle_registry_duplicate_number;      /* vehicles with a duplicate id */
+} simulation_context_t;
+
+simulation_context_t* simulation_context_create(); //create a simulation context with an empty element pool and the default random number streams
+void simulation_context_destroy(simulation_context_t *ctx); //free a simulation context along with its element pool and vehicle registry
+void simulation_context_bind(simulation_context_t *ctx); //bind ctx to the calling thread as its current simulation context
+simulation_context_t* simulation_context_current(); //return the current simulation context of the calling thread, creating one if none is bound
+
+/* storage class of the state of a simulation that is kept per thread  */
+/* instead of in the context: the scratch arrays that are reused by    */
+/* the calls of one simulation but carry nothing from call to call     */
+#if defined(_WIN32)
+#define SMPL_THREAD_LOCAL __declspec(thread)
+#else
+#define SMPL_THREAD_LOCAL __thread
+#endif
+
+/* state of a simulation kept per thread with SMPL_THREAD_LOCAL:       */
+/*   the target point batch of shortest-path.c (target_point_batch_*)  */
+/*   & the trajectory edge index stamp of tpd.c                        */
+/*   (tpd_encounter_candidate_stamp); the APSP repair scratch of       */
+/*   all-pairs-shortest-paths.c is per thread with APSP_THREAD_LOCAL   */
+/*                                                                     */
+/* state that is still process-wide, so two simulations run on two     */
+/* threads of one process would share it:                              */
+/*   - param & the road network of run() in main.c (Gr, Er, DEr, the   */
+/*     traffic tables & the APSP matrices): locals of main() & run()   */
+/*     that are passed down by pointer, & also stored into param by    */
+/*     create_vanet_information_table_in_parameter(), so they are per  */
+/*     run but not yet in the context                                  */
+/*   - the GSL workspace pool & the probability memo table of          */
+/*     gsl-util.c (gsl_workspace_pool, gsl_probability_memo_table)     */
+/*   - the queue node slabs of queue.c (queue_node_slab_table) behind  */
+/*     queue_node_slab_mutex                                           */
+/*   - the statistics & self-check counters of all-pairs-shortest-     */
+/*     paths.c, gsl-util.c, tpd.c & shortest-path.c                    */
+/*   - the trace & log file pointers of util.c (fp_vanet, fp_path_list */
+/*     & the others opened by open_*_file())                           */
+/*   - the gnuplot & visualization globals of main.c (g_*) & tpd.c     */
+/*     (g_margin_time, g_predicted_encounter_time), & vadd.c           */
+/*     (g_expired_meeting_count, m_isLogOn)                            */
+/*   - the function-local statics of the target point selection of     */
+/*     shortest-path.c (vehicle_trajectory_expiration_count),          */
+/*     schedule.c, util.c, heap.c & all-pairs-shortest-paths.c         */
+/*   - the sweep state of option -+ in main.c (sweep_*), which is set  */
+/*     before any simulation starts                                    */
+
 //extern real Lq(), U(), B(), time();
 //extern char *fname(), *mname();
 //extern FILE *sendto();
@@ -51,6 +179,7 @@ int cause(int *ev,int *tkn);
 //real time();
 real smpl_time();
 int cancel(int ev);
+int smpl_event_number(); //return the number of events in the event list
 int facility(char *s,int n);
 int request(int f, int tkn, int pri);
 int preempt(int f, int tkn, int pri);
@@ -21,7 +21,7 @@ int TADB_Get_RefTime_And_Target_Zone(parameter_t *param, struct_graph_node *Gr,
 	// Get all intersection on receiver trajectory
 	for(path_ptr = path_list->next; path_ptr != path_list;)								
 	{
-		tmpIntersection = atoi(path_ptr->vertex);				
+		tmpIntersection = path_ptr->vertex_id;				
 		printf("%d ",tmpIntersection);
 		if (valid_flag == 1)
 		{
@@ -69,12 +69,12 @@ int TADB_Get_RefTime_And_Target_Zone(parameter_t *param, struct_graph_node *Gr,
 	int maxIntersection;
 	int minIntersection;
 							
-	minIntersection = atoi(receiver_vehicle->path_ptr->vertex);
+	minIntersection = receiver_vehicle->path_ptr->vertex_id;
 					
 	valid_flag = 0;		
 	for(path_ptr = path_list->next; path_ptr != path_list;)								
 	{
-		tmpIntersection = atoi(path_ptr->vertex);	
+		tmpIntersection = path_ptr->vertex_id;	
 								
 		if (valid_flag == 1)
 		{
@@ -116,7 +116,7 @@ int TADB_Get_RefTime_And_Target_Zone(parameter_t *param, struct_graph_node *Gr,
 	valid_flag = 0;		
 	for(path_ptr = path_list->next; path_ptr != path_list;)								
 	{
-		tmpIntersection = atoi(path_ptr->vertex);	
+		tmpIntersection = path_ptr->vertex_id;	
 									
 		if (tmpIntersection == minIntersection)
 		{
@@ -97,6 +97,59 @@ int TPD_Allocate_Predicted_Encounter_Graph_For_Packet(packet_queue_node_t* packe
 	return 0;
 }
 
+#if PACKET_COPY_ON_WRITE_FLAG /* [ */
+int TPD_Share_Predicted_Encounter_Graph_For_Packet(packet_queue_node_t* packet)
+{ //let packet, which is a copy of another packet of the same global packet, share the predicted encounter graph pointed by its predicted_encounter_graph with the other packet; it returns 1 if packet shares the graph, and 0 if packet needs its own graph
+	packet_queue_node_t *original_packet = NULL; //pointer to the original packet of packet's global packet
+
+	if(packet == NULL)
+	{
+		printf("%s:%d packet is NULL!\n", 
+				__FUNCTION__, __LINE__);
+		exit(1);
+	}
+
+	/* a new packet or a packet copy made before its global packet exists has no graph to share */
+	if(packet->predicted_encounter_graph == NULL || packet->global_packet == NULL)
+		return 0;
+
+	/* the holders of a shared graph are the packet copies in the packet pointer list of the global packet; the copies of a packet in the list stay in the list, so a copy of a packet not in the list is a copy of the original packet */
+	if(packet->packet_pointer == NULL)
+	{
+		original_packet = packet->global_packet->packet;
+		if(original_packet == NULL || original_packet->packet_pointer != NULL || original_packet->predicted_encounter_graph != packet->predicted_encounter_graph)
+			return 0;
+
+		Enqueue_Packet_Into_PacketPointerList(original_packet);
+	}
+
+	Enqueue_Packet_Into_PacketPointerList(packet);
+
+	return 1;
+}
+
+int TPD_Unshare_Predicted_Encounter_Graph_For_Packet(packet_queue_node_t* packet)
+{ //give packet its own predicted encounter graph if packet shares its graph with other packet copies; this must be called before packet's graph is rebuilt 
+
+	if(packet == NULL)
+	{
+		printf("%s:%d packet is NULL!\n", 
+				__FUNCTION__, __LINE__);
+		exit(1);
+	}
+
+	if(packet->packet_pointer == NULL || Is_Predicted_Encounter_Graph_Shared_In_PacketPointerList(packet) == FALSE)
+		return 0;
+
+	/* leave the shared graph to the other packet copies; the new graph starts empty as the graph allocated for every packet copy did before the copies shared it */
+	packet->predicted_encounter_graph->holder_count--;
+	TPD_Allocate_Predicted_Encounter_Graph_For_Packet(packet);
+	packet->predicted_encounter_graph->holder_count = 1; //packet stays in the packet pointer list as the only holder of its new graph
+
+	return 1;
+}
+#endif /* ] */
+
 int TPD_Free_Predicted_Encounter_Graph(struct_vehicle_t *vehicle)
 { //free the memory of a predicted encounter graph for vehicle
 
@@ -121,6 +174,9 @@ int TPD_Free_Predicted_Encounter_Graph(struct_vehicle_t *vehicle)
 
 int TPD_Free_Predicted_Encounter_Graph_For_Packet(packet_queue_node_t* packet)
 { //free the memory of a predicted encounter graph for packet 
+#if PACKET_COPY_ON_WRITE_FLAG /* [ */
+	boolean shared_flag = FALSE; //flag to indicate whether another packet copy holds packet's graph
+#endif /* ] */
 
 	if(packet == NULL)
 	{
@@ -129,6 +185,21 @@ int TPD_Free_Predicted_Encounter_Graph_For_Packet(packet_queue_node_t* packet)
 		exit(1);
 	}
 
+#if PACKET_COPY_ON_WRITE_FLAG /* [ */
+	/* let the other packet copies keep the graph if they still share it */
+	if(packet->packet_pointer != NULL)
+	{
+		shared_flag = Is_Predicted_Encounter_Graph_Shared_In_PacketPointerList(packet);
+		Dequeue_Packet_From_PacketPointerList(packet);
+
+		if(shared_flag)
+		{
+			packet->predicted_encounter_graph = NULL;
+			return 0;
+		}
+	}
+#endif /* ] */
+
 	/* destroy packet's predicted_encounter_graph's minimum priority queue */
 	DestroyQueue((queue_t*)&(packet->predicted_encounter_graph->Q)); 
 
@@ -170,6 +241,12 @@ int TPD_Reset_Queues_In_Predicted_Encounter_Graph_For_Packet(packet_queue_node_t
 		exit(1);
 	}
 
+#if PACKET_COPY_ON_WRITE_FLAG /* [ */
+	/* a packet copy sharing its graph gets an empty graph of its own instead of resetting the shared one */
+	if(TPD_Unshare_Predicted_Encounter_Graph_For_Packet(packet))
+		return 0;
+#endif /* ] */
+
 	/* reset packet's predicted_encounter_graph's minimum priority queue */
 	ResetQueue((queue_t*)&(packet->predicted_encounter_graph->Q)); 
 
@@ -248,6 +325,121 @@ double TPD_Compute_EDR_and_EDD_For_Source_Routing(double current_time,
 	return EDR;
 }
 
+static SMPL_THREAD_LOCAL int tpd_encounter_candidate_stamp = 0; //stamp for the latest query of the trajectory edge index of the simulation on this thread; it increases across indices so that a stale stamp in a vehicle never matches
+
+static int TPD_Compare_Trajectory_Edge_Entry(const void *a, const void *b)
+{ //compare two trajectory edge entries in the order of tail, head and T_tail for qsort()
+	const tpd_trajectory_edge_entry_t *x = (const tpd_trajectory_edge_entry_t*)a;
+	const tpd_trajectory_edge_entry_t *y = (const tpd_trajectory_edge_entry_t*)b;
+
+	if(x->tail != y->tail)
+		return (x->tail < y->tail ? -1 : 1);
+	else if(x->head != y->head)
+		return (x->head < y->head ? -1 : 1);
+	else if(x->T_tail != y->T_tail)
+		return (x->T_tail < y->T_tail ? -1 : 1);
+	else
+		return 0;
+}
+
+void TPD_Build_Trajectory_Edge_Index(tpd_trajectory_edge_index_t *index)
+{ //build the trajectory edge index with the remaining trajectories of the vehicles in vehicle_list
+	struct struct_vehicle* vehicle_list = get_vehicle_list(); //pointer to vehicle_list
+	struct struct_vehicle* vehicle = NULL; //pointer to vehicle node
+	struct_path_node *path_ptr = NULL; //pointer to the tail vertex of an edge along a vehicle trajectory
+	int entry_number = 0; //number of road segments on the remaining trajectories
+	int i = 0; //index for entries
+
+	memset(index, 0, sizeof(tpd_trajectory_edge_index_t));
+
+	/* count the road segments visited in TPD_Compute_Encounter_Probability(), that is, from path_ptr up to the last edge */
+	for(vehicle = vehicle_list->next; vehicle != vehicle_list; vehicle = vehicle->next)
+	{
+		if(vehicle->path_list == NULL || vehicle->path_ptr == NULL)
+			continue;
+
+		for(path_ptr = vehicle->path_ptr; path_ptr != vehicle->path_list->prev; path_ptr = path_ptr->next)
+			entry_number++;
+	}
+
+	if(entry_number == 0)
+		return;
+
+	index->entry = (tpd_trajectory_edge_entry_t*) calloc(entry_number, sizeof(tpd_trajectory_edge_entry_t));
+	assert_memory(index->entry);
+
+	for(vehicle = vehicle_list->next; vehicle != vehicle_list; vehicle = vehicle->next)
+	{
+		if(vehicle->path_list == NULL || vehicle->path_ptr == NULL)
+			continue;
+
+		for(path_ptr = vehicle->path_ptr; path_ptr != vehicle->path_list->prev; path_ptr = path_ptr->next)
+		{
+			index->entry[i].tail = path_ptr->vertex_id;
+			index->entry[i].head = path_ptr->next->vertex_id;
+			index->entry[i].T_tail = path_ptr->expected_arrival_time;
+			index->entry[i].vehicle = vehicle;
+			i++;
+		}
+	}
+
+	index->entry_number = entry_number;
+
+	/* sort the entries so that the entries of a road segment are contiguous in ascending order of T_tail */
+	qsort(index->entry, entry_number, sizeof(tpd_trajectory_edge_entry_t), TPD_Compare_Trajectory_Edge_Entry);
+}
+
+static void TPD_Mark_Trajectory_Edge_Vehicles(tpd_trajectory_edge_index_t *index, int tail, int head, double T_threshold)
+{ //set index->stamp in the vehicles whose trajectories have the road segment (tail, head) with the arrival time at tail not earlier than T_threshold
+	tpd_trajectory_edge_entry_t *entry = index->entry; //entries
+	int low = 0, high = index->entry_number, mid = 0; //indices for binary search
+	int i = 0; //index for entries
+
+	/* find the first entry of (tail, head) whose T_tail is not less than T_threshold */
+	while(low < high)
+	{
+		mid = (low + high)/2;
+		if(entry[mid].tail < tail || (entry[mid].tail == tail && (entry[mid].head < head || (entry[mid].head == head && entry[mid].T_tail < T_threshold))))
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	for(i = low; i < index->entry_number && entry[i].tail == tail && entry[i].head == head; i++)
+		entry[i].vehicle->tpd_encounter_candidate_stamp = index->stamp;
+}
+
+void TPD_Mark_Encounter_Candidates(tpd_trajectory_edge_index_t *index, struct_vehicle_t *vehicle, double T_threshold)
+{ //set index->stamp in the vehicles that can encounter vehicle in TPD_Compute_Encounter_Probability(), that is, the vehicles having a road segment of vehicle's trajectory in either direction with the arrival times at the tail vertices not earlier than T_threshold
+	struct_path_node *path_ptr = NULL; //pointer to the tail vertex of an edge along vehicle's trajectory
+
+	index->stamp = ++tpd_encounter_candidate_stamp;
+
+	if(vehicle->path_list == NULL || vehicle->path_ptr == NULL)
+		return;
+
+	for(path_ptr = vehicle->path_ptr; path_ptr != vehicle->path_list->prev; path_ptr = path_ptr->next)
+	{
+		if(path_ptr->expected_arrival_time < T_threshold)
+			continue;
+
+		/* vehicles moving in the opposite direction and in the same direction */
+		TPD_Mark_Trajectory_Edge_Vehicles(index, path_ptr->next->vertex_id, path_ptr->vertex_id, T_threshold);
+		TPD_Mark_Trajectory_Edge_Vehicles(index, path_ptr->vertex_id, path_ptr->next->vertex_id, T_threshold);
+	}
+}
+
+void TPD_Free_Trajectory_Edge_Index(tpd_trajectory_edge_index_t *index)
+{ //free the memory of the trajectory edge index
+	if(index->entry != NULL)
+	{
+		free(index->entry);
+		index->entry = NULL;
+	}
+
+	index->entry_number = 0;
+}
+
 double TPD_Construct_Predicted_Encounter_Graph(double current_time,
 		parameter_t *param, 
 		struct_vehicle_t *src_vehicle, 
@@ -280,6 +472,7 @@ double TPD_Construct_Predicted_Encounter_Graph(double current_time,
 	double O_encounter = 0; //offset in the encountered edge where src_vehicle and vehicle encounter
 	boolean destination_flag = FALSE; //flag to indicate whether the graph node for dst_vehicle exists in the graph G
 	double EDR = 0; //Expected Delivery Ratio (EDR)
+	tpd_trajectory_edge_index_t edge_index; //trajectory edge index to find the encounter candidates of a vehicle
 
 #if 0 /* [ */
 	if(current_time > 8012 && src_vehicle->id == 94)
@@ -313,6 +506,15 @@ double TPD_Construct_Predicted_Encounter_Graph(double current_time,
 		return EDR;
 	}
 
+	/* bring the offsets of all the vehicles up to date under STEP_ANALYTIC since the encounter prediction reads the vehicles' positions beyond the scanned edges */
+	update_all_vehicle_positions_on_demand(param, current_time);
+
+#if TPD_TRAJECTORY_EDGE_INDEX_FLAG /* [ */
+	/* index the road segments on the vehicle trajectories to find the encounter candidates of each vehicle dequeued from Q */
+	TPD_Build_Trajectory_Edge_Index(&edge_index);
+#endif /* ] */
+
+
 	/* set up Q and G with src_vehicle's predicted_encounter_graph */
 	Q = &(src_vehicle->predicted_encounter_graph->Q);
 	G = &(src_vehicle->predicted_encounter_graph->G);
@@ -497,6 +699,10 @@ int tempX = 1;
 		 *		*/
 		//T_threshold = pQueueNode->key; //the encounter time of vehicle and its parent vehicle  
 		vehicle_list = get_vehicle_list(); //get the pointer to vehicle_list defined in util.c
+#if TPD_TRAJECTORY_EDGE_INDEX_FLAG /* [ */
+		TPD_Mark_Encounter_Candidates(&edge_index, current_vehicle, T_threshold); //find the vehicles that can encounter current_vehicle
+#endif /* ] */
+
 		
 		vehicle = vehicle_list->next;
 	/*	printf("%.2f] taehwan11272130 TPD Construct ",current_time);
@@ -528,6 +734,15 @@ int tempX = 1;
 			flag = TPD_Do_Vehicles_Encounter(current_time, param, current_vehicle, vehicle, &tail_vertex, &head_vertex, &edge_length, &P_encounter, &T_encounter, &D_encounter, &O_encounter); //check whether src_vehicle and vehicle encounter at the offset O_encounter in an edge (tail_vertex, head_vertex) with P_encounter of at least encounter_probability_threshold at time T_encounter after the travel time (i.e., delay) of D_encounter.
 #endif /* ] */
 			
+#if TPD_TRAJECTORY_EDGE_INDEX_FLAG /* [ */
+			/* skip the vehicle whose trajectory shares no road segment with current_vehicle's trajectory after T_threshold */
+			if(vehicle->tpd_encounter_candidate_stamp != edge_index.stamp)
+			{
+				vehicle = vehicle->next; //move on the next vehicle in vehicle_list
+				continue;
+			}
+#endif /* ] */
+
 			flag = TPD_Compute_Encounter_Probability(param, 
 					vehicle, 
 					current_vehicle,
@@ -646,6 +861,11 @@ int tempX = 1;
 	//if (src_vehicle->id == 193)
 	//	printf("\n%.2f] EDR %d is %.2f\n\n",current_time,src_vehicle->id,src_vehicle->EDR_for_V2V);
 	
+#if TPD_TRAJECTORY_EDGE_INDEX_FLAG /* [ */
+	TPD_Free_Trajectory_Edge_Index(&edge_index);
+#endif /* ] */
+
+
 	return src_vehicle->EDR_for_V2V;
 }
 
@@ -682,6 +902,7 @@ double TPD_Construct_Predicted_Encounter_Graph_For_Packet(double current_time,
 	double O_encounter = 0; //offset in the encountered edge where src_vehicle and vehicle encounter
 	boolean destination_flag = FALSE; //flag to indicate whether the graph node for dst_vehicle exists in the graph G
 	double EDR = 0; //Expected Delivery Ratio (EDR)
+	tpd_trajectory_edge_index_t edge_index; //trajectory edge index to find the encounter candidates of a vehicle
 
 	//printf("TPD_Construct_Predicted_Encounter_Graph_For_Packet %.2f\n",current_time);
 
@@ -722,6 +943,20 @@ double TPD_Construct_Predicted_Encounter_Graph_For_Packet(double current_time,
 		return EDR;
 	}
 
+	/* bring the offsets of all the vehicles up to date under STEP_ANALYTIC since the encounter prediction reads the vehicles' positions beyond the scanned edges */
+	update_all_vehicle_positions_on_demand(param, current_time);
+
+#if TPD_TRAJECTORY_EDGE_INDEX_FLAG /* [ */
+	/* index the road segments on the vehicle trajectories to find the encounter candidates of each vehicle dequeued from Q */
+	TPD_Build_Trajectory_Edge_Index(&edge_index);
+#endif /* ] */
+
+
+#if PACKET_COPY_ON_WRITE_FLAG /* [ */
+	/* give packet its own graph before rebuilding it if packet is a copy sharing its source packet's graph */
+	TPD_Unshare_Predicted_Encounter_Graph_For_Packet(packet);
+#endif /* ] */
+
 	/* set up Q and G with packet's predicted_encounter_graph */
 	Q = &(packet->predicted_encounter_graph->Q);
 	G = &(packet->predicted_encounter_graph->G);
@@ -898,6 +1133,10 @@ double TPD_Construct_Predicted_Encounter_Graph_For_Packet(double current_time,
 		 *		*/
 		//T_threshold = pQueueNode->key; //the encounter time of vehicle and its parent vehicle  
 		vehicle_list = get_vehicle_list(); //get the pointer to vehicle_list defined in util.c
+#if TPD_TRAJECTORY_EDGE_INDEX_FLAG /* [ */
+		TPD_Mark_Encounter_Candidates(&edge_index, current_vehicle, T_threshold); //find the vehicles that can encounter current_vehicle
+#endif /* ] */
+
 		vehicle = vehicle_list->next;
 		while(vehicle != vehicle_list) //while-1
 		{
@@ -920,6 +1159,15 @@ double TPD_Construct_Predicted_Encounter_Graph_For_Packet(double current_time,
 #if 0 /* [ */			
 			flag = TPD_Do_Vehicles_Encounter(current_time, param, current_vehicle, vehicle, &tail_vertex, &head_vertex, &edge_length, &P_encounter, &T_encounter, &D_encounter, &O_encounter); //check whether src_vehicle and vehicle encounter at the offset O_encounter in an edge (tail_vertex, head_vertex) with P_encounter of at least encounter_probability_threshold at time T_encounter after the travel time (i.e., delay) of D_encounter.
 #endif /* ] */
+#if TPD_TRAJECTORY_EDGE_INDEX_FLAG /* [ */
+			/* skip the vehicle whose trajectory shares no road segment with current_vehicle's trajectory after T_threshold */
+			if(vehicle->tpd_encounter_candidate_stamp != edge_index.stamp)
+			{
+				vehicle = vehicle->next; //move on the next vehicle in vehicle_list
+				continue;
+			}
+#endif /* ] */
+
 			flag = TPD_Compute_Encounter_Probability(param,
 					vehicle, 
 					current_vehicle,
@@ -1027,6 +1275,11 @@ double TPD_Construct_Predicted_Encounter_Graph_For_Packet(double current_time,
 	packet->EDR_for_V2V = src_vehicle->EDR_for_V2V;
 	packet->EDD_for_V2V = src_vehicle->EDD_for_V2V;
 
+#if TPD_TRAJECTORY_EDGE_INDEX_FLAG /* [ */
+	TPD_Free_Trajectory_Edge_Index(&edge_index);
+#endif /* ] */
+
+
 	return packet->EDR_for_V2V;
 }
 
@@ -1053,14 +1306,14 @@ boolean TPD_Do_Vehicles_Encounter(double current_time,
 
 	for(path_ptr1 = vehicle1->path_ptr; path_ptr1 != vehicle1->path_list->prev;)
 	{
-		tail_1 = atoi(path_ptr1->vertex);
-		head_1 = atoi(path_ptr1->next->vertex);
+		tail_1 = path_ptr1->vertex_id;
+		head_1 = path_ptr1->next->vertex_id;
 		T_tail_1 = path_ptr1->expected_arrival_time;
 		T_head_1 = path_ptr1->next->expected_arrival_time;
 		for(path_ptr2 = vehicle2->path_ptr; path_ptr2 != vehicle2->path_list->prev;)
 		{
-			tail_2 = atoi(path_ptr2->vertex);
-			head_2 = atoi(path_ptr2->next->vertex);
+			tail_2 = path_ptr2->vertex_id;
+			head_2 = path_ptr2->next->vertex_id;
 			T_tail_2 = path_ptr2->expected_arrival_time;
 			T_head_2 = path_ptr2->next->expected_arrival_time;
 
@@ -1289,13 +1542,13 @@ boolean TPD_Compute_FWD_Probability(
 	double D_head_std_1 = 0, D_head_std_2 = 0; //the travel time standard deviations for vehicle1 and vehicle2 from their current position to their head vertex along their trajectory
 	double t_1 = 0; //the travel time in the encountered edge of vehicle1
 	double t_2 = 0; //the travel time in the encountered edge of vehicle2
-	int vehicle1_path_current_edge_tail = atoi(vehicle1->path_ptr->vertex); //the tail id of the current edge of vehicle1
-	int vehicle2_path_current_edge_tail = atoi(vehicle2->path_ptr->vertex); //the tail id of the current edge of vehicle2
+	int vehicle1_path_current_edge_tail = vehicle1->path_ptr->vertex_id; //the tail id of the current edge of vehicle1
+	int vehicle2_path_current_edge_tail = vehicle2->path_ptr->vertex_id; //the tail id of the current edge of vehicle2
 
 	for(path_ptr1 = vehicle1->path_ptr; path_ptr1 != vehicle1->path_list->prev;)
 	{
-		tail_1 = atoi(path_ptr1->vertex);
-		head_1 = atoi(path_ptr1->next->vertex);
+		tail_1 = path_ptr1->vertex_id;
+		head_1 = path_ptr1->next->vertex_id;
 		T_tail_1 = path_ptr1->expected_arrival_time;
 		T_head_1 = path_ptr1->next->expected_arrival_time;
 
@@ -1332,8 +1585,8 @@ boolean TPD_Compute_FWD_Probability(
 		flag2 = TRUE;
 		for(path_ptr2 = vehicle2->path_ptr; path_ptr2 != vehicle2->path_list->prev;)
 		{
-			tail_2 = atoi(path_ptr2->vertex);
-			head_2 = atoi(path_ptr2->next->vertex);
+			tail_2 = path_ptr2->vertex_id;
+			head_2 = path_ptr2->next->vertex_id;
 			T_tail_2 = path_ptr2->expected_arrival_time;
 			T_head_2 = path_ptr2->next->expected_arrival_time;
 
@@ -1465,13 +1718,13 @@ boolean TPD_Compute_Encounter_Probability(parameter_t *param,
 
 	double t_1 = 0; //the travel time in the encountered edge of vehicle1
 	double t_2 = 0; //the travel time in the encountered edge of vehicle2
-	int vehicle1_path_current_edge_tail = atoi(vehicle1->path_ptr->vertex); //the tail id of the current edge of vehicle1
-	int vehicle2_path_current_edge_tail = atoi(vehicle2->path_ptr->vertex); //the tail id of the current edge of vehicle2
+	int vehicle1_path_current_edge_tail = vehicle1->path_ptr->vertex_id; //the tail id of the current edge of vehicle1
+	int vehicle2_path_current_edge_tail = vehicle2->path_ptr->vertex_id; //the tail id of the current edge of vehicle2
 
 	for(path_ptr1 = vehicle1->path_ptr; path_ptr1 != vehicle1->path_list->prev;)
 	{
-		tail_1 = atoi(path_ptr1->vertex);
-		head_1 = atoi(path_ptr1->next->vertex);
+		tail_1 = path_ptr1->vertex_id;
+		head_1 = path_ptr1->next->vertex_id;
 		T_tail_1 = path_ptr1->expected_arrival_time;						
 		T_head_1 = path_ptr1->next->expected_arrival_time;					
 																			
@@ -1508,8 +1761,8 @@ boolean TPD_Compute_Encounter_Probability(parameter_t *param,
 		flag2 = TRUE;
 		for(path_ptr2 = vehicle2->path_ptr; path_ptr2 != vehicle2->path_list->prev;)
 		{
-			tail_2 = atoi(path_ptr2->vertex);
-			head_2 = atoi(path_ptr2->next->vertex);										
+			tail_2 = path_ptr2->vertex_id;
+			head_2 = path_ptr2->next->vertex_id;										
 			T_tail_2 = path_ptr2->expected_arrival_time;
 			T_head_2 = path_ptr2->next->expected_arrival_time;
 
@@ -1733,13 +1986,13 @@ boolean TPD_Compute_Forward_Probability(parameter_t *param,
 	double D_head_std_1 = 0, D_head_std_2 = 0; //the travel time standard deviations for vehicle1 and vehicle2 from their current position to their head vertex along their trajectory
 	double t_1 = 0; //the travel time in the encountered edge of vehicle1
 	double t_2 = 0; //the travel time in the encountered edge of vehicle2
-	int vehicle1_path_current_edge_tail = atoi(vehicle1->path_ptr->vertex); //the tail id of the current edge of vehicle1
-	int vehicle2_path_current_edge_tail = atoi(vehicle2->path_ptr->vertex); //the tail id of the current edge of vehicle2
+	int vehicle1_path_current_edge_tail = vehicle1->path_ptr->vertex_id; //the tail id of the current edge of vehicle1
+	int vehicle2_path_current_edge_tail = vehicle2->path_ptr->vertex_id; //the tail id of the current edge of vehicle2
 
 	for (path_ptr1 = vehicle1->path_ptr; path_ptr1 != vehicle1->path_list->prev;)
 	{
-		tail_1 = atoi(path_ptr1->vertex);
-		head_1 = atoi(path_ptr1->next->vertex);
+		tail_1 = path_ptr1->vertex_id;
+		head_1 = path_ptr1->next->vertex_id;
 		T_tail_1 = path_ptr1->expected_arrival_time;					
 		T_head_1 = path_ptr1->next->expected_arrival_time;					
 	
@@ -1776,8 +2029,8 @@ boolean TPD_Compute_Forward_Probability(parameter_t *param,
 		flag2 = TRUE;
 		for (path_ptr2 = vehicle2->path_ptr; path_ptr2 != vehicle2->path_list->prev;)
 		{
-			tail_2 = atoi(path_ptr2->vertex);
-			head_2 = atoi(path_ptr2->next->vertex);										
+			tail_2 = path_ptr2->vertex_id;
+			head_2 = path_ptr2->next->vertex_id;										
 			T_tail_2 = path_ptr2->expected_arrival_time;
 			T_head_2 = path_ptr2->next->expected_arrival_time;
 
@@ -2680,6 +2933,7 @@ boolean TPD_Is_There_Next_Carrier_On_Road_Segment_Incident_To_Intersection_For_A
 		exit(1);
 	}
 
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
 	size = pEdgeNode->vehicle_movement_list.size;
         pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
 		
@@ -3161,6 +3415,7 @@ boolean TPD_Is_There_Next_Carrier_On_Road_Segment_Incident_To_Intersection_For_G
 		exit(1);
 	}
 
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
@@ -3281,6 +3536,7 @@ boolean TPD_Is_There_Next_Carrier_On_Road_Segment_Incident_To_Intersection_For_S
 		exit(1);
 	}
 
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
@@ -3538,8 +3794,8 @@ int TPD_Print_Vehicle_Trajectory(struct_vehicle_t *vehicle)
 	//return 0;
 	for(path_ptr = vehicle->path_ptr; path_ptr != vehicle->path_list->prev;)
 	{
-		tail = atoi(path_ptr->vertex);
-		head = atoi(path_ptr->next->vertex);
+		tail = path_ptr->vertex_id;
+		head = path_ptr->next->vertex_id;
 		T_tail = path_ptr->expected_arrival_time;
 		T_head = path_ptr->next->expected_arrival_time;					
 		length = path_ptr->next->weight;
@@ -3562,12 +3818,12 @@ void TPD_Print_Vehicle_Forward_Area_Compared(struct_vehicle_t *comparision_vehic
 
 	for (path_ptr1 = comparision_vehicle->path_ptr; path_ptr1 != comparision_vehicle->path_list->prev;)
 	{
-		tail_1 = atoi(path_ptr1->vertex);
-		head_1 = atoi(path_ptr1->next->vertex);
+		tail_1 = path_ptr1->vertex_id;
+		head_1 = path_ptr1->next->vertex_id;
 		for (path_ptr2 = current_vehicle->path_ptr; path_ptr2 != current_vehicle->path_list->prev;)
 		{
-			tail_2 = atoi(path_ptr2->vertex);
-			head_2 = atoi(path_ptr2->next->vertex);
+			tail_2 = path_ptr2->vertex_id;
+			head_2 = path_ptr2->next->vertex_id;
 			if ((tail_1 == tail_2) && (head_1 == head_2))
 			{			
 				printf("jinyong Vehicle:[%d, %d] TPD Vehicle_Forward_Area %d->%d \n", current_vehicle->id, comparision_vehicle->id, tail_1, head_1);
@@ -3585,12 +3841,12 @@ void TPD_Print_Vehicle_Encounter_Area_Compared(struct_vehicle_t *comparision_veh
 	int tail_2 = 0, head_2 = 0; //the tail vertex and head vertex of the edge visited by comparision_vehicle
 	for (path_ptr1 = comparision_vehicle->path_ptr; path_ptr1 != comparision_vehicle->path_list->prev;)
 	{
-		tail_1 = atoi(path_ptr1->vertex);
-		head_1 = atoi(path_ptr1->next->vertex);
+		tail_1 = path_ptr1->vertex_id;
+		head_1 = path_ptr1->next->vertex_id;
 		for (path_ptr2 = current_vehicle->path_ptr; path_ptr2 != current_vehicle->path_list->prev;)
 		{
-			tail_2 = atoi(path_ptr2->vertex);
-			head_2 = atoi(path_ptr2->next->vertex);
+			tail_2 = path_ptr2->vertex_id;
+			head_2 = path_ptr2->next->vertex_id;
 			if ((tail_1 == head_2) && (head_1 == tail_2))
 			{
 				printf("jinyong Vehicle:[%d, %d] TPD Vehicle_Encounter_Area %d->%d \n", current_vehicle->id, comparision_vehicle->id, tail_2, head_2);
@@ -3696,6 +3952,7 @@ boolean TPD_Is_There_Next_Carrier_On_One_Way_Road_Segment_For_Greedy_Routing(par
 		exit(1);
 	}
   
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
@@ -3879,6 +4136,7 @@ boolean TPD_Is_There_Next_Carrier_On_Two_Way_Road_Segment_For_Greedy_Routing(par
 		exit(1);
 	}
   
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
@@ -3982,6 +4240,7 @@ boolean TPD_Is_There_Next_Carrier_On_Two_Way_Road_Segment_For_Greedy_Routing(par
 		exit(1);
 	}
   
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
@@ -4176,6 +4435,7 @@ boolean TPD_Is_There_Next_Carrier_On_Two_Way_Road_Segment_For_Source_Routing(par
 		exit(1);
 	}
   
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
@@ -4261,6 +4521,7 @@ boolean TPD_Is_There_Next_Carrier_On_Two_Way_Road_Segment_For_Source_Routing(par
 		exit(1);
 	}
   
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
@@ -19,6 +19,33 @@ double TPD_Get_Predicted_Encounter_Time(int vehicle_id);
 /* taehwan 20140802 */
 void TPD_Set_Margin_Time(int margin);
 
+/** entry of the trajectory edge index for a road segment on a vehicle trajectory */
+typedef struct _tpd_trajectory_edge_entry_t
+{
+	int tail; //tail vertex id of the road segment
+	int head; //head vertex id of the road segment
+	double T_tail; //vehicle's expected arrival time at the tail vertex
+	struct_vehicle_t *vehicle; //vehicle whose trajectory has this road segment
+} tpd_trajectory_edge_entry_t;
+
+/** trajectory edge index to find the vehicles whose trajectories have a road segment in either direction */
+typedef struct _tpd_trajectory_edge_index_t
+{
+	tpd_trajectory_edge_entry_t *entry; //entries in ascending order of (tail, head, T_tail)
+	int entry_number; //number of entries
+	int stamp; //stamp that the latest query has set in the encounter candidates
+} tpd_trajectory_edge_index_t;
+
+/** The Operations of Trajectory Edge Index */
+void TPD_Build_Trajectory_Edge_Index(tpd_trajectory_edge_index_t *index);
+//build the trajectory edge index with the remaining trajectories of the vehicles in vehicle_list
+
+void TPD_Mark_Encounter_Candidates(tpd_trajectory_edge_index_t *index, struct_vehicle_t *vehicle, double T_threshold);
+//set index->stamp in the vehicles that can encounter vehicle in TPD_Compute_Encounter_Probability(), that is, the vehicles having a road segment of vehicle's trajectory in either direction with the arrival times at the tail vertices not earlier than T_threshold
+
+void TPD_Free_Trajectory_Edge_Index(tpd_trajectory_edge_index_t *index);
+//free the memory of the trajectory edge index
+
 /** The Operations of Predicted Encounter Graph */
 int TPD_Allocate_Predicted_Encounter_Graph(parameter_t *param, struct_vehicle_t *vehicle);
 //allocate the memory of a predicted encounter graph for vehicle
@@ -26,6 +53,14 @@ int TPD_Allocate_Predicted_Encounter_Graph(parameter_t *param, struct_vehicle_t
 int TPD_Allocate_Predicted_Encounter_Graph_For_Packet(packet_queue_node_t* packet);
 //allocate the memory of a predicted encounter graph for packet 
 
+#if PACKET_COPY_ON_WRITE_FLAG /* [ */
+int TPD_Share_Predicted_Encounter_Graph_For_Packet(packet_queue_node_t* packet);
+//let packet, which is a copy of another packet of the same global packet, share the predicted encounter graph pointed by its predicted_encounter_graph with the other packet; it returns 1 if packet shares the graph, and 0 if packet needs its own graph
+
+int TPD_Unshare_Predicted_Encounter_Graph_For_Packet(packet_queue_node_t* packet);
+//give packet its own predicted encounter graph if packet shares its graph with other packet copies; this must be called before packet's graph is rebuilt 
+#endif /* ] */
+
 int TPD_Free_Predicted_Encounter_Graph(struct_vehicle_t *vehicle);
 //free the memory of a predicted encounter graph for vehicle
 
@@ -17,10 +17,10 @@
 #include "tpd.h"
 
 #include <math.h> //sin(), cos(), atan(), etc
+#include <time.h> //clock()
 
 #include "gsl-util.h" //GSL_Vanet_Compute_TravelTime_And_Deviation()
 
-static struct struct_vehicle vehicle_list; /* head node for vehicle list */
 static FILE* fp_track_circle = NULL; /* file for logging target tracking based on circle */
 static FILE* fp_track_contour = NULL; /* file for logging target tracking based on contour */
 static FILE* fp_localization = NULL; /* file for logging the localization simulation */
@@ -280,16 +280,88 @@ real delay_func(struct parameter *param, int type, ...)
 
 void init_vehicle_list()
 { //initialize vehicle_list by let vehicle_list.next and vehicle_list.prev pointing to itself
-	vehicle_list.next = &vehicle_list;
-	vehicle_list.prev = &vehicle_list;
+	struct struct_vehicle *vehicle_list = get_vehicle_list(); //pointer to vehicle_list in the current simulation context
+	simulation_context_t *ctx = simulation_context_current(); //current simulation context having the vehicle registry
+
+	vehicle_list->next = vehicle_list;
+	vehicle_list->prev = vehicle_list;
+
+	/* empty the vehicle registry, keeping its slots for the next vehicles */
+	if(ctx->vehicle_registry != NULL)
+		memset(ctx->vehicle_registry, 0, ctx->vehicle_registry_size*sizeof(struct struct_vehicle*));
+	ctx->vehicle_registry_duplicate_number = 0;
+}
+
+static void vehicle_registry_register(struct struct_vehicle* vehicle)
+{ //register a vehicle node into vehicle_registry with its id as index
+	simulation_context_t *ctx = simulation_context_current(); //current simulation context having the vehicle registry
+	int new_size = 0; //new number of slots in vehicle_registry
+	
+	if(vehicle->id < 0)
+		return; //vehicle_search() finds a vehicle with negative id through vehicle_list
+
+	if(vehicle->id >= ctx->vehicle_registry_size)
+	{ //enlarge vehicle_registry to cover vehicle->id
+		new_size = MAX(VEHICLE_REGISTRY_INITIAL_SIZE, ctx->vehicle_registry_size);
+		while(new_size <= vehicle->id)
+			new_size *= 2;
+
+		ctx->vehicle_registry = (struct struct_vehicle**) realloc(ctx->vehicle_registry, new_size*sizeof(struct struct_vehicle*));
+		assert_memory(ctx->vehicle_registry);
+		memset(ctx->vehicle_registry + ctx->vehicle_registry_size, 0, (new_size - ctx->vehicle_registry_size)*sizeof(struct struct_vehicle*));
+		ctx->vehicle_registry_size = new_size;
+	}
+
+	if(ctx->vehicle_registry[vehicle->id] == NULL)
+		ctx->vehicle_registry[vehicle->id] = vehicle;
+	else //the vehicle registered first keeps the slot as the first one in vehicle_list
+		ctx->vehicle_registry_duplicate_number++;
+}
+
+static struct struct_vehicle* vehicle_search_in_vehicle_list(int id)
+{ //search a vehicle node corresponding to id by walking vehicle_list from its head
+	struct struct_vehicle *vehicle_list = get_vehicle_list(); //pointer to vehicle_list in the current simulation context
+	struct struct_vehicle* ptr;
+
+	for(ptr = vehicle_list->next; ptr != vehicle_list; ptr = ptr->next)
+	{
+		if(id == ptr->id)
+		{
+			return ptr;
+		}
+	}
+
+	return NULL;
+}
+
+static void vehicle_registry_unregister(struct struct_vehicle* vehicle)
+{ //unregister a vehicle node already unlinked from vehicle_list from vehicle_registry
+	simulation_context_t *ctx = simulation_context_current(); //current simulation context having the vehicle registry
+
+	if(vehicle->id < 0 || vehicle->id >= ctx->vehicle_registry_size || ctx->vehicle_registry[vehicle->id] != vehicle)
+		return;
+
+	ctx->vehicle_registry[vehicle->id] = NULL;
+
+	/* let another vehicle with the same id take over the slot */
+	if(ctx->vehicle_registry_duplicate_number > 0)
+	{
+		ctx->vehicle_registry[vehicle->id] = vehicle_search_in_vehicle_list(vehicle->id);
+		if(ctx->vehicle_registry[vehicle->id] != NULL)
+			ctx->vehicle_registry_duplicate_number--;
+	}
 }
 
 void vehicle_insert(struct struct_vehicle* vehicle)
 { //insert a vehicle node into vehicle_list
-	vehicle_list.prev->next = vehicle;
-	vehicle->prev = vehicle_list.prev;
-	vehicle->next = &vehicle_list;
-	vehicle_list.prev = vehicle;
+	struct struct_vehicle *vehicle_list = get_vehicle_list(); //pointer to vehicle_list in the current simulation context
+
+	vehicle_list->prev->next = vehicle;
+	vehicle->prev = vehicle_list->prev;
+	vehicle->next = vehicle_list;
+	vehicle_list->prev = vehicle;
+
+	vehicle_registry_register(vehicle);
 }
 
 
@@ -297,36 +369,38 @@ boolean vehicle_delete(int id)
 { //delete a vehicle node corresponding to id from vehicle_list
 	struct struct_vehicle* ptr;
 	printf("free vd\n");
-	for(ptr = vehicle_list.next; ptr != &vehicle_list; ptr = ptr->next)
+	ptr = vehicle_search(id);
+	if(ptr != NULL)
 	{
-		if(id == ptr->id)
-		{
-			ptr->prev->next = ptr->next;
-			ptr->next->prev = ptr->prev;
+		ptr->prev->next = ptr->next;
+		ptr->next->prev = ptr->prev;
+		vehicle_registry_unregister(ptr);
 
-			/* release the memory occupied by the list for the shortest path from source to destination */
-			Free_Path_List(ptr->path_list);
+		/* release the memory occupied by the list for the shortest path from source to destination */
+		Free_Path_List(ptr->path_list);
 
-			/* release the memory allocated to sensor queue */
-			if(ptr->sensor_queue->size > 0)
-			{
-			  DestroyQueue((queue_t*)ptr->sensor_queue); //free the memory allocated to the sensor queue nodes of sensor queue
-			  free(ptr->sensor_queue); //free the memory allocated to sensor queue
-			}
+		/* free the prefix sums along the path list */
+		Free_Trajectory_PrefixSum(&(ptr->path_prefix_sum));
 
-			/* release the memory allocated to packet queue */
-			if(ptr->packet_queue->size > 0)
-			{
-			  DestroyQueue((queue_t*)ptr->packet_queue); //free the memory allocated to the packet queue nodes of packet queue
-			  free(ptr->packet_queue); //free the memory allocated to packet queue
-			}
-
-			/* free the memory of a predicted encounter graph */
-			TPD_Free_Predicted_Encounter_Graph(ptr);
+		/* release the memory allocated to sensor queue */
+		if(ptr->sensor_queue->size > 0)
+		{
+		  DestroyQueue((queue_t*)ptr->sensor_queue); //free the memory allocated to the sensor queue nodes of sensor queue
+		  free(ptr->sensor_queue); //free the memory allocated to sensor queue
+		}
 
-			free(ptr); //free the memory allocated to vehicle node
-			return TRUE;
+		/* release the memory allocated to packet queue */
+		if(ptr->packet_queue->size > 0)
+		{
+		  DestroyQueue((queue_t*)ptr->packet_queue); //free the memory allocated to the packet queue nodes of packet queue
+		  free(ptr->packet_queue); //free the memory allocated to packet queue
 		}
+
+		/* free the memory of a predicted encounter graph */
+		TPD_Free_Predicted_Encounter_Graph(ptr);
+
+		free(ptr); //free the memory allocated to vehicle node
+		return TRUE;
 	}
 
 	return FALSE;
@@ -334,11 +408,12 @@ boolean vehicle_delete(int id)
 
 void free_vehicle_list()
 { //free vehicle list along with the allocated memory
+	struct struct_vehicle *vehicle_list = get_vehicle_list(); //pointer to vehicle_list in the current simulation context
 	struct struct_vehicle* ptr; //pointer to vehicle node
 	struct struct_vehicle* q; //pointer to the deleted vehicle node
 	//printf("free vl\n");
-	ptr = vehicle_list.next;
-	while(ptr != &vehicle_list)
+	ptr = vehicle_list->next;
+	while(ptr != vehicle_list)
 	{
 	  q = ptr;
 
@@ -348,6 +423,9 @@ void free_vehicle_list()
 	  /* release the memory occupied by the list for the shortest path from source to destination */
 	  Free_Path_List(q->path_list);
 
+	  /* free the prefix sums along the path list */
+	  Free_Trajectory_PrefixSum(&(q->path_prefix_sum));
+
 /* release the memory allocated to sensor queue */
 	  if(q->sensor_queue->size > 0)
 	  {
@@ -373,20 +451,78 @@ void free_vehicle_list()
 
 struct struct_vehicle* vehicle_search(int id)
 { //search a vehicle node corresponding to id from vehicle_list
+	struct struct_vehicle *vehicle_list = get_vehicle_list(); //pointer to vehicle_list in the current simulation context
+	simulation_context_t *ctx = simulation_context_current(); //current simulation context having the vehicle registry
 	struct struct_vehicle* ptr;
 
-	if(&vehicle_list == vehicle_list.next)
+	if(vehicle_list == vehicle_list->next)
 		return NULL; //there is no vehicle node in the vehicle list
 
-	for(ptr = vehicle_list.next; ptr != &vehicle_list; ptr = ptr->next)
+	if(id >= 0)
+	{ //every vehicle with non-negative id is registered in vehicle_registry
+		if(id < ctx->vehicle_registry_size)
+			ptr = ctx->vehicle_registry[id];
+		else
+			ptr = NULL;
+
+		return ptr;
+	}
+
+	return vehicle_search_in_vehicle_list(id);
+}
+
+void benchmark_vehicle_search(int vehicle_number, int event_number)
+{ //measure the cost of dispatching event_number synthetic events to vehicle_number vehicles through vehicle_search() and through the linear walk of vehicle_list
+	struct struct_vehicle *vehicles = NULL; //array of vehicle nodes for the benchmark
+	struct struct_vehicle *vehicle = NULL; //pointer to the vehicle found for an event
+	int linear_event_number = 0; //number of events dispatched by the linear walk
+	int i = 0; //loop index
+	int id = 0; //vehicle id of an event
+	long checksum = 0; //sum of the found vehicle ids to keep the lookups from being optimized away
+	clock_t start = 0; //start time of a measurement
+	double registry_time = 0; //elapsed time of vehicle_search() in seconds
+	double linear_time = 0; //elapsed time of the linear walk in seconds
+
+	/* the linear walk visits vehicle_number/2 nodes per event on average, so limit its events */
+	linear_event_number = (int) MIN(event_number, VEHICLE_SEARCH_BENCHMARK_LINEAR_WALK_BUDGET/vehicle_number);
+
+	vehicles = (struct struct_vehicle*) calloc(vehicle_number, sizeof(struct struct_vehicle));
+	assert_memory(vehicles);
+
+	init_vehicle_list();
+	for(i = 0; i < vehicle_number; i++)
 	{
-		if(id == ptr->id)
-		{
-			return ptr;
-		}
+		vehicles[i].id = i + 1;
+		vehicle_insert(&vehicles[i]);
 	}
 
-	return NULL;
+	/* events are sent to vehicles in the random order of the event list */
+	start = clock();
+	for(i = 0; i < event_number; i++)
+	{
+		id = smpl_random(1, vehicle_number);
+		vehicle = vehicle_search(id);
+		checksum += vehicle->id;
+	}
+	registry_time = (double)(clock() - start)/CLOCKS_PER_SEC;
+
+	start = clock();
+	for(i = 0; i < linear_event_number; i++)
+	{
+		id = smpl_random(1, vehicle_number);
+		vehicle = vehicle_search_in_vehicle_list(id);
+		checksum += vehicle->id;
+	}
+	linear_time = (double)(clock() - start)/CLOCKS_PER_SEC;
+
+	printf("benchmark_vehicle_search(): vehicles=%d: vehicle_search() dispatched %d events in %.3f s (%.4f us/event); linear walk dispatched %d events in %.3f s (%.4f us/event) [checksum=%ld]\n",
+			vehicle_number,
+			event_number, registry_time, registry_time*1e6/event_number,
+			linear_event_number, linear_time, linear_time*1e6/MAX(linear_event_number, 1),
+			checksum);
+
+	init_vehicle_list();
+	free(vehicles);
 }
 
 boolean isdetected(struct struct_sensor* sensor_list, int sensor_number, double x, double y)
@@ -2970,6 +3106,7 @@ struct_vehicle_t* register_vehicle(int vehicle_id, char *traffic_source, double
 
 	vehicle->path_hop_count = path_hop_count; //set up path_hop_count for path_list
 	vehicle->path_ptr = path_list->next;
+	vehicle->tpd_trajectory_version++; //let the prefix sums along vehicle's trajectory become stale
 	vehicle->path_current_hop = 0; //reset path_current_hop to zero
 	vehicle->path_current_edge_offset = 0; //set path_current_edge_offset to zero
 
@@ -3143,6 +3280,7 @@ void update_vehicle_trajectory(struct_vehicle_t* vehicle, double arrival_time, s
 
 	vehicle->path_hop_count = path_hop_count; //set up path_hop_count for path_list
 	vehicle->path_ptr = path_list->next;
+	vehicle->tpd_trajectory_version++; //let the prefix sums along vehicle's trajectory become stale
 	vehicle->path_current_hop = 0; //reset path_current_hop to zero
 	vehicle->path_current_edge_offset = 0; //set path_current_edge_offset to zero
 
@@ -3211,12 +3349,13 @@ void update_vehicle_trajectory(struct_vehicle_t* vehicle, double arrival_time, s
 void register_all_vehicle_movement(parameter_t *param, double registration_time, struct_graph_node *G)
 { /* register all vehicles' movement into the corresponding vehicle_movement_list of the directional edge
      pointed by a graph node in G where each vehicle is moving */
+	struct struct_vehicle *vehicle_list = get_vehicle_list(); //pointer to vehicle_list in the current simulation context
 	struct struct_vehicle* ptr;
 
-	if(&vehicle_list == vehicle_list.next)
+	if(vehicle_list == vehicle_list->next)
 		return; //there is no vehicle node in the vehicle list
 
-	for(ptr = vehicle_list.next; ptr != &vehicle_list; ptr = ptr->next)
+	for(ptr = vehicle_list->next; ptr != vehicle_list; ptr = ptr->next)
 	{
 	  if(ptr->state != VEHICLE_ESCAPE) //for the vehicle with state VEHICLE_ESCAPE, we do not register it since it is leaving the road network
 	    register_vehicle_movement(param, ptr, registration_time, G); //register vehicle's movement into vehicle_movement_list in the directional edge
@@ -3225,12 +3364,13 @@ void register_all_vehicle_movement(parameter_t *param, double registration_time,
 
 void update_all_vehicle_edd(double update_time, parameter_t *param, struct_graph_node *G, int G_size, struct_traffic_table *ap_table)
 { //update all vehicles' EDDs using each vehicle's offset in directional edge along with real graph G and AP table 
+	struct struct_vehicle *vehicle_list = get_vehicle_list(); //pointer to vehicle_list in the current simulation context
 	struct struct_vehicle* ptr;
 
-	if(&vehicle_list == vehicle_list.next)
+	if(vehicle_list == vehicle_list->next)
 		return; //there is no vehicle node in the vehicle list
 
-	for(ptr = vehicle_list.next; ptr != &vehicle_list; ptr = ptr->next)
+	for(ptr = vehicle_list->next; ptr != vehicle_list; ptr = ptr->next)
 	{
 	  if(ptr->state != VEHICLE_ESCAPE) //for the vehicle with state VEHICLE_ESCAPE, we do not update its EDD since it is leaving the road network
 	    VADD_Update_Vehicle_EDD(update_time, param, ptr, G, G_size, ap_table);
@@ -3240,12 +3380,13 @@ void update_all_vehicle_edd(double update_time, parameter_t *param, struct_graph
 
 void update_all_vehicle_edd_and_edd_sd(double update_time, parameter_t *param, struct_graph_node *G, int G_size, struct_traffic_table *ap_table)
 { //update all vehicles' EDDs and EDD_SDs using each vehicle's offset in directional edge along with real graph G and AP table 
+	struct struct_vehicle *vehicle_list = get_vehicle_list(); //pointer to vehicle_list in the current simulation context
 	struct struct_vehicle* ptr;
 
-	if(&vehicle_list == vehicle_list.next)
+	if(vehicle_list == vehicle_list->next)
 		return; //there is no vehicle node in the vehicle list
 
-	for(ptr = vehicle_list.next; ptr != &vehicle_list; ptr = ptr->next)
+	for(ptr = vehicle_list->next; ptr != vehicle_list; ptr = ptr->next)
 	{
 	  /**@for debugging */
 	  //if(ptr->id == 90)
@@ -3275,6 +3416,9 @@ void register_vehicle_movement(parameter_t *param, struct_vehicle_t* vehicle, do
   /** initialize movement_node */
   memset(&movement_node, 0, sizeof(movement_node));
 
+  /** bring the vehicle's position up to date under STEP_ANALYTIC */
+  update_vehicle_position_on_demand(vehicle, registration_time);
+
   /* check whether flag_vehicle_movement_queue_registration is set to FALSE */
   if(vehicle->flag_vehicle_movement_queue_registration == FALSE) //if-1
   {
@@ -3380,6 +3524,92 @@ void delete_vehicle_movement(parameter_t *param, struct_vehicle_t* vehicle, doub
   }
 }
 
+void start_vehicle_analytic_movement(struct_vehicle_t *vehicle)
+{ //start a movement step of vehicle up to its edge exit under STEP_ANALYTIC; the vehicle's position is computed on demand from its position at move_start_time until VEHICLE_MOVE
+  vehicle->flag_analytic_movement = TRUE;
+  vehicle->move_start_offset = vehicle->current_pos_in_Gr.offset;
+  vehicle->move_start_path_current_edge_offset = vehicle->path_current_edge_offset;
+  vehicle->move_start_pos = vehicle->current_pos;
+}
+
+void finish_vehicle_analytic_movement(struct_vehicle_t *vehicle)
+{ //finish the movement step of vehicle under STEP_ANALYTIC by restoring its position at move_start_time so that VEHICLE_MOVE can advance it by move_interval
+  if(vehicle->flag_analytic_movement == FALSE)
+    return;
+
+  vehicle->current_pos_in_Gr.offset = vehicle->move_start_offset;
+  vehicle->path_current_edge_offset = vehicle->move_start_path_current_edge_offset;
+  vehicle->current_pos = vehicle->move_start_pos;
+  vehicle->flag_analytic_movement = FALSE;
+}
+
+void update_vehicle_position_on_demand(struct_vehicle_t *vehicle, double current_time)
+{ //compute vehicle's position at current_time from move_start_time, speed and pos_update_vector under STEP_ANALYTIC and update its offsets in real graph Gr and in its vehicle movement queue
+  double movement_time = 0; //movement time since move_start_time
+  double movement_distance = 0; //movement distance since move_start_time
+
+  if(vehicle->flag_analytic_movement == FALSE)
+    return;
+
+  movement_time = MIN(current_time, vehicle->move_end_time) - vehicle->move_start_time;
+  if(movement_time < 0)
+    movement_time = 0;
+  movement_distance = movement_time*vehicle->speed;
+
+  /* compute the offset in real graph Gr along with the movement direction on the undirectional edge */
+  if(vehicle->move_type == MOVE_FORWARD)
+    vehicle->current_pos_in_Gr.offset = vehicle->move_start_offset + movement_distance;
+  else
+    vehicle->current_pos_in_Gr.offset = vehicle->move_start_offset - movement_distance;
+
+  vehicle->path_current_edge_offset = vehicle->move_start_path_current_edge_offset + movement_distance;
+
+  /* compute the geometric location in the 2-D Cartesian coordinate system */
+  vehicle->current_pos.x = vehicle->move_start_pos.x + movement_time*vehicle->pos_update_vector.x;
+  vehicle->current_pos.y = vehicle->move_start_pos.y + movement_time*vehicle->pos_update_vector.y;
+
+  /* update the offset in the vehicle movement queue and vehicle's current_pos_in_digraph */
+  if(vehicle->flag_vehicle_movement_queue_registration && vehicle->ptr_vehicle_movement_queue_node != NULL)
+  {
+    if(vehicle->move_type == MOVE_FORWARD)
+      UpdateVehicleMovementOffset(vehicle->ptr_vehicle_movement_queue_node, vehicle->current_pos_in_Gr.offset);
+    else
+      UpdateVehicleMovementOffset(vehicle->ptr_vehicle_movement_queue_node, vehicle->edge_length - vehicle->current_pos_in_Gr.offset);
+
+    vehicle->current_pos_in_digraph.offset = vehicle->ptr_vehicle_movement_queue_node->offset;
+  }
+}
+
+void update_vehicle_movement_queue_on_demand(parameter_t *param, vehicle_movement_queue_t *Q)
+{ //update the offsets of the vehicles in vehicle movement queue Q at the current simulation time under STEP_ANALYTIC
+  vehicle_movement_queue_node_t *pMoveNode = NULL; //pointer to a vehicle movement queue node
+  double current_time = 0; //current simulation time
+  int i = 0; //index for for-loop
+
+  if(param->vehicle_step_mode != STEP_ANALYTIC)
+    return;
+
+  current_time = smpl_time();
+  pMoveNode = &(Q->head);
+  for(i = 0; i < Q->size; i++)
+  {
+    pMoveNode = pMoveNode->next;
+    update_vehicle_position_on_demand(pMoveNode->vnode, current_time);
+  }
+}
+
+void update_all_vehicle_positions_on_demand(parameter_t *param, double current_time)
+{ //update the positions of all the vehicles in vehicle_list at current_time under STEP_ANALYTIC
+  struct struct_vehicle *vehicle_list = get_vehicle_list(); //pointer to vehicle_list in the current simulation context
+  struct_vehicle_t *ptr = NULL; //pointer to a vehicle node
+
+  if(param->vehicle_step_mode != STEP_ANALYTIC)
+    return;
+
+  for(ptr = vehicle_list->next; ptr != vehicle_list; ptr = ptr->next)
+    update_vehicle_position_on_demand(ptr, current_time);
+}
+
 void process_acl_convoy_for_vehicle_arrival(parameter_t *param, struct_vehicle_t *vehicle, double registration_time, directional_edge_queue_node_t *edge)
 { //process the vehicle convoy for a new vehicle arrival into the directional edge in order to compute the ACL for the directional edge
 
@@ -4518,10 +4748,14 @@ char *itoa(int i, char* a)
 /** Convoy Operations */
 void convoy_all_vehicle_join(parameter_t *param, double join_time, struct_graph_node *G, int G_size, packet_delivery_statistics_t *packet_delivery_stat)
 { //let all vehicles join their own convoy moving on the directional edge pointed by a graph node in G where each vehicle is moving
+	struct struct_vehicle *vehicle_list = get_vehicle_list(); //pointer to vehicle_list in the current simulation context
 
-	if(&vehicle_list == vehicle_list.next)
+	if(vehicle_list == vehicle_list->next)
 	  return; //there is no vehicle node in the vehicle list
 
+	/* bring all vehicles' offsets up to date under STEP_ANALYTIC before sorting them */
+	update_all_vehicle_positions_on_demand(param, join_time);
+
 	/* sort the vehicle movement queue for each directional edge in graph G */
 	SortVehicleMovementQueues_In_Graph(G, G_size);
 
@@ -4543,7 +4777,7 @@ void convoy_construct_convoys_in_graph(parameter_t *param, double join_time, str
 
 		while(ptr != NULL)
 		{
-			j = atoi(ptr->vertex) - 1; 
+			j = ptr->vertex_id - 1; 
 			//node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
                         convoy_construct_convoys_in_directional_edge(param, join_time, &(ptr->ptr_directional_edge_node->vehicle_movement_list), &(ptr->ptr_directional_edge_node->convoy_list), packet_delivery_stat);
                         //construct convoys moving on the directional edge <v_i,v_j> along with vehicle_movement_list
@@ -4568,6 +4802,9 @@ void convoy_construct_convoys_in_directional_edge(parameter_t *param, double joi
   if(CQ->size)
     DestroyQueue((queue_t*)CQ);
 
+  /** bring the offsets in VQ up to date under STEP_ANALYTIC */
+  update_vehicle_movement_queue_on_demand(param, VQ);
+
   /** construct convoy by traversing the VQ from the rear vehicle movement node with the greatest offset towards the front vehicle movement node with the smallest offset */
   pMoveNode = &(VQ->head);
   for(i = 0; i < VQ->size; i++) //for-1
@@ -4740,6 +4977,7 @@ boolean convoy_join(parameter_t *param, struct_vehicle_t *vehicle, double join_t
     }
     else
     {
+      update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
       pConvoyNode = GetConvoyClosestToVehicle(param, &(pEdgeNode->convoy_list), vehicle->current_pos_in_digraph.offset); //get the pointer to the convoy node closest to the vehicle within the communication range
       //pConvoyNode = (convoy_queue_node_t*) GetRearQueueNode((queue_t*) &(pEdgeNode->convoy_list));
       //get the pointer to the last enqueued convoy node since it is closest to the vehicle
@@ -5051,6 +5289,29 @@ boolean convoy_leave(parameter_t *param, struct_vehicle_t *vehicle, double leave
   return flag;
 }
 
+#if CONVOY_LAZY_SORT_SELF_CHECK_FLAG /* [ */
+static void Check_VehicleMovementQueue_DescentCount(vehicle_movement_queue_t *VQ)
+{ //recount the adjacent node pairs out of ascending order of offset in VQ, and exit on a difference from VQ's descent count
+  vehicle_movement_queue_node_t *pMoveNode = NULL; //pointer to a vehicle movement queue node
+  int count = 0; //number of the descents along the list
+  int i = 0; //index for for-loop
+
+  pMoveNode = VQ->head.next;
+  for(i = 1; i < VQ->size; i++)
+  {
+    if(pMoveNode->offset > pMoveNode->next->offset)
+      count++;
+    pMoveNode = pMoveNode->next;
+  }
+
+  if(count != VQ->descent_count)
+  {
+    printf("Check_VehicleMovementQueue_DescentCount(): Error: VQ(eid=%d) has %d descents, but its descent count is %d\n", VQ->eid, count, VQ->descent_count);
+    exit(1);
+  }
+}
+#endif /* ] */
+
 boolean convoy_update(parameter_t *param, struct_vehicle_t *vehicle, double update_time)
 { //update the convoys close to the vehicle with the convoy operations, such as convoy_construct, convoy_split, and convoy_merge. 
   boolean flag = FALSE;
@@ -5071,6 +5332,8 @@ boolean convoy_update(parameter_t *param, struct_vehicle_t *vehicle, double upda
   /*@ Note: we update vehicle_convoy, left_convoy, right_convoy before using it after performing convoy_merge() or convoy_split() since the pointers of vehicle_convoy, left_convoy and right_convoy might change after these two operations */
 
   /*@ Note: assume that the vehicle_list is sorted in ascending order of offsets */
+
+  /*@ Note: a convoy is a maximal run of vehicles in the offset order of VQ whose neighbor gaps are within r, and the gaps change only next to the moved vehicle, so a split or a merge is detected here from d_left and d_right alone in O(1) without rescanning VQ; with CONVOY_LAZY_SORT_FLAG, VQ is sorted only after a vehicle has passed its neighbor. The convoys are not kept as union-find sets or intervals over the offset index because vehicle->ptr_convoy_queue_node is read directly by the forwarding code, so MergeTwoConvoys() and SplitConvoy() still relink the vehicle lists and repoint the moved vehicles in O(convoy size). */
   
   /** Operarations 
     - Let r be the communication range.
@@ -5150,12 +5413,35 @@ boolean convoy_update(parameter_t *param, struct_vehicle_t *vehicle, double upda
   //  printf("convoy_update(): at %f, vehicle(id=%d) is traced\n", (float)update_time, vehicle->id);
   /******************/
 
+  /** Bring the offsets in VQ up to date under STEP_ANALYTIC before sorting them. */
+  update_vehicle_movement_queue_on_demand(param, VQ);
+
+#if CONVOY_LAZY_SORT_SELF_CHECK_FLAG /* [ */
+  Check_VehicleMovementQueue_DescentCount(VQ);
+#endif /* ] */
+
   /** Sort the vehicle movement queue for the directional edge where vehicle (i.e., i) is moving. */
+#if CONVOY_LAZY_SORT_FLAG /* [ */
+  /* the queue is already in ascending order of offset unless some vehicle has passed its neighbor since the last sort */
+  if(VQ->descent_count > 0)
+    SortVehicleMovementQueue(VQ);
+#else /* ][ */
   SortVehicleMovementQueue(VQ);
   //sort vehicle movement queue nodes in ascending order according to offset in the directional edge
+#endif /* ] */
   
   /** Obtain the left vehicle and the right vehicle for vehicle */
+#if CONVOY_LAZY_SORT_FLAG /* [ */
+  /* the orders are not renumbered when the sort is skipped, so take the first and the last positions from the list links; any other order means a middle position */
+  if(vehicle->ptr_vehicle_movement_queue_node->prev == &(VQ->head))
+    order = 0;
+  else if(vehicle->ptr_vehicle_movement_queue_node->next == &(VQ->head))
+    order = VQ_size-1;
+  else
+    order = 1;
+#else /* ][ */
   order = vehicle->ptr_vehicle_movement_queue_node->order;
+#endif /* ] */
   if(VQ_size == 1) //if-1
   {
     return FALSE; //there is nothing to update for convoy
@@ -5477,13 +5763,8 @@ boolean convoy_update(parameter_t *param, struct_vehicle_t *vehicle, double upda
 boolean convoy_merge(parameter_t *param, double merge_time, convoy_queue_node_t *src_convoy, convoy_queue_node_t *dst_convoy)
 { //let src_convoy merge into dst_convoy; concatenate src_convoy's vehicle_list into dst_convoy's vehicle_list
   boolean flag = FALSE;
-  convoy_queue_t *CQ = src_convoy->ptr_queue; //pointer to convoy queue
   int src_size = src_convoy->vehicle_list.size; //size of the vehicle list in src_convoy 
   int dst_size = dst_convoy->vehicle_list.size; //size of the vehicle list in dst_convoy
-  vehicle_queue_node_t *src_head = &(src_convoy->vehicle_list.head); //pointer to the head node the vehicle list in src_convoy 
-  vehicle_queue_node_t *dst_head = &(dst_convoy->vehicle_list.head); //pointer to the head node the vehicle list in dst_convoy 
-  vehicle_queue_node_t *pVehicleNode = NULL; //pointer to vehicle queue node
-  int i = 0; //index for for-loop
 
 #ifdef __DEBUG_CONVOY_MERGE__
   printf("convoy_merge(): at time %f, src_convoy(cid=%d) is merged into dst_convoy(cid=%d)\n", (float)merge_time, src_convoy->cid, dst_convoy->cid);
@@ -5501,48 +5782,8 @@ boolean convoy_merge(parameter_t *param, double merge_time, convoy_queue_node_t
     exit(1);
   } 
 
-  /** concatenate src_convoy's vehicle_list into dst_convoy's vehicle_list */
-  /* link dst_head's rear node and src_head's front node */
-  dst_head->prev->next = src_head->next;
-  src_head->next->prev = dst_head->prev;
-  
-  /* link dst_head and src_head's rear node */
-  dst_head->prev = src_head->prev;  
-  src_head->prev->next = dst_head;
-
-  /** adjust the pointer to the convoy queue node for each vehicle in src_convoy */
-  pVehicleNode = src_head;
-  for(i = 0; i < src_size; i++)
-  {
-    pVehicleNode = pVehicleNode->next;
-    pVehicleNode->vnode->ptr_convoy_queue_node = dst_convoy;
-    pVehicleNode->vnode->convoy_join_time = merge_time;
-  }
-
-  /** update the size of the vehicle list in dst_convoy and src_convoy */
-  dst_convoy->vehicle_list.size += src_size;
-  src_convoy->vehicle_list.size = 0;
-
-  /* reset src_head->prev and src_head->next to src_head */
-  src_head->prev = src_head;
-  src_head->next = src_head;
-
-  /** delete src_convoy */
-  DeleteConvoyWithCID(CQ, src_convoy->cid);
-
-  /** update the convoy head, tail and leader */  
-  /* sort dst_convoy's vehicle list in ascending order of offset */
-  SortVehicleQueue(&(dst_convoy->vehicle_list));
-
-  /* set the convoy head to the rear vehicle in vehicle list and update the convoy's id (i.e., cid) with the new head vehicle's id */
-  dst_convoy->head_vehicle = dst_convoy->vehicle_list.head.prev->vnode;
-  dst_convoy->cid = dst_convoy->head_vehicle->id;
-  
-  /* set the convoy tail to the front vehicle in vehicle list */
-  dst_convoy->tail_vehicle = dst_convoy->vehicle_list.head.next->vnode;
-
-  /* set the convoy leader to the vehicle with minimum EDD in vehicle list */
-  Set_NewConvoyLeader(param, dst_convoy); //find a vehicle with minimum EDD as the convoy's new leader in dst_convoy
+  /** concatenate src_convoy's vehicle_list into dst_convoy's vehicle_list, delete src_convoy, and update dst_convoy's head, tail and leader */
+  MergeTwoConvoys(param, merge_time, src_convoy, dst_convoy);
 
   return flag;
 }
@@ -5550,20 +5791,7 @@ boolean convoy_merge(parameter_t *param, double merge_time, convoy_queue_node_t
 boolean convoy_split(parameter_t *param, double split_time, convoy_queue_node_t *src_convoy, struct_vehicle_t *vehicle)
 { //let src_convoy split into dst_convoy_1 and dst_convoy_2 by using vehicle as the boundary of these two convoys; vehicle is the head of dst_convoy_2
   boolean flag = FALSE;
-  convoy_queue_t *CQ = src_convoy->ptr_queue; //pointer to convoy queue
-  vehicle_queue_t* VQ = &(src_convoy->vehicle_list); //pointer to vehicle queue
-  vehicle_queue_node_t *convoy_1_head = &(src_convoy->vehicle_list.head); //pointer to the head for dst_convoy_1's vehicle list where dst_convoy_1 is the convoy consisting of vehicles preceding vehicle
-  vehicle_queue_node_t *convoy_2_head = NULL; //pointer to the head for dst_convoy_2's vehicle list where dst_convoy_2 is the convoy consisting of vehicles following vehicle along with vehicle
-  vehicle_queue_node_t *convoy_1_start = NULL; //pointer to the vehicle queue node for the start of the vehicle list of src_convoy after the split
-  convoy_queue_node_t convoy_node; //convoy queue node
-  convoy_queue_node_t *dst_convoy = NULL; //pointer to the destination convoy separated from src_convoy, having vehicle as the convoy head
   int src_size = src_convoy->vehicle_list.size; //size of the vehicle list in src_convoy
-  int dst_size = 0; //size of the vehicle list in dst_convoy
-  vehicle_queue_node_t *src_head = &(src_convoy->vehicle_list.head); //pointer to the head node the vehicle list in src_convoy 
-  //vehicle_queue_node_t *dst_head = NULL; //pointer to the head node the vehicle list in dst_convoy 
-  vehicle_queue_node_t *pVehicleNode = NULL; //pointer to vehicle queue node
-  int i = 0; //index for for-loop
-  int count = 0; //count for the number of dst_convoy_2
 
 #ifdef __DEBUG_CONVOY_SPLIT__
   printf("convoy_split(): at time %f, convoy(cid=%d) is split for vehicle(vid=%d)\n", (float)split_time, src_convoy->cid, vehicle->id);
@@ -5586,88 +5814,11 @@ boolean convoy_split(parameter_t *param, double split_time, convoy_queue_node_t
     exit(1);
   } 
 
-  /** sort vehicle list in ascending order of offset */
-  SortVehicleQueue(VQ);
-
-  /** split src_convoy into src_convoy and dst_convoy by using vehicle as the convoy head of dst_convoy */
-  /* obtain the pointer to the vehicle queue node corresponding to vehicle */
-  pVehicleNode = src_head;
-  for(i = 0; i < src_size; i++)
-  {
-    pVehicleNode = pVehicleNode->next;
-    count++; //increment count by one
-    if(vehicle->id == pVehicleNode->vnode->id)
-      break;
-  }
-
-  if(i == src_size)
-  {
-    printf("convoy_split(): Error: vehicle(id=%d) does not exist in the convoy(cid=%d)\n", vehicle->id, src_convoy->cid);
-    exit(1);
-  }
-
-  /* let convoy_1_start point to the next node of pVehicleNode */
-  convoy_1_start = pVehicleNode->next;
-
-  /**@ Start of the construction of convoy_2 */
- 
-  /* make a convoy queue node for dst_convoy_2 and enqueue it into convoy queue CQ */
-  convoy_node.cid = pVehicleNode->vnode->id; //set the new convoy's id with the head vehicle's id
-  convoy_node.tail_vehicle = pVehicleNode->vnode;
-  convoy_node.head_vehicle = pVehicleNode->vnode;
-  convoy_node.leader_vehicle = pVehicleNode->vnode;
-  dst_convoy = (convoy_queue_node_t*)Enqueue((queue_t*)CQ, (queue_node_t*)&convoy_node);
-
-  /* set convoy_2_head to the pointer to the head for dst_convoy_2's vehicle list where dst_convoy_2 is the convoy consisting of vehicles following vehicle along with vehicle */
-  convoy_2_head = &(dst_convoy->vehicle_list.head);
-
-  /* set convoy_2_head where convoy_2 is the convoy consisting of vehicles following vehicle along with vehicle */
-  convoy_2_head->next = src_head->next;
-  convoy_2_head->prev = pVehicleNode;
- 
-  /* let the first vehicle node and the last vehicle node point to convoy_2_head */
-  convoy_2_head->next->prev = convoy_2_head;
-  convoy_2_head->prev->next = convoy_2_head;
-
-  /* set dst_convoy->vehicle_list.size to count */
-  dst_convoy->vehicle_list.size = count;
-
-  /**@ End of the construction of convoy_2 */
- 
-
-  /**@ Start of the construction of convoy_1 */
-  /* set convoy_1_head where convoy_1 is the convoy consisting of vehicles preceding vehicle */
-  convoy_1_head->next = convoy_1_start; //note that convoy_1_head->next == src_head->nex
-  //convoy_1_head->prev = src_head->prev;
-
-  /* let the first vehicle node point to convoy_1_head */
-  convoy_1_head->next->prev = convoy_1_head;
-
-  /* set src_convoy->vehicle_list.size to count */
-  src_convoy->vehicle_list.size -= count;
-
-  /**@ End of the construction of convoy_1 */
-
-
-  /** adjust the pointer to the convoy queue node for each vehicle in dst_convoy */
-  pVehicleNode = &(dst_convoy->vehicle_list.head);
-  for(i = 0; i < count; i++)
-  {
-    pVehicleNode = pVehicleNode->next;
-    pVehicleNode->vnode->ptr_convoy_queue_node = dst_convoy;
-    pVehicleNode->vnode->convoy_join_time = split_time;
-  }
-
-  /** adjust the convoy tail and convoy leader of src_convoy */
-  src_convoy->tail_vehicle = src_convoy->vehicle_list.head.next->vnode; //set convoy tail to the first vehicle node in vehicle list
-  Set_NewConvoyLeader(param, src_convoy); //find a vehicle with minimum EDD as the convoy's new leader in src_convoy
-
-  /** adjust the convoy tail and convoy leader of dst_convoy */
-  dst_convoy->tail_vehicle = dst_convoy->vehicle_list.head.next->vnode; //set convoy tail to the first vehicle node in vehicle list
-  Set_NewConvoyLeader(param, dst_convoy); //find a vehicle with minimum EDD as the convoy's new leader in dst_convoy
+  /** split src_convoy into src_convoy and dst_convoy by using vehicle as the convoy head of dst_convoy, and update the tails and leaders of both convoys */
+  SplitConvoy(param, split_time, src_convoy, vehicle);
 
 #ifdef __DEBUG_CONVOY_SPLIT__
-  printf("convoy_split(): at time %f, dst_convoy(cid=%d) is split from for src_convoy(cid=%d)\n", (float)split_time, dst_convoy->cid, src_convoy->cid);
+  printf("convoy_split(): at time %f, dst_convoy(cid=%d) is split from for src_convoy(cid=%d)\n", (float)split_time, vehicle->ptr_convoy_queue_node->cid, src_convoy->cid); //vehicle is the head of dst_convoy
 #endif
   
   return flag;
@@ -5702,6 +5853,7 @@ void set_vehicle_trajectory(struct_vehicle_t *vehicle, double arrival_time, int
   vehicle->path_list = path_list;
   vehicle->path_hop_count = path_hop_count; //set up path_hop_count for path_list
   vehicle->path_ptr = path_list->next;
+  vehicle->tpd_trajectory_version++; //let the prefix sums along vehicle's trajectory become stale
   vehicle->path_current_hop = 0; //reset path_current_hop to zero
 
   /** set the initial position, current position and movement type */
@@ -5765,6 +5917,7 @@ void set_vehicle_current_position(parameter_t *param, struct_vehicle_t *vehicle,
 
   /** set the current position to the beginning of the path with path_current_hop zero and also set movement type according to the direction of the edge */
   vehicle->path_ptr = vehicle->path_list->next; //let path_ptr point to the first node on the path_list
+  vehicle->tpd_trajectory_version++; //let the prefix sums along vehicle's trajectory become stale
   vehicle->path_current_hop = 0; //reset path_current_hop to zero
 
   tail_node = vehicle->path_list->next->vertex;
@@ -6069,6 +6222,7 @@ void replace_vehicle_trajectory_with_mobility_list(double arrival_time, paramete
 
   vehicle->path_hop_count = path_hop_count; //set up path_hop_count for path_list
   vehicle->path_ptr = path_list->next;
+  vehicle->tpd_trajectory_version++; //let the prefix sums along vehicle's trajectory become stale
   vehicle->path_current_hop = 0; //reset path_current_hop to zero
 
   /* set the initial position, current position and movement type */
@@ -6136,6 +6290,7 @@ void update_vehicle_trajectory_with_mobility_list(double arrival_time, parameter
   {
     /* set path_ptr and path_current_hop */
     vehicle->path_ptr = vehicle->path_list->next;
+    vehicle->tpd_trajectory_version++; //let the prefix sums along vehicle's trajectory become stale
     vehicle->path_current_hop = 0; //reset path_current_hop to zero
 
 	/* set path_list to vehicle->path_list */
@@ -6183,6 +6338,7 @@ void update_vehicle_trajectory_with_mobility_list(double arrival_time, parameter
 
     vehicle->path_hop_count = path_hop_count; //set up path_hop_count for path_list
     vehicle->path_ptr = path_list->next;
+    vehicle->tpd_trajectory_version++; //let the prefix sums along vehicle's trajectory become stale
     vehicle->path_current_hop = 0; //reset path_current_hop to zero
   }
 
@@ -6234,17 +6390,32 @@ void update_vehicle_trajectory_with_mobility_list(double arrival_time, parameter
 
 void set_vehicle_speed(parameter_t *param, struct_vehicle_t *vehicle)
 { //set up vehicle speed according to the speed distribution along with vehicle minimum speed and vehicle maximum speed
+#if RAND_GENERATOR_TYPE == RAND_GENERATOR_PHILOX /* [ */
+  rand_substream_t speed_substream; //vehicle's substream for its speed
+  rand_substream_t *prev_substream = NULL; //substream used before this function
+
+  /* draw the speed from the vehicle's own substream so that it does not depend on the order of the other draws */
+  rand_substream_init(&speed_substream, rand_current_seed(), RAND_ENTITY_VEHICLE, vehicle->id);
+  speed_substream.counter = vehicle->speed_draw_count;
+  prev_substream = rand_use_substream(&speed_substream);
+#endif /* ] */
 
   /* select vehicle's speed using the speed distribution considering vehicle minimum speed and vehicle maximum speed */
   do
   {
     vehicle->speed = delay_func(param, DELAY_VEHICLE_SPEED);
+    vehicle->tpd_trajectory_version++; //let the prefix sums along vehicle's trajectory become stale
 		
     //@let vehicle's speed be less than param->vehicle_maximum_speed
     if((vehicle->speed >= param->vehicle_minimum_speed) && 
        (vehicle->speed <= param->vehicle_maximum_speed))
       break;
   } while(1);
+
+#if RAND_GENERATOR_TYPE == RAND_GENERATOR_PHILOX /* [ */
+  vehicle->speed_draw_count = speed_substream.counter;
+  rand_use_substream(prev_substream);
+#endif /* ] */
 }
 
 /** logging functions */
@@ -6502,6 +6673,263 @@ void combinations_for_target_points(int v[], int w[], int start, int n, int k, i
 	}
 }
 
+/** Branch-and-Bound Search for Multiple Target Points */
+#define TARGET_POINT_PROBABILITY_BOUND_SLACK 0.000000000001 //slack added to the delivery probability bound against the rounding of products of delivery-failure probabilities multiplied in a different order
+
+/** structure for the state of the branch-and-bound search for target points */
+typedef struct _target_point_search_t {
+	int *w; //intersection vector of the destination vehicle's trajectory
+	int *v; //index vector of the combination under construction
+	double *p; //delivery probability vector for w
+	double *d; //delivery delay vector for w
+	int n; //number of intersections in w
+	int maxk; //number of target points in a combination
+	double **F_min; //F_min[s][r] is the minimum accumulated delivery-failure probability of r target points taken from w[s..n]
+	boolean probability_bound_flag; //flag to indicate whether F_min bounds the delivery probability, that is, every p[i] is in [0, 1]
+	boolean delay_bound_flag; //flag to indicate whether the delay of a prefix bounds the delay of its combinations, that is, every d[i] with p[i] > 0 is non-negative
+	double threshold; //user-required delivery probability
+	target_point_queue_t *global_TPQ; //best target point set found so far
+	unsigned long evaluated_combination_count; //number of complete combinations evaluated
+} target_point_search_t;
+
+static boolean can_improve_target_points(target_point_search_t *S, int start, int r, double P_failure, double delay)
+{ //return TRUE if some combination extending the current prefix with r target points from w[start..n] can replace global_TPQ, where P_failure and delay are the prefix's accumulated delivery-failure probability and conditional delay sum
+	target_point_queue_t *G = S->global_TPQ;
+	double P_bound = 1; //upper bound of the delivery success probability of the combinations
+
+	/* the delivery success probability of a superset is at least that of its subset, so the r target points with the highest delivery probabilities give the bound */
+	if(S->probability_bound_flag)
+		P_bound = 1 - P_failure*S->F_min[start][r] + TARGET_POINT_PROBABILITY_BOUND_SLACK;
+
+	/* the rules below must agree with the replacement rules in combinations_for_target_points() */
+	if(G->delivery_success_probability < S->threshold)
+	{
+		if(P_bound <= G->delivery_success_probability)
+			return FALSE;
+
+		return TRUE;
+	}
+	else
+	{
+		if(P_bound <= S->threshold)
+			return FALSE;
+
+		/* the conditional delay terms are non-negative, so the prefix's delay never decreases by adding target points */
+		if(S->delay_bound_flag && (delay >= G->minimum_average_delivery_delay))
+			return FALSE;
+
+		return TRUE;
+	}
+}
+
+static void evaluate_target_point_combination(target_point_search_t *S, double P_failure, double delay)
+{ //replace global_TPQ with the combination in v[1..maxk] if it is better than global_TPQ in the same way as combinations_for_target_points()
+	target_point_queue_t *G = S->global_TPQ;
+	target_point_queue_t local_TPQ; //local target point queue
+	target_point_queue_node_t qnode; //target point queue node
+	double P_success = 1 - P_failure; //accumulated delivery-success probability
+	boolean replace_flag = FALSE; //flag to indicate whether the combination replaces global_TPQ
+	int i;
+
+	S->evaluated_combination_count++;
+
+	if((G->delivery_success_probability < S->threshold) && (P_success > G->delivery_success_probability))
+		replace_flag = TRUE;
+	else if((G->delivery_success_probability >= S->threshold) && (P_success > S->threshold) && (delay < G->minimum_average_delivery_delay))
+		replace_flag = TRUE;
+
+	if(replace_flag == FALSE)
+		return;
+
+	/* make the target point queue only for a combination that replaces global_TPQ */
+	InitQueue((queue_t*) &local_TPQ, QTYPE_TARGET_POINT);
+	memset(&qnode, 0, sizeof(qnode));
+	for(i = 1; i <= S->maxk; i++)
+	{
+		qnode.target_point_id = S->w[S->v[i]];
+		qnode.delivery_delay = S->d[S->v[i]];
+		qnode.delivery_probability = S->p[S->v[i]];
+		Enqueue((queue_t*)&local_TPQ, (queue_node_t*)&qnode);
+	}
+
+	ReplaceTargetPointQueue(G, &local_TPQ);
+
+	/* these assignments must be performed after ReplaceTargetPointQueue(); otherwise, the performance metric values are erased */
+	G->minimum_average_delivery_delay = delay;
+	G->delivery_success_probability = P_success;
+}
+
+static void search_target_point_combinations(target_point_search_t *S, int start, int k, double P_failure, double delay)
+{ //try w[start..n] as the k-th target point of the combination in v and search the combinations below it in the same order as combinations_for_target_points()
+	double child_P_failure = 0; //accumulated delivery-failure probability with the k-th target point
+	double child_delay = 0; //sum of conditional expectations of the delivery delay with the k-th target point
+	int i;
+
+	if(k > S->maxk)
+	{
+		evaluate_target_point_combination(S, P_failure, delay);
+		return;
+	}
+
+	for(i = start; i <= S->n - (S->maxk - k); i++)
+	{
+		S->v[k] = i;
+
+		/* accumulate the k-th target point in the same way as combinations_for_target_points() so that the metrics are bitwise identical */
+		child_P_failure = P_failure;
+		child_delay = delay;
+		if(S->p[i] > 0)
+		{
+			child_delay += S->d[i] * (P_failure * S->p[i]);
+			child_P_failure *= (1 - S->p[i]);
+		}
+
+		/* prune the branch if no combination below it can replace global_TPQ */
+		if(can_improve_target_points(S, i+1, S->maxk - k, child_P_failure, child_delay) == FALSE)
+			continue;
+
+		search_target_point_combinations(S, i+1, k+1, child_P_failure, child_delay);
+	}
+}
+
+#if TARGET_POINT_BRANCH_AND_BOUND_SELF_CHECK_FLAG /* [ */
+static unsigned long target_point_branch_and_bound_check_count = 0; //number of the branch-and-bound searches compared with the exhaustive search
+
+static void check_target_point_branch_and_bound(target_point_search_t *S, target_point_queue_t *exhaustive_TPQ)
+{ //compare global_TPQ found by the branch-and-bound search with exhaustive_TPQ found by combinations_for_target_points()
+	target_point_queue_t *G = S->global_TPQ;
+	target_point_queue_node_t *p = &(G->head), *q = &(exhaustive_TPQ->head);
+	int i;
+
+	target_point_branch_and_bound_check_count++;
+
+	if((G->size != exhaustive_TPQ->size) || (G->delivery_success_probability != exhaustive_TPQ->delivery_success_probability) || (G->minimum_average_delivery_delay != exhaustive_TPQ->minimum_average_delivery_delay))
+	{
+		printf("%s:%d the branch-and-bound search (size=%d, P=%f, delay=%f) is different from the exhaustive search (size=%d, P=%f, delay=%f) for maxk=%d\n",
+				__FUNCTION__, __LINE__,
+				G->size, (float)G->delivery_success_probability, (float)G->minimum_average_delivery_delay,
+				exhaustive_TPQ->size, (float)exhaustive_TPQ->delivery_success_probability, (float)exhaustive_TPQ->minimum_average_delivery_delay,
+				S->maxk);
+		exit(1);
+	}
+
+	for(i = 0; i < G->size; i++)
+	{
+		p = p->next;
+		q = q->next;
+		if(p->target_point_id != q->target_point_id)
+		{
+			printf("%s:%d the %d-th target point(%d) of the branch-and-bound search is different from that(%d) of the exhaustive search\n",
+					__FUNCTION__, __LINE__,
+					i+1, p->target_point_id, q->target_point_id);
+			exit(1);
+		}
+	}
+}
+
+void report_target_point_branch_and_bound_self_check(FILE *fp)
+{ //report how many branch-and-bound searches have matched the exhaustive search
+	fprintf(fp, "target_point_branch_and_bound_self_check: checked=%lu\n", target_point_branch_and_bound_check_count);
+}
+#endif /* ] */
+
+unsigned long branch_and_bound_for_target_points(int w[], int n, int maxk, double p[], double d[], parameter_t *param, target_point_queue_t *global_TPQ)
+{ /* select maxk target points among w[1..n] in the same way as combinations_for_target_points(), but skip the branches of combinations 
+   * that cannot replace global_TPQ: a branch is bounded above in the delivery probability by its r most reliable remaining target points 
+   * and below in the delivery delay by its prefix. This returns the number of complete combinations evaluated.
+   */
+	target_point_search_t S; //search state
+	double f = 0; //delivery-failure probability of w[s]
+	int s, r;
+#if TARGET_POINT_BRANCH_AND_BOUND_SELF_CHECK_FLAG /* [ */
+	target_point_queue_t exhaustive_TPQ; //target points found by the exhaustive search
+	target_point_queue_node_t *pQueueNode = NULL; //pointer to a target point queue node
+	int i;
+#endif /* ] */
+
+	memset(&S, 0, sizeof(S));
+	S.w = w;
+	S.p = p;
+	S.d = d;
+	S.n = n;
+	S.maxk = maxk;
+	S.threshold = param->communication_packet_delivery_probability_threshold;
+	S.global_TPQ = global_TPQ;
+
+	if((maxk < 1) || (maxk > n))
+		return 0;
+
+	S.v = (int*) calloc(maxk+1, sizeof(int));
+	assert_memory(S.v);
+
+	/* check whether the bounds are valid for the given vectors p and d */
+	S.probability_bound_flag = TRUE;
+	S.delay_bound_flag = TRUE;
+	for(s = 1; s <= n; s++)
+	{
+		if((p[s] < 0) || (p[s] > 1))
+			S.probability_bound_flag = FALSE;
+
+		if((p[s] > 0) && (d[s] < 0))
+			S.delay_bound_flag = FALSE;
+	}
+
+	/* compute F_min[s][r] from the end of w, where a target point with zero delivery probability is skipped as in the accumulation of P_failure */
+	S.F_min = (double**) calloc(n+2, sizeof(double*));
+	assert_memory(S.F_min);
+	for(s = 1; s <= n+1; s++)
+	{
+		S.F_min[s] = (double*) calloc(maxk+1, sizeof(double));
+		assert_memory(S.F_min[s]);
+	}
+
+	for(r = 0; r <= maxk; r++)
+		S.F_min[n+1][r] = 1;
+
+	for(s = n; s >= 1; s--)
+	{
+		f = (p[s] > 0) ? (1 - p[s]) : 1;
+		S.F_min[s][0] = 1;
+		for(r = 1; r <= maxk; r++)
+		{
+			if(n - s + 1 < r)
+				S.F_min[s][r] = 1; //no combination of r target points exists in w[s..n]
+			else if(n - s + 1 == r)
+				S.F_min[s][r] = f * S.F_min[s+1][r-1];
+			else
+				S.F_min[s][r] = MIN(S.F_min[s+1][r], f * S.F_min[s+1][r-1]);
+		}
+	}
+
+#if TARGET_POINT_BRANCH_AND_BOUND_SELF_CHECK_FLAG /* [ */
+	/* let the exhaustive search start from the same global_TPQ */
+	InitQueue((queue_t*) &exhaustive_TPQ, QTYPE_TARGET_POINT);
+	pQueueNode = &(global_TPQ->head);
+	for(i = 0; i < global_TPQ->size; i++)
+	{
+		pQueueNode = pQueueNode->next;
+		Enqueue((queue_t*)&exhaustive_TPQ, (queue_node_t*)pQueueNode);
+	}
+	exhaustive_TPQ.minimum_average_delivery_delay = global_TPQ->minimum_average_delivery_delay;
+	exhaustive_TPQ.delivery_success_probability = global_TPQ->delivery_success_probability;
+#endif /* ] */
+
+	search_target_point_combinations(&S, 1, 1, 1, 0);
+
+#if TARGET_POINT_BRANCH_AND_BOUND_SELF_CHECK_FLAG /* [ */
+	combinations_for_target_points(S.v, w, 1, n, 1, maxk, p, d, param, 0, NULL, NULL, NULL, NULL, &exhaustive_TPQ);
+	check_target_point_branch_and_bound(&S, &exhaustive_TPQ);
+	DestroyQueue((queue_t*) &exhaustive_TPQ);
+#endif /* ] */
+
+	for(s = 1; s <= n+1; s++)
+		free(S.F_min[s]);
+	free(S.F_min);
+	free(S.v);
+
+	return S.evaluated_combination_count;
+}
+
 double compute_delivery_probability_along_with_delivery_delay_for_target_point(int target_point_id, parameter_t *param, double current_time, char *AP_vertex, struct_vehicle_t *destination_vehicle, forwarding_table_queue_t *FTQ, double *delivery_delay)
 { //Given a target point, compute the delivery probability along with the delivery delay for the given target point
 	double optimization_value = 0; //value for target point optimization
@@ -6620,8 +7048,16 @@ char* get_data_forwarding_mode_name(data_forwarding_mode_t type)
 }
 
 struct struct_vehicle* get_vehicle_list()
-{ //get the pointer to a static global variable vehicle_list
-	return &vehicle_list;
+{ //get the pointer to the head node of vehicle_list in the current simulation context, allocating it on the first use
+	simulation_context_t *ctx = simulation_context_current(); //current simulation context
+
+	if(ctx->vehicle_list == NULL)
+	{
+		ctx->vehicle_list = (struct struct_vehicle*) calloc(1, sizeof(struct struct_vehicle));
+		assert_memory(ctx->vehicle_list);
+	}
+
+	return ctx->vehicle_list;
 }
 
 boolean compute_arrival_time_mean_and_standard_deviation_for_path_node(double arrival_time,
@@ -6826,7 +7262,7 @@ boolean show_trajectory_and_arrival_time_for_vehicle(int vid,
 	printf("\n%d:", vid);
 	for(path_ptr = path_list->next; path_ptr != path_list;)
 	{
-		intersection = atoi(path_ptr->vertex);
+		intersection = path_ptr->vertex_id;
 		arrival_time = path_ptr->expected_arrival_time;
 
 		if(path_ptr->next != path_list)
@@ -6882,7 +7318,7 @@ boolean store_trajectory_and_arrival_time_for_vehicle(FILE *fp,
 	fprintf(fp, "\nvid=%d: ", vid);
 	for(path_ptr = path_list->next; path_ptr != path_list;)
 	{
-		intersection = atoi(path_ptr->vertex);
+		intersection = path_ptr->vertex_id;
 		arrival_time = path_ptr->expected_arrival_time;
 
 		if(path_ptr->next != path_list)
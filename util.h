@@ -40,6 +40,8 @@ void free_vehicle_list(); //free vehicle list along with the allocated memory
 
 struct struct_vehicle* vehicle_search(int id); //search a vehicle node corresponding to id from vehicle_list
 
+void benchmark_vehicle_search(int vehicle_number, int event_number); //measure the cost of dispatching event_number synthetic events to vehicle_number vehicles through vehicle_search() and through the linear walk of vehicle_list
+
 boolean isdetected(struct struct_sensor* sensor_list, int sensor_number, double x, double y); //check if the vehicle with its position (x, y) is detected by an active sensor
 
 double estimate_energy_consumption(double time, double sensing_range, double energy_consumption_rate); //estimate the amount of energy consumption to consider sensor's working time
@@ -213,6 +215,21 @@ void register_vehicle_movement(parameter_t *param, struct_vehicle_t* vehicle, do
 void delete_vehicle_movement(parameter_t *param, struct_vehicle_t* vehicle, double departure_time, struct_graph_node *G);
 //delete the vehicle's movement from the vehicle_movement_list of the directional edge pointed by a graph node in G with vehicle id
 
+void start_vehicle_analytic_movement(struct_vehicle_t *vehicle);
+//start a movement step of vehicle up to its edge exit under STEP_ANALYTIC; the vehicle's position is computed on demand from its position at move_start_time until VEHICLE_MOVE
+
+void finish_vehicle_analytic_movement(struct_vehicle_t *vehicle);
+//finish the movement step of vehicle under STEP_ANALYTIC by restoring its position at move_start_time so that VEHICLE_MOVE can advance it by move_interval
+
+void update_vehicle_position_on_demand(struct_vehicle_t *vehicle, double current_time);
+//compute vehicle's position at current_time from move_start_time, speed and pos_update_vector under STEP_ANALYTIC and update its offsets in real graph Gr and in its vehicle movement queue
+
+void update_vehicle_movement_queue_on_demand(parameter_t *param, vehicle_movement_queue_t *Q);
+//update the offsets of the vehicles in vehicle movement queue Q at the current simulation time under STEP_ANALYTIC
+
+void update_all_vehicle_positions_on_demand(parameter_t *param, double current_time);
+//update the positions of all the vehicles in vehicle_list at current_time under STEP_ANALYTIC
+
 void process_acl_convoy_for_vehicle_arrival(parameter_t *param, struct_vehicle_t *vehicle, double registration_time, directional_edge_queue_node_t *edge);
 //process the vehicle convoy for a new vehicle arrival into the directional edge in order to compute the ACL for the directional edge
 
@@ -394,6 +411,17 @@ void combinations_for_target_points(int v[], int w[], int start, int n, int k, i
 	   For example, p[i] is the delivery probability of target point w[i].
  */
 
+unsigned long branch_and_bound_for_target_points(int w[], int n, int maxk, double p[], double d[], parameter_t *param, target_point_queue_t *global_TPQ);
+/* select maxk target points among w[1..n] in the same way as combinations_for_target_points(), but skip the branches of combinations 
+ * that cannot replace global_TPQ: a branch is bounded above in the delivery probability by its r most reliable remaining target points 
+ * and below in the delivery delay by its prefix. This returns the number of complete combinations evaluated.
+ */
+
+#if TARGET_POINT_BRANCH_AND_BOUND_SELF_CHECK_FLAG /* [ */
+void report_target_point_branch_and_bound_self_check(FILE *fp);
+//report how many branch-and-bound searches have matched the exhaustive search
+#endif /* ] */
+
 double compute_delivery_probability_along_with_delivery_delay_for_target_point(int target_point_id, parameter_t *param, double current_time, char *AP_vertex, struct_vehicle_t *destination_vehicle, forwarding_table_queue_t *FTQ, double *delivery_delay);
 //Given a target point, compute the delivery probability along with the delivery delay for the given target point
 
@@ -405,7 +433,7 @@ char* get_data_forwarding_mode_name(data_forwarding_mode_t type);
 //return the data forwarding mode in string
 
 struct struct_vehicle* get_vehicle_list();
-//get the pointer to a static global variable vehicle_list
+//get the pointer to the head node of vehicle_list in the current simulation context
 
 boolean compute_arrival_time_mean_and_standard_deviation_for_path_node(double arrival_time,
 		parameter_t *param,
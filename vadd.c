@@ -205,16 +205,16 @@ void VADD_Compute_Forwarding_Probability(parameter_t *param, struct_graph_node *
 					break;
 
 				case FORWARDING_LINK_SELECTION_DISTANCE: //link selection based on the geographic distance between the vehicle position and the target point, such as access point and target vehicle
-					u = atoi(G[i].vertex) - 1;
-					v = atoi(pNeighborNode->vertex) - 1;	
+					u = G[i].vertex_id - 1;
+					v = pNeighborNode->vertex_id - 1;	
 					w = ap_node_id - 1; //index for the target point, such as AP
 
 					pNeighborNode->theta = D_move[u][v] + D_move[v][w]; //the shortest path distance from u to w via v
 					break;
 
 				case FORWARDING_LINK_SELECTION_DELAY: //link selection based on the aggregated link delay between the vehicle position and the target point, such as access point and target vehicle
-					u = atoi(G[i].vertex) - 1;
-					v = atoi(pNeighborNode->vertex) - 1;	
+					u = G[i].vertex_id - 1;
+					v = pNeighborNode->vertex_id - 1;	
 					w = ap_node_id - 1; //index for the target point, such as AP
 
 					pNeighborNode->theta = D_edd[u][v] + D_edd[v][w]; //the shortest aggregated link delay path from u to w via v
@@ -488,16 +488,16 @@ void VADD_Compute_Forwarding_Probability_For_Target_Intersection(parameter_t *pa
 					break;
 
 				case FORWARDING_LINK_SELECTION_DISTANCE: //link selection based on the geographic distance between the vehicle position and the target point, such as access point and target vehicle
-					u = atoi(G[i].vertex) - 1;
-					v = atoi(pNeighborNode->vertex) - 1;	
+					u = G[i].vertex_id - 1;
+					v = pNeighborNode->vertex_id - 1;	
 					w = target_node_id - 1; //index for the target point, such as target intersection
 
 					pNeighborNode->theta = D_move[u][v] + D_move[v][w]; //the shortest path distance from u to w via v
 					break;
 
 				case FORWARDING_LINK_SELECTION_DELAY: //link selection based on the aggregated link delay between the vehicle position and the target point, such as access point and target vehicle
-					u = atoi(G[i].vertex) - 1;
-					v = atoi(pNeighborNode->vertex) - 1;	
+					u = G[i].vertex_id - 1;
+					v = pNeighborNode->vertex_id - 1;	
 					w = target_node_id - 1; //index for the target point, such as target intersection
 
 					pNeighborNode->theta = D_edd[u][v] + D_edd[v][w]; //the shortest aggregated link delay path from u to w via v
@@ -867,6 +867,132 @@ double VADD_Compute_Conditional_Probability_For_Pure_Forwarding_Probability(angl
   return P_cond;
 }
 
+void VADD_Solve_Stochastic_Model_Linear_System(delay_queue_t *DQ, boolean *destination_flag, boolean variance_flag, double *x)
+{ //solve the linear system (P - E)x = -d of the stochastic model for the delay nodes in DQ where destination_flag[i] tells whether the road segment of the i-th delay node ends at a destination; if variance_flag is TRUE, solve (P^2 - E)x = -v for the delivery delay variances instead, where P^2 is the entrywise square of P and v is the edge delay variance vector
+  delay_queue_node_t *pDelayNode = NULL; //pointer to delay queue node
+  delay_component_queue_node_t *pDelayComponentNode = NULL; //pointer to delay component node
+  int n = DQ->size; //number of road segments
+  int i = 0, j = 0; //indices of for-loops
+  double **A = NULL; //n x (n+1) augmented matrix (P - E | -d) for the dense Gaussian elimination
+  LA_sparse_matrix_t *S = NULL; //n x n sparse matrix P - E for the SOR solver
+  double *b = NULL; //right-hand side -d for the SOR solver
+  int *p = NULL; //permutation vector of size n
+  int row_id = 0, column_id = 0; //row index i and column index j of the P_ij in the forwarding probability matrix P
+  double P = 0; //forwarding probability for an edge
+  double previous = 0; //solution of the previous update for the warm start
+
+  if(n > VADD_SPARSE_SOLVER_EDGE_NUMBER_THRESHOLD)
+  {
+    /** solve the linear system with the sparse SOR solver; each row has only the forwarding probabilities to the outgoing edges of its head intersection */
+    S = LA_Allocate_Sparse_Matrix(n, 4*n);
+
+    b = (double*)calloc(n, sizeof(double));
+    assert_memory(b);
+
+    pDelayNode = &(DQ->head);
+    for(i = 0; i < n; i++)
+    {
+      pDelayNode = pDelayNode->next;
+      row_id = pDelayNode->order;
+
+      pDelayComponentNode = &(pDelayNode->delay_component_list.head);
+      for(j = 0; j < pDelayNode->delay_component_list.size; j++)
+      {
+        pDelayComponentNode = pDelayComponentNode->next;
+        column_id = pDelayComponentNode->order;
+
+        P = (destination_flag[i] ? 0 : pDelayComponentNode->P);
+        if(P != 0)
+          LA_Set_Sparse_Matrix_Entry(S, row_id, column_id, (variance_flag ? P*P : P));
+      }
+
+      LA_Set_Sparse_Matrix_Entry(S, row_id, row_id, -1);
+
+      b[row_id] = (variance_flag ? -pDelayNode->edge_delay_variance : -pDelayNode->edge_delay);
+
+      /* warm start from the solution of the previous update kept in the edge's head node */
+      previous = (variance_flag ? pDelayNode->enode->head_gnode->EDD_VAR : pDelayNode->enode->head_gnode->EDD);
+      x[row_id] = ((previous >= 0 && previous < INF) ? previous : 0);
+    }
+
+    LA_Compress_Sparse_Matrix(S);
+
+    if(LA_Perform_Sparse_SOR(S, b, x, VADD_SPARSE_SOLVER_RELAXATION_FACTOR, VADD_SPARSE_SOLVER_TOLERANCE, VADD_SPARSE_SOLVER_MAXIMUM_ITERATION_NUMBER) > 0)
+    {
+      LA_Free_Sparse_Matrix(S);
+      free(b);
+      return;
+    }
+
+    /* SOR does not converge, e.g., under the extremely light-traffic condition where P - E is nearly singular, so fall back to Gaussian elimination */
+    LA_Free_Sparse_Matrix(S);
+    free(b);
+  }
+
+  /** construct n x (n+1) matrix containing the forwarding probability matrix and edge delay vector */
+  A = LA_Allocate_Matrix_Of_Type_Double(n, n+1);
+
+  /* allocate the memory for permutation vector p */
+  p = (int*)calloc(n, sizeof(int));
+  assert_memory(p);
+
+  /* initialize the matrix A with delay queue DQ */
+  pDelayNode = &(DQ->head);
+  for(i = 0; i < n; i++)
+  {
+    pDelayNode = pDelayNode->next;
+
+    /* Note: pDelayNode->order is the order to determine the row index of variable in matrix P */
+    row_id = pDelayNode->order; //row id i of the P_ij in the forwarding probability matrix P
+
+    pDelayComponentNode = &(pDelayNode->delay_component_list.head);
+    for(j = 0; j < pDelayNode->delay_component_list.size; j++)
+    {
+      pDelayComponentNode = pDelayComponentNode->next;
+
+      /* Note: pDelayComponentNode->order is the order to determine the column index of matrix P */
+      column_id = pDelayComponentNode->order; //column id j of the P_ij in the forwarding probability matrix P
+
+      if(destination_flag[i])
+      {
+        P = 0; //Since a destination is placed at the end of this road segment, the forwarding probability must be zero
+      }
+      else
+      {
+        P = pDelayComponentNode->P; //forwarding probability P for the edge corresponding to eid
+      }
+
+      A[row_id][column_id] = (variance_flag ? P*P : P); //set forwarding probability P (or its square for the variance) to A_ij
+    }
+
+    /* set the diagonal entry to -1:
+       Since matrix (P-E)x = -d is used to compute forwarding probability, the diagonal entry must have additional -1.
+    */
+    A[row_id][row_id] = -1;
+
+    /* set the (n+1)-column entry to -d where d is edge delay (or -v where v is edge delay variance) */
+    A[row_id][n] = (variance_flag ? -pDelayNode->edge_delay_variance : -pDelayNode->edge_delay);
+  }
+
+  /** solve the linear system using Gaussian Elimination */
+
+  /* perform Gaussian elimination for nonsingular case of matrix A where A's column_size is equal to row_size+1, since matrix A is the augmented matrix A = (P | -d) where P is n x n matrix and d is a column vector */
+  LA_Perform_Gaussian_Elimination_For_Nonsingular_Case(A, n, n+1, p);
+
+  /* perform Backward substitution to obtain the solution x for the augmented matrix A where x is a column vector of dimension row_size */
+  LA_Perform_Backward_Substitution(A, n, p, x);
+
+#ifdef __LOG_LEVEL_GAUSSIAN_ELIMINATION__
+  /**@ log the linear system and the solution */
+  if(variance_flag == FALSE)
+    LA_Log_LinearSystem_And_Solution(NULL, A, n, x);
+#endif
+
+  /** free the memory for the matrix A and permutation vector p */
+  LA_Free_Matrix_Of_Type_Double(A, n);
+  free(p);
+}
+
 void VADD_Compute_EDD_Based_On_Stochastic_Model(parameter_t *param, struct_graph_node *G, int G_size, directional_edge_queue_t *EQ, struct_traffic_table *ap_table, int ap_table_index)
 { //compute the Expected Delivery Delay (EDD) based on the stochastic model with graph G and directional edge queue EQ.
   directional_edge_queue_node_t *pEdgeNode = NULL, *pEdgeNode2 = NULL;  //pointers to directional edge queue nodes
@@ -874,18 +1000,12 @@ void VADD_Compute_EDD_Based_On_Stochastic_Model(parameter_t *param, struct_graph
   delay_queue_node_t delay_node; //contains a queue of delay components of type
   delay_queue_node_t *pDelayNode = NULL; //pointer to delay queue node with delay_component_list containing forwarding probability P and EDD D per edge.
   delay_component_queue_node_t delay_component_node; //delay component node
-  delay_component_queue_node_t *pDelayComponentNode = NULL; //pointer to delay component node
   int n = EQ->size; //number of road segments
   int i = 0, j = 0; //indices of for-loops
   struct_graph_node *pTailNode = NULL, *pHeadNode = NULL, *pNeighborNode = NULL; //pointers to graph nodes
   int head_id = 0; //id for a head node in the edge <tail_node, head_node>
-  double **A = NULL; //n x (n+1) EDD matrix containing n x n forwarding probability matrix and edge delay vector
-  int row_size = 0, column_size = 0; //row size and column size of a matrix
-  int row_id = 0, column_id = 0; //row index i and column index j of the P_ij in the forwarding probability matrix P
-  double P = 0; //forwarding probability for an edge
-  double *x = NULL; //solution vector of size row_size
-  int *p = NULL; //permutation vector of size row_size
-  int label = 0; //label to determine P_ij and edge_delay
+  double *x = NULL; //solution vector of size n
+  boolean *destination_flag = NULL; //destination_flag[i] tells whether the i-th road segment ends at an access point
 
   /** Compute Forwarding Probability for each directional edge in G */
   VADD_Compute_Forwarding_Probability(param, G, G_size, ap_table, ap_table_index); //compute forwarding probability P per road segment
@@ -942,87 +1062,26 @@ void VADD_Compute_EDD_Based_On_Stochastic_Model(parameter_t *param, struct_graph
     } //end of for-4
   } //end of for-3
   
-  /** construct n x (n+1) matrix containing the forwarding probability matrix and edge delay vector */
-  /* allocate the memory of the row_size x column_size matrix A of type double */
-  row_size = n;
-  column_size = n + 1;
-  A = LA_Allocate_Matrix_Of_Type_Double(row_size, column_size);
-
   /* allocate the memory for solution vector x */
-  x = (double*)calloc(row_size, sizeof(double));
+  x = (double*)calloc(n, sizeof(double));
   assert_memory(x);
 
-  /* allocate the memory for permutation vector p */
-  p = (int*)calloc(row_size, sizeof(int));
-  assert_memory(p);
+  /* allocate the memory for destination flag vector */
+  destination_flag = (boolean*)calloc(n, sizeof(boolean));
+  assert_memory(destination_flag);
 
-  /* initialize the matrix A with delay queue DQ */  
+  /* mark the road segments whose head_node is equal to one of access points in ap_table; note that the tail_node being an access point takes precedence */
   pDelayNode = &(DQ.head);
   for(i = 0; i < n; i++) //for-5
   {
     pDelayNode = pDelayNode->next;
 
-    label = 0; //label to determine P_ij and edge_delay
-    if(IsVertexInTrafficTable(ap_table, pDelayNode->enode->tail_node) == TRUE) 
-    /* check whether pDelayNode's tail_node is equal to one of access points in ap_table */
-    {
-      label = 1;
-      
-      /* set the edge_delay of the edge corresponding to pDelayNode with eid */
-      //pDelayNode->enode->head_gnode->edge_delay = 0;	
-    }
-    else if(IsVertexInTrafficTable(ap_table, pDelayNode->enode->head_node) == TRUE)
-    /* check whether pDelayNode's head_node is equal to one of access points in ap_table */
-      label = 2;
-
-    /* Note: pDelayNode->order is the order to determine the row index of variable in matrix P */       
-    row_id = pDelayNode->order; //row id i of the P_ij in the forwarding probability matrix P
-    //row_id = pDelayNode->eid; //row id i of the P_ij in the forwarding probability matrix P
-
-    pDelayComponentNode = &(pDelayNode->delay_component_list.head);
-    for(j = 0; j < pDelayNode->delay_component_list.size; j++) //for-6
-    {
-      pDelayComponentNode = pDelayComponentNode->next;
-
-      /* Note: pDelayComponentNode->order is the order to determine the column index of matrix P */
-      column_id = pDelayComponentNode->order; //column id j of the P_ij in the forwarding probability matrix P
-      //column_id = pDelayComponentNode->eid; //column id j of the P_ij in the forwarding probability matrix P
-
-      if(label == 2)
-      //if(label == 1 || label == 2)
-      { 
-	P = 0; //Since a destination is placed at the end of this road segment, the forwarding probability must be zero
-      }
-      else 
-	P = pDelayComponentNode->P; //forwarding probability P for the edge corresponding to eid
-
-      A[row_id][column_id] = P; //set forwarding probability P to A_ij
-      //A[row_id-1][column_id-1] = P; //set forwarding probability P to A_ij
-    } //end of for-6
-    
-    /* set the diagonal entry to -1:
-       Since matrix (P-E)x = -d is used to compute forwarding probability, the diagonal entry must have additional -1.
-    */
-    A[row_id][row_id] = -1;
-    //A[row_id-1][row_id-1] = -1;
-
-    /* set the (n+1)-column entry to -d where d is edge delay */
-    //if(label == 1)
-    //  A[row_id][n] = 0; //Since pDelayNode's tail_node is equal to one of access points, the edge delay must be zero.
-    //else
-
-    A[row_id][n] = -pDelayNode->edge_delay;
-
+    if(IsVertexInTrafficTable(ap_table, pDelayNode->enode->tail_node) == FALSE && IsVertexInTrafficTable(ap_table, pDelayNode->enode->head_node) == TRUE)
+      destination_flag[i] = TRUE;
   } //end of for-5
-  
 
-  /** solve the linear system using Gaussian Elimination */
-
-  /* perform Gaussian elimination for nonsingular case of matrix A where A's column_size is equal to row_size+1, since matrix A is the augmented matrix A = (P | -d) where P is n x n matrix and d is a column vector */
-  LA_Perform_Gaussian_Elimination_For_Nonsingular_Case(A, row_size, column_size, p);
-  
-  /* perform Backward substitution to obtain the solution x for the augmented matrix A where x is a column vector of dimension row_size */
-  LA_Perform_Backward_Substitution(A, row_size, p, x);
+  /** solve the linear system (P - E)x = -d */
+  VADD_Solve_Stochastic_Model_Linear_System(&DQ, destination_flag, FALSE, x);
 
   /** set the solutions in x to the EDDs in delay queue DQ */
   pDelayNode = &(DQ.head);
@@ -1036,14 +1095,11 @@ void VADD_Compute_EDD_Based_On_Stochastic_Model(parameter_t *param, struct_graph
   /** sort the intersection edd queue for each intersection in graph G */
   SortIntersection_EDD_Queues_In_Graph(param, G, G_size);
 
-  /** free the memory for the matrix A */
-  LA_Free_Matrix_Of_Type_Double(A, row_size);
-
   /** free the memory for solution vector x */
   free(x);
 
-  /** free the memory for permutation vector p */
-  free(p);
+  /** free the memory for destination flag vector */
+  free(destination_flag);
 
   /** destory delay queue DQ */
   DestroyQueue((queue_t*) &DQ);
@@ -1175,18 +1231,13 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Stochastic_Model(parameter_t *param, s
 	delay_queue_node_t delay_node; //contains a queue of delay components of type
 	delay_queue_node_t *pDelayNode = NULL; //pointer to delay queue node with delay_component_list containing forwarding probability P and EDD D per edge.
 	delay_component_queue_node_t delay_component_node; //delay component node
-	delay_component_queue_node_t *pDelayComponentNode = NULL, *pDelayComponentNode2 = NULL; //pointers to delay component node
+	delay_component_queue_node_t *pDelayComponentNode2 = NULL; //pointer to delay component node
 	int n = EQ->size; //number of road segments
 	int i = 0, j = 0, k = 0; //indices of for-loops
 	struct_graph_node *pTailNode = NULL, *pHeadNode = NULL, *pNeighborNode = NULL; //pointers to graph nodes
 	int head_id = 0; //id for a head node in the edge <tail_node, head_node>
-	double **A = NULL; //n x (n+1) EDD matrix containing n x n forwarding probability matrix and edge delay vector
-	int row_size = 0, column_size = 0; //row size and column size of a matrix
-	int row_id = 0, column_id = 0; //row index i and column index j of the P_ij in the forwarding probability matrix P
-	double P = 0; //forwarding probability for an edge
-	double *x = NULL; //solution vector of size row_size
-	int *p = NULL; //permutation vector of size row_size
-	int label = 0; //label to determine P_ij and edge_delay
+	double *x = NULL; //solution vector of size n
+	boolean *destination_flag = NULL; //destination_flag[i] tells whether the i-th road segment ends at the destination
 
 	/** Compute Forwarding Probability for each directional edge in G */
 	VADD_Compute_Forwarding_Probability(param, G, G_size, ap_table, ap_table_index); //compute forwarding probability P per road segment
@@ -1252,77 +1303,26 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Stochastic_Model(parameter_t *param, s
 		} //end of for-4
 	} //end of for-3
   
-	/** construct n x (n+1) matrix containing the forwarding probability matrix and edge delay vector */
-	/* allocate the memory of the row_size x column_size matrix A of type double */
-	row_size = n;
-	column_size = n + 1;
-	A = LA_Allocate_Matrix_Of_Type_Double(row_size, column_size);
-
 	/* allocate the memory for solution vector x */
-	x = (double*)calloc(row_size, sizeof(double));
+	x = (double*)calloc(n, sizeof(double));
 	assert_memory(x);
 
-	/* allocate the memory for permutation vector p */
-	p = (int*)calloc(row_size, sizeof(int));
-	assert_memory(p);
+	/* allocate the memory for destination flag vector */
+	destination_flag = (boolean*)calloc(n, sizeof(boolean));
+	assert_memory(destination_flag);
 
-	/* initialize the matrix A with delay queue DQ */  
+	/* mark the road segments whose head_node is the destination; note that the tail_node being the destination takes precedence */
 	pDelayNode = &(DQ.head);
 	for(i = 0; i < n; i++) //for-5
 	{
 		pDelayNode = pDelayNode->next;
 
-		label = 0; //label to determine P_ij and edge_delay
-		if(IsVertexInTrafficTable(ap_table, pDelayNode->enode->tail_node) == TRUE) 
-		/* check whether pDelayNode's tail_node is equal to one of access points in ap_table */
-		{
-			label = 1;
-		}
-		else if(IsVertexInTrafficTable(ap_table, pDelayNode->enode->head_node) == TRUE)
-		/* check whether pDelayNode's head_node is equal to one of access points in ap_table */
-		{
-			label = 2;
-		}
-
-		/* Note: pDelayNode->order is the order to determine the row index of variable in matrix P */       
-		row_id = pDelayNode->order; //row id i of the P_ij in the forwarding probability matrix P
-
-		pDelayComponentNode = &(pDelayNode->delay_component_list.head);
-		for(j = 0; j < pDelayNode->delay_component_list.size; j++) //for-6
-		{
-			pDelayComponentNode = pDelayComponentNode->next;
-
-			/* Note: pDelayComponentNode->order is the order to determine the column index of matrix P */
-			column_id = pDelayComponentNode->order; //column id j of the P_ij in the forwarding probability matrix P
-
-			if(label == 2)
-			{ 
-				P = 0; //Since a destination is placed at the end of this road segment, the forwarding probability must be zero
-			}
-			else
-			{
-				P = pDelayComponentNode->P; //forwarding probability P for the edge corresponding to eid
-			}
-
-			A[row_id][column_id] = P; //set forwarding probability P to A_ij
-		} //end of for-6
-    
-		/* set the diagonal entry to -1:
-			Since matrix (P-E)x = -d is used to compute forwarding probability, the diagonal entry must have additional -1.
-		*/
-		A[row_id][row_id] = -1;
-
-		/* set the (n+1)-column entry to -d where d is edge delay */
-		A[row_id][n] = -pDelayNode->edge_delay;    
+		if(IsVertexInTrafficTable(ap_table, pDelayNode->enode->tail_node) == FALSE && IsVertexInTrafficTable(ap_table, pDelayNode->enode->head_node) == TRUE)
+			destination_flag[i] = TRUE;
 	} //end of for-5
 
-	/** solve the linear system using Gaussian Elimination */
-
-	/* perform Gaussian elimination for nonsingular case of matrix A where A's column_size is equal to row_size+1, since matrix A is the augmented matrix A = (P | -d) where P is n x n matrix and d is a column vector */
-	LA_Perform_Gaussian_Elimination_For_Nonsingular_Case(A, row_size, column_size, p);
-  
-	/* perform Backward substitution to obtain the solution x for the augmented matrix A where x is a column vector of dimension row_size */
-	LA_Perform_Backward_Substitution(A, row_size, p, x);
+	/** solve the linear system (P - E)x = -d */
+	VADD_Solve_Stochastic_Model_Linear_System(&DQ, destination_flag, FALSE, x);
 
 	/** set the solutions in x to the EDDs in delay queue DQ */
 	pDelayNode = &(DQ.head);
@@ -1334,76 +1334,12 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Stochastic_Model(parameter_t *param, s
 		pDelayNode->enode->head_gnode->EDD = MIN(pDelayNode->EDD, INF); //[10/26/09] let the edge's head_node have its EDD while pDelayNode->EDD is at most INF under the extremely light-traffic condition
 	} //end of for-7
 
-#ifdef __LOG_LEVEL_GAUSSIAN_ELIMINATION__
-	/**@ log the linear system and the solution */
-	LA_Log_LinearSystem_And_Solution(NULL, A, row_size, x);
-#endif
-
 	/********************************************************/
 
 	/*** compute the variance of the E2E delivery delay ***/
 
-	/* reset matrix A and vector x */
-	LA_Reset_Matrix_Of_Type_Double(A, row_size, column_size);
-	//reset the memory of row_size x column_size matrix A of type double
-
-	memset(x, 0, row_size*sizeof(double));
-	//reset the memory of row_size vector x
-
-	/* initialize the matrix A with delay queue DQ */  
-	pDelayNode = &(DQ.head);
-	for(i = 0; i < n; i++) //for-5
-	{
-		pDelayNode = pDelayNode->next;
-
-		label = 0; //label to determine P_ij and edge_delay_variance
-		if(IsVertexInTrafficTable(ap_table, pDelayNode->enode->tail_node) == TRUE) 
-		/* check whether pDelayNode's tail_node is equal to one of access points in ap_table */
-		{
-			label = 1;
-		}
-		else if(IsVertexInTrafficTable(ap_table, pDelayNode->enode->head_node) == TRUE)
-		/* check whether pDelayNode's head_node is equal to one of access points in ap_table */
-		{
-			label = 2;
-		}
-
-		row_id = pDelayNode->order; //row id i of the P_ij in the forwarding probability matrix P
-
-		pDelayComponentNode = &(pDelayNode->delay_component_list.head);
-		for(j = 0; j < pDelayNode->delay_component_list.size; j++) //for-6
-		{
-			pDelayComponentNode = pDelayComponentNode->next;
-			column_id = pDelayComponentNode->order; //column id j of the P_ij in the forwarding probability matrix P
-
-			if(label == 2)
-			{ 
-				P = 0; //Since a destination is placed at the end of this road segment, the forwarding probability must be zero
-			}
-			else
-			{
-				P = pDelayComponentNode->P; //forwarding probability P for the edge corresponding to eid
-			}
-
-			A[row_id][column_id] = P*P; //set the square of forwarding probability P to A_ij
-		} //end of for-6
-    
-		/* set the diagonal entry to -1:
-			Since matrix (P-E)x = -d is used to compute forwarding probability, the diagonal entry must have additional -1.
-		*/
-		A[row_id][row_id] = -1;
-
-		/* set the (n+1)-column entry to 0 */
-		A[row_id][n] = -pDelayNode->edge_delay_variance; //set zero for the other cases except for label == 1 or label == 2 
-	} //end of for-5
-
-	/** solve the linear system using Gaussian Elimination */
-
-	/* perform Gaussian elimination for nonsingular case of matrix A where A's column_size is equal to row_size+1, since matrix A is the augmented matrix A = (P | -d) where P is n x n matrix and d is a column vector */
-	LA_Perform_Gaussian_Elimination_For_Nonsingular_Case(A, row_size, column_size, p);
-  
-	/* perform Backward substitution to obtain the solution x for the augmented matrix A where x is a column vector of dimension row_size */
-	LA_Perform_Backward_Substitution(A, row_size, p, x);
+	/** solve the linear system (P^2 - E)x = -v where v is edge delay variance */
+	VADD_Solve_Stochastic_Model_Linear_System(&DQ, destination_flag, TRUE, x);
 
 	/** set the solutions in x to the delivery delay variances in delay queue DQ */
 	pDelayNode = &(DQ.head);
@@ -1428,14 +1364,11 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Stochastic_Model(parameter_t *param, s
 	/** sort the intersection edd queue for each intersection in graph G */
 	SortIntersection_EDD_Queues_In_Graph(param, G, G_size);
 
-	/** free the memory for the matrix A */
-	LA_Free_Matrix_Of_Type_Double(A, row_size);
-
 	/** free the memory for solution vector x */
 	free(x);
 
-	/** free the memory for permutation vector p */
-	free(p);
+	/** free the memory for destination flag vector */
+	free(destination_flag);
 
 	/** destory delay queue DQ */
 	DestroyQueue((queue_t*) &DQ);
@@ -1448,18 +1381,13 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Stochastic_Model_For_Target_Intersecti
 	delay_queue_node_t delay_node; //contains a queue of delay components of type
 	delay_queue_node_t *pDelayNode = NULL; //pointer to delay queue node with delay_component_list containing forwarding probability P and EDD D per edge.
 	delay_component_queue_node_t delay_component_node; //delay component node
-	delay_component_queue_node_t *pDelayComponentNode = NULL, *pDelayComponentNode2 = NULL; //pointers to delay component node
+	delay_component_queue_node_t *pDelayComponentNode2 = NULL; //pointer to delay component node
 	int n = EQ->size; //number of road segments
 	int i = 0, j = 0, k = 0; //indices of for-loops
 	struct_graph_node *pTailNode = NULL, *pHeadNode = NULL, *pNeighborNode = NULL; //pointers to graph nodes
 	int head_id = 0; //id for a head node in the edge <tail_node, head_node>
-	double **A = NULL; //n x (n+1) EDD matrix containing n x n forwarding probability matrix and edge delay vector
-	int row_size = 0, column_size = 0; //row size and column size of a matrix
-	int row_id = 0, column_id = 0; //row index i and column index j of the P_ij in the forwarding probability matrix P
-	double P = 0; //forwarding probability for an edge
-	double *x = NULL; //solution vector of size row_size
-	int *p = NULL; //permutation vector of size row_size
-	int label = 0; //label to determine P_ij and edge_delay
+	double *x = NULL; //solution vector of size n
+	boolean *destination_flag = NULL; //destination_flag[i] tells whether the i-th road segment ends at the destination
 	int target_node_id = target_intersection_index + 1; //target intersection's node id
 
 	/** Compute Forwarding Probability for each directional edge in G */
@@ -1528,79 +1456,26 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Stochastic_Model_For_Target_Intersecti
 		} //end of for-4
 	} //end of for-3
   
-	/** construct n x (n+1) matrix containing the forwarding probability matrix and edge delay vector */
-	/* allocate the memory of the row_size x column_size matrix A of type double */
-	row_size = n;
-	column_size = n + 1;
-	A = LA_Allocate_Matrix_Of_Type_Double(row_size, column_size);
-
 	/* allocate the memory for solution vector x */
-	x = (double*)calloc(row_size, sizeof(double));
+	x = (double*)calloc(n, sizeof(double));
 	assert_memory(x);
 
-	/* allocate the memory for permutation vector p */
-	p = (int*)calloc(row_size, sizeof(int));
-	assert_memory(p);
+	/* allocate the memory for destination flag vector */
+	destination_flag = (boolean*)calloc(n, sizeof(boolean));
+	assert_memory(destination_flag);
 
-	/* initialize the matrix A with delay queue DQ */  
+	/* mark the road segments whose head_node is the destination; note that the tail_node being the destination takes precedence */
 	pDelayNode = &(DQ.head);
 	for(i = 0; i < n; i++) //for-5
 	{
 		pDelayNode = pDelayNode->next;
 
-		label = 0; //label to determine P_ij and edge_delay
-		if(target_node_id == atoi(pDelayNode->enode->tail_node))
-		//if(IsVertexInTrafficTable(ap_table, pDelayNode->enode->tail_node) == TRUE) 
-		/* check whether pDelayNode's tail_node is equal to one of access points in ap_table */
-		{
-			label = 1;
-		}
-		else if(target_node_id == atoi(pDelayNode->enode->head_node))
-		//else if(IsVertexInTrafficTable(ap_table, pDelayNode->enode->head_node) == TRUE)
-		/* check whether pDelayNode's head_node is equal to one of access points in ap_table */
-		{
-			label = 2;
-		}
-
-		/* Note: pDelayNode->order is the order to determine the row index of variable in matrix P */       
-		row_id = pDelayNode->order; //row id i of the P_ij in the forwarding probability matrix P
-
-		pDelayComponentNode = &(pDelayNode->delay_component_list.head);
-		for(j = 0; j < pDelayNode->delay_component_list.size; j++) //for-6
-		{
-			pDelayComponentNode = pDelayComponentNode->next;
-
-			/* Note: pDelayComponentNode->order is the order to determine the column index of matrix P */
-			column_id = pDelayComponentNode->order; //column id j of the P_ij in the forwarding probability matrix P
-
-			if(label == 2)
-			{ 
-				P = 0; //Since a destination is placed at the end of this road segment, the forwarding probability must be zero
-			}
-			else
-			{
-				P = pDelayComponentNode->P; //forwarding probability P for the edge corresponding to eid
-			}
-
-			A[row_id][column_id] = P; //set forwarding probability P to A_ij
-		} //end of for-6
-    
-		/* set the diagonal entry to -1:
-			Since matrix (P-E)x = -d is used to compute forwarding probability, the diagonal entry must have additional -1.
-		*/
-		A[row_id][row_id] = -1;
-
-		/* set the (n+1)-column entry to -d where d is edge delay */
-		A[row_id][n] = -pDelayNode->edge_delay;    
+		if(target_node_id != atoi(pDelayNode->enode->tail_node) && target_node_id == atoi(pDelayNode->enode->head_node))
+			destination_flag[i] = TRUE;
 	} //end of for-5
 
-	/** solve the linear system using Gaussian Elimination */
-
-	/* perform Gaussian elimination for nonsingular case of matrix A where A's column_size is equal to row_size+1, since matrix A is the augmented matrix A = (P | -d) where P is n x n matrix and d is a column vector */
-	LA_Perform_Gaussian_Elimination_For_Nonsingular_Case(A, row_size, column_size, p);
-  
-	/* perform Backward substitution to obtain the solution x for the augmented matrix A where x is a column vector of dimension row_size */
-	LA_Perform_Backward_Substitution(A, row_size, p, x);
+	/** solve the linear system (P - E)x = -d */
+	VADD_Solve_Stochastic_Model_Linear_System(&DQ, destination_flag, FALSE, x);
 
 	/** set the solutions in x to the EDDs in delay queue DQ */
 	pDelayNode = &(DQ.head);
@@ -1612,78 +1487,12 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Stochastic_Model_For_Target_Intersecti
 		pDelayNode->enode->head_gnode->EDD = MIN(pDelayNode->EDD, INF); //[10/26/09] let the edge's head_node have its EDD while pDelayNode->EDD is at most INF under the extremely light-traffic condition
 	} //end of for-7
 
-#ifdef __LOG_LEVEL_GAUSSIAN_ELIMINATION__
-	/**@ log the linear system and the solution */
-	LA_Log_LinearSystem_And_Solution(NULL, A, row_size, x);
-#endif
-
 	/********************************************************/
 
 	/*** compute the variance of the E2E delivery delay ***/
 
-	/* reset matrix A and vector x */
-	LA_Reset_Matrix_Of_Type_Double(A, row_size, column_size);
-	//reset the memory of row_size x column_size matrix A of type double
-
-	memset(x, 0, row_size*sizeof(double));
-	//reset the memory of row_size vector x
-
-	/* initialize the matrix A with delay queue DQ */  
-	pDelayNode = &(DQ.head);
-	for(i = 0; i < n; i++) //for-5
-	{
-		pDelayNode = pDelayNode->next;
-
-		label = 0; //label to determine P_ij and edge_delay_variance
-		if(target_node_id == atoi(pDelayNode->enode->tail_node))
-		//if(IsVertexInTrafficTable(ap_table, pDelayNode->enode->tail_node) == TRUE) 
-		/* check whether pDelayNode's tail_node is equal to one of access points in ap_table */
-		{
-			label = 1;
-		}
-		else if(target_node_id == atoi(pDelayNode->enode->head_node))
-		//else if(IsVertexInTrafficTable(ap_table, pDelayNode->enode->head_node) == TRUE)
-		/* check whether pDelayNode's head_node is equal to one of access points in ap_table */
-		{
-			label = 2;
-		}
-
-		row_id = pDelayNode->order; //row id i of the P_ij in the forwarding probability matrix P
-
-		pDelayComponentNode = &(pDelayNode->delay_component_list.head);
-		for(j = 0; j < pDelayNode->delay_component_list.size; j++) //for-6
-		{
-			pDelayComponentNode = pDelayComponentNode->next;
-			column_id = pDelayComponentNode->order; //column id j of the P_ij in the forwarding probability matrix P
-
-			if(label == 2)
-			{ 
-				P = 0; //Since a destination is placed at the end of this road segment, the forwarding probability must be zero
-			}
-			else
-			{
-				P = pDelayComponentNode->P; //forwarding probability P for the edge corresponding to eid
-			}
-
-			A[row_id][column_id] = P*P; //set the square of forwarding probability P to A_ij
-		} //end of for-6
-    
-		/* set the diagonal entry to -1:
-			Since matrix (P-E)x = -d is used to compute forwarding probability, the diagonal entry must have additional -1.
-		*/
-		A[row_id][row_id] = -1;
-
-		/* set the (n+1)-column entry to 0 */
-		A[row_id][n] = -pDelayNode->edge_delay_variance; //set zero for the other cases except for label == 1 or label == 2 
-	} //end of for-5
-
-	/** solve the linear system using Gaussian Elimination */
-
-	/* perform Gaussian elimination for nonsingular case of matrix A where A's column_size is equal to row_size+1, since matrix A is the augmented matrix A = (P | -d) where P is n x n matrix and d is a column vector */
-	LA_Perform_Gaussian_Elimination_For_Nonsingular_Case(A, row_size, column_size, p);
-  
-	/* perform Backward substitution to obtain the solution x for the augmented matrix A where x is a column vector of dimension row_size */
-	LA_Perform_Backward_Substitution(A, row_size, p, x);
+	/** solve the linear system (P^2 - E)x = -v where v is edge delay variance */
+	VADD_Solve_Stochastic_Model_Linear_System(&DQ, destination_flag, TRUE, x);
 
 	/** set the solutions in x to the delivery delay variances in delay queue DQ */
 	pDelayNode = &(DQ.head);
@@ -1710,14 +1519,11 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Stochastic_Model_For_Target_Intersecti
 	/** sort the intersection edd queue for each intersection in graph G */
 	SortIntersection_EDD_Queues_In_Graph(param, G, G_size);
 
-	/** free the memory for the matrix A */
-	LA_Free_Matrix_Of_Type_Double(A, row_size);
-
 	/** free the memory for solution vector x */
 	free(x);
 
-	/** free the memory for permutation vector p */
-	free(p);
+	/** free the memory for destination flag vector */
+	free(destination_flag);
 
 	/** destory delay queue DQ */
 	DestroyQueue((queue_t*) &DQ);
@@ -1786,6 +1592,11 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Shortest_Path_Model_For_Shortest_EDD(p
   int ***M = NULL; //predecessor matrix for the EDD shortest path for a forwarding table entry
   double ***S = NULL; //supplementary metric matrix for the EDD shortest path for a forwarding table entry
   int *matrix_size = &(param->vanet_table.matrix_size_for_edd_in_Gr); //matrix size for the EDD shortest path matrix for a forwarding table entry 
+#if APSP_INCREMENTAL_UPDATE_FLAG /* [ */
+  double ***W_prev = NULL; //edge weight matrix used by the previous update for the incremental update
+  double ***V_prev = NULL; //supplementary edge weight matrix used by the previous update for the incremental update
+  int *n_prev = NULL; //node number of the previous update for the incremental update
+#endif /* ] */
 
   double **D_edd = NULL; //weight matrix for all-pairs shortest paths in terms of Expected Delivery Delay (EDD) in real graph Gr
   int **M_edd = NULL; //predecessor matrix for all-pairs shortest paths in terms of EDD in real graph Gr
@@ -1813,24 +1624,52 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Shortest_Path_Model_For_Shortest_EDD(p
 	D = &(FTQ_Entry->Dr_edd);
 	M = &(FTQ_Entry->Mr_edd);
     S = &(FTQ_Entry->Sr_edd);
+#if APSP_INCREMENTAL_UPDATE_FLAG /* [ */
+	W_prev = &(FTQ_Entry->Dr_edd_weight);
+	V_prev = &(FTQ_Entry->Sr_edd_weight);
+	n_prev = &(FTQ_Entry->node_number_for_edd_weight_in_Gr);
+#endif /* ] */
   }
   else
   { /** the case where the global matrices are used */
   	D = &(param->vanet_table.Dr_edd); //weight matrix for the EDD shortest path
   	M = &(param->vanet_table.Mr_edd); //predecessor matrix for the EDD shortest path
   	S = &(param->vanet_table.Sr_edd); //supplementary metric matrix for the EDD shortest path
+#if APSP_INCREMENTAL_UPDATE_FLAG /* [ */
+  	W_prev = &(param->vanet_table.Dr_edd_weight); //edge weight matrix used by the previous update
+  	V_prev = &(param->vanet_table.Sr_edd_weight); //supplementary edge weight matrix used by the previous update
+  	n_prev = &(param->vanet_table.node_number_for_edd_weight_in_Gr); //node number of the previous update
+#endif /* ] */
   }
 
   /** Compute Forwarding Probability for each directional edge in G; the forwarding probability can be used for the computation of the EDD and EDD_SD at each intersection */
   VADD_Compute_Forwarding_Probability(param, G, G_size, ap_table, ap_table_index); //compute forwarding probability P per road segment; even though P is not used in this function, but it will be used to EDD in TBD.
 
+#if FORWARDING_TABLE_REVERSE_SHORTEST_PATH_FLAG /* [ */
+  if(forwarding_table_update_flag)
+  { /** the forwarding table entry keeps only the EDD vectors towards its target point, so one reverse shortest path pass replaces the all-pairs matrices */
+    Reverse_Dijkstra_Construct_Vectors_For_EDD(G, G_size, k, FTQ_Entry->Dv_edd, FTQ_Entry->Nv_edd, FTQ_Entry->Sv_edd, param);
+
+    /* set the EDD, EDD_VAR and EDD_SD towards the target point to the road graph G */
+    VADD_Set_EDD_And_EDD_SD_In_Graph_With_Vectors(G, G_size, FTQ_Entry->Dv_edd, FTQ_Entry->Sv_edd);
+
+    /** sort the intersection edd queue for each intersection in graph G */
+    SortIntersection_EDD_Queues_In_Graph(param, G, G_size);
+    return;
+  }
+#endif /* ] */
+
   /** Compute the shortest path length in terms of delivery delay in G */
   ///* allocate the matrices for Expected Delivery Delay (EDD) in G */
   //matrix_size_for_edd_in_G = G_size;
   //Floyd_Warshall_Allocate_Matrices_For_EDD(&D_edd, &M_edd, &S_edd, matrix_size_for_edd_in_G);
 
   /* construct the shortest path delay matrix D_edd, the predecessor matrix M_edd, and the supplementary metric matrix S in terms of delivery delay */
+#if APSP_INCREMENTAL_UPDATE_FLAG
+  Floyd_Warshall_Construct_Matrices_For_EDD_Incrementally(G, G_size, D, M, S, matrix_size, W_prev, V_prev, n_prev, param);
+#else
   Floyd_Warshall_Construct_Matrices_For_EDD(G, G_size, D, M, S, matrix_size, param);
+#endif
 
   /* set up D_edd, M_edd, S_edd and matrix_size_for_edd_in_G */
   D_edd = *D;
@@ -1852,7 +1691,7 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Shortest_Path_Model_For_Shortest_EDD(p
 
     while(ptr != NULL)
     {
-      j = atoi(ptr->vertex) - 1;
+      j = ptr->vertex_id - 1;
       //node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 
       ptr->EDD = ptr->edge_delay + D_edd[j][k]; //E2E delay for the shortest path via road segment r_ij in term of delay
@@ -1882,6 +1721,11 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Shortest_Path_Model_For_Shortest_EDD_V
   int ***M = NULL; //predecessor matrix for the EDD shortest path
   double ***S = NULL; //supplementary metric matrix for the EDD shortest path
   int *matrix_size = &(param->vanet_table.matrix_size_for_edd_in_Gr); //matrix size for the EDD shortest path matrix 
+#if APSP_INCREMENTAL_UPDATE_FLAG /* [ */
+  double ***W_prev = NULL; //edge weight matrix used by the previous update for the incremental update
+  double ***V_prev = NULL; //supplementary edge weight matrix used by the previous update for the incremental update
+  int *n_prev = NULL; //node number of the previous update for the incremental update
+#endif /* ] */
 
   double **D_edd_var = NULL; //weight matrix for all-pairs shortest paths in terms of Delivery Delay Variance (EDD_VAR) in real graph Gr
   int **M_edd_var = NULL; //predecessor matrix for all-pairs shortest paths in terms of EDD_VAR in real graph Gr
@@ -1909,24 +1753,52 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Shortest_Path_Model_For_Shortest_EDD_V
 	D = &(FTQ_Entry->Dr_edd);
 	M = &(FTQ_Entry->Mr_edd);
     S = &(FTQ_Entry->Sr_edd);
+#if APSP_INCREMENTAL_UPDATE_FLAG /* [ */
+	W_prev = &(FTQ_Entry->Dr_edd_weight);
+	V_prev = &(FTQ_Entry->Sr_edd_weight);
+	n_prev = &(FTQ_Entry->node_number_for_edd_weight_in_Gr);
+#endif /* ] */
   }
   else
   { /** the case where the global matrices are used */
   	D = &(param->vanet_table.Dr_edd); //weight matrix for the EDD shortest path
   	M = &(param->vanet_table.Mr_edd); //predecessor matrix for the EDD shortest path
   	S = &(param->vanet_table.Sr_edd); //supplementary metric matrix for the EDD shortest path
+#if APSP_INCREMENTAL_UPDATE_FLAG /* [ */
+  	W_prev = &(param->vanet_table.Dr_edd_weight); //edge weight matrix used by the previous update
+  	V_prev = &(param->vanet_table.Sr_edd_weight); //supplementary edge weight matrix used by the previous update
+  	n_prev = &(param->vanet_table.node_number_for_edd_weight_in_Gr); //node number of the previous update
+#endif /* ] */
   }
 
   /** Compute Forwarding Probability for each directional edge in G; the forwarding probability can be used for the computation of the EDD and EDD_SD at each intersection */
   VADD_Compute_Forwarding_Probability(param, G, G_size, ap_table, ap_table_index); //compute forwarding probability P per road segment; even though P is not used in this function, but it will be used to EDD in TBD.
 
+#if FORWARDING_TABLE_REVERSE_SHORTEST_PATH_FLAG /* [ */
+  if(forwarding_table_update_flag)
+  { /** the forwarding table entry keeps only the EDD_VAR vectors towards its target point, so one reverse shortest path pass replaces the all-pairs matrices */
+    Reverse_Dijkstra_Construct_Vectors_For_EDD_VAR(G, G_size, k, FTQ_Entry->Dv_edd, FTQ_Entry->Nv_edd, FTQ_Entry->Sv_edd, param);
+
+    /* set the EDD, EDD_VAR and EDD_SD towards the target point to the road graph G; Sv_edd has the delay and Dv_edd has the delay variance */
+    VADD_Set_EDD_And_EDD_SD_In_Graph_With_Vectors(G, G_size, FTQ_Entry->Sv_edd, FTQ_Entry->Dv_edd);
+
+    /** sort the intersection edd_var queue for each intersection in graph G */
+    SortIntersection_EDD_Queues_In_Graph(param, G, G_size);
+    return;
+  }
+#endif /* ] */
+
   /** Compute the shortest path length in terms of delivery delay variance in G */
   ///* allocate the matrices for Delivery Delay Variance (EDD_VAR) in G */
   //matrix_size_for_edd_var_in_G = G_size;
   //Floyd_Warshall_Allocate_Matrices_For_EDD_VAR(&D_edd_var, &M_edd_var, &S_edd_var, matrix_size_for_edd_var_in_G);
 
   /** construct the shortest path delay variance matrix D_edd_var, the predecessor matrix M_edd_var, and the supplementary metric matrix S in terms of delivery delay */
+#if APSP_INCREMENTAL_UPDATE_FLAG
+  Floyd_Warshall_Construct_Matrices_For_EDD_Incrementally(G, G_size, D, M, S, matrix_size, W_prev, V_prev, n_prev, param);
+#else
   Floyd_Warshall_Construct_Matrices_For_EDD(G, G_size, D, M, S, matrix_size, param);
+#endif
 
   /* set up D_edd, M_edd, S_edd and matrix_size_for_edd_in_G */
   D_edd_var = *D;
@@ -1948,7 +1820,7 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Shortest_Path_Model_For_Shortest_EDD_V
 
     while(ptr != NULL)
     {
-      j = atoi(ptr->vertex) - 1;
+      j = ptr->vertex_id - 1;
       //node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 
       ptr->EDD_VAR = ptr->edge_delay_variance + D_edd_var[j][k]; //E2E delay variance for the shortest path via road segment r_ij in terms of delay variance
@@ -1976,6 +1848,11 @@ void VADD_Compute_EDC_And_EDC_SD_Based_On_Shortest_Path_Model_For_Shortest_EDC(p
   int ***M = NULL; //predecessor matrix for the EDC shortest path
   double ***S = NULL; //supplementary metric matrix for the EDC shortest path
   int *matrix_size = &(param->vanet_table.matrix_size_for_edc_in_Gr); //matrix size for the EDC shortest path matrix 
+#if APSP_INCREMENTAL_UPDATE_FLAG /* [ */
+  double ***W_prev = NULL; //edge weight matrix used by the previous update for the incremental update
+  double ***V_prev = NULL; //supplementary edge weight matrix used by the previous update for the incremental update
+  int *n_prev = NULL; //node number of the previous update for the incremental update
+#endif /* ] */
 
   double **W_edc = NULL; //weight matrix for all-pairs shortest paths in terms of Expected Delivery Cost (EDC) in real graph Gr
   double **D_edc = NULL; //shortest path weight matrix for all-pairs shortest paths in terms of Expected Delivery Cost (EDC) in real graph Gr
@@ -2005,6 +1882,11 @@ void VADD_Compute_EDC_And_EDC_SD_Based_On_Shortest_Path_Model_For_Shortest_EDC(p
 	D = &(FTQ_Entry->Dr_edc);
 	M = &(FTQ_Entry->Mr_edc);
     S = &(FTQ_Entry->Sr_edc);
+#if APSP_INCREMENTAL_UPDATE_FLAG /* [ */
+	W_prev = &(FTQ_Entry->Dr_edc_weight);
+	V_prev = &(FTQ_Entry->Sr_edc_weight);
+	n_prev = &(FTQ_Entry->node_number_for_edc_weight_in_Gr);
+#endif /* ] */
   }
   else
   { /** the case where the global matrices are used */
@@ -2012,18 +1894,38 @@ void VADD_Compute_EDC_And_EDC_SD_Based_On_Shortest_Path_Model_For_Shortest_EDC(p
   	D = &(param->vanet_table.Dr_edc); //shortest path weight matrix for the EDD shortest path
   	M = &(param->vanet_table.Mr_edc); //predecessor matrix for the EDD shortest path
   	S = &(param->vanet_table.Sr_edc); //supplementary metric matrix for the EDD shortest path
+#if APSP_INCREMENTAL_UPDATE_FLAG /* [ */
+  	W_prev = &(param->vanet_table.Dr_edc_weight); //edge weight matrix used by the previous update
+  	V_prev = &(param->vanet_table.Sr_edc_weight); //supplementary edge weight matrix used by the previous update
+  	n_prev = &(param->vanet_table.node_number_for_edc_weight_in_Gr); //node number of the previous update
+#endif /* ] */
   }
 
   /** Compute Forwarding Probability for each directional edge in G; the forwarding probability can be used for the computation of the EDC and EDC_SD at each intersection */
   VADD_Compute_Forwarding_Probability(param, G, G_size, ap_table, ap_table_index); //compute forwarding probability P per road segment; even though P is not used in this function, but it will be used to EDD in TBD.
 
+#if FORWARDING_TABLE_REVERSE_SHORTEST_PATH_FLAG /* [ */
+  if(forwarding_table_update_flag)
+  { /** the forwarding table entry keeps only the EDC vectors towards its target point, so one reverse shortest path pass replaces the all-pairs matrices */
+    Reverse_Dijkstra_Construct_Vectors_For_EDC(G, G_size, k, FTQ_Entry->Dv_edc, FTQ_Entry->Nv_edc, FTQ_Entry->Sv_edc, param);
+
+    /* set the EDC, EDC_VAR and EDC_SD towards the target point to the road graph G */
+    VADD_Set_EDC_And_EDC_SD_In_Graph_With_Vectors(G, G_size, FTQ_Entry->Dv_edc, FTQ_Entry->Sv_edc);
+    return;
+  }
+#endif /* ] */
+
   /** Compute the shortest path length in terms of delivery cost in G */
   ///* allocate the matrices for Expected Delivery Cost (EDC) in G */
   //matrix_size_for_edc_in_G = G_size;
   //Floyd_Warshall_Allocate_Matrices_For_EDC(&D_edc, &M_edc, &S_edc, matrix_size_for_edc_in_G);
 
   /* construct the shortest path cost matrix D_edc, the predecessor matrix M_edc, and the supplementary metric matrix S_edc in terms of delivery delay */
+#if APSP_INCREMENTAL_UPDATE_FLAG
+  Floyd_Warshall_Construct_Matrices_For_EDC_Incrementally(G, G_size, W, D, M, S, matrix_size, W_prev, V_prev, n_prev, param);
+#else
   Floyd_Warshall_Construct_Matrices_For_EDC(G, G_size, W, D, M, S, matrix_size, param);
+#endif
 
   /* set up W_edc, D_edc, M_edc, S_edc and matrix_size_for_edc_in_G */
   W_edc = *W;
@@ -2046,7 +1948,7 @@ void VADD_Compute_EDC_And_EDC_SD_Based_On_Shortest_Path_Model_For_Shortest_EDC(p
 
     while(ptr != NULL)
     {
-      j = atoi(ptr->vertex) - 1;
+      j = ptr->vertex_id - 1;
       //node id starts from 1, but it should decrease by 1 for weight matrix where the id starts from 0.
 
       ptr->EDC = ptr->edge_cost + D_edc[j][k]; //E2E cost for the shortest path via road segment r_ij in term of delay
@@ -2066,6 +1968,64 @@ void VADD_Compute_EDC_And_EDC_SD_Based_On_Shortest_Path_Model_For_Shortest_EDC(p
   //Floyd_Warshall_Free_Matrices_For_EDD(&D_edd, &M_edd, &S_edd, &matrix_size_for_edd_in_G);
 } //end of function 
 
+void VADD_Set_EDD_And_EDD_SD_In_Graph_With_Vectors(struct_graph_node *G, int G_size, double *delay, double *delay_variance)
+{ //set the EDD, EDD_VAR and EDD_SD of each intersection and road segment in G with the shortest path delay vector and delay variance vector towards a target point
+  struct_graph_node *ptr = NULL; //pointer to graph node
+  int i = 0, j = 0; //indices of for-loops
+
+  for(i = 0; i < G_size; i++)
+  {
+    ptr = G[i].next;
+    if(ptr == NULL)
+      continue;
+
+    /* set up the EDD, EDD_VAR, and EDD_SD of intersection G[i] */
+    G[i].EDD = delay[i];
+    G[i].EDD_VAR = delay_variance[i];
+    G[i].EDD_SD = sqrt(G[i].EDD_VAR);
+
+    while(ptr != NULL)
+    {
+      j = ptr->vertex_id - 1;
+
+      ptr->EDD = ptr->edge_delay + delay[j]; //E2E delay for the shortest path via road segment r_ij
+      ptr->EDD_VAR = ptr->edge_delay_variance + delay_variance[j]; //E2E delay variance for the shortest path
+      ptr->EDD_SD = sqrt(ptr->EDD_VAR); //E2E delay standard deviation for the shortest path
+
+      ptr = ptr->next;
+    }
+  }
+}
+
+void VADD_Set_EDC_And_EDC_SD_In_Graph_With_Vectors(struct_graph_node *G, int G_size, double *cost, double *cost_variance)
+{ //set the EDC, EDC_VAR and EDC_SD of each intersection and road segment in G with the shortest path cost vector and cost variance vector towards a target point
+  struct_graph_node *ptr = NULL; //pointer to graph node
+  int i = 0, j = 0; //indices of for-loops
+
+  for(i = 0; i < G_size; i++)
+  {
+    ptr = G[i].next;
+    if(ptr == NULL)
+      continue;
+
+    /* set up the EDC, EDC_VAR, and EDC_SD of intersection G[i] */
+    G[i].EDC = cost[i];
+    G[i].EDC_VAR = cost_variance[i];
+    G[i].EDC_SD = sqrt(G[i].EDC_VAR);
+
+    while(ptr != NULL)
+    {
+      j = ptr->vertex_id - 1;
+
+      ptr->EDC = ptr->edge_cost + cost[j]; //E2E cost for the shortest path via road segment r_ij
+      ptr->EDC_VAR = ptr->edge_cost_variance + cost_variance[j]; //E2E cost variance for the shortest path
+      ptr->EDC_SD = sqrt(ptr->EDC_VAR); //E2E cost standard deviation for the shortest path
+
+      ptr = ptr->next;
+    }
+  }
+}
+
 double VADD_Compute_Edge_Delay(parameter_t *param, struct_graph_node *pGraphNode)
 { //compute the edge delay for the road segment r_ij with head node pGraphNode->vertex
   double delay = 0; //edge delay
@@ -3516,6 +3476,8 @@ boolean VADD_Is_Within_Destination_Vehicle_Communication_Range(parameter_t *para
     if(pQueueNode->vnode->id == vehicle->id)
       continue;
 
+    update_vehicle_position_on_demand(pQueueNode->vnode, smpl_time()); //bring the destination vehicle's offset up to date under STEP_ANALYTIC
+
     if(pQueueNode->vnode->current_pos_in_Gr.eid == vehicle->current_pos_in_Gr.eid)
     { //two vehicles are moving on the same edge on the road network graph
       distance = fabs(pQueueNode->vnode->current_pos_in_Gr.offset - vehicle->current_pos_in_Gr.offset);
@@ -3624,6 +3586,7 @@ boolean VADD_Is_There_Next_Carrier_On_One_Way_Road_Segment(parameter_t *param, d
 	vehicle_movement_queue_node_t *pMoveNode = NULL; //pointer to the vehicle movement queue
 	int i = 0; //index for for-loop
 	int size = 0; //size of vehicle movement queue
+	vehicle_movement_queue_node_t **neighbor_array = NULL; //array of the vehicle movement queue nodes within the communication range in the order of the vehicle movement list
 	double offset_in_undirectional_edge = 0; //vehicle's offset on the undirectional edge
 	double offset_in_directional_edge = 0; //vehicle's offset on the directional edge
 
@@ -3703,11 +3666,21 @@ boolean VADD_Is_There_Next_Carrier_On_One_Way_Road_Segment(parameter_t *param, d
 		exit(1);
 	}
   
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	/* visit only the vehicles within the communication range of the vehicle by the offset index of the edge */
+	size = GetVehicleMovementsInOffsetRange(&(pEdgeNode->vehicle_movement_list), offset_in_directional_edge - param->communication_range, offset_in_directional_edge + param->communication_range, &neighbor_array);
+#else
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
+#endif /* ] */
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
 	{
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+		pMoveNode = neighbor_array[i];
+#else
 		pMoveNode = pMoveNode->next;
+#endif /* ] */
 		if(vehicle->id == pMoveNode->vid)
 			continue;
 
@@ -3846,6 +3819,10 @@ boolean VADD_Is_There_Next_Carrier_On_One_Way_Road_Segment(parameter_t *param, d
 				exit(1);
 		} //end of switch-1
 	} //end of for-1
+
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	free(neighbor_array);
+#endif /* ] */
    
 	/** [03/18/09] set the next_carrier to the vehicle's convoy leader when there exists no next carrier candidate in a different convoy with less EDD */
 	if(param->vehicle_vanet_forwarding_type == VANET_FORWARDING_BASED_ON_CONVOY)
@@ -3887,6 +3864,7 @@ boolean VADD_Is_There_Next_Carrier_On_Two_Way_Road_Segment(parameter_t *param, d
 	vehicle_movement_queue_node_t *pMoveNode = NULL; //pointer to the vehicle movement queue
 	int i = 0; //index for for-loop
 	int size = 0; //size of vehicle movement queue
+	vehicle_movement_queue_node_t **neighbor_array = NULL; //array of the vehicle movement queue nodes within the communication range in the order of the vehicle movement list
 	double offset_in_undirectional_edge = 0; //vehicle's offset on the undirectional edge
 	double offset_in_directional_edge = 0; //vehicle's offset on the directional edge
 	struct_vehicle_t *next_carrier_candidate_1 = NULL; //next carrier candidate on the same directional edge for vehicle
@@ -3952,12 +3930,22 @@ boolean VADD_Is_There_Next_Carrier_On_Two_Way_Road_Segment(parameter_t *param, d
 		exit(1);
 	}
   
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	/* visit only the vehicles within the communication range of the vehicle by the offset index of the edge */
+	size = GetVehicleMovementsInOffsetRange(&(pEdgeNode->vehicle_movement_list), offset_in_directional_edge - param->communication_range, offset_in_directional_edge + param->communication_range, &neighbor_array);
+#else
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
+#endif /* ] */
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
 	//for(i = 0; i < size; i++) //for-1
 	{
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+		pMoveNode = neighbor_array[i];
+#else
 		pMoveNode = pMoveNode->next;
+#endif /* ] */
 		if(vehicle->id == pMoveNode->vid)
 			continue;
 
@@ -4093,6 +4081,10 @@ boolean VADD_Is_There_Next_Carrier_On_Two_Way_Road_Segment(parameter_t *param, d
 				exit(1);
 		} //end of switch-1
 	} //end of for-1
+
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	free(neighbor_array);
+#endif /* ] */
  
 	/******************************************************************************/
 
@@ -4150,11 +4142,21 @@ boolean VADD_Is_There_Next_Carrier_On_Two_Way_Road_Segment(parameter_t *param, d
 		exit(1);
 	}
   
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	/* visit only the vehicles within the communication range of the vehicle by the offset index of the edge */
+	size = GetVehicleMovementsInOffsetRange(&(pEdgeNode->vehicle_movement_list), offset_in_directional_edge - param->communication_range, offset_in_directional_edge + param->communication_range, &neighbor_array);
+#else
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
+#endif /* ] */
 	for(i = 0; i < size && flag == FALSE; i++) //for-1
 	{
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+		pMoveNode = neighbor_array[i];
+#else
 		pMoveNode = pMoveNode->next;
+#endif /* ] */
 		if(vehicle->id == pMoveNode->vid)
 			continue;
 
@@ -4281,6 +4283,10 @@ boolean VADD_Is_There_Next_Carrier_On_Two_Way_Road_Segment(parameter_t *param, d
 				exit(1);
 		} //end of switch-1
 	} //end of for-1
+
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	free(neighbor_array);
+#endif /* ] */
    
 	/******************************************************************************/
 
@@ -4370,6 +4376,7 @@ boolean VADD_Is_There_Next_Carrier_On_Road_Segment_Incident_To_Intersection(para
 	vehicle_movement_queue_node_t *pMoveNode = NULL; //pointer to the vehicle movement queue
 	int i = 0; //index for for-loop
 	int size = 0; //size of vehicle movement queue
+	vehicle_movement_queue_node_t **neighbor_array = NULL; //array of the vehicle movement queue nodes within the communication range in the order of the vehicle movement list
 
 	int source_intersection_id = atoi(tail_node); //the id of the tail intersection of the directed edge where the packet carrier is moving
 
@@ -4425,11 +4432,24 @@ boolean VADD_Is_There_Next_Carrier_On_Road_Segment_Incident_To_Intersection(para
 	/* set min_neighbor_EDD according to param's data_forwarding_mode and vehicle_vanet_forwarding_type */
 	min_neighbor_EDD = VADD_Get_Initial_Minimum_Neighbor_EDD(param, vehicle);
 
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	/* visit only the vehicles within the communication range of the intersection by the offset index of the edge */
+	if(edge_type == OUTGOING_EDGE)
+		size = GetVehicleMovementsInOffsetRange(&(pEdgeNode->vehicle_movement_list), -INF, param->communication_range, &neighbor_array);
+	else
+		size = GetVehicleMovementsInOffsetRange(&(pEdgeNode->vehicle_movement_list), pEdgeNode->weight - param->communication_range, pEdgeNode->weight + param->communication_range, &neighbor_array);
+#else
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
+#endif /* ] */
 	for(i = 0; i < size && flag == FALSE; i++) //[03/18/09] for-1
 	{
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+		pMoveNode = neighbor_array[i];
+#else
 		pMoveNode = pMoveNode->next;
+#endif /* ] */
 		if(vehicle->id == pMoveNode->vid)
 			continue;
 
@@ -4545,6 +4565,10 @@ boolean VADD_Is_There_Next_Carrier_On_Road_Segment_Incident_To_Intersection(para
 		} //end of switch-1
 	} //end of for-1
 
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	free(neighbor_array);
+#endif /* ] */
+
 	/** check whether a next carrier vehicle exists */
 	if(*next_carrier != NULL)
 		result = TRUE;
@@ -4748,6 +4772,7 @@ boolean VADD_Is_There_Next_Carrier_On_Road_Segment_Incident_To_Intersection_For_
 	vehicle_movement_queue_node_t *pMoveNode = NULL; //pointer to the vehicle movement queue
 	int i = 0; //index for for-loop
 	int size = 0; //size of vehicle movement queue
+	vehicle_movement_queue_node_t **neighbor_array = NULL; //array of the vehicle movement queue nodes within the communication range in the order of the vehicle movement list
 	int source_intersection_id = atoi(AP->vertex); //the id of the packet source intersection having the AP
 	struct_graph_node *Gr_global = param->vanet_table.Gr; //pointer to the global road network graph having the global directional queue DEr to manage the clusters of vehicles 
 	int Gr_global_size = param->vanet_table.Gr_size; //size of Gr_global
@@ -4799,11 +4824,24 @@ boolean VADD_Is_There_Next_Carrier_On_Road_Segment_Incident_To_Intersection_For_
 		exit(1);
 	}
 
+	update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	/* visit only the vehicles within the communication range of the intersection by the offset index of the edge */
+	if(edge_type == OUTGOING_EDGE)
+		size = GetVehicleMovementsInOffsetRange(&(pEdgeNode->vehicle_movement_list), -INF, param->communication_range, &neighbor_array);
+	else
+		size = GetVehicleMovementsInOffsetRange(&(pEdgeNode->vehicle_movement_list), pEdgeNode->weight - param->communication_range, pEdgeNode->weight + param->communication_range, &neighbor_array);
+#else
 	size = pEdgeNode->vehicle_movement_list.size;
 	pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
+#endif /* ] */
 	for(i = 0; i < size && flag == FALSE; i++) //[03/18/09] for-1
 	{
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+		pMoveNode = neighbor_array[i];
+#else
 		pMoveNode = pMoveNode->next;
+#endif /* ] */
 
 		if(edge_type == OUTGOING_EDGE) //for the outgoing edge of the intersection (i.e., tail_node)
 			distance = pMoveNode->offset;
@@ -4887,6 +4925,10 @@ boolean VADD_Is_There_Next_Carrier_On_Road_Segment_Incident_To_Intersection_For_
 		} //end of switch-1
 	} //end of for-1
 
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+	free(neighbor_array);
+#endif /* ] */
+
 	/** check whether a next carrier vehicle exists */
 	if(*next_carrier != NULL)
 		result = TRUE;
@@ -8903,15 +8945,15 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_VADD_For_V2V_Data_Delivery(parameter_t
 	*vehicle_EDD_SD = MIN(*vehicle_EDD_SD, INF); //[10/26/09] vehicle_EDD_SD is at most INF
 }
 
-void VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection(parameter_t *param, int target_point_id, char *AP_vertex, forwarding_table_queue_t *FTQ, double *AP_EDD, double *AP_EDD_SD)
+void VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection(parameter_t *param, int target_point_id, char *AP_vertex, struct_graph_node *G, int G_size, double *AP_EDD, double *AP_EDD_SD)
 { //compute the EDD and EDD_SD for a target point towards a destination vehicle, based on EDD Computation Model (i.e., Stochastic Model or Shortest Path Model) from an intersection having an access point, that is, from AP's gnode.
 
     /* Note that we compute the EDD and EDD_SD for each intersection only where VANET E2E Delay Model is Stochastic Model, because with VANET E2E Delay Model of Shortest Path Model, the EDD and EDD_SD of each intersection has been computed at VADD_Compute_EDD_And_EDD_SD_Based_On_Shortest_Path_Model_For_Shortest_EDD */
     if(param->vehicle_vanet_edd_computation_model == VANET_EDD_COMPUTATION_BASED_ON_STOCHASTIC_MODEL)
-        VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection_Based_On_Stochastic_Model(param, target_point_id, AP_vertex, FTQ, AP_EDD, AP_EDD_SD);
+        VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection_Based_On_Stochastic_Model(param, target_point_id, AP_vertex, G, G_size, AP_EDD, AP_EDD_SD);
 }
 
-void VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection_Based_On_Stochastic_Model(parameter_t *param, int target_point_id, char *AP_vertex, forwarding_table_queue_t *FTQ, double *AP_EDD, double *AP_EDD_SD)
+void VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection_Based_On_Stochastic_Model(parameter_t *param, int target_point_id, char *AP_vertex, struct_graph_node *G, int G_size, double *AP_EDD, double *AP_EDD_SD)
 { //compute the EDD and EDD_SD for a target point towards a destination vehicle, based on VADD Stochastic Model (i.e., Per-intersection Model) from an intersection having an access point, that is, from AP's gnode.
   int AP_vertex_id = atoi(AP_vertex); //id corresponding to the vertex having AP
   double EDD = 0; //EDD at intersection
@@ -8923,17 +8965,11 @@ void VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection_Based_On_Stocha
   char *tail_node = NULL; //tail node of the directional edge where vehicle is moving
   char *head_node = NULL; //head node of the directional edge where vehicle is moving
   directional_edge_queue_node_t *pEdgeNode = NULL; //pointer to the directional edge of <tail_node,head_node>
-  struct_graph_node *G = NULL; //pointer to graph G for target_point_id
-  int G_size = 0; //size of graph G
   struct_graph_node *intersection_gnode = NULL; //pointer to a graph node corresponding to intersection_id
   struct_graph_node *neighbor_gnode = NULL; //pointer to a neighbor graph node
   int i = 0; //index for for-loop
   int neighbor_number = 0; //number of neighbors for the intersection point having the AP
 
-  /** get the graph for the target point from forwarding table queue FTQ */
-  G = FTQ->index_table[target_point_id-1]->G;
-  G_size = FTQ->size;
-
   /** get the pointer to the graph node corresponding to intersection_id */
   if(AP_vertex_id > G_size)
   {
@@ -9091,7 +9127,7 @@ void VADD_Get_EDD_And_EDD_SD_For_TargetPoint_At_Intersection(parameter_t *param,
   int G_size = 0; //size of graph G
   struct_graph_node *intersection_gnode = NULL; //pointer to a graph node corresponding to intersection_id
   /** get the graph for the target point from forwarding table queue FTQ */
-  G = FTQ->index_table[target_point_id-1]->G;
+  G = GetForwardingTableGraph(FTQ, target_point_id);
   G_size = FTQ->size;
 
   /** get the pointer to the graph node corresponding to intersection_id */
@@ -9105,6 +9141,8 @@ void VADD_Get_EDD_And_EDD_SD_For_TargetPoint_At_Intersection(parameter_t *param,
   /* set intersection_EDD and intersection_EDD_SD to EDD and EDD_SD, respectively */
   *intersection_EDD = intersection_gnode->EDD;
   *intersection_EDD_SD = intersection_gnode->EDD_SD; 
+
+  ReleaseForwardingTableGraph(FTQ); //G must not be used after this release
 }
 
 void VADD_Get_EDD_And_EDD_SD_For_TargetPoint_At_Intersection_For_V2V_Data_Delivery(parameter_t *param, int target_point_id, char *intersection_vertex, forwarding_table_queue_t *FTQ, struct_graph_node *Gr, int Gr_size, double *intersection_EDD, double *intersection_EDD_SD)
@@ -9126,8 +9164,9 @@ void VADD_Get_EDD_And_EDD_SD_For_TargetPoint_At_Intersection_For_V2V_Data_Delive
 
 #if 1 /* [ */ 
   /** get the graph for the target point from forwarding table queue FTQ */
-  G2 = FTQ->index_table[target_point_id-1]->G;
+  G2 = GetForwardingTableGraph(FTQ, target_point_id);
   G_size2 = FTQ->size;
+  ReleaseForwardingTableGraph(FTQ); //G2 must not be used after this release
 #endif /* ] */
 
   /** get the pointer to the graph node corresponding to intersection_id */
@@ -9163,7 +9202,7 @@ void VADD_Get_EDD_And_EDD_SD_For_TargetPoint_At_Carrier(parameter_t *param, int
   double EDD_VAR = 0; //E2E delivery delay variance
 
   /** get the graph for the target point from forwarding table queue FTQ */
-  G = FTQ->index_table[target_point_id-1]->G;
+  G = GetForwardingTableGraph(FTQ, target_point_id);
   G_size = FTQ->size;
 
   /** get the pointer to the directed edge corresponding to (pTailNode, pHeadNode) */
@@ -9192,6 +9231,8 @@ void VADD_Get_EDD_And_EDD_SD_For_TargetPoint_At_Carrier(parameter_t *param, int
 
   EDD_VAR = pEdgeNode->head_gnode->gnode->EDD_VAR; 
   *EDD_SD = sqrt(EDD_VAR + link_delay_variance); 
+
+  ReleaseForwardingTableGraph(FTQ); //G must not be used after this release
 }
 
 double VADD_Get_EDD_And_EDD_SD_In_Shortest_Path_Model(parameter_t *param, int src_id, int dst_id, double *EDD, double *EDD_SD)
@@ -9339,7 +9380,7 @@ void VADD_Update_Vehicle_EDD_And_EDD_SD_For_Download(double update_time, paramet
   }
 
   /* set up G, G_size and tp_table */
-  G = FTQ->index_table[vehicle->target_point_id-1]->G;
+  G = GetForwardingTableGraph(FTQ, vehicle->target_point_id);
   G_size = FTQ->size;
     
   /* set up target point table with vehicle's target point id */
@@ -9370,6 +9411,8 @@ void VADD_Update_Vehicle_EDD_And_EDD_SD_For_Download(double update_time, paramet
 
   /* update vehicle's EDD update time */
   vehicle->EDD_update_time_for_download = update_time;
+
+  ReleaseForwardingTableGraph(FTQ); //G must not be used after this release
 }
 
 void VADD_Update_Vehicle_EDD_And_EDD_SD_For_Download_With_Given_TargetPoint_And_SequenceNumber(double update_time, parameter_t *param, struct_vehicle_t *vehicle, forwarding_table_queue_t *FTQ, int target_point_id, unsigned int seq)
@@ -9407,7 +9450,7 @@ void VADD_Update_Vehicle_EDD_And_EDD_SD_For_Download_With_Given_TargetPoint_And_
   }
 
   /* set up G, G_size and tp_table */
-  G = FTQ->index_table[vehicle->target_point_id-1]->G;
+  G = GetForwardingTableGraph(FTQ, vehicle->target_point_id);
   G_size = FTQ->size;
     
   /* set up target point table with vehicle's target point id */
@@ -9438,6 +9481,8 @@ void VADD_Update_Vehicle_EDD_And_EDD_SD_For_Download_With_Given_TargetPoint_And_
 
   /* update vehicle's EDD update time */
   vehicle->EDD_update_time_for_download = update_time;
+
+  ReleaseForwardingTableGraph(FTQ); //G must not be used after this release
 }
 
 void VADD_Update_VehicleTargetPoint_Along_With_EDD_And_EDD_SD_For_Download(double update_time, parameter_t *param, struct_vehicle_t *vehicle, forwarding_table_queue_t *FTQ, intersection_area_type_t input_intersection_area_type)
@@ -9846,6 +9891,7 @@ boolean VADD_Is_There_Next_Carrier_On_Road_Segment_Incident_To_Intersection_Area
   vehicle_movement_queue_node_t *pMoveNode = NULL; //pointer to the vehicle movement queue
   int i = 0; //index for for-loop
   int size = 0; //size of vehicle movement queue
+  vehicle_movement_queue_node_t **neighbor_array = NULL; //array of the vehicle movement queue nodes within the communication range in the order of the vehicle movement list
   double offset_in_directional_edge = 0; //vehicle's offset on the directional edge; NOTE that this offset will be -R/2 where R is the communication range.
 
   /** reset *next_carrier to NULL */
@@ -9870,12 +9916,25 @@ boolean VADD_Is_There_Next_Carrier_On_Road_Segment_Incident_To_Intersection_Area
     exit(1);
   }
 
+  update_vehicle_movement_queue_on_demand(param, &(pEdgeNode->vehicle_movement_list)); //bring the offsets on this edge up to date under STEP_ANALYTIC
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+  /* visit only the vehicles within the communication range of the intersection by the offset index of the edge */
+  if(edge_type == OUTGOING_EDGE)
+    size = GetVehicleMovementsInOffsetRange(&(pEdgeNode->vehicle_movement_list), -INF, R, &neighbor_array);
+  else
+    size = GetVehicleMovementsInOffsetRange(&(pEdgeNode->vehicle_movement_list), pEdgeNode->weight - R, INF, &neighbor_array);
+#else
   size = pEdgeNode->vehicle_movement_list.size;
   pMoveNode = &(pEdgeNode->vehicle_movement_list.head);
+#endif /* ] */
   for(i = 0; i < size && flag == FALSE; i++) //[03/18/09] for-1
   //for(i = 0; i < size; i++) //for-1
   {
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+    pMoveNode = neighbor_array[i];
+#else
     pMoveNode = pMoveNode->next;
+#endif /* ] */
     if(vehicle->id == pMoveNode->vid)
       continue;
 
@@ -9937,6 +9996,10 @@ boolean VADD_Is_There_Next_Carrier_On_Road_Segment_Incident_To_Intersection_Area
     } //end of switch-1
   } //end of for-1
 
+#if VEHICLE_MOVEMENT_OFFSET_INDEX_FLAG /* [ */
+  free(neighbor_array);
+#endif /* ] */
+
   /** check whether a next carrier vehicle exists */
   if(*next_carrier != NULL)
     result = TRUE;
@@ -9965,8 +10028,8 @@ boolean VADD_Is_Vehicle_Moving_On_Packet_Trajectory(struct_vehicle_t *vehicle, p
   }
   else
   {
-    vehicle_tail_intersection_id = atoi(vehicle->path_ptr->vertex);
-    vehicle_head_intersection_id = atoi(vehicle->path_ptr->next->vertex);
+    vehicle_tail_intersection_id = vehicle->path_ptr->vertex_id;
+    vehicle_head_intersection_id = vehicle->path_ptr->next->vertex_id;
   }
 
   /** set packet_tail_intersection_id and packet_head_intersection_id to the tail and head nodes of the packet's current edge */
@@ -79,6 +79,9 @@ double VADD_Compute_Conditional_Probability_For_Forwarding_Probability(angle_que
 double VADD_Compute_Conditional_Probability_For_Pure_Forwarding_Probability(angle_queue_t *M, int k, int h, angle_queue_node_t *pAngleNode);
 //compute conditional probability that a vehicle moving in road r_ih will forward a packet to another vehicle moving towards intersection I_k at intersection I_i along with angle queue M where pAngleNode is the pointer to the angle node corresponding to k; Note that this pure forwarding probability excludes the case where the carrier towards I_h keeps carrying the packet without forwarding.
 
+void VADD_Solve_Stochastic_Model_Linear_System(delay_queue_t *DQ, boolean *destination_flag, boolean variance_flag, double *x);
+//solve the linear system (P - E)x = -d of the stochastic model for the delay nodes in DQ where destination_flag[i] tells whether the road segment of the i-th delay node ends at a destination; if variance_flag is TRUE, solve (P^2 - E)x = -v for the delivery delay variances instead, where P^2 is the entrywise square of P and v is the edge delay variance vector
+
 void VADD_Compute_EDD_Based_On_Stochastic_Model(parameter_t *param, struct_graph_node *G, int G_size, directional_edge_queue_t *EQ, struct_traffic_table *ap_table, int ap_table_index);
 //compute the Expected Delivery Delay (EDD) based on the stochastic model with graph G and directional edge queue EQ.
 
@@ -121,10 +124,16 @@ void VADD_Compute_EDD_And_EDD_SD_Based_On_Shortest_Path_Model_For_Shortest_EDD_V
 void VADD_Compute_EDC_And_EDC_SD_Based_On_Shortest_Path_Model_For_Shortest_EDC(parameter_t *param, struct_graph_node *G, int G_size, directional_edge_queue_t *EQ, struct_traffic_table *ap_table, int ap_table_index, boolean forwarding_table_update_flag);
 //For the shortest EDC (i.e., expected delivery cost), compute the Expected Delivery Cost (EDC) and the Delivery Cost Standard Deviation based on the shortest path model with graph G and directional edge queue EQ. Note that if fowarding_table_update_flag is TRUE, this functions updates the matrices for the forwarding table entry corresponding to ap_table_index. Otherwise, it updates the matrices of the global matrices, such as param->vanet_table.Dr_edc.
 
-void VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection(parameter_t *param, int target_point_id, char *AP_vertex, forwarding_table_queue_t *FTQ, double *AP_EDD, double *AP_EDD_SD);
+void VADD_Set_EDD_And_EDD_SD_In_Graph_With_Vectors(struct_graph_node *G, int G_size, double *delay, double *delay_variance);
+//set the EDD, EDD_VAR and EDD_SD of each intersection and road segment in G with the shortest path delay vector and delay variance vector towards a target point
+
+void VADD_Set_EDC_And_EDC_SD_In_Graph_With_Vectors(struct_graph_node *G, int G_size, double *cost, double *cost_variance);
+//set the EDC, EDC_VAR and EDC_SD of each intersection and road segment in G with the shortest path cost vector and cost variance vector towards a target point
+
+void VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection(parameter_t *param, int target_point_id, char *AP_vertex, struct_graph_node *G, int G_size, double *AP_EDD, double *AP_EDD_SD);
 //compute the EDD and EDD_SD for a target point towards a destination vehicle, based on EDD Computation Model (i.e., Stochastic Model or Shortest Path Model) from an intersection having an access point, that is, from AP's gnode.
 
-void VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection_Based_On_Stochastic_Model(parameter_t *param, int target_point_id, char *AP_vertex, forwarding_table_queue_t *FTQ, double *AP_EDD, double *AP_EDD_SD);
+void VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection_Based_On_Stochastic_Model(parameter_t *param, int target_point_id, char *AP_vertex, struct_graph_node *G, int G_size, double *AP_EDD, double *AP_EDD_SD);
 //compute the EDD and EDD_SD for a target point towards a destination vehicle, based on VADD Stochastic Model (i.e., Per-intersection Model) from an intersection having an access point, that is, from AP's gnode.
 
 void VADD_Compute_EDD_And_EDD_SD_For_TargetPoint_At_Intersection_For_V2V_Data_Delivery(parameter_t *param, int target_point_id, int source_intersection_id, struct_graph_node *Gr, int Gr_size, double *E2E_EDD, double *E2E_EDD_SD);
@@ -103,6 +103,10 @@ typedef struct struct_vehicle
     double move_start_time; /* time is when vehicle starts to move in each movement step */
     double move_end_time;   /* time is when vehicle ends to move in each movement step */
     double move_interval;   /* movement interval in each movement step */
+    boolean flag_analytic_movement; /* flag to indicate that the position of the ongoing movement step is computed on demand under STEP_ANALYTIC */
+    double move_start_offset; /* offset in real graph Gr at move_start_time under STEP_ANALYTIC */
+    double move_start_path_current_edge_offset; /* path_current_edge_offset at move_start_time under STEP_ANALYTIC */
+    struct_coordinate1_t move_start_pos; /* position in the Cartesian coordinate system at move_start_time under STEP_ANALYTIC */
     double arrival_time;    /* time when it arrives at road network */
     double restart_time;     /* time when this vehicle restared its movement with a new trajectory */
     double detection_time; /* time detected by a sensor */
@@ -130,8 +134,15 @@ typedef struct struct_vehicle
 
     int path_traverse_count; //count for how many times vehicle passed its vehicle trajectory
 
+    unsigned long long speed_draw_count; //number of draws taken from the vehicle's counter-based substream for its speed
+
 	/** Variables for TPD */
 	struct _predicted_encounter_graph_t *predicted_encounter_graph; //predicted encounter graph
+	int tpd_encounter_candidate_stamp; //stamp of the latest trajectory edge index query that found this vehicle as an encounter candidate
+	int tpd_trajectory_version; //version of the vehicle trajectory that is increased whenever the trajectory, its current road segment or the vehicle speed changes
+
+	/** Variables for trajectory queries */
+	trajectory_prefix_sum_t path_prefix_sum; //prefix sums along path_list that are rebuilt at the first query after tpd_trajectory_version changes
 
     struct struct_vehicle* next; /* next vehicle */
     struct struct_vehicle* prev; /* previous vehicle */